@@ -226,7 +226,7 @@ namespace Adventure
 
         private void Bind(IShaderBindingTable sbt, ITopLevelAS tlas)
         {
-            spriteInstance.Bind(this.tlasData.InstanceName, sbt, tlas, sprite);
+            spriteInstance.Bind(this.tlasData, sbt, tlas, sprite);
         }
     }
 }
@@ -233,7 +233,7 @@ namespace Adventure.Battle
             blasInstanceData.indexOffset = floorMesh.Instance.IndexOffset;
             fixed (BlasInstanceData* ptr = &blasInstanceData)
             {
-                floorShader.BindSbt(floorInstanceData.InstanceName, sbt, tlas, new IntPtr(ptr), (uint)sizeof(BlasInstanceData));
+                floorShader.BindSbt(floorInstanceData, sbt, tlas, new IntPtr(ptr), (uint)sizeof(BlasInstanceData));
             }
         }
 
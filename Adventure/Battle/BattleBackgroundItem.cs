@@ -102,7 +102,7 @@ namespace Adventure.Battle
 
         private void Bind(IShaderBindingTable sbt, ITopLevelAS tlas)
         {
-            spriteInstance.Bind(this.tlasData.InstanceName, sbt, tlas, sprite);
+            spriteInstance.Bind(this.tlasData, sbt, tlas, sprite);
         }
     }
 }
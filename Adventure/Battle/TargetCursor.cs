@@ -507,7 +507,7 @@ namespace Adventure.Battle
 
         private void Bind(IShaderBindingTable sbt, ITopLevelAS tlas)
         {
-            spriteInstance.Bind(this.tlasData.InstanceName, sbt, tlas, sprite);
+            spriteInstance.Bind(this.tlasData, sbt, tlas, sprite);
         }
 
         private void KeybindService_KeybindChanged(KeybindService service, KeyBindings keyBinding)
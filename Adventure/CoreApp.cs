@@ -79,6 +79,8 @@ namespace Adventure
                 o.DeviceId = options.DeviceId;
                 o.UpsamplingMethod = options.UpsamplingMethod;
                 o.FSR1RenderPercentage = options.FSR1RenderPercentage;
+                o.ShaderCacheDirectory = Path.Combine(Environment.GetFolderPath(Environment.SpecialFolder.LocalApplicationData), "Anomalous Adventure", "ShaderCache");
+                o.NumDeferredContexts = 1;
             })
             .AddDiligentEngineRt();
 
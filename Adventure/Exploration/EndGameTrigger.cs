@@ -267,7 +267,7 @@ class EndGameTrigger : IDisposable, IZonePlaceable
         blasInstanceData.indexOffset = cubeBLAS.Instance.IndexOffset;
         fixed (BlasInstanceData* ptr = &blasInstanceData)
         {
-            primaryHitShader.BindSbt(tlasData.InstanceName, sbt, tlas, new IntPtr(ptr), (uint)sizeof(BlasInstanceData));
+            primaryHitShader.BindSbt(tlasData, sbt, tlas, new IntPtr(ptr), (uint)sizeof(BlasInstanceData));
         }
     }
 }
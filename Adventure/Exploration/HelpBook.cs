@@ -404,6 +404,6 @@ class HelpBook : IDisposable, IZonePlaceable
 
     private void Bind(IShaderBindingTable sbt, ITopLevelAS tlas)
     {
-        spriteInstance.Bind(this.tlasData.InstanceName, sbt, tlas, sprite);
+        spriteInstance.Bind(this.tlasData, sbt, tlas, sprite);
     }
 }
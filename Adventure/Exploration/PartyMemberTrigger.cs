@@ -355,7 +355,7 @@ namespace Adventure.Exploration
 
         private void Bind(IShaderBindingTable sbt, ITopLevelAS tlas)
         {
-            spriteInstance.Bind(this.tlasData.InstanceName, sbt, tlas, sprite);
+            spriteInstance.Bind(this.tlasData, sbt, tlas, sprite);
         }
 
         private void OnMainHandModified(CharacterSheet characterSheet)
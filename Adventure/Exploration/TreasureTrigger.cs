@@ -220,6 +220,6 @@ class TreasureTrigger : IDisposable, IZonePlaceable
 
     private void Bind(IShaderBindingTable sbt, ITopLevelAS tlas)
     {
-        spriteInstance.Bind(this.tlasData.InstanceName, sbt, tlas, sprite);
+        spriteInstance.Bind(this.tlasData, sbt, tlas, sprite);
     }
 }
@@ -559,6 +559,8 @@ namespace Adventure
                     description.MainThreadSyncTask = null; //Null this out so we don't hold onto any closures
                 }
 
+                //The zone floor never changes once it is built
+                floorMesh.Compact = true;
                 await floorMesh.End("ZoneFloor");
 
                 //TODO: The zone BLASes must be loaded before the shaders, see todo in PrimaryHitShader
@@ -1684,7 +1686,7 @@ namespace Adventure
             floorBlasInstanceData.indexOffset = mapMesh.FloorMesh.Instance.IndexOffset;
             fixed (BlasInstanceData* ptr = &floorBlasInstanceData)
             {
-                floorShader.BindSbt(floorInstanceData.InstanceName, sbt, tlas, new IntPtr(ptr), (uint)sizeof(BlasInstanceData));
+                floorShader.BindSbt(floorInstanceData, sbt, tlas, new IntPtr(ptr), (uint)sizeof(BlasInstanceData));
             }
         }
 
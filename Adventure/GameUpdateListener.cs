@@ -34,6 +34,7 @@ namespace Adventure
         private readonly IClockService clockService;
         private readonly IAchievementService achievementService;
         private readonly PauseService pauseService;
+        private readonly DeferredCommandRecorder commandRecorder;
         private IGameState gameState;
 
         public unsafe GameUpdateListener
@@ -53,7 +54,8 @@ namespace Adventure
             GameOptions gameOptions,
             IClockService clockService,
             IAchievementService achievementService,
-            PauseService pauseService
+            PauseService pauseService,
+            DeferredCommandRecorder commandRecorder
         )
         {
 
@@ -73,6 +75,7 @@ namespace Adventure
             this.clockService = clockService;
             this.achievementService = achievementService;
             this.pauseService = pauseService;
+            this.commandRecorder = commandRecorder;
             this.gameState = startState.GetFirstGameState();
             this.gameState.SetActive(true);
         }
@@ -118,6 +121,14 @@ namespace Adventure
             var pRTV = swapChain.GetCurrentBackBufferRTV();
             var pDSV = swapChain.GetDepthBufferDSV();
 
+            //The gui does not depend on the scene, so record it on another thread while the scene renders.
+            //The render targets are transitioned on the immediate context before it runs.
+            var guiRecording = commandRecorder.Begin(context =>
+            {
+                context.SetRenderTarget(pRTV, pDSV, RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_NONE);
+                sharpGui.Render(context);
+            });
+
             cameraMover.GetPosition(clock, out var camPos, out var camRot);
             bool clearRenderTarget = rayTracingRenderer.Render(rtInstances, camPos, camRot);
             immediateContext.SetRenderTarget(pRTV, pDSV, RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
@@ -130,7 +141,7 @@ namespace Adventure
             }
 
             immediateContext.ClearDepthStencil(pDSV, CLEAR_DEPTH_STENCIL_FLAGS.CLEAR_DEPTH_FLAG, 1.0f, 0, RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-            sharpGui.Render(immediateContext);
+            commandRecorder.Execute(guiRecording);
 
             this.swapChain.Present(gameOptions.PresentInterval);
 
@@ -281,7 +281,7 @@ namespace Adventure.WorldMap
 
         private unsafe void Bind(IShaderBindingTable sbt, ITopLevelAS tlas)
         {
-            spriteInstance.Bind(this.instanceData.InstanceName, sbt, tlas, sprite);
+            spriteInstance.Bind(this.instanceData, sbt, tlas, sprite);
         }
 
         public void CreatePhysics()
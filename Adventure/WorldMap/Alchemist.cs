@@ -292,7 +292,7 @@ namespace Adventure.WorldMap
         {
             foreach (var data in tlasData)
             {
-                spriteInstance.Bind(data.InstanceName, sbt, tlas, sprite);
+                spriteInstance.Bind(data, sbt, tlas, sprite);
             }
         }
     }
@@ -375,7 +375,7 @@ namespace Adventure.WorldMap
             {
                 foreach (var data in floorInstanceData)
                 {
-                    shader.BindSbt(data.InstanceName, sbt, tlas, new IntPtr(ptr), (uint)sizeof(BlasInstanceData));
+                    shader.BindSbt(data, sbt, tlas, new IntPtr(ptr), (uint)sizeof(BlasInstanceData));
                 }
             }
         }
@@ -127,7 +127,7 @@ namespace Adventure.WorldMap
             blasInstanceData.indexOffset = meshBlas.Instance.IndexOffset;
             fixed (BlasInstanceData* ptr = &blasInstanceData)
             {
-                primaryHitShader.BindSbt(instanceData.InstanceName, sbt, tlas, new IntPtr(ptr), (uint)sizeof(BlasInstanceData));
+                primaryHitShader.BindSbt(instanceData, sbt, tlas, new IntPtr(ptr), (uint)sizeof(BlasInstanceData));
             }
         }
 
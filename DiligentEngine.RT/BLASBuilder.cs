@@ -1,4 +1,5 @@
 ﻿using Engine;
+using Microsoft.Extensions.Logging;
 using System;
 using System.Collections.Generic;
 using System.Linq;
@@ -33,6 +34,12 @@ namespace DiligentEngine.RT
         public RAYTRACING_BUILD_AS_FLAGS BuildAsFlags { get; set; } = RAYTRACING_BUILD_AS_FLAGS.RAYTRACING_BUILD_AS_PREFER_FAST_TRACE;
 
         public RAYTRACING_GEOMETRY_FLAGS Flags { get; internal set; } = RAYTRACING_GEOMETRY_FLAGS.RAYTRACING_GEOMETRY_FLAG_OPAQUE;
+
+        /// <summary>
+        /// Compact the blas after it is built. This makes the blas smaller, but waits for the gpu to be idle
+        /// to find out the compacted size. Use this for static geometry that is loaded once and kept around.
+        /// </summary>
+        public bool Compact { get; set; }
     }
 
     public class BLASInstance : IDisposable
@@ -46,13 +53,13 @@ namespace DiligentEngine.RT
         internal AutoPtr<IBuffer> VertexBuffer { get; set; }
         internal AutoPtr<IBuffer> IndexBuffer { get; set; }
 
-        public uint VertexOffset { get; internal set; }
+        public uint VertexOffset => VertexRange.Offset;
 
-        public uint IndexOffset { get; internal set; }
+        public uint IndexOffset => IndexRange.Offset;
 
-        internal CubeAttribVertex[] AttrVertices;
+        internal GeometryArenaRange VertexRange { get; set; }
 
-        internal uint[] Indices;
+        internal GeometryArenaRange IndexRange { get; set; }
 
         private readonly BLASBuilder builder;
 
@@ -67,86 +74,41 @@ namespace DiligentEngine.RT
 
     public class BLASBuilder : IDisposable
     {
-        class BLASInstanceManager
-        {
-            private List<BLASInstance> instances = new List<BLASInstance>();
-            private int vertexCount = 0;
-            private int indexCount = 0;
-
-            public int VertexCount => vertexCount;
-
-            public int IndexCount => indexCount;
-
-            public void Add(BLASInstance instance)
-            {
-                this.instances.Add(instance);
-                vertexCount += instance.AttrVertices.Length;
-                indexCount += instance.Indices.Length;
-            }
-
-            public void Remove(BLASInstance instance)
-            {
-                var index = instances.IndexOf(instance);
-                if (index != -1)
-                {
-                    this.instances.RemoveAt(index);
-                    vertexCount -= instance.AttrVertices.Length;
-                    indexCount -= instance.Indices.Length;
-                }
-            }
-
-            public CubeAttribVertex[] CreateAttrVerticesArray()
-            {
-                //TODO: For now just do a lame copy of the array, can improve this later once everything is working
-                var array = new CubeAttribVertex[vertexCount];
-                int offset = 0;
-                foreach(var instance in instances)
-                {
-                    instance.VertexOffset = (uint)offset;
-                    var length = instance.AttrVertices.Length;
-                    var target = new Span<CubeAttribVertex>(array, offset, length);
-                    var source = new Span<CubeAttribVertex>(instance.AttrVertices);
-                    source.CopyTo(target);
-                    offset += length;
-                }
-                return array;
-            }
-
-            public uint[] CreateAttrIndicesArray()
-            {
-                //TODO: For now just do a lame copy of the array, can improve this later once everything is working
-                var array = new uint[indexCount];
-                int offset = 0;
-                foreach (var instance in instances)
-                {
-                    instance.IndexOffset = (uint)offset;
-                    var length = instance.Indices.Length;
-                    var target = new Span<uint>(array, offset, length);
-                    var source = new Span<uint>(instance.Indices);
-                    source.CopyTo(target);
-                    offset += length;
-                }
-                return array;
-            }
-        }
-
         private readonly GraphicsEngine graphicsEngine;
         private readonly RayTracingRenderer renderer;
-        private readonly BLASInstanceManager manager = new BLASInstanceManager();
+        private readonly ILogger<BLASBuilder> logger;
+        private readonly GeometryArena<CubeAttribVertex> attrArena;
+        private readonly GeometryArena<uint> indexArena;
+        private readonly IBottomLevelAS[] compactBlas = new IBottomLevelAS[1];
+        private readonly ulong[] compactedSizes = new ulong[1];
 
-        AutoPtr<IBuffer> attrBuffer;
-        AutoPtr<IBuffer> indexBuffer;
+        //Chunk sizes the shared geometry grows by, in elements
+        private const uint VertexChunkSize = 64 * 1024;
+        private const uint IndexChunkSize = 256 * 1024;
 
-        public IBuffer AttrBuffer => attrBuffer.Obj;
+        public IBuffer AttrBuffer => attrArena.Buffer;
 
-        public IBuffer IndexBuffer => indexBuffer.Obj;
+        public IBuffer IndexBuffer => indexArena.Buffer;
 
-        public BLASBuilder(GraphicsEngine graphicsEngine, RayTracingRenderer renderer)
+        public BLASBuilder(GraphicsEngine graphicsEngine, RayTracingRenderer renderer, ILogger<BLASBuilder> logger)
         {
             this.graphicsEngine = graphicsEngine;
             this.renderer = renderer;
+            this.logger = logger;
+            this.attrArena = new GeometryArena<CubeAttribVertex>(graphicsEngine, "Attrib vertices buffer", VertexChunkSize);
+            this.indexArena = new GeometryArena<uint>(graphicsEngine, "Indices buffer", IndexChunkSize);
         }
 
+        /// <summary>
+        /// The total size of the compacted blases before compaction. This only counts what the backend can report.
+        /// </summary>
+        public ulong UncompactedBlasMemory { get; private set; }
+
+        /// <summary>
+        /// The total size of the compacted blases after compaction.
+        /// </summary>
+        public ulong CompactedBlasMemory { get; private set; }
+
         /// <summary>
         /// Create a blas mesh. The caller is responsible to dispose the result.
         /// </summary>
@@ -159,6 +121,7 @@ namespace DiligentEngine.RT
             var Attribs = new BuildBLASAttribs();
             var result = new BLASInstance(this);
             AutoPtr<IBuffer> pScratchBuffer = null;
+            CubeAttribVertex[] attrVertices = null;
 
             try
             {
@@ -166,12 +129,9 @@ namespace DiligentEngine.RT
 
                 await Task.Run(() =>
                 {
-                    var attrVertices = new CubeAttribVertex[blasMeshDesc.CubePos.Length];
+                    attrVertices = new CubeAttribVertex[blasMeshDesc.CubePos.Length];
                     var Indices = blasMeshDesc.Indices;
 
-                    result.AttrVertices = attrVertices;
-                    result.Indices = Indices;
-
                     for (var i = 0; i < blasMeshDesc.CubePos.Length; ++i)
                     {
                         var vertex = new CubeAttribVertex();
@@ -270,6 +230,10 @@ namespace DiligentEngine.RT
                             var ASDesc = new BottomLevelASDesc();
                             ASDesc.Name = $"{blasMeshDesc.Name} BLAS";
                             ASDesc.Flags = blasMeshDesc.BuildAsFlags;
+                            if (blasMeshDesc.Compact)
+                            {
+                                ASDesc.Flags |= RAYTRACING_BUILD_AS_FLAGS.RAYTRACING_BUILD_AS_ALLOW_COMPACTION;
+                            }
                             ASDesc.pTriangles = new List<BLASTriangleDesc> { Triangles };
 
                             result.BLAS = m_pDevice.CreateBLAS(ASDesc);
@@ -278,12 +242,14 @@ namespace DiligentEngine.RT
                         }
 
                         // Create scratch buffer
+                        var scratchSizes = new ScratchBufferSizesPassStruct();
+                        result.BLAS.Obj.GetScratchBufferSizes(ref scratchSizes);
                         pScratchBuffer = m_pDevice.CreateBuffer(new BufferDesc()
                         {
                             Name = $"{blasMeshDesc.Name} BLAS Scratch Buffer",
                             Usage = USAGE.USAGE_DEFAULT,
                             BindFlags = BIND_FLAGS.BIND_RAY_TRACING,
-                            Size = result.BLAS.Obj.ScratchBufferSizes_Build,
+                            Size = scratchSizes.Build,
                         }, new BufferData());
 
                         barriers.Add(new StateTransitionDesc { pResource = pScratchBuffer.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_BUILD_AS_WRITE, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
@@ -316,8 +282,7 @@ namespace DiligentEngine.RT
                 });
 
                 //TODO: For now this has no synchronization, so do it on the main thread, but this could be changed
-                manager.Add(result);
-                UpdateSharedBuffers(barriers);
+                UploadSharedGeometry(result, attrVertices, blasMeshDesc.Indices, barriers);
 
                 var m_pImmediateContext = graphicsEngine.ImmediateContext;
                 m_pImmediateContext.TransitionResourceStates(barriers);
@@ -328,6 +293,11 @@ namespace DiligentEngine.RT
                 barriers.Add(new StateTransitionDesc { pResource = result.BLAS.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_BUILD_AS_READ, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
                 m_pImmediateContext.TransitionResourceStates(barriers);
 
+                if (blasMeshDesc.Compact)
+                {
+                    CompactBLAS(result, blasMeshDesc.Name, barriers);
+                }
+
                 return result;
             }
             finally
@@ -338,7 +308,64 @@ namespace DiligentEngine.RT
 
         public void Dispose()
         {
-            DestroyShaderBuffers();
+            attrArena.Dispose();
+            indexArena.Dispose();
+        }
+
+        private void CompactBLAS(BLASInstance instance, String name, List<StateTransitionDesc> barriers)
+        {
+            var m_pDevice = graphicsEngine.RenderDevice;
+            var m_pImmediateContext = graphicsEngine.ImmediateContext;
+
+            var source = instance.BLAS;
+            compactBlas[0] = source.Obj;
+            try
+            {
+                m_pImmediateContext.ReadBLASCompactedSizes(m_pDevice, compactBlas, compactedSizes);
+            }
+            finally
+            {
+                compactBlas[0] = null;
+            }
+
+            var ASDesc = new BottomLevelASDesc();
+            ASDesc.Name = $"{name} Compacted BLAS";
+            ASDesc.CompactedSize = compactedSizes[0];
+            var compacted = m_pDevice.CreateBLAS(ASDesc);
+            if (compacted == null)
+            {
+                logger.LogWarning($"Could not create compacted BLAS for '{name}'. Keeping the original.");
+                return;
+            }
+
+            m_pImmediateContext.CopyBLAS(source.Obj, compacted.Obj, COPY_AS_MODE.COPY_AS_MODE_COMPACT,
+                RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+            barriers.Clear();
+            barriers.Add(new StateTransitionDesc { pResource = compacted.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_BUILD_AS_READ, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
+            m_pImmediateContext.TransitionResourceStates(barriers);
+
+            var before = source.Obj.MemorySize;
+            var after = compacted.Obj.MemorySize;
+            if (after == 0)
+            {
+                after = compactedSizes[0];
+            }
+
+            //The copy is recorded, Diligent keeps the source alive until the gpu is done with it
+            instance.BLAS = compacted;
+            source.Dispose();
+
+            UncompactedBlasMemory += before;
+            CompactedBlasMemory += after;
+            if (before > 0)
+            {
+                logger.LogInformation($"Compacted BLAS '{name}' from {before} to {after} bytes. Compacted BLAS total {UncompactedBlasMemory} to {CompactedBlasMemory} bytes.");
+            }
+            else
+            {
+                logger.LogInformation($"Compacted BLAS '{name}' to {after} bytes. The size before compaction is not available on this backend.");
+            }
         }
 
         public void CalculateTangentBitangent(
@@ -374,85 +401,26 @@ namespace DiligentEngine.RT
             v3.binormal = bitangent;
         }
 
-        private void DestroyShaderBuffers()
+        private void UploadSharedGeometry(BLASInstance instance, CubeAttribVertex[] attrVertices, uint[] indices, List<StateTransitionDesc> barriers)
         {
-            attrBuffer?.Dispose();
-            indexBuffer?.Dispose();
-            attrBuffer = null;
-            indexBuffer = null;
-        }
-
-        private void UpdateSharedBuffers(List<StateTransitionDesc> barriers)
-        {
-            var m_pDevice = graphicsEngine.RenderDevice;
+            instance.VertexRange = attrArena.Add(attrVertices, barriers, out var attrReplaced);
+            instance.IndexRange = indexArena.Add(indices, barriers, out var indexReplaced);
 
-            DestroyShaderBuffers();
-
-            // Create attribs vertex buffer
-            unsafe
+            if (attrReplaced || indexReplaced)
             {
-                var attrVertices = manager.CreateAttrVerticesArray();
-                if(attrVertices.Length == 0)
-                {
-                    return; //No vertices, bail
-                }
-
-                var BuffDesc = new BufferDesc();
-                BuffDesc.Name = "Attrib vertices buffer";
-                BuffDesc.Usage = USAGE.USAGE_IMMUTABLE;
-                BuffDesc.BindFlags = BIND_FLAGS.BIND_SHADER_RESOURCE;
-                BuffDesc.ElementByteStride = (uint)sizeof(CubeAttribVertex);
-                BuffDesc.Mode = BUFFER_MODE.BUFFER_MODE_STRUCTURED;
-
-                BufferData BufData = new BufferData();
-                fixed (CubeAttribVertex* p_vertices = attrVertices)
-                {
-                    BufData.pData = new IntPtr(p_vertices);
-                    BufData.DataSize = BuffDesc.Size = BuffDesc.ElementByteStride * (uint)attrVertices.Length;
-                    attrBuffer = m_pDevice.CreateBuffer(BuffDesc, BufData)
-                        ?? throw new InvalidOperationException("Cannot create attribute buffer");
-                }
-
-                barriers.Add(new StateTransitionDesc { pResource = attrBuffer.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_SHADER_RESOURCE, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
+                renderer.RequestRebind();
             }
-
-            // Create index buffer
-            unsafe
-            {
-                var Indices = manager.CreateAttrIndicesArray();
-                if(Indices.Length == 0)
-                {
-                    return; //No Indices, bail
-                }
-
-                var BuffDesc = new BufferDesc();
-                BuffDesc.Name = "Indices buffer";
-                BuffDesc.Usage = USAGE.USAGE_IMMUTABLE;
-                BuffDesc.BindFlags = BIND_FLAGS.BIND_SHADER_RESOURCE;
-                BuffDesc.ElementByteStride = (uint)sizeof(uint);
-                BuffDesc.Mode = BUFFER_MODE.BUFFER_MODE_STRUCTURED;
-
-                BufferData BufData = new BufferData();
-                fixed (uint* p_indices = Indices)
-                {
-                    BufData.pData = new IntPtr(p_indices);
-                    BufData.DataSize = BuffDesc.Size = BuffDesc.ElementByteStride * (uint)Indices.Length;
-                    indexBuffer = m_pDevice.CreateBuffer(BuffDesc, BufData)
-                        ?? throw new InvalidOperationException("Cannot create index buffer");
-                }
-
-                barriers.Add(new StateTransitionDesc { pResource = indexBuffer.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_SHADER_RESOURCE, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
-            }
-
-            renderer.RequestRebind();
         }
 
         internal void Remove(BLASInstance blas)
         {
-            manager.Remove(blas);
-            var barriers = new List<StateTransitionDesc>();
-            UpdateSharedBuffers(barriers);
-            graphicsEngine.ImmediateContext.TransitionResourceStates(barriers);
+            if (blas.VertexRange != null)
+            {
+                attrArena.Remove(blas.VertexRange);
+                indexArena.Remove(blas.IndexRange);
+                blas.VertexRange = null;
+                blas.IndexRange = null;
+            }
         }
     }
 }
@@ -0,0 +1,239 @@
+﻿using Engine;
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Runtime.InteropServices;
+using System.Text;
+using System.Threading.Tasks;
+
+namespace DiligentEngine.RT
+{
+    [StructLayout(LayoutKind.Sequential, Pack = 0)]
+    struct CheckerboardConstants
+    {
+        public Vector4 PrevCameraPos;
+        public Vector4 PrevFrustumRayLB;
+        public Vector4 PrevFrustumRayRB;
+        public Vector4 PrevFrustumRayLT;
+
+        public int HistoryValid;
+        public int padding0;
+        public int padding1;
+        public int padding2;
+    }
+
+    /// <summary>
+    /// Fills in the pixels that were not traced when RTOptions.Checkerboard is on. Rays are traced into
+    /// this class's textures and a compute pass writes the full image into the blitter's texture, keeping
+    /// a copy to reproject from next frame. Does nothing if checkerboard is off.
+    /// </summary>
+    public class CheckerboardReconstruction : IDisposable
+    {
+        const TEXTURE_FORMAT ColorBufferFormat = TEXTURE_FORMAT.TEX_FORMAT_RGBA32_FLOAT;
+        const TEXTURE_FORMAT DepthBufferFormat = TEXTURE_FORMAT.TEX_FORMAT_R32_FLOAT;
+        const uint ThreadGroupSize = 8;
+
+        private readonly GraphicsEngine graphicsEngine;
+
+        private AutoPtr<IPipelineState> resolvePSO;
+        private AutoPtr<IShaderResourceBinding> resolveSRB;
+        private FrameRingBuffer checkerboardCB;
+        private CheckerboardConstants checkerboardConstants;
+
+        private AutoPtr<ITexture> traceColor;
+        private AutoPtr<ITexture> traceDepth;
+        private AutoPtr<ITexture>[] history = new AutoPtr<ITexture>[2];
+        private int historyIndex;
+        private bool historyValid;
+        private uint textureWidth;
+        private uint textureHeight;
+        private uint lastRenderWidth;
+        private uint lastRenderHeight;
+        private int parity;
+        private uint renderWidth;
+        private uint renderHeight;
+
+        public CheckerboardReconstruction(GraphicsEngine graphicsEngine, ShaderLoader<RTShaders> shaderLoader, ShaderCache shaderCache, RTOptions options)
+        {
+            this.graphicsEngine = graphicsEngine;
+            Enabled = options.Checkerboard;
+            if (!Enabled)
+            {
+                return;
+            }
+
+            var m_pDevice = graphicsEngine.RenderDevice;
+
+            ShaderCreateInfo ShaderCI = new ShaderCreateInfo();
+            ShaderCI.UseCombinedTextureSamplers = false;
+            ShaderCI.ShaderCompiler = SHADER_COMPILER.SHADER_COMPILER_DXC;
+            ShaderCI.HLSLVersion = new ShaderVersion { Major = 6, Minor = 5 };
+            ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE.SHADER_SOURCE_LANGUAGE_HLSL;
+
+            ShaderCI.Desc.ShaderType = SHADER_TYPE.SHADER_TYPE_COMPUTE;
+            ShaderCI.Desc.Name = "Checkerboard resolve CS";
+            ShaderCI.Source = shaderLoader.LoadShader("assets/CheckerboardResolve.csh");
+            ShaderCI.EntryPoint = "main";
+            using var pCS = shaderCache.CreateShader(ShaderCI)
+                ?? throw new InvalidOperationException($"Could not create '{ShaderCI.Desc.Name}'");
+
+            var PSOCreateInfo = new ComputePipelineStateCreateInfo();
+            PSOCreateInfo.PSODesc.Name = "Checkerboard resolve PSO";
+            PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE.PIPELINE_TYPE_COMPUTE;
+            //The history textures swap every frame and the output is the blitter's texture
+            PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE.SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+            PSOCreateInfo.pCS = pCS.Obj;
+            PSOCreateInfo.pPSOCache = shaderCache.PipelineStateCache;
+
+            resolvePSO = m_pDevice.CreateComputePipelineState(PSOCreateInfo)
+                ?? throw new InvalidOperationException("Cannot create checkerboard resolve pipeline state");
+
+            resolveSRB = resolvePSO.Obj.CreateShaderResourceBinding(true)
+                ?? throw new InvalidOperationException("Cannot create checkerboard resolve shader resource binding");
+
+            unsafe
+            {
+                checkerboardCB = new FrameRingBuffer(m_pDevice, "Checkerboard constant buffer", (uint)sizeof(CheckerboardConstants), BIND_FLAGS.BIND_UNIFORM_BUFFER);
+            }
+            resolveSRB.Obj.GetVariableByName(SHADER_TYPE.SHADER_TYPE_COMPUTE, "g_CheckerboardCB").Set(checkerboardCB.Buffer);
+        }
+
+        public void Dispose()
+        {
+            DestroyTextures();
+            checkerboardCB?.Dispose();
+            resolveSRB?.Dispose();
+            resolvePSO?.Dispose();
+        }
+
+        /// <summary>
+        /// True if RTOptions.Checkerboard was set.
+        /// </summary>
+        public bool Enabled { get; private set; }
+
+        /// <summary>
+        /// The texture rays are traced into.
+        /// </summary>
+        public IDeviceObject TraceColorView => traceColor.Obj.GetDefaultView(TEXTURE_VIEW_TYPE.TEXTURE_VIEW_UNORDERED_ACCESS);
+
+        /// <summary>
+        /// The texture the depth of each traced pixel goes into.
+        /// </summary>
+        public IDeviceObject TraceDepthView => traceDepth.Obj.GetDefaultView(TEXTURE_VIEW_TYPE.TEXTURE_VIEW_UNORDERED_ACCESS);
+
+        /// <summary>
+        /// The number of rays to dispatch across, half the render width rounded up.
+        /// </summary>
+        public uint DispatchWidth => (renderWidth + 1) / 2;
+
+        private void DestroyTextures()
+        {
+            traceColor?.Dispose();
+            traceColor = null;
+            traceDepth?.Dispose();
+            traceDepth = null;
+            for (int i = 0; i < history.Length; ++i)
+            {
+                history[i]?.Dispose();
+                history[i] = null;
+            }
+        }
+
+        private AutoPtr<ITexture> CreateTexture(String name, uint width, uint height, TEXTURE_FORMAT format)
+        {
+            var RTDesc = new TextureDesc();
+            RTDesc.Name = name;
+            RTDesc.Type = RESOURCE_DIMENSION.RESOURCE_DIM_TEX_2D;
+            RTDesc.Width = width;
+            RTDesc.Height = height;
+            RTDesc.BindFlags = BIND_FLAGS.BIND_UNORDERED_ACCESS | BIND_FLAGS.BIND_SHADER_RESOURCE;
+            RTDesc.ClearValue.Format = format;
+            RTDesc.Format = format;
+
+            return graphicsEngine.RenderDevice.CreateTexture(RTDesc, null)
+                ?? throw new InvalidOperationException($"Cannot create '{name}'");
+        }
+
+        /// <summary>
+        /// Pick the pixels to trace this frame and upload the last frame's camera. Call after the camera
+        /// in constants is set for this frame. The textures match the size of the blitter's texture so the
+        /// render size can change without making them again.
+        /// </summary>
+        internal void Prepare(IDeviceContext immediateContext, uint textureWidth, uint textureHeight, uint renderWidth, uint renderHeight, ref Constants constants)
+        {
+            if (traceColor == null || this.textureWidth != textureWidth || this.textureHeight != textureHeight)
+            {
+                DestroyTextures();
+                this.textureWidth = textureWidth;
+                this.textureHeight = textureHeight;
+                traceColor = CreateTexture("Checkerboard color buffer", textureWidth, textureHeight, ColorBufferFormat);
+                traceDepth = CreateTexture("Checkerboard depth buffer", textureWidth, textureHeight, DepthBufferFormat);
+                history[0] = CreateTexture("Checkerboard history 0", textureWidth, textureHeight, ColorBufferFormat);
+                history[1] = CreateTexture("Checkerboard history 1", textureWidth, textureHeight, ColorBufferFormat);
+                historyValid = false;
+
+                resolveSRB.Obj.GetVariableByName(SHADER_TYPE.SHADER_TYPE_COMPUTE, "g_TraceColor").Set(traceColor.Obj.GetDefaultView(TEXTURE_VIEW_TYPE.TEXTURE_VIEW_SHADER_RESOURCE));
+                resolveSRB.Obj.GetVariableByName(SHADER_TYPE.SHADER_TYPE_COMPUTE, "g_TraceDepth").Set(traceDepth.Obj.GetDefaultView(TEXTURE_VIEW_TYPE.TEXTURE_VIEW_SHADER_RESOURCE));
+            }
+
+            this.renderWidth = renderWidth;
+            this.renderHeight = renderHeight;
+            parity ^= 1;
+            constants.Checkerboard = 1;
+            constants.CheckerboardParity = parity;
+
+            //History is only good if the last frame was resolved at the same size
+            checkerboardConstants.HistoryValid = historyValid && renderWidth == lastRenderWidth && renderHeight == lastRenderHeight ? 1 : 0;
+            historyValid = false;
+
+            checkerboardCB.Reset();
+            checkerboardCB.Write(immediateContext, checkerboardConstants);
+
+            //Keep this frame's camera for next frame
+            checkerboardConstants.PrevCameraPos = constants.CameraPos;
+            checkerboardConstants.PrevFrustumRayLB = constants.FrustumRayLB;
+            checkerboardConstants.PrevFrustumRayRB = constants.FrustumRayRB;
+            checkerboardConstants.PrevFrustumRayLT = constants.FrustumRayLT;
+        }
+
+        /// <summary>
+        /// Bind the frame constants, call when they are recreated.
+        /// </summary>
+        internal void Bind(IBuffer constantsBuffer)
+        {
+            resolveSRB.Obj.GetVariableByName(SHADER_TYPE.SHADER_TYPE_COMPUTE, "g_ConstantsCB").Set(constantsBuffer);
+        }
+
+        public void SetupUnorderedAccess(List<StateTransitionDesc> barriers)
+        {
+            barriers.Add(new StateTransitionDesc { pResource = traceColor.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_UNORDERED_ACCESS, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
+            barriers.Add(new StateTransitionDesc { pResource = traceDepth.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_UNORDERED_ACCESS, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
+        }
+
+        /// <summary>
+        /// Record the pass that writes the full image to output. Record after the rays are traced.
+        /// </summary>
+        internal void Resolve(FramePacket framePacket, IDeviceObject outputView)
+        {
+            var previous = history[historyIndex].Obj;
+            historyIndex ^= 1;
+            var current = history[historyIndex].Obj;
+
+            resolveSRB.Obj.GetVariableByName(SHADER_TYPE.SHADER_TYPE_COMPUTE, "g_History").Set(previous.GetDefaultView(TEXTURE_VIEW_TYPE.TEXTURE_VIEW_SHADER_RESOURCE));
+            resolveSRB.Obj.GetVariableByName(SHADER_TYPE.SHADER_TYPE_COMPUTE, "g_NewHistory").Set(current.GetDefaultView(TEXTURE_VIEW_TYPE.TEXTURE_VIEW_UNORDERED_ACCESS));
+            resolveSRB.Obj.GetVariableByName(SHADER_TYPE.SHADER_TYPE_COMPUTE, "g_Output").Set(outputView);
+
+            framePacket.SetPipelineState(resolvePSO.Obj);
+            framePacket.CommitShaderResources(resolveSRB.Obj, RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+            var Attribs = new DispatchComputeAttribs();
+            Attribs.ThreadGroupCountX = (renderWidth + ThreadGroupSize - 1) / ThreadGroupSize;
+            Attribs.ThreadGroupCountY = (renderHeight + ThreadGroupSize - 1) / ThreadGroupSize;
+            framePacket.DispatchCompute(Attribs);
+
+            historyValid = true;
+            lastRenderWidth = renderWidth;
+            lastRenderHeight = renderHeight;
+        }
+    }
+}
@@ -47,48 +47,6 @@ namespace DiligentEngine.RT
 
         // Light properties
         public float4 AmbientColor;
-        public float4 LightPos_0;
-        public float4 LightPos_1;
-        public float4 LightPos_2;
-        public float4 LightPos_3;
-        public float4 LightPos_4;
-        public float4 LightPos_5;
-        public float4 LightPos_6;
-        public float4 LightPos_7;
-        public float4 LightPos_8;
-        public float4 LightPos_9;
-        public float4 LightPos_10;
-        public float4 LightPos_11;
-        public float4 LightPos_12;
-        public float4 LightPos_13;
-        public float4 LightPos_14;
-        public float4 LightPos_15;
-        public float4 LightPos_16;
-        public float4 LightPos_17;
-        public float4 LightPos_18;
-        public float4 LightPos_19;
-
-        //Light color stores length of the light in w
-        public float4 LightColor_0;
-        public float4 LightColor_1;
-        public float4 LightColor_2;
-        public float4 LightColor_3;
-        public float4 LightColor_4;
-        public float4 LightColor_5;
-        public float4 LightColor_6;
-        public float4 LightColor_7;
-        public float4 LightColor_8;
-        public float4 LightColor_9;
-        public float4 LightColor_10;
-        public float4 LightColor_11;
-        public float4 LightColor_12;
-        public float4 LightColor_13;
-        public float4 LightColor_14;
-        public float4 LightColor_15;
-        public float4 LightColor_16;
-        public float4 LightColor_17;
-        public float4 LightColor_18;
-        public float4 LightColor_19;
 
         public float4 Pallete_0;
         public float4 Pallete_1;
@@ -112,6 +70,18 @@ namespace DiligentEngine.RT
 
         public float padding1;
 
+        //Light culling tiles, the lights for each tile are in g_TileLights
+        public int LightTileSize;
+        public int LightTilesX;
+        public int LightTilesY;
+        public int MaxTileLights;
+        public int RenderWidth;
+        public int RenderHeight;
+
+        //Set when only every other pixel is traced, the parity picks which ones this frame
+        public int Checkerboard;
+        public int CheckerboardParity;
+
         public static Constants CreateDefault(uint maxRecursionDepth)
         {
             return new Constants
@@ -122,11 +92,6 @@ namespace DiligentEngine.RT
 
                 AmbientColor = new Vector4(1f, 1f, 1f, 0f) * 0f,
                 Darkness = 0.125f,
-                LightPos_0 = new Vector4(8.00f, -8.0f, +0.00f, 0f),
-                LightColor_0 = new Vector4(1.00f, +0.8f, +0.80f, float.MaxValue),
-                LightPos_1 = new Vector4(0.00f, -4.0f, -5.00f, 0f),
-                LightColor_1 = new Vector4(0.4f, +0.4f, +0.6f, float.MaxValue),
-                NumActiveLights = 2,
 
                 Pallete_0 = new float4(0.32f, 0.00f, 0.92f, 0f),
                 Pallete_1 = new float4(0.00f, 0.22f, 0.90f, 0f),
@@ -13,10 +13,13 @@ namespace DiligentEngine.RT
         const TEXTURE_FORMAT ColorBufferFormat = TEXTURE_FORMAT.TEX_FORMAT_RGBA32_FLOAT;
 
         AutoPtr<ITexture> colorRT;
+        TextureDescPassStruct colorRTDesc;
         AutoPtr<IPipelineState> imageBlitPSO;
         AutoPtr<IShaderResourceBinding> imageBlitSRB;
+        uint viewportWidth;
+        uint viewportHeight;
 
-        public void CreateBuffers(GraphicsEngine graphicsEngine, ShaderLoader<RTShaders> shaderLoader)
+        public void CreateBuffers(GraphicsEngine graphicsEngine, ShaderLoader<RTShaders> shaderLoader, ShaderCache shaderCache)
         {
             var m_pDevice = graphicsEngine.RenderDevice;
             var m_pSwapChain = graphicsEngine.SwapChain;
@@ -29,7 +32,9 @@ namespace DiligentEngine.RT
             PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE.PIPELINE_TYPE_GRAPHICS;
 
             PSOCreateInfo.GraphicsPipeline.NumRenderTargets = 1;
-            PSOCreateInfo.GraphicsPipeline.RTVFormats_0 = m_pSwapChain.GetDesc_ColorBufferFormat;
+            var swapChainDesc = new SwapChainDescPassStruct();
+            m_pSwapChain.GetDesc(ref swapChainDesc);
+            PSOCreateInfo.GraphicsPipeline.RTVFormats_0 = swapChainDesc.ColorBufferFormat;
             PSOCreateInfo.GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY.PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
             PSOCreateInfo.GraphicsPipeline.RasterizerDesc.CullMode = CULL_MODE.CULL_MODE_NONE;
             PSOCreateInfo.GraphicsPipeline.DepthStencilDesc.DepthEnable = false;
@@ -43,14 +48,14 @@ namespace DiligentEngine.RT
             ShaderCI.EntryPoint = "main";
             ShaderCI.Desc.Name = "Image blit VS";
             ShaderCI.Source = shaderLoader.LoadShader("assets/ImageBlit.vsh");
-            using var pVS = m_pDevice.CreateShader(ShaderCI);
+            using var pVS = shaderCache.CreateShader(ShaderCI);
             //VERIFY_EXPR(pVS != nullptr);
 
             ShaderCI.Desc.ShaderType = SHADER_TYPE.SHADER_TYPE_PIXEL;
             ShaderCI.EntryPoint = "main";
             ShaderCI.Desc.Name = "Image blit PS";
             ShaderCI.Source = shaderLoader.LoadShader("assets/ImageBlit.psh");
-            using var pPS = m_pDevice.CreateShader(ShaderCI);
+            using var pPS = shaderCache.CreateShader(ShaderCI);
             //VERIFY_EXPR(pPS != nullptr);
 
             PSOCreateInfo.pVS = pVS.Obj;
@@ -73,6 +78,7 @@ namespace DiligentEngine.RT
 
             PSOCreateInfo.PSODesc.ResourceLayout.ImmutableSamplers = ImmutableSamplers;
             PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE.SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+            PSOCreateInfo.pPSOCache = shaderCache.PipelineStateCache;
 
             imageBlitPSO = m_pDevice.CreateGraphicsPipelineState(PSOCreateInfo);
             //VERIFY_EXPR(m_pImageBlitPSO != nullptr);
@@ -111,13 +117,22 @@ namespace DiligentEngine.RT
 
         public ITexture FullBufferTexture => colorRT.Obj;
 
-        public uint Width => colorRT.Obj.GetDesc_Width;
+        public uint Width => colorRTDesc.Width;
 
-        public uint Height => colorRT.Obj.GetDesc_Height;
+        public uint Height => colorRTDesc.Height;
         
-        public uint FullWidth => colorRT.Obj.GetDesc_Width;
+        public uint FullWidth => colorRTDesc.Width;
         
-        public uint FullHeight => colorRT.Obj.GetDesc_Height;
+        public uint FullHeight => colorRTDesc.Height;
+
+        public uint ViewportWidth => viewportWidth;
+
+        public uint ViewportHeight => viewportHeight;
+
+        public void SetRenderScale(GraphicsEngine graphicsEngine, float scale)
+        {
+            //Always traces the full size, there is nothing to upsample with
+        }
 
         public void WindowResize(GraphicsEngine graphicsEngine, UInt32 Width, UInt32 Height)
         {
@@ -129,8 +144,8 @@ namespace DiligentEngine.RT
 
             // Check if the image needs to be recreated.
             if (colorRT != null &&
-                colorRT.Obj.GetDesc_Width == Width &&
-                colorRT.Obj.GetDesc_Height == Height)
+                colorRTDesc.Width == Width &&
+                colorRTDesc.Height == Height)
             {
                 return;
             }
@@ -154,6 +169,9 @@ namespace DiligentEngine.RT
             RTDesc.Format = ColorBufferFormat;
 
             colorRT = m_pDevice.CreateTexture(RTDesc, null);
+            colorRT.Obj.GetDesc(ref colorRTDesc);
+            viewportWidth = Width;
+            viewportHeight = Height;
         }
     }
 }
@@ -16,6 +16,10 @@ namespace DiligentEngine.RT
         public UInt32 inputSizeH;
         public UInt32 outSizeW;
         public UInt32 outSizeH;
+        public UInt32 viewportSizeW;
+        public UInt32 viewportSizeH;
+        public UInt32 padding0;
+        public UInt32 padding1;
     };
 
     public class FSRImageBlitterImpl : IRTImageBlitterImpl
@@ -23,6 +27,7 @@ namespace DiligentEngine.RT
         const TEXTURE_FORMAT ColorBufferFormat = TEXTURE_FORMAT.TEX_FORMAT_RGBA32_FLOAT;
 
         AutoPtr<ITexture> colorRT;
+        TextureDescPassStruct colorRTDesc;
 
         AutoPtr<IPipelineState> upsamplePSO;
         AutoPtr<IShaderResourceBinding> upsampleSRB;
@@ -31,13 +36,16 @@ namespace DiligentEngine.RT
         private FSRConstants fsrConstants;
 
         private float renderPercent;
+        private float renderScale;
+        private List<StateTransitionDesc> constantsBarriers = new List<StateTransitionDesc>(1);
 
         public FSRImageBlitterImpl(DiligentEngineOptions options)
         {
             renderPercent = options.FSR1RenderPercentage;
+            renderScale = renderPercent;
         }
 
-        public void CreateBuffers(GraphicsEngine graphicsEngine, ShaderLoader<RTShaders> shaderLoader)
+        public void CreateBuffers(GraphicsEngine graphicsEngine, ShaderLoader<RTShaders> shaderLoader, ShaderCache shaderCache)
         {
             unsafe
             {
@@ -51,10 +59,10 @@ namespace DiligentEngine.RT
                 m_fsrConstants = m_pDevice.CreateBuffer(CBDesc);
             }
 
-            CreateUpsamplePSO(graphicsEngine, shaderLoader);
+            CreateUpsamplePSO(graphicsEngine, shaderLoader, shaderCache);
         }
 
-        private void CreateUpsamplePSO(GraphicsEngine graphicsEngine, ShaderLoader<RTShaders> shaderLoader)
+        private void CreateUpsamplePSO(GraphicsEngine graphicsEngine, ShaderLoader<RTShaders> shaderLoader, ShaderCache shaderCache)
         {
             var m_pDevice = graphicsEngine.RenderDevice;
             var m_pSwapChain = graphicsEngine.SwapChain;
@@ -65,7 +73,9 @@ namespace DiligentEngine.RT
             PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE.PIPELINE_TYPE_GRAPHICS;
 
             PSOCreateInfo.GraphicsPipeline.NumRenderTargets = 1;
-            PSOCreateInfo.GraphicsPipeline.RTVFormats_0 = m_pSwapChain.GetDesc_ColorBufferFormat;
+            var swapChainDesc = new SwapChainDescPassStruct();
+            m_pSwapChain.GetDesc(ref swapChainDesc);
+            PSOCreateInfo.GraphicsPipeline.RTVFormats_0 = swapChainDesc.ColorBufferFormat;
             PSOCreateInfo.GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY.PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
             PSOCreateInfo.GraphicsPipeline.RasterizerDesc.CullMode = CULL_MODE.CULL_MODE_NONE;
             PSOCreateInfo.GraphicsPipeline.DepthStencilDesc.DepthEnable = false;
@@ -79,14 +89,14 @@ namespace DiligentEngine.RT
             ShaderCI.EntryPoint = "main";
             ShaderCI.Desc.Name = "Image upsample VS";
             ShaderCI.Source = shaderLoader.LoadShader("assets/FSRUpsample.vsh");
-            using var pVS = m_pDevice.CreateShader(ShaderCI);
+            using var pVS = shaderCache.CreateShader(ShaderCI);
             //VERIFY_EXPR(pVS != nullptr);
 
             ShaderCI.Desc.ShaderType = SHADER_TYPE.SHADER_TYPE_PIXEL;
             ShaderCI.EntryPoint = "main";
             ShaderCI.Desc.Name = "Image upsample PS";
             ShaderCI.Source = shaderLoader.LoadShader("assets/FSRUpsample.psh");
-            using var pPS = m_pDevice.CreateShader(ShaderCI);
+            using var pPS = shaderCache.CreateShader(ShaderCI);
             //VERIFY_EXPR(pPS != nullptr);
 
             PSOCreateInfo.pVS = pVS.Obj;
@@ -115,6 +125,7 @@ namespace DiligentEngine.RT
 
             PSOCreateInfo.PSODesc.ResourceLayout.ImmutableSamplers = ImmutableSamplers;
             PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE.SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+            PSOCreateInfo.pPSOCache = shaderCache.PipelineStateCache;
 
             upsamplePSO = m_pDevice.CreateGraphicsPipelineState(PSOCreateInfo);
 
@@ -155,14 +166,39 @@ namespace DiligentEngine.RT
 
         public ITexture RTTexture => colorRT.Obj;
 
-        public uint Width => colorRT.Obj.GetDesc_Width;
+        public uint Width => colorRTDesc.Width;
 
-        public uint Height => colorRT.Obj.GetDesc_Height;
+        public uint Height => colorRTDesc.Height;
 
         public uint FullWidth => fsrConstants.outSizeW;
 
         public uint FullHeight => fsrConstants.outSizeH;
 
+        public uint ViewportWidth => fsrConstants.viewportSizeW;
+
+        public uint ViewportHeight => fsrConstants.viewportSizeH;
+
+        public void SetRenderScale(GraphicsEngine graphicsEngine, float scale)
+        {
+            renderScale = scale;
+            if (colorRT == null)
+            {
+                return;
+            }
+
+            //The color buffer is made at the largest size, only the viewport changes
+            var viewportWidth = Math.Clamp((UInt32)(fsrConstants.outSizeW * scale), 1, fsrConstants.inputSizeW);
+            var viewportHeight = Math.Clamp((UInt32)(fsrConstants.outSizeH * scale), 1, fsrConstants.inputSizeH);
+            if (viewportWidth == fsrConstants.viewportSizeW && viewportHeight == fsrConstants.viewportSizeH)
+            {
+                return;
+            }
+
+            fsrConstants.viewportSizeW = viewportWidth;
+            fsrConstants.viewportSizeH = viewportHeight;
+            UpdateConstants(graphicsEngine.ImmediateContext);
+        }
+
         public void WindowResize(GraphicsEngine graphicsEngine, UInt32 width, UInt32 height)
         {
             // Check if the image needs to be recreated.
@@ -185,7 +221,6 @@ namespace DiligentEngine.RT
             }
 
             var m_pDevice = graphicsEngine.RenderDevice;
-            var immediateContext = graphicsEngine.ImmediateContext;
 
             if (colorWidth == 0 || colorHeight == 0)
             {
@@ -207,17 +242,27 @@ namespace DiligentEngine.RT
                 RTDesc.Format = ColorBufferFormat;
 
                 colorRT = m_pDevice.CreateTexture(RTDesc, null);
+                colorRT.Obj.GetDesc(ref colorRTDesc);
             }
 
-            fsrConstants.inputSizeW = colorRT.Obj.GetDesc_Width;
-            fsrConstants.inputSizeH = colorRT.Obj.GetDesc_Height;
+            fsrConstants.inputSizeW = colorRTDesc.Width;
+            fsrConstants.inputSizeH = colorRTDesc.Height;
             fsrConstants.outSizeW = width;
             fsrConstants.outSizeH = height;
+            fsrConstants.viewportSizeW = 0;
+            fsrConstants.viewportSizeH = 0;
+            SetRenderScale(graphicsEngine, renderScale);
+        }
+
+        private void UpdateConstants(IDeviceContext immediateContext)
+        {
             unsafe
             {
                 fixed (FSRConstants* constantsPtr = &fsrConstants)
                 {
-                    var barriers = new List<StateTransitionDesc>(1); //TODO: Persist this and don't make it every frame
+                    //This changes with the render scale, so it can be every frame with dynamic resolution
+                    var barriers = constantsBarriers;
+                    barriers.Clear();
                     barriers.Add(new StateTransitionDesc { pResource = m_fsrConstants.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_COPY_DEST, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
                     immediateContext.TransitionResourceStates(barriers);
                     immediateContext.UpdateBuffer(m_fsrConstants.Obj, 0, (uint)sizeof(FSRConstants), new IntPtr(constantsPtr), RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_VERIFY);
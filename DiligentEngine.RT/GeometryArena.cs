@@ -0,0 +1,179 @@
+﻿using Engine;
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+using System.Threading.Tasks;
+
+namespace DiligentEngine.RT
+{
+    /// <summary>
+    /// A range of elements in a GeometryArena. The offset can change when the arena is defragmented.
+    /// </summary>
+    public class GeometryArenaRange
+    {
+        internal GeometryArenaRange(uint offset, uint size)
+        {
+            this.Offset = offset;
+            this.Size = size;
+        }
+
+        public uint Offset { get; internal set; }
+
+        public uint Size { get; }
+    }
+
+    /// <summary>
+    /// A structured gpu buffer that geometry is sub allocated from. Adding data only uploads that data and
+    /// removing it only frees its range. When there is no free range big enough the arena is defragmented
+    /// and grown by whole chunks into a new buffer on the gpu.
+    /// </summary>
+    public unsafe class GeometryArena<T> : IDisposable
+        where T : unmanaged
+    {
+        private readonly GraphicsEngine graphicsEngine;
+        private readonly String name;
+        private readonly uint chunkSize;
+        private readonly RangeAllocator allocator = new RangeAllocator(0);
+        private Dictionary<uint, GeometryArenaRange> ranges = new Dictionary<uint, GeometryArenaRange>();
+        private Dictionary<uint, GeometryArenaRange> remappedRanges = new Dictionary<uint, GeometryArenaRange>();
+        private readonly List<RangeAllocatorMove> moves = new List<RangeAllocatorMove>();
+        private readonly Dictionary<uint, uint> moveTargets = new Dictionary<uint, uint>();
+        private AutoPtr<IBuffer> buffer;
+
+        /// <param name="chunkSize">The number of elements to grow by.</param>
+        public GeometryArena(GraphicsEngine graphicsEngine, String name, uint chunkSize)
+        {
+            this.graphicsEngine = graphicsEngine;
+            this.name = name;
+            this.chunkSize = chunkSize;
+        }
+
+        public void Dispose()
+        {
+            buffer?.Dispose();
+            buffer = null;
+        }
+
+        /// <summary>
+        /// The buffer, this is replaced when the arena grows or is defragmented.
+        /// </summary>
+        public IBuffer Buffer => buffer?.Obj;
+
+        public uint Capacity => allocator.Capacity;
+
+        public uint UsedSize => allocator.UsedSize;
+
+        /// <summary>
+        /// Upload data into the arena. Any barriers needed before the buffer is used by shaders are added
+        /// to barriers. bufferReplaced is set to true if the buffer changed and must be rebound.
+        /// </summary>
+        public GeometryArenaRange Add(T[] data, List<StateTransitionDesc> barriers, out bool bufferReplaced)
+        {
+            bufferReplaced = false;
+            var size = (uint)data.Length;
+            if (size == 0)
+            {
+                return new GeometryArenaRange(0, 0);
+            }
+
+            if (!allocator.TryAllocate(size, out var offset))
+            {
+                var newCapacity = allocator.Capacity;
+                if (allocator.FreeSize < size)
+                {
+                    newCapacity = (allocator.UsedSize + size + chunkSize - 1) / chunkSize * chunkSize;
+                }
+                Reallocate(newCapacity);
+                bufferReplaced = true;
+
+                if (!allocator.TryAllocate(size, out offset))
+                {
+                    throw new InvalidOperationException($"Could not allocate {size} elements in geometry arena '{name}'.");
+                }
+            }
+
+            var range = new GeometryArenaRange(offset, size);
+            ranges.Add(offset, range);
+
+            var stride = (uint)sizeof(T);
+            fixed (T* pData = data)
+            {
+                graphicsEngine.ImmediateContext.UpdateBuffer(buffer.Obj, offset * stride, size * stride, new IntPtr(pData), RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+            }
+
+            barriers.Add(new StateTransitionDesc { pResource = buffer.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_SHADER_RESOURCE, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
+
+            return range;
+        }
+
+        /// <summary>
+        /// Free a range returned by Add. The data is left in place until something else is put there.
+        /// </summary>
+        public void Remove(GeometryArenaRange range)
+        {
+            if (range.Size == 0)
+            {
+                return;
+            }
+
+            ranges.Remove(range.Offset);
+            allocator.Free(range.Offset);
+        }
+
+        private void Reallocate(uint newCapacity)
+        {
+            moves.Clear();
+            allocator.Defragment(moves);
+            allocator.Grow(newCapacity);
+
+            moveTargets.Clear();
+            foreach (var move in moves)
+            {
+                moveTargets.Add(move.From, move.To);
+            }
+
+            var oldBuffer = buffer;
+            buffer = CreateBuffer(newCapacity);
+
+            //Copy everything that is still allocated into the new buffer at its packed offset
+            var stride = (uint)sizeof(T);
+            var m_pImmediateContext = graphicsEngine.ImmediateContext;
+            remappedRanges.Clear();
+            foreach (var range in ranges.Values)
+            {
+                if (!moveTargets.TryGetValue(range.Offset, out var target))
+                {
+                    target = range.Offset;
+                }
+
+                m_pImmediateContext.CopyBuffer(oldBuffer.Obj, range.Offset * stride, RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                    buffer.Obj, target * stride, range.Size * stride, RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+                range.Offset = target;
+                remappedRanges.Add(target, range);
+            }
+
+            var swap = ranges;
+            ranges = remappedRanges;
+            remappedRanges = swap;
+
+            //Diligent keeps the old buffer alive until the copies are done
+            oldBuffer?.Dispose();
+        }
+
+        private AutoPtr<IBuffer> CreateBuffer(uint capacity)
+        {
+            var BuffDesc = new BufferDesc();
+            BuffDesc.Name = name;
+            BuffDesc.Usage = USAGE.USAGE_DEFAULT;
+            BuffDesc.BindFlags = BIND_FLAGS.BIND_SHADER_RESOURCE;
+            BuffDesc.ElementByteStride = (uint)sizeof(T);
+            BuffDesc.Mode = BUFFER_MODE.BUFFER_MODE_STRUCTURED;
+            BuffDesc.Size = BuffDesc.ElementByteStride * capacity;
+
+            return graphicsEngine.RenderDevice.CreateBuffer(BuffDesc)
+                ?? throw new InvalidOperationException($"Cannot create {name}");
+        }
+    }
+}
@@ -30,6 +30,35 @@ namespace DiligentEngine.RT.HLSL
         float2 RayConeAtOrigin;
     };
 
+    [StructLayout(LayoutKind.Sequential)]
+    public struct BounceRay
+    {
+        float3 Origin;
+        float TMin;
+        float3 Direction;
+        float TMax;
+        float3 Weight;
+        uint Recursion;
+        float3 GlassMaterialColor;
+        float GlassAbsorption;
+        float2 RayConeAtOrigin;
+    };
+
+    /// <summary>
+    /// The PrimaryRayPayload when the shaders are compiled with ITERATIVE_BOUNCES.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    public struct IterativePrimaryRayPayload
+    {
+        float3 Color;
+        float Depth;
+        uint Recursion;
+        float2 RayConeAtOrigin;
+        uint NumBounces;
+        BounceRay Bounce0; //Bounces[MAX_BOUNCE_RAYS]
+        BounceRay Bounce1;
+    };
+
     [StructLayout(LayoutKind.Sequential)]
     struct EmissiveRayPayload
     {
@@ -106,6 +135,13 @@ namespace DiligentEngine.RT.HLSL
         public int emissiveTexture;
     };
 
+    [StructLayout(LayoutKind.Sequential)]
+    public struct LightData
+    {
+        public float4 Pos;
+        public float4 Color; //Light color stores length of the light in w
+    };
+
     public enum BlasSpecialMaterial
     {
         None,
@@ -0,0 +1,72 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Runtime.InteropServices;
+using System.Text;
+using System.Threading.Tasks;
+
+namespace DiligentEngine.RT
+{
+    /// <summary>
+    /// Collects hit group bindings for a frame and sends them to the sbt in one call. Bindings are
+    /// made by sbt binding index and shader group NameTable id so nothing is looked up by name per frame.
+    /// </summary>
+    internal class HitGroupBindingBatch
+    {
+        private uint[] bindingIndices = new uint[64];
+        private uint[] shaderGroupNameIds = new uint[64];
+        private uint[] dataOffsets = new uint[64];
+        private uint[] dataSizes = new uint[64];
+        private byte[] data = new byte[64 * 64];
+        private uint count = 0;
+        private uint dataSize = 0;
+
+        public uint Count => count;
+
+        public void Clear()
+        {
+            count = 0;
+            dataSize = 0;
+        }
+
+        public unsafe void Add(uint bindingIndex, uint shaderGroupNameId, IntPtr recordData, uint recordSize)
+        {
+            if (count == bindingIndices.Length)
+            {
+                var newSize = bindingIndices.Length * 2;
+                Array.Resize(ref bindingIndices, newSize);
+                Array.Resize(ref shaderGroupNameIds, newSize);
+                Array.Resize(ref dataOffsets, newSize);
+                Array.Resize(ref dataSizes, newSize);
+            }
+
+            if (dataSize + recordSize > data.Length)
+            {
+                Array.Resize(ref data, Math.Max(data.Length * 2, (int)(dataSize + recordSize)));
+            }
+
+            bindingIndices[count] = bindingIndex;
+            shaderGroupNameIds[count] = shaderGroupNameId;
+            dataOffsets[count] = dataSize;
+            dataSizes[count] = recordSize;
+            if (recordSize > 0)
+            {
+                fixed (byte* dest = &data[dataSize])
+                {
+                    Buffer.MemoryCopy(recordData.ToPointer(), dest, data.Length - dataSize, recordSize);
+                }
+            }
+            dataSize += recordSize;
+            ++count;
+        }
+
+        public void Submit(IShaderBindingTable sbt)
+        {
+            if (count > 0)
+            {
+                sbt.BindHitGroupsByIndex(count, bindingIndices, shaderGroupNameIds, data, dataOffsets, dataSizes);
+            }
+            Clear();
+        }
+    }
+}
@@ -0,0 +1,182 @@
+﻿using Engine;
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+using System.Threading.Tasks;
+
+namespace DiligentEngine.RT
+{
+    /// <summary>
+    /// Builds a list of lights for each screen tile in a compute pass before rays are traced. A light is
+    /// in a tile if its length reaches the tile's frustum, the hit shaders only cast shadow rays to the
+    /// lights in the tile their hit point projects into.
+    /// </summary>
+    public class LightCulling : IDisposable
+    {
+        private readonly GraphicsEngine graphicsEngine;
+        private readonly RTCameraAndLight cameraAndLight;
+        private readonly RTOptions options;
+
+        private AutoPtr<IPipelineState> cullingPSO;
+        private AutoPtr<IShaderResourceBinding> cullingSRB;
+        private AutoPtr<IBuffer> lightBuffer;
+        private AutoPtr<IBuffer> tileLightBuffer;
+        private uint tileLightCapacity;
+        private HLSL.LightData[] lights;
+        private int numLights;
+        private uint tilesX;
+        private uint tilesY;
+
+        public LightCulling(GraphicsEngine graphicsEngine, ShaderLoader<RTShaders> shaderLoader, ShaderCache shaderCache, RTCameraAndLight cameraAndLight, RTOptions options)
+        {
+            this.graphicsEngine = graphicsEngine;
+            this.cameraAndLight = cameraAndLight;
+            this.options = options;
+
+            lights = new HLSL.LightData[cameraAndLight.NumLights];
+
+            var m_pDevice = graphicsEngine.RenderDevice;
+
+            ShaderCreateInfo ShaderCI = new ShaderCreateInfo();
+            ShaderCI.UseCombinedTextureSamplers = false;
+            ShaderCI.ShaderCompiler = SHADER_COMPILER.SHADER_COMPILER_DXC;
+            ShaderCI.HLSLVersion = new ShaderVersion { Major = 6, Minor = 5 };
+            ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE.SHADER_SOURCE_LANGUAGE_HLSL;
+
+            ShaderCI.Desc.ShaderType = SHADER_TYPE.SHADER_TYPE_COMPUTE;
+            ShaderCI.Desc.Name = "Light culling CS";
+            ShaderCI.Source = shaderLoader.LoadShader("assets/LightCulling.csh");
+            ShaderCI.EntryPoint = "main";
+            using var pCS = shaderCache.CreateShader(ShaderCI)
+                ?? throw new InvalidOperationException($"Could not create '{ShaderCI.Desc.Name}'");
+
+            var PSOCreateInfo = new ComputePipelineStateCreateInfo();
+            PSOCreateInfo.PSODesc.Name = "Light culling PSO";
+            PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE.PIPELINE_TYPE_COMPUTE;
+            //The tile buffer and the constants are bound again when they are recreated
+            PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE.SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+            PSOCreateInfo.pCS = pCS.Obj;
+            PSOCreateInfo.pPSOCache = shaderCache.PipelineStateCache;
+
+            cullingPSO = m_pDevice.CreateComputePipelineState(PSOCreateInfo)
+                ?? throw new InvalidOperationException("Cannot create light culling pipeline state");
+
+            cullingSRB = cullingPSO.Obj.CreateShaderResourceBinding(true)
+                ?? throw new InvalidOperationException("Cannot create light culling shader resource binding");
+
+            unsafe
+            {
+                var BuffDesc = new BufferDesc();
+                BuffDesc.Name = "Light buffer";
+                BuffDesc.Usage = USAGE.USAGE_DEFAULT;
+                BuffDesc.BindFlags = BIND_FLAGS.BIND_SHADER_RESOURCE;
+                BuffDesc.ElementByteStride = (uint)sizeof(HLSL.LightData);
+                BuffDesc.Mode = BUFFER_MODE.BUFFER_MODE_STRUCTURED;
+                BuffDesc.Size = BuffDesc.ElementByteStride * (uint)lights.Length;
+                lightBuffer = m_pDevice.CreateBuffer(BuffDesc)
+                    ?? throw new InvalidOperationException("Cannot create light buffer");
+            }
+
+            cullingSRB.Obj.GetVariableByName(SHADER_TYPE.SHADER_TYPE_COMPUTE, "g_Lights").Set(lightBuffer.Obj.GetDefaultView(BUFFER_VIEW_TYPE.BUFFER_VIEW_SHADER_RESOURCE));
+        }
+
+        public void Dispose()
+        {
+            tileLightBuffer?.Dispose();
+            lightBuffer.Dispose();
+            cullingSRB.Dispose();
+            cullingPSO.Dispose();
+        }
+
+        /// <summary>
+        /// Copy this frame's lights and fill in the tile info in the constants. Returns true if the tile
+        /// buffer was recreated, Bind must be called again before it is used.
+        /// </summary>
+        internal bool Prepare(uint width, uint height, ref Constants constants)
+        {
+            numLights = constants.NumActiveLights = cameraAndLight.NumActiveLights;
+            for (int i = 0; i < numLights; ++i)
+            {
+                //Need to invert going into the shader
+                lights[i].Pos = cameraAndLight.LightPos[i] * -1;
+                var color = cameraAndLight.LightColor[i];
+                lights[i].Color = new Vector4(color.r * numLights, color.g * numLights, color.b * numLights, cameraAndLight.LightLength[i]);
+            }
+
+            var tileSize = (uint)Math.Max(options.LightTileSize, 1);
+            var maxTileLights = (uint)Math.Max(options.MaxLightsPerTile, 1);
+            tilesX = (width + tileSize - 1) / tileSize;
+            tilesY = (height + tileSize - 1) / tileSize;
+
+            constants.LightTileSize = (int)tileSize;
+            constants.LightTilesX = (int)tilesX;
+            constants.LightTilesY = (int)tilesY;
+            constants.MaxTileLights = (int)maxTileLights;
+            constants.RenderWidth = (int)width;
+            constants.RenderHeight = (int)height;
+
+            //Each tile has its light count followed by room for the max number of lights
+            var required = Math.Max(tilesX * tilesY * (maxTileLights + 1), 1);
+            if (tileLightBuffer != null && required <= tileLightCapacity)
+            {
+                return false;
+            }
+
+            tileLightBuffer?.Dispose();
+
+            var BuffDesc = new BufferDesc();
+            BuffDesc.Name = "Tile light buffer";
+            BuffDesc.Usage = USAGE.USAGE_DEFAULT;
+            BuffDesc.BindFlags = BIND_FLAGS.BIND_UNORDERED_ACCESS | BIND_FLAGS.BIND_SHADER_RESOURCE;
+            BuffDesc.ElementByteStride = sizeof(uint);
+            BuffDesc.Mode = BUFFER_MODE.BUFFER_MODE_STRUCTURED;
+            BuffDesc.Size = BuffDesc.ElementByteStride * required;
+            tileLightBuffer = graphicsEngine.RenderDevice.CreateBuffer(BuffDesc)
+                ?? throw new InvalidOperationException("Cannot create tile light buffer");
+            tileLightCapacity = required;
+
+            cullingSRB.Obj.GetVariableByName(SHADER_TYPE.SHADER_TYPE_COMPUTE, "g_TileLights").Set(tileLightBuffer.Obj.GetDefaultView(BUFFER_VIEW_TYPE.BUFFER_VIEW_UNORDERED_ACCESS));
+
+            return true;
+        }
+
+        /// <summary>
+        /// Bind the light buffers to the ray tracing srb and the frame constants to the culling pass.
+        /// </summary>
+        internal void Bind(IShaderResourceBinding rayTracingSRB, IBuffer constantsBuffer)
+        {
+            cullingSRB.Obj.GetVariableByName(SHADER_TYPE.SHADER_TYPE_COMPUTE, "g_ConstantsCB").Set(constantsBuffer);
+
+            //These are null if no closest hit shader does lighting
+            rayTracingSRB.GetVariableByName(SHADER_TYPE.SHADER_TYPE_RAY_CLOSEST_HIT, "g_Lights")?.Set(lightBuffer.Obj.GetDefaultView(BUFFER_VIEW_TYPE.BUFFER_VIEW_SHADER_RESOURCE));
+            rayTracingSRB.GetVariableByName(SHADER_TYPE.SHADER_TYPE_RAY_CLOSEST_HIT, "g_TileLights")?.Set(tileLightBuffer.Obj.GetDefaultView(BUFFER_VIEW_TYPE.BUFFER_VIEW_SHADER_RESOURCE));
+        }
+
+        /// <summary>
+        /// Record the light upload and the culling dispatch. The barriers to read the results in the hit
+        /// shaders are added to barriers, record them before rays are traced.
+        /// </summary>
+        internal unsafe void Cull(FramePacket framePacket, List<StateTransitionDesc> barriers)
+        {
+            if (numLights > 0)
+            {
+                fixed (HLSL.LightData* pLights = lights)
+                {
+                    framePacket.UpdateBuffer(lightBuffer.Obj, 0, (uint)(sizeof(HLSL.LightData) * numLights), new IntPtr(pLights), RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+                }
+            }
+
+            framePacket.SetPipelineState(cullingPSO.Obj);
+            framePacket.CommitShaderResources(cullingSRB.Obj, RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+            var Attribs = new DispatchComputeAttribs();
+            Attribs.ThreadGroupCountX = tilesX;
+            Attribs.ThreadGroupCountY = tilesY;
+            framePacket.DispatchCompute(Attribs);
+
+            barriers.Add(new StateTransitionDesc { pResource = tileLightBuffer.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_SHADER_RESOURCE, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
+            barriers.Add(new StateTransitionDesc { pResource = lightBuffer.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_SHADER_RESOURCE, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
+        }
+    }
+}
@@ -18,6 +18,11 @@ namespace DiligentEngine.RT
 
         public uint NumIndices => numIndices;
 
+        /// <summary>
+        /// Compact the blas when End is called, see BLASDesc.Compact.
+        /// </summary>
+        public bool Compact { get; set; }
+
         private uint numIndices = 0;
         private uint currentVert = 0;
         private uint indexBlock = 0;
@@ -116,6 +121,7 @@ namespace DiligentEngine.RT
 
         public async Task End(String debugName)
         {
+            blasDesc.Compact = Compact;
             instance = await blasBuilder.CreateBLAS(blasDesc);
             blasDesc = null;
         }
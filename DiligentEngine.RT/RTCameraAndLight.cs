@@ -11,26 +11,29 @@ namespace DiligentEngine.RT
     {
         public Matrix4x4 CurrentViewProj { get; private set; }
 
-        private const int NUM_LIGHTS = 20;
-
-        public readonly int NumLights = NUM_LIGHTS;
+        public readonly int NumLights;
 
         private int currentLight = 0;
 
-        public Vector4[] LightPos { get; } = new Vector4[NUM_LIGHTS];
+        public Vector4[] LightPos { get; }
 
-        public Color[] LightColor { get; } = new Color[NUM_LIGHTS];
+        public Color[] LightColor { get; }
 
-        public float[] LightLength { get; } = new float[NUM_LIGHTS];
+        public float[] LightLength { get; }
 
         public int NumActiveLights => currentLight;
 
-        public RTCameraAndLight()
+        public RTCameraAndLight(RTOptions options)
         {
+            NumLights = Math.Max(options.MaxLights, 2);
+            LightPos = new Vector4[NumLights];
+            LightColor = new Color[NumLights];
+            LightLength = new float[NumLights];
+
             LightColor[0] = new Color(1.00f, +0.8f, +0.80f);
             LightColor[1] = new Color(0.2f, 0.2f, 0.4f);
 
-            for(int i = 0; i < NUM_LIGHTS; i++)
+            for(int i = 0; i < NumLights; i++)
             {
                 LightLength[i] = float.MaxValue;
             }
@@ -56,7 +59,7 @@ namespace DiligentEngine.RT
         /// <returns></returns>
         public bool CheckoutLight(out int lightIndex)
         {
-            if (currentLight < NUM_LIGHTS)
+            if (currentLight < NumLights)
             {
                 lightIndex = currentLight;
                 ++currentLight;
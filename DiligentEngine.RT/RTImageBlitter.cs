@@ -1,4 +1,5 @@
 ﻿using DiligentEngine;
+using Engine;
 using Engine.Platform;
 using Microsoft.Extensions.Logging;
 using System;
@@ -16,10 +17,18 @@ namespace DiligentEngine.RT
         uint Width { get; }
         uint FullWidth { get; }
         uint FullHeight { get; }
+        uint ViewportWidth { get; }
+        uint ViewportHeight { get; }
 
         void Blit(GraphicsEngine graphicsEngine);
-        void CreateBuffers(GraphicsEngine graphicsEngine, ShaderLoader<RTShaders> shaderLoader);
+        void CreateBuffers(GraphicsEngine graphicsEngine, ShaderLoader<RTShaders> shaderLoader, ShaderCache shaderCache);
         void WindowResize(GraphicsEngine graphicsEngine, uint width, uint height);
+
+        /// <summary>
+        /// Trace into the top left of RTTexture at this fraction of the full size. This can't go past
+        /// the size of RTTexture, blitters that can't upsample from part of the texture ignore it.
+        /// </summary>
+        void SetRenderScale(GraphicsEngine graphicsEngine, float scale);
     }
 
     public class RTImageBlitter : IDisposable
@@ -29,15 +38,18 @@ namespace DiligentEngine.RT
         private readonly OSWindow window;
         private readonly DiligentEngineOptions options;
         private readonly ILogger<RTImageBlitter> logger;
+        private readonly ShaderCache shaderCache;
         IRTImageBlitterImpl blitterImpl;
+        DynamicResolutionController dynamicResolution;
 
-        public RTImageBlitter(ShaderLoader<RTShaders> shaderLoader, GraphicsEngine graphicsEngine, OSWindow window, DiligentEngineOptions options, ILogger<RTImageBlitter> logger)
+        public RTImageBlitter(ShaderLoader<RTShaders> shaderLoader, GraphicsEngine graphicsEngine, OSWindow window, DiligentEngineOptions options, ILogger<RTImageBlitter> logger, ShaderCache shaderCache)
         {
             this.shaderLoader = shaderLoader;
             this.graphicsEngine = graphicsEngine;
             this.window = window;
             this.options = options;
             this.logger = logger;
+            this.shaderCache = shaderCache;
             RecreateBuffer();
 
             window.Resized += Window_Resized;
@@ -52,12 +64,19 @@ namespace DiligentEngine.RT
         public void RecreateBuffer()
         {
             blitterImpl?.Dispose();
+            dynamicResolution = null;
 
             switch (options.UpsamplingMethod)
             {
                 case UpsamplingMethod.FSR1:
                     logger.LogInformation($"Creating FSR1 blitter upsampling from {options.FSR1RenderPercentage}.");
                     blitterImpl = new FSRImageBlitterImpl(options);
+                    if (options.FSR1DynamicResolution)
+                    {
+                        var minPercent = Math.Min(options.FSR1MinRenderPercentage, options.FSR1RenderPercentage);
+                        logger.LogInformation($"Using dynamic resolution from {minPercent} to {options.FSR1RenderPercentage} at {options.FSR1TargetFrameRate} fps.");
+                        dynamicResolution = new DynamicResolutionController(1.0f / options.FSR1TargetFrameRate, minPercent, options.FSR1RenderPercentage);
+                    }
                     break;
                 case UpsamplingMethod.None:
                 default:
@@ -65,7 +84,7 @@ namespace DiligentEngine.RT
                     blitterImpl = new DirectImageBlitter();
                     break;
             }
-            blitterImpl.CreateBuffers(graphicsEngine, shaderLoader);
+            blitterImpl.CreateBuffers(graphicsEngine, shaderLoader, shaderCache);
             WindowResize((uint)window.WindowWidth, (uint)window.WindowHeight);
         }
 
@@ -86,9 +105,19 @@ namespace DiligentEngine.RT
 
         public IDeviceObject RTTextureView => blitterImpl.RTTexture.GetDefaultView(TEXTURE_VIEW_TYPE.TEXTURE_VIEW_UNORDERED_ACCESS);
 
-        public uint RTBufferWidth => blitterImpl.RTTexture.GetDesc_Width;
+        public uint RTBufferWidth => blitterImpl.Width;
+
+        public uint RTBufferHeight => blitterImpl.Height;
 
-        public uint RTBufferHeight => blitterImpl.RTTexture.GetDesc_Height;
+        /// <summary>
+        /// The width of the part of the ray tracing texture to trace into this frame.
+        /// </summary>
+        public uint RenderWidth => blitterImpl.ViewportWidth;
+
+        /// <summary>
+        /// The height of the part of the ray tracing texture to trace into this frame.
+        /// </summary>
+        public uint RenderHeight => blitterImpl.ViewportHeight;
 
         public uint FullBufferWidth => blitterImpl.FullWidth;
 
@@ -97,6 +126,33 @@ namespace DiligentEngine.RT
         public void WindowResize(UInt32 width, UInt32 height)
         {
             blitterImpl.WindowResize(graphicsEngine, width, height);
+            if (dynamicResolution != null)
+            {
+                blitterImpl.SetRenderScale(graphicsEngine, dynamicResolution.Scale);
+            }
+        }
+
+        /// <summary>
+        /// True if the render size changes to hold a frame rate. Call UpdateRenderScale every frame.
+        /// </summary>
+        public bool DynamicResolution => dynamicResolution != null;
+
+        /// <summary>
+        /// Give dynamic resolution the last frame time in seconds and resize the viewport rays are traced
+        /// into for the next frame. Does nothing if dynamic resolution is off.
+        /// </summary>
+        public void UpdateRenderScale(float frameTime)
+        {
+            if (dynamicResolution == null)
+            {
+                return;
+            }
+
+            var scale = dynamicResolution.Scale;
+            if (dynamicResolution.Update(frameTime) != scale)
+            {
+                blitterImpl.SetRenderScale(graphicsEngine, dynamicResolution.Scale);
+            }
         }
     }
 }
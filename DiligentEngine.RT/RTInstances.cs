@@ -20,6 +20,21 @@ namespace DiligentEngine.RT
         //There is always an extra dummy instance to serve as the lookup for anything new that has been added
         internal TLASBuildInstanceDataPassStruct[] passInstances = new TLASBuildInstanceDataPassStruct[1];
 
+        //Incremented every time passInstances is rebuilt, the renderer uses this to know when the tlas must be fully rebuilt
+        internal int InstanceSetVersion { get; private set; }
+
+        //The sbt hit group index for each instance, resolved from the tlas once per full build
+        uint[] instanceHitGroupIndices = new uint[0];
+        uint[] instanceNameIds = new uint[0];
+        uint resolvedInstanceCount = 0;
+        HitGroupBindingBatch hitGroupBindings = new HitGroupBindingBatch();
+        bool batchingHitGroups = false;
+
+        //The sbt keeps the records from the last frame, so unless everything has to be bound again only sprites
+        //that changed frame are bound. Their dirty flags are cleared once the whole batch has been bound.
+        bool rebindAll = true;
+        List<ISprite> boundDirtySprites = new List<ISprite>();
+
         internal void UpdateInstances()
         {
             if (updatePassInstances)
@@ -34,6 +49,7 @@ namespace DiligentEngine.RT
                 //from the original build data.
 
                 updatePassInstances = false;
+                ++InstanceSetVersion;
                 passInstances = new TLASBuildInstanceDataPassStruct[instances.Count + 1];
                 var numInstancs = instances.Count;
                 for (int i = 0; i < numInstancs; i++)
@@ -42,7 +58,7 @@ namespace DiligentEngine.RT
                     instance.InstanceIndex = i;
                     passInstances[i] = new TLASBuildInstanceDataPassStruct
                     {
-                        InstanceName = instance.InstanceName,
+                        InstanceName = instance.InstanceNamePtr,
                         pBLAS = instance.pBLAS.ObjPtr,
                         Transform = instance.Transform,
                         CustomId = instance.CustomId,
@@ -66,6 +82,7 @@ namespace DiligentEngine.RT
             updatePassInstances = true;
             instance.InstanceIndex = passInstances.Length - 1;
             instance.RTInstances = this;
+            instance.InstanceNameId = NameTable.Register(instance.InstanceName);
             instances.Add(instance);
         }
 
@@ -76,12 +93,16 @@ namespace DiligentEngine.RT
                 updatePassInstances = true;
                 instance.InstanceIndex = TLASInstanceData.DefaultRTInstanceIndex;
                 instance.RTInstances = TLASInstanceData.DefaultRTInstance;
+                //The old passInstances can still point to this name, but they are replaced before the next build
+                NameTable.Release(instance.InstanceNameId);
+                instance.InstanceNameId = NameTable.NullId;
             }
         }
 
         public void AddShaderTableBinder(ShaderTableBinder binder)
         {
             shaderTableBinders.Add(binder);
+            rebindAll = true;
         }
 
         public void RemoveShaderTableBinder(ShaderTableBinder binder)
@@ -97,14 +118,13 @@ namespace DiligentEngine.RT
 
         public void AddSprite(ISprite sprite)
         {
+            //A sprite is added again when its SpriteInstance is swapped, that changes the record without a new frame
+            rebindAll = true;
+
             //Only add a sprite to the animations list if there is an animation with more than 1 frame
-            foreach(var animation in sprite.Animations)
+            if (sprite.AnimationTable.HasMultipleFrames)
             {
-                if(animation.Value.frames.Length > 1)
-                {
-                    sprites.Add(sprite);
-                    break;
-                }
+                sprites.Add(sprite);
             }
         }
 
@@ -121,11 +141,92 @@ namespace DiligentEngine.RT
             }
         }
 
-        internal void BindShaders(IShaderBindingTable sbt, ITopLevelAS tlas)
+        /// <summary>
+        /// Run the shader table binders. Set rebindAll when the sbt is new or the tlas was fully built,
+        /// otherwise the records from the last frame are still in the sbt and static sprites skip binding.
+        /// </summary>
+        internal void BindShaders(IShaderBindingTable sbt, ITopLevelAS tlas, bool rebindAll)
+        {
+            this.rebindAll |= rebindAll;
+            batchingHitGroups = true;
+            try
+            {
+                foreach (var i in shaderTableBinders)
+                {
+                    i(sbt, tlas);
+                }
+            }
+            finally
+            {
+                batchingHitGroups = false;
+                this.rebindAll = false;
+            }
+            hitGroupBindings.Submit(sbt);
+
+            foreach (var sprite in boundDirtySprites)
+            {
+                sprite.ClearFrameDirty();
+            }
+            boundDirtySprites.Clear();
+        }
+
+        /// <summary>
+        /// Check if a sprite needs to bind its sbt record this frame. This is true if its frame changed,
+        /// everything is being bound again or this is called outside of BindShaders.
+        /// </summary>
+        internal bool NeedsSpriteBind(ISprite sprite)
+        {
+            if (!batchingHitGroups)
+            {
+                return true;
+            }
+
+            if (sprite.FrameDirty)
+            {
+                //The flag is cleared after the batch, a sprite can be shared by more than one instance
+                boundDirtySprites.Add(sprite);
+                return true;
+            }
+
+            return rebindAll;
+        }
+
+        /// <summary>
+        /// Look up the hit group index of every instance. Call after the tlas is fully built, the
+        /// indices stay the same when it is only refit.
+        /// </summary>
+        internal void ResolveHitGroupIndices(ITopLevelAS tlas)
         {
-            foreach (var i in shaderTableBinders)
+            var count = instances.Count;
+            if (instanceNameIds.Length < count)
+            {
+                instanceNameIds = new uint[passInstances.Length];
+                instanceHitGroupIndices = new uint[passInstances.Length];
+            }
+
+            for (int i = 0; i < count; ++i)
+            {
+                instanceNameIds[i] = instances[i].InstanceNameId;
+            }
+
+            tlas.GetInstanceHitGroupIndices((uint)count, instanceNameIds, instanceHitGroupIndices);
+            resolvedInstanceCount = (uint)count;
+        }
+
+        /// <summary>
+        /// Bind a hit group for an instance. While BindShaders is running this goes into the batch by
+        /// index, otherwise it falls back to binding right away by name id.
+        /// </summary>
+        internal void BindHitGroup(TLASInstanceData instance, IShaderBindingTable sbt, ITopLevelAS tlas, uint rayOffset, uint shaderGroupNameId, IntPtr data, uint size)
+        {
+            var instanceIndex = (uint)instance.InstanceIndex;
+            if (batchingHitGroups && instanceIndex < resolvedInstanceCount)
+            {
+                hitGroupBindings.Add(instanceHitGroupIndices[instanceIndex] + rayOffset, shaderGroupNameId, data, size);
+            }
+            else
             {
-                i(sbt, tlas);
+                sbt.BindHitGroupForInstance(tlas, instance.InstanceNameId, rayOffset, shaderGroupNameId, data, size);
             }
         }
     }
@@ -1,4 +1,5 @@
-﻿using System;
+﻿using DiligentEngine.RT.Resources;
+using System;
 using System.Collections.Generic;
 using System.Linq;
 using System.Text;
@@ -8,5 +9,65 @@ namespace DiligentEngine.RT
 {
     public class RTOptions
     {
+        /// <summary>
+        /// The number of refits the tlas can do in a row before it is fully rebuilt again. Refits
+        /// are cheap but the bvh quality goes down the more the instances move around, so do a full
+        /// build every so often to get it back.
+        /// </summary>
+        public int TlasMaxRefits { get; set; } = 120;
+
+        /// <summary>
+        /// The number of textures ActiveTextures starts with room for. This is the size of the texture array
+        /// in the shaders, it doubles and the shaders are created again if more are added.
+        /// </summary>
+        public int MaxTextures { get; set; } = 200;
+
+        /// <summary>
+        /// Compile a closest hit shader for each material type that is bound instead of switching on the
+        /// type in one shader. Types used in a run are remembered in the ShaderCache and created at startup.
+        /// </summary>
+        public bool SpecializeHitGroups { get; set; } = true;
+
+        /// <summary>
+        /// The number of lights RTCameraAndLight can check out in a frame. This sizes the light buffer,
+        /// so it is fixed once the renderer is created.
+        /// </summary>
+        public int MaxLights { get; set; } = 128;
+
+        /// <summary>
+        /// The size in pixels of the screen tiles lights are culled for. Hit shaders only shoot shadow
+        /// rays to the lights that can reach their tile.
+        /// </summary>
+        public int LightTileSize { get; set; } = 16;
+
+        /// <summary>
+        /// The most lights a tile can list. Tiles with more than this go back to checking every light.
+        /// </summary>
+        public int MaxLightsPerTile { get; set; } = 32;
+
+        /// <summary>
+        /// Trace half the pixels each frame in a checkerboard that flips every frame. The other half is
+        /// filled in from the last frame, moved to where it is now with the camera and the traced depth.
+        /// This is part of the pipeline so it is fixed once the renderer is created.
+        /// </summary>
+        public bool Checkerboard { get; set; }
+
+        /// <summary>
+        /// Trace reflections and refractions in a loop in the raygen shader instead of recursing from the
+        /// hit shaders. The pipeline only needs a recursion depth of 2 for the shadow rays, which uses
+        /// much less stack. This is part of the pipeline so it is fixed once the renderer is created.
+        /// </summary>
+        public bool IterativeBounces { get; set; }
+
+        /// <summary>
+        /// Upload only mip 0 of loaded textures and make the rest of the mips in compute passes. Normal
+        /// maps are renormalized in each mip. If this is false the mips are scaled on the cpu.
+        /// </summary>
+        public bool GpuMipGeneration { get; set; } = true;
+
+        /// <summary>
+        /// The filter used to make the mips of color textures on the gpu. Kaiser keeps more detail than box.
+        /// </summary>
+        public MipFilter ColorMipFilter { get; set; } = MipFilter.Box;
     }
 }
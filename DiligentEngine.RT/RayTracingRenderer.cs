@@ -1,7 +1,10 @@
-﻿using DiligentEngine.RT.ShaderSets;
+﻿using DiligentEngine.RT.Resources;
+using DiligentEngine.RT.ShaderSets;
 using Engine;
+using Microsoft.Extensions.Logging;
 using System;
 using System.Collections.Generic;
+using System.Diagnostics;
 using System.Linq;
 using System.Text;
 using System.Threading.Tasks;
@@ -18,22 +21,52 @@ namespace DiligentEngine.RT
         private readonly GraphicsEngine graphicsEngine;
         private readonly RTImageBlitter imageBlitter;
         private readonly RTCameraAndLight cameraAndLight;
+        private readonly RTOptions options;
+        private readonly TextureUploader textureUploader;
+        private readonly ShaderCache shaderCache;
+        private readonly GpuTimer gpuTimer;
+        private readonly GpuMemoryTracker gpuMemoryTracker;
+        private readonly LightCulling lightCulling;
+        private readonly CheckerboardReconstruction checkerboard;
+        private readonly MipGenerator mipGenerator;
+        private SwapChainDescPassStruct swapChainDesc;
+        private long lastFrameTimestamp;
+        private readonly ILogger<RayTracingRenderer> logger;
         private byte maxRecursionDepth = 8;
+        //Raygen traces the bounces with IterativeBounces, the deepest the pipeline goes is a hit shader's shadow rays
+        private const byte IterativeRecursionDepth = 2;
 
-        private AutoPtr<IBuffer> m_ConstantsCB;
+        private FrameRingBuffer m_ConstantsCB;
         private Constants m_Constants;
         private AutoPtr<IPipelineState> m_pRayTracingPSO;
         private AutoPtr<IShaderResourceBinding> m_pRayTracingSRB;
         private AutoPtr<IShaderBindingTable> m_pSBT;
         AutoPtr<IBuffer> m_ScratchBuffer;
         AutoPtr<IBuffer> m_InstanceBuffer;
+        AutoPtr<ITopLevelAS> m_pTLAS;
+        uint tlasCapacity = 0;
         uint lastNumInstances = 0;
+        uint builtInstanceCount = 0;
+        int lastInstanceSetVersion = -1;
+        int refitCount = 0;
+        IntPtr[] builtBlas = new IntPtr[0];
+        bool rebindTlas = true;
+        bool rebindLights = true;
+        FramePacket framePacket = new FramePacket();
+        List<StateTransitionDesc> frameBarriers = new List<StateTransitionDesc>(4);
         bool rebuildPipeline = true;
         bool rebindShaderResources;
+        bool rebindAllHitGroups;
         private TaskCompletionSource pipelineRebuildTask = new TaskCompletionSource();
 
         public event Action<RayTracingPipelineStateCreateInfo> OnSetupCreateInfo;
 
+        /// <summary>
+        /// Called every frame after any rebind and before rays are traced. Use this to send small changes
+        /// to resources that are already bound instead of requesting a full rebind.
+        /// </summary>
+        public event Action<IDeviceContext> OnUpdateShaderResources;
+
 
         public delegate void ShaderResourceBinder(IShaderResourceBinding rayTracingSRB);
 
@@ -47,22 +80,63 @@ namespace DiligentEngine.RT
         (
             GraphicsEngine graphicsEngine,
             RTImageBlitter imageBlitter,
-            RTCameraAndLight cameraAndLight
+            RTCameraAndLight cameraAndLight,
+            RTOptions options,
+            TextureUploader textureUploader,
+            ShaderCache shaderCache,
+            GpuTimer gpuTimer,
+            GpuMemoryTracker gpuMemoryTracker,
+            LightCulling lightCulling,
+            CheckerboardReconstruction checkerboard,
+            MipGenerator mipGenerator,
+            ILogger<RayTracingRenderer> logger
         )
         {
             this.graphicsEngine = graphicsEngine;
             this.imageBlitter = imageBlitter;
             this.cameraAndLight = cameraAndLight;
-            maxRecursionDepth = (byte)Math.Min(maxRecursionDepth, graphicsEngine.RenderDevice.DeviceProperties_MaxRayTracingRecursionDepth);
+            this.options = options;
+            this.textureUploader = textureUploader;
+            this.shaderCache = shaderCache;
+            this.gpuTimer = gpuTimer;
+            this.gpuMemoryTracker = gpuMemoryTracker;
+            this.lightCulling = lightCulling;
+            this.checkerboard = checkerboard;
+            this.mipGenerator = mipGenerator;
+            this.logger = logger;
+            var deviceRecursionDepth = graphicsEngine.RenderDevice.DeviceProperties_MaxRayTracingRecursionDepth;
+            if (options.IterativeBounces)
+            {
+                //The bounces are not limited by the device, only by the constants
+                PipelineRecursionDepth = (byte)Math.Min(IterativeRecursionDepth, deviceRecursionDepth);
+            }
+            else
+            {
+                maxRecursionDepth = (byte)Math.Min(maxRecursionDepth, deviceRecursionDepth);
+                PipelineRecursionDepth = maxRecursionDepth;
+            }
             m_Constants = Constants.CreateDefault(maxRecursionDepth);
         }
 
         public void Dispose()
         {
             m_pSBT?.Dispose();
+            m_pTLAS?.Dispose();
             DestroyPSO();
+            framePacket.Dispose();
         }
 
+        /// <summary>
+        /// How long the last ray tracing pipeline took to create. Compare runs with a cold and warm
+        /// ShaderCache to see how much the cache saves at startup.
+        /// </summary>
+        public TimeSpan LastPipelineCreateTime { get; private set; }
+
+        /// <summary>
+        /// The recursion depth the pipeline reserves stack for. This is much lower with RTOptions.IterativeBounces.
+        /// </summary>
+        public byte PipelineRecursionDepth { get; private set; }
+
         public Task WaitForPipelineRebuild()
         {
             return pipelineRebuildTask.Task;
@@ -98,14 +172,15 @@ namespace DiligentEngine.RT
 
             // DirectX 12 only: set attribute and payload size. Values should be as small as possible to minimize the memory usage.
             PSOCreateInfo.MaxAttributeSize = (uint)sizeof(/*BuiltInTriangleIntersectionAttributes*/ Vector2);
-            PSOCreateInfo.MaxPayloadSize = (uint)Math.Max(Math.Max(sizeof(HLSL.PrimaryRayPayload), sizeof(HLSL.ShadowRayPayload)), sizeof(HLSL.EmissiveRayPayload));
+            var primaryPayloadSize = options.IterativeBounces ? sizeof(HLSL.IterativePrimaryRayPayload) : sizeof(HLSL.PrimaryRayPayload);
+            PSOCreateInfo.MaxPayloadSize = (uint)Math.Max(Math.Max(primaryPayloadSize, sizeof(HLSL.ShadowRayPayload)), sizeof(HLSL.EmissiveRayPayload));
 
             // Specify the maximum ray recursion depth.
             // WARNING: the driver does not track the recursion depth and it is the
             //          application's responsibility to not exceed the specified limit.
             //          The value is used to reserve the necessary stack size and
             //          exceeding it will likely result in driver crash.
-            PSOCreateInfo.RayTracingPipeline.MaxRecursionDepth = maxRecursionDepth;
+            PSOCreateInfo.RayTracingPipeline.MaxRecursionDepth = PipelineRecursionDepth;
 
             // Define immutable sampler for g_Texture and g_GroundTexture. Immutable samplers should be used whenever possible
             var SamLinearWrapDesc = new SamplerDesc
@@ -142,12 +217,19 @@ namespace DiligentEngine.RT
             {
                 new ShaderResourceVariableDesc{ShaderStages = SHADER_TYPE.SHADER_TYPE_RAY_GEN | SHADER_TYPE.SHADER_TYPE_RAY_MISS | SHADER_TYPE.SHADER_TYPE_RAY_CLOSEST_HIT, Name = "g_ConstantsCB", Type = SHADER_RESOURCE_VARIABLE_TYPE.SHADER_RESOURCE_VARIABLE_TYPE_STATIC},
                 new ShaderResourceVariableDesc{ShaderStages = SHADER_TYPE.SHADER_TYPE_RAY_GEN | SHADER_TYPE.SHADER_TYPE_RAY_CLOSEST_HIT, Name = "g_TLAS", Type = SHADER_RESOURCE_VARIABLE_TYPE.SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC},
-                new ShaderResourceVariableDesc{ShaderStages = SHADER_TYPE.SHADER_TYPE_RAY_GEN, Name = "g_ColorBuffer", Type = SHADER_RESOURCE_VARIABLE_TYPE.SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC} //This is the buffer where the rays are written
+                new ShaderResourceVariableDesc{ShaderStages = SHADER_TYPE.SHADER_TYPE_RAY_GEN, Name = "g_ColorBuffer", Type = SHADER_RESOURCE_VARIABLE_TYPE.SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC}, //This is the buffer where the rays are written
+                new ShaderResourceVariableDesc{ShaderStages = SHADER_TYPE.SHADER_TYPE_RAY_CLOSEST_HIT, Name = "g_TileLights", Type = SHADER_RESOURCE_VARIABLE_TYPE.SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC} //Grows with the render size
             };
 
+            if (checkerboard.Enabled)
+            {
+                Variables.Add(new ShaderResourceVariableDesc { ShaderStages = SHADER_TYPE.SHADER_TYPE_RAY_GEN, Name = "g_DepthBuffer", Type = SHADER_RESOURCE_VARIABLE_TYPE.SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC });
+            }
+
             PSOCreateInfo.PSODesc.ResourceLayout.Variables = Variables;
             PSOCreateInfo.PSODesc.ResourceLayout.ImmutableSamplers = ImmutableSamplers;
             PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE.SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+            PSOCreateInfo.pPSOCache = shaderCache.PipelineStateCache;
 
             OnSetupCreateInfo?.Invoke(PSOCreateInfo);
 
@@ -158,23 +240,20 @@ namespace DiligentEngine.RT
         {
             var m_pDevice = graphicsEngine.RenderDevice;
 
-            // Create a buffer with shared constants.
-            BufferDesc BuffDesc = new BufferDesc();
-            BuffDesc.Name = "Constant buffer";
-            BuffDesc.Size = (uint)sizeof(Constants);
-            BuffDesc.Usage = USAGE.USAGE_DEFAULT;
-            BuffDesc.BindFlags = BIND_FLAGS.BIND_UNIFORM_BUFFER;
-
-            m_ConstantsCB = m_pDevice.CreateBuffer(BuffDesc)
-                ?? throw new InvalidOperationException("Cannot create Ray Tracing PSO Constants Buffer");
+            // Create a buffer with shared constants, it is dynamic and written once a frame.
+            m_ConstantsCB = new FrameRingBuffer(m_pDevice, "Constant buffer", (uint)sizeof(Constants), BIND_FLAGS.BIND_UNIFORM_BUFFER);
 
             var createInfo = CreatePSOCreateInfo();
+            var sw = Stopwatch.StartNew();
             this.m_pRayTracingPSO = m_pDevice.CreateRayTracingPipelineState(createInfo)
                  ?? throw new InvalidOperationException("Cannot create Ray Tracing PSO Pipeline State");
+            sw.Stop();
+            LastPipelineCreateTime = sw.Elapsed;
+            logger.LogInformation($"Created ray tracing pipeline in {sw.Elapsed.TotalMilliseconds}ms. Shader cache is {(shaderCache.IsWarm ? "warm" : "cold")} with {shaderCache.Hits} hits and {shaderCache.Misses} misses, {shaderCache.CompileTime.TotalMilliseconds}ms spent compiling.");
 
-            m_pRayTracingPSO.Obj.GetStaticVariableByName(SHADER_TYPE.SHADER_TYPE_RAY_GEN, "g_ConstantsCB").Set(m_ConstantsCB.Obj);
-            m_pRayTracingPSO.Obj.GetStaticVariableByName(SHADER_TYPE.SHADER_TYPE_RAY_MISS, "g_ConstantsCB").Set(m_ConstantsCB.Obj);
-            m_pRayTracingPSO.Obj.GetStaticVariableByName(SHADER_TYPE.SHADER_TYPE_RAY_CLOSEST_HIT, "g_ConstantsCB").Set(m_ConstantsCB.Obj);
+            m_pRayTracingPSO.Obj.GetStaticVariableByName(SHADER_TYPE.SHADER_TYPE_RAY_GEN, "g_ConstantsCB").Set(m_ConstantsCB.Buffer);
+            m_pRayTracingPSO.Obj.GetStaticVariableByName(SHADER_TYPE.SHADER_TYPE_RAY_MISS, "g_ConstantsCB").Set(m_ConstantsCB.Buffer);
+            m_pRayTracingPSO.Obj.GetStaticVariableByName(SHADER_TYPE.SHADER_TYPE_RAY_CLOSEST_HIT, "g_ConstantsCB").Set(m_ConstantsCB.Buffer);
 
             m_pRayTracingSRB = m_pRayTracingPSO.Obj.CreateShaderResourceBinding(true)
                 ?? throw new InvalidOperationException("Cannot create Ray Tracing PSO Shader Resource Binding");
@@ -200,11 +279,10 @@ namespace DiligentEngine.RT
 
         private RTInstances lastInstances;
 
-        AutoPtr<ITopLevelAS> UpdateTLAS(RTInstances activeInstances)
+        ITopLevelAS UpdateTLAS(RTInstances activeInstances)
         {
             var m_pDevice = graphicsEngine.RenderDevice;
             var m_pImmediateContext = graphicsEngine.ImmediateContext;
-            bool rebuildScratchBuffers = rebuildPipeline;
             bool rebuildSbt = rebuildPipeline;
 
             if(lastInstances != activeInstances)
@@ -230,7 +308,6 @@ namespace DiligentEngine.RT
             if (numInstances != lastNumInstances)
             {
                 rebuildSbt = true; //Not 100% sure about this, but its good for now
-                rebuildScratchBuffers = true;
                 lastNumInstances = numInstances;
             }
 
@@ -250,6 +327,8 @@ namespace DiligentEngine.RT
                 pipelineRebuildTask.SetResult();
                 rebuildPipeline = false;
                 rebindShaderResources = true;
+                rebindTlas = true;
+                rebindLights = true;
             }
 
             if (rebindShaderResources && m_pRayTracingSRB != null)
@@ -258,48 +337,71 @@ namespace DiligentEngine.RT
                 rebindShaderResources = false;
             }
 
+            OnUpdateShaderResources?.Invoke(graphicsEngine.ImmediateContext);
+
             if (rebuildSbt)
             {
                 CreateSBT();
             }
 
-            if (rebuildScratchBuffers)
+            var tlasBarriers = new List<StateTransitionDesc>(4);
+
+            // The tlas is kept between frames. If the instances are the same as the last full build it can be refit,
+            // otherwise it is rebuilt, and it is only recreated if it has to grow.
+            bool refit = m_pTLAS != null
+                && !rebuildSbt
+                && activeInstances.InstanceSetVersion == lastInstanceSetVersion
+                && numInstances == builtInstanceCount
+                && refitCount < options.TlasMaxRefits
+                && SameBlas(instances, numInstances);
+
+            // Create TLAS
+            if (m_pTLAS == null || numInstances > tlasCapacity)
             {
-                m_ScratchBuffer?.Dispose();
-                m_ScratchBuffer = null;
+                m_pTLAS?.Dispose();
                 m_InstanceBuffer?.Dispose();
                 m_InstanceBuffer = null;
-            }
+                m_ScratchBuffer?.Dispose();
+                m_ScratchBuffer = null;
 
-            // Create TLAS
-            var tlasBarriers = new List<StateTransitionDesc>(4);
-            var TLASDesc = new TopLevelASDesc();
-            TLASDesc.Name = "TLAS";
-            TLASDesc.MaxInstanceCount = numInstances;
-            TLASDesc.Flags = RAYTRACING_BUILD_AS_FLAGS.RAYTRACING_BUILD_AS_ALLOW_UPDATE | RAYTRACING_BUILD_AS_FLAGS.RAYTRACING_BUILD_AS_PREFER_FAST_TRACE;
+                var TLASDesc = new TopLevelASDesc();
+                TLASDesc.Name = "TLAS";
+                TLASDesc.MaxInstanceCount = numInstances;
+                TLASDesc.Flags = RAYTRACING_BUILD_AS_FLAGS.RAYTRACING_BUILD_AS_ALLOW_UPDATE | RAYTRACING_BUILD_AS_FLAGS.RAYTRACING_BUILD_AS_PREFER_FAST_TRACE;
 
-            var m_pTLAS = m_pDevice.CreateTLAS(TLASDesc)
-                ?? throw new InvalidOperationException($"Could not create TLAS '{TLASDesc.Name}'");
+                m_pTLAS = m_pDevice.CreateTLAS(TLASDesc)
+                    ?? throw new InvalidOperationException($"Could not create TLAS '{TLASDesc.Name}'");
+                tlasCapacity = numInstances;
+                refit = false;
+                rebindTlas = true;
+            }
 
             tlasBarriers.Add(new StateTransitionDesc { pResource = m_pTLAS.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_BUILD_AS_WRITE, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
 
-            m_pRayTracingSRB.Obj.GetVariableByName(SHADER_TYPE.SHADER_TYPE_RAY_GEN, "g_TLAS").Set(m_pTLAS.Obj);
-            m_pRayTracingSRB.Obj.GetVariableByName(SHADER_TYPE.SHADER_TYPE_RAY_CLOSEST_HIT, "g_TLAS").Set(m_pTLAS.Obj);
+            if (rebindTlas)
+            {
+                m_pRayTracingSRB.Obj.GetVariableByName(SHADER_TYPE.SHADER_TYPE_RAY_GEN, "g_TLAS").Set(m_pTLAS.Obj);
+                m_pRayTracingSRB.Obj.GetVariableByName(SHADER_TYPE.SHADER_TYPE_RAY_CLOSEST_HIT, "g_TLAS").Set(m_pTLAS.Obj);
+                rebindTlas = false;
+            }
 
             // Create scratch buffer
             if (m_ScratchBuffer == null)
             {
+                var scratchSizes = new ScratchBufferSizesPassStruct();
+                m_pTLAS.Obj.GetScratchBufferSizes(ref scratchSizes);
                 var BuffDesc = new BufferDesc()
                 {
                     Name = "TLAS Scratch Buffer",
                     Usage = USAGE.USAGE_DEFAULT,
                     BindFlags = BIND_FLAGS.BIND_RAY_TRACING,
-                    Size = Math.Max(m_pTLAS.Obj.ScratchBufferSizes_Build, m_pTLAS.Obj.ScratchBufferSizes_Update)
+                    Size = Math.Max(scratchSizes.Build, scratchSizes.Update)
                 };
                 m_ScratchBuffer = m_pDevice.CreateBuffer(BuffDesc, new BufferData())
                     ?? throw new InvalidOperationException($"Cannot create '{BuffDesc.Name}'");
 
                 tlasBarriers.Add(new StateTransitionDesc { pResource = m_ScratchBuffer.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_BUILD_AS_WRITE, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
+                refit = false;
             }
 
             // Create instance buffer
@@ -309,16 +411,17 @@ namespace DiligentEngine.RT
                 BuffDesc.Name = "TLAS Instance Buffer";
                 BuffDesc.Usage = USAGE.USAGE_DEFAULT;
                 BuffDesc.BindFlags = BIND_FLAGS.BIND_RAY_TRACING;
-                BuffDesc.Size = ITopLevelAS.TLAS_INSTANCE_DATA_SIZE * numInstances;
+                BuffDesc.Size = ITopLevelAS.TLAS_INSTANCE_DATA_SIZE * tlasCapacity;
 
                 m_InstanceBuffer = m_pDevice.CreateBuffer(BuffDesc, new BufferData())
                     ?? throw new InvalidOperationException($"Cannot create '{BuffDesc.Name}'");
+                refit = false;
             }
 
             // Build or update TLAS
             var Attribs = new BuildTLASAttribsOptimized();
             Attribs.pTLAS = m_pTLAS.Obj;
-            Attribs.Update = false;
+            Attribs.Update = refit;
 
             // Scratch buffer will be used to store temporary data during TLAS build or update.
             // Previous content in the scratch buffer will be discarded.
@@ -343,19 +446,89 @@ namespace DiligentEngine.RT
             Attribs.ScratchBufferTransitionMode = RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_VERIFY;
 
             m_pImmediateContext.TransitionResourceStates(tlasBarriers);
+
+            var timerName = refit ? "TLAS Refit" : "TLAS Build";
+            PerformanceMonitor.start(timerName);
+            var buildStart = Stopwatch.GetTimestamp();
+            gpuTimer.Begin(timerName);
             m_pImmediateContext.BuildTLAS(Attribs);
+            gpuTimer.End(timerName);
+            var buildTicks = Stopwatch.GetTimestamp() - buildStart;
+            PerformanceMonitor.stop(timerName);
+
+            if (refit)
+            {
+                ++refitCount;
+                LastTlasRefitTime = TimeSpan.FromSeconds((double)buildTicks / Stopwatch.Frequency);
+            }
+            else
+            {
+                refitCount = 0;
+                lastInstanceSetVersion = activeInstances.InstanceSetVersion;
+                builtInstanceCount = numInstances;
+                SaveBlas(instances, numInstances);
+                activeInstances.ResolveHitGroupIndices(m_pTLAS.Obj);
+                LastTlasBuildTime = TimeSpan.FromSeconds((double)buildTicks / Stopwatch.Frequency);
+            }
+            LastTlasWasRefit = refit;
 
             // Hit groups for primary ray
-            activeInstances.BindShaders(m_pSBT.Obj, m_pTLAS.Obj);
+            activeInstances.BindShaders(m_pSBT.Obj, m_pTLAS.Obj, rebuildSbt || !refit || rebindAllHitGroups);
+            rebindAllHitGroups = false;
 
             // Hit groups for shadow ray.
             BindTlasShaderResources(m_pSBT.Obj, m_pTLAS.Obj);
 
-            m_pImmediateContext.UpdateSBT(m_pSBT.Obj);
+            framePacket.UpdateSBT(m_pSBT.Obj);
 
-            return m_pTLAS;
+            return m_pTLAS.Obj;
         }
 
+        private bool SameBlas(TLASBuildInstanceDataPassStruct[] instances, uint numInstances)
+        {
+            if (builtBlas.Length < numInstances)
+            {
+                return false;
+            }
+
+            for (int i = 0; i < numInstances; ++i)
+            {
+                if (builtBlas[i] != instances[i].pBLAS)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        private void SaveBlas(TLASBuildInstanceDataPassStruct[] instances, uint numInstances)
+        {
+            if (builtBlas.Length < numInstances)
+            {
+                builtBlas = new IntPtr[numInstances];
+            }
+
+            for (int i = 0; i < numInstances; ++i)
+            {
+                builtBlas[i] = instances[i].pBLAS;
+            }
+        }
+
+        /// <summary>
+        /// The cpu time spent recording the last full tlas build.
+        /// </summary>
+        public TimeSpan LastTlasBuildTime { get; private set; }
+
+        /// <summary>
+        /// The cpu time spent recording the last tlas refit.
+        /// </summary>
+        public TimeSpan LastTlasRefitTime { get; private set; }
+
+        /// <summary>
+        /// True if the tlas was refit instead of rebuilt this frame.
+        /// </summary>
+        public bool LastTlasWasRefit { get; private set; }
+
         public void SetMissTextureSet(int textureSet, int textureSet2 = -1, float blendAmount = 0.0f, in Vector2 uvOffset = new Vector2())
         {
             this.m_Constants.missTextureSet = textureSet;
@@ -372,9 +545,28 @@ namespace DiligentEngine.RT
             var swapChain = graphicsEngine.SwapChain;
             var m_pImmediateContext = graphicsEngine.ImmediateContext;
 
-            //TODO: Might be able to avoid recreating this like the other buffers, this also seems ok
-            //So really need more info about behavior to decide here
-            using var tlas = UpdateTLAS(activeInstances);
+            gpuTimer.BeginFrame();
+            gpuMemoryTracker.Update();
+
+            //Read the desc once for the frame instead of a call per field
+            swapChain.GetDesc(ref swapChainDesc);
+
+            if (imageBlitter.DynamicResolution)
+            {
+                imageBlitter.UpdateRenderScale(GetDynamicResolutionFrameTime());
+            }
+            var renderWidth = imageBlitter.RenderWidth;
+            var renderHeight = imageBlitter.RenderHeight;
+
+            //Record any textures streamed in since the last frame before anything can sample them. The mip
+            //jobs are taken first, their source textures were staged before they were queued so their copies
+            //are recorded here too.
+            mipGenerator.BeginFrame();
+            textureUploader.Process(m_pImmediateContext);
+            mipGenerator.Process(m_pImmediateContext);
+
+            framePacket.Reset();
+            var tlas = UpdateTLAS(activeInstances);
             var render = tlas != null;
 
             if (render)
@@ -382,11 +574,11 @@ namespace DiligentEngine.RT
                 // Update constants
                 {
                     var pDSV = swapChain.GetDepthBufferDSV();
-                    var preTransform = swapChain.GetDesc_PreTransform;
+                    var preTransform = swapChainDesc.PreTransform;
 
                     //= new Vector3(0f, 0f, -15f);
                     var preTransformMatrix = CameraHelpers.GetSurfacePretransformMatrix(new Vector3(0, 0, 1), preTransform);
-                    var cameraProj = CameraHelpers.GetAdjustedProjectionMatrix(YFov, ZNear, ZFar, imageBlitter.RTBufferWidth, imageBlitter.RTBufferHeight, preTransform);
+                    var cameraProj = CameraHelpers.GetAdjustedProjectionMatrix(YFov, ZNear, ZFar, renderWidth, renderHeight, preTransform);
                     cameraAndLight.GetCameraPosition(cameraPos, cameraRot, preTransformMatrix, cameraProj, out var CameraWorldPos, out var CameraViewProj);
 
                     var Frustum = new ViewFrustum();
@@ -426,71 +618,23 @@ namespace DiligentEngine.RT
                     //TODO: Only change this when the camera size changes
                     m_Constants.eyeToPixelConeSpreadAngle = MathF.Atan((2.0f * MathF.Tan(YFov * 0.5f)) / (float)imageBlitter.FullBufferHeight); //Use the full buffer here to make the mips adjust
 
-                    //Need to invert going into the shader
-                    m_Constants.LightPos_0 = cameraAndLight.LightPos[0] * -1;
-                    m_Constants.LightPos_1 = cameraAndLight.LightPos[1] * -1;
-                    m_Constants.LightPos_2 = cameraAndLight.LightPos[2] * -1;
-                    m_Constants.LightPos_3 = cameraAndLight.LightPos[3] * -1;
-                    m_Constants.LightPos_4 = cameraAndLight.LightPos[4] * -1;
-                    m_Constants.LightPos_5 = cameraAndLight.LightPos[5] * -1;
-                    m_Constants.LightPos_6 = cameraAndLight.LightPos[6] * -1;
-                    m_Constants.LightPos_7 = cameraAndLight.LightPos[7] * -1;
-                    m_Constants.LightPos_8 = cameraAndLight.LightPos[8] * -1;
-                    m_Constants.LightPos_9 = cameraAndLight.LightPos[9] * -1;
-                    m_Constants.LightPos_10 = cameraAndLight.LightPos[10] * -1;
-                    m_Constants.LightPos_11 = cameraAndLight.LightPos[11] * -1;
-                    m_Constants.LightPos_12 = cameraAndLight.LightPos[12] * -1;
-                    m_Constants.LightPos_13 = cameraAndLight.LightPos[13] * -1;
-                    m_Constants.LightPos_14 = cameraAndLight.LightPos[14] * -1;
-                    m_Constants.LightPos_15 = cameraAndLight.LightPos[15] * -1;
-                    m_Constants.LightPos_16 = cameraAndLight.LightPos[16] * -1;
-                    m_Constants.LightPos_17 = cameraAndLight.LightPos[17] * -1;
-                    m_Constants.LightPos_18 = cameraAndLight.LightPos[18] * -1;
-                    m_Constants.LightPos_19 = cameraAndLight.LightPos[19] * -1;
-
-                    var numLights = m_Constants.NumActiveLights = cameraAndLight.NumActiveLights;
-                    Color color;
-                    color = cameraAndLight.LightColor[0];
-                    m_Constants.LightColor_0 = new Vector4(color.r * numLights, color.g * numLights, color.b * numLights, cameraAndLight.LightLength[0]);
-                    color = cameraAndLight.LightColor[1];
-                    m_Constants.LightColor_1 = new Vector4(color.r * numLights, color.g * numLights, color.b * numLights, cameraAndLight.LightLength[1]);
-                    color = cameraAndLight.LightColor[2];
-                    m_Constants.LightColor_2 = new Vector4(color.r * numLights, color.g * numLights, color.b * numLights, cameraAndLight.LightLength[2]);
-                    color = cameraAndLight.LightColor[3];
-                    m_Constants.LightColor_3 = new Vector4(color.r * numLights, color.g * numLights, color.b * numLights, cameraAndLight.LightLength[3]);
-                    color = cameraAndLight.LightColor[4];
-                    m_Constants.LightColor_4 = new Vector4(color.r * numLights, color.g * numLights, color.b * numLights, cameraAndLight.LightLength[4]);
-                    color = cameraAndLight.LightColor[5];
-                    m_Constants.LightColor_5 = new Vector4(color.r * numLights, color.g * numLights, color.b * numLights, cameraAndLight.LightLength[5]);
-                    color = cameraAndLight.LightColor[6];
-                    m_Constants.LightColor_6 = new Vector4(color.r * numLights, color.g * numLights, color.b * numLights, cameraAndLight.LightLength[6]);
-                    color = cameraAndLight.LightColor[7];
-                    m_Constants.LightColor_7 = new Vector4(color.r * numLights, color.g * numLights, color.b * numLights, cameraAndLight.LightLength[7]);
-                    color = cameraAndLight.LightColor[8];
-                    m_Constants.LightColor_8 = new Vector4(color.r * numLights, color.g * numLights, color.b * numLights, cameraAndLight.LightLength[8]);
-                    color = cameraAndLight.LightColor[9];
-                    m_Constants.LightColor_9 = new Vector4(color.r * numLights, color.g * numLights, color.b * numLights, cameraAndLight.LightLength[9]);
-                    color = cameraAndLight.LightColor[10];
-                    m_Constants.LightColor_10 = new Vector4(color.r * numLights, color.g * numLights, color.b * numLights, cameraAndLight.LightLength[10]);
-                    color = cameraAndLight.LightColor[11];
-                    m_Constants.LightColor_11 = new Vector4(color.r * numLights, color.g * numLights, color.b * numLights, cameraAndLight.LightLength[11]);
-                    color = cameraAndLight.LightColor[12];
-                    m_Constants.LightColor_12 = new Vector4(color.r * numLights, color.g * numLights, color.b * numLights, cameraAndLight.LightLength[12]);
-                    color = cameraAndLight.LightColor[13];
-                    m_Constants.LightColor_13 = new Vector4(color.r * numLights, color.g * numLights, color.b * numLights, cameraAndLight.LightLength[13]);
-                    color = cameraAndLight.LightColor[14];
-                    m_Constants.LightColor_14 = new Vector4(color.r * numLights, color.g * numLights, color.b * numLights, cameraAndLight.LightLength[14]);
-                    color = cameraAndLight.LightColor[15];
-                    m_Constants.LightColor_15 = new Vector4(color.r * numLights, color.g * numLights, color.b * numLights, cameraAndLight.LightLength[15]);
-                    color = cameraAndLight.LightColor[16];
-                    m_Constants.LightColor_16 = new Vector4(color.r * numLights, color.g * numLights, color.b * numLights, cameraAndLight.LightLength[16]);
-                    color = cameraAndLight.LightColor[17];
-                    m_Constants.LightColor_17 = new Vector4(color.r * numLights, color.g * numLights, color.b * numLights, cameraAndLight.LightLength[17]);
-                    color = cameraAndLight.LightColor[18];
-                    m_Constants.LightColor_18 = new Vector4(color.r * numLights, color.g * numLights, color.b * numLights, cameraAndLight.LightLength[18]);
-                    color = cameraAndLight.LightColor[19];
-                    m_Constants.LightColor_19 = new Vector4(color.r * numLights, color.g * numLights, color.b * numLights, cameraAndLight.LightLength[19]);
+                    //Lights are copied to the light buffer, the constants only get the count and tile info
+                    if (lightCulling.Prepare(renderWidth, renderHeight, ref m_Constants) || rebindLights)
+                    {
+                        lightCulling.Bind(m_pRayTracingSRB.Obj, m_ConstantsCB.Buffer);
+                        if (checkerboard.Enabled)
+                        {
+                            checkerboard.Bind(m_ConstantsCB.Buffer);
+                        }
+                        rebindLights = false;
+                    }
 
+                    if (checkerboard.Enabled)
+                    {
+                        checkerboard.Prepare(m_pImmediateContext, imageBlitter.RTBufferWidth, imageBlitter.RTBufferHeight, renderWidth, renderHeight, ref m_Constants);
+                    }
+
+                    Color color;
                     color = cameraAndLight.MissPallete[0]; m_Constants.Pallete_0 = new Vector4(color.r, color.g, color.b, 0);
                     color = cameraAndLight.MissPallete[1]; m_Constants.Pallete_1 = new Vector4(color.r, color.g, color.b, 0);
                     color = cameraAndLight.MissPallete[2]; m_Constants.Pallete_2 = new Vector4(color.r, color.g, color.b, 0);
@@ -498,38 +642,62 @@ namespace DiligentEngine.RT
                     color = cameraAndLight.MissPallete[4]; m_Constants.Pallete_4 = new Vector4(color.r, color.g, color.b, 0);
                     color = cameraAndLight.MissPallete[5]; m_Constants.Pallete_5 = new Vector4(color.r, color.g, color.b, 0);
 
-                    fixed (Constants* constantsPtr = &m_Constants)
-                    {
-                        var barriers = new List<StateTransitionDesc>(1); //TODO: Persist this and don't make it every frame
-                        barriers.Add(new StateTransitionDesc { pResource = m_ConstantsCB.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_COPY_DEST, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
-                        m_pImmediateContext.TransitionResourceStates(barriers);
-                        m_pImmediateContext.UpdateBuffer(m_ConstantsCB.Obj, 0, (uint)sizeof(Constants), new IntPtr(constantsPtr), RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_VERIFY);
-                    }
+                    //Written straight into mapped memory, the packet that uses it runs on the same context this frame
+                    m_ConstantsCB.Reset();
+                    m_ConstantsCB.Write(m_pImmediateContext, m_Constants);
                 }
 
                 //Trace rays
                 {
-                    var barriers = new List<StateTransitionDesc>(3); //TODO: Persist this and don't make it every frame
-                    barriers.Add(new StateTransitionDesc { pResource = m_ConstantsCB.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_CONSTANT_BUFFER, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
-                    barriers.Add(new StateTransitionDesc { pResource = tlas.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_RAY_TRACING, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
+                    var barriers = frameBarriers;
+                    barriers.Clear();
+                    lightCulling.Cull(framePacket, barriers);
+                    barriers.Add(new StateTransitionDesc { pResource = tlas, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_RAY_TRACING, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
                     imageBlitter.SetupUnorderedAccess(barriers);
-                    m_pImmediateContext.TransitionResourceStates(barriers);
+                    if (checkerboard.Enabled)
+                    {
+                        checkerboard.SetupUnorderedAccess(barriers);
+                    }
+                    framePacket.TransitionResourceStates(barriers);
 
-                    m_pRayTracingSRB.Obj.GetVariableByName(SHADER_TYPE.SHADER_TYPE_RAY_GEN, "g_ColorBuffer").Set(imageBlitter.RTTextureView);
+                    if (checkerboard.Enabled)
+                    {
+                        //Half the pixels are traced into the checkerboard textures, the resolve fills the blitter's texture
+                        m_pRayTracingSRB.Obj.GetVariableByName(SHADER_TYPE.SHADER_TYPE_RAY_GEN, "g_ColorBuffer").Set(checkerboard.TraceColorView);
+                        m_pRayTracingSRB.Obj.GetVariableByName(SHADER_TYPE.SHADER_TYPE_RAY_GEN, "g_DepthBuffer").Set(checkerboard.TraceDepthView);
+                    }
+                    else
+                    {
+                        m_pRayTracingSRB.Obj.GetVariableByName(SHADER_TYPE.SHADER_TYPE_RAY_GEN, "g_ColorBuffer").Set(imageBlitter.RTTextureView);
+                    }
 
-                    m_pImmediateContext.SetPipelineState(m_pRayTracingPSO.Obj);
-                    m_pImmediateContext.CommitShaderResources(m_pRayTracingSRB.Obj, RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_VERIFY);
+                    framePacket.SetPipelineState(m_pRayTracingPSO.Obj);
+                    framePacket.CommitShaderResources(m_pRayTracingSRB.Obj, RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 
                     var Attribs = new TraceRaysAttribs();
-                    Attribs.DimensionX = imageBlitter.RTBufferWidth;
-                    Attribs.DimensionY = imageBlitter.RTBufferHeight;
+                    Attribs.DimensionX = checkerboard.Enabled ? checkerboard.DispatchWidth : renderWidth;
+                    Attribs.DimensionY = renderHeight;
                     Attribs.pSBT = m_pSBT.Obj;
 
-                    m_pImmediateContext.TraceRays(Attribs);
+                    framePacket.TraceRays(Attribs);
+
+                    if (checkerboard.Enabled)
+                    {
+                        checkerboard.Resolve(framePacket, imageBlitter.RTTextureView);
+                    }
+                }
+
+                //Everything after the tlas build goes to the context in one call
+                using (gpuTimer.Time("Trace Rays"))
+                {
+                    m_pImmediateContext.ExecutePacket(framePacket);
                 }
 
-                // Blit to swapchain image
-                imageBlitter.Blit();
+                // Blit to swapchain image, this includes the fsr passes when they are on
+                using (gpuTimer.Time("Image Blit"))
+                {
+                    imageBlitter.Blit();
+                }
             }
 
             cameraAndLight.ResetLights();
@@ -537,19 +705,50 @@ namespace DiligentEngine.RT
             return !render;
         }
 
+        /// <summary>
+        /// The time dynamic resolution scales against. The gpu time to trace and upsample is used when
+        /// there are timestamp queries since it is not held at the refresh rate by vsync, otherwise this is
+        /// the cpu time since the last frame.
+        /// </summary>
+        private float GetDynamicResolutionFrameTime()
+        {
+            var now = Stopwatch.GetTimestamp();
+            var cpuFrameTime = lastFrameTimestamp != 0 ? (float)((double)(now - lastFrameTimestamp) / Stopwatch.Frequency) : 0.0f;
+            lastFrameTimestamp = now;
+
+            if (gpuTimer.TryGetDuration("Trace Rays", out var traceTime) && gpuTimer.TryGetDuration("Image Blit", out var blitTime))
+            {
+                return (float)(traceTime + blitTime).TotalSeconds;
+            }
+            return cpuFrameTime;
+        }
+
+        /// <summary>
+        /// Bind the shader resources and every hit group record again next frame. Call this when the shared
+        /// geometry buffers are replaced, static sprites baked their offsets into their records.
+        /// </summary>
         public void RequestRebind()
         {
             rebindShaderResources = true;
+            rebindAllHitGroups = true;
         }
 
         public void AddShaderResourceBinder(ShaderResourceBinder binder)
+        {
+            RequestPipelineRebuild();
+            shaderResourceBinders.Add(binder);
+        }
+
+        /// <summary>
+        /// Create the pipeline again next frame, use this when the shaders added in OnSetupCreateInfo change.
+        /// </summary>
+        public void RequestPipelineRebuild()
         {
             if (pipelineRebuildTask.Task.IsCompleted)
             {
                 pipelineRebuildTask = new TaskCompletionSource();
             }
             rebuildPipeline = true;
-            shaderResourceBinders.Add(binder);
         }
 
         public void RemoveShaderResourceBinder(ShaderResourceBinder binder)
@@ -24,7 +24,19 @@ namespace DiligentEngine.RT.Resources
             public int physicalIndex;
         }
 
-        public int MaxTextures => 200; //This can be much higher
+        private static readonly SHADER_TYPE[] BoundStages = new SHADER_TYPE[] { SHADER_TYPE.SHADER_TYPE_RAY_CLOSEST_HIT, SHADER_TYPE.SHADER_TYPE_RAY_ANY_HIT, SHADER_TYPE.SHADER_TYPE_RAY_MISS };
+
+        /// <summary>
+        /// The size of the texture array in the shaders. This starts at RTOptions.MaxTextures and doubles
+        /// when it runs out of slots, the same as the texture sets buffer.
+        /// </summary>
+        public int MaxTextures { get; private set; }
+
+        /// <summary>
+        /// Called when MaxTextures grows. The shaders are compiled with the size of the texture array, so
+        /// anything that creates them has to create them again and request a pipeline rebuild.
+        /// </summary>
+        public event Action OnMaxTexturesChanged;
         internal List<IDeviceObject> Textures => textures;
 
         private Stack<int> availableSlots;
@@ -41,12 +53,24 @@ namespace DiligentEngine.RT.Resources
         private readonly RayTracingRenderer renderer;
         private readonly GraphicsEngine graphicsEngine;
         AutoPtr<IBuffer> texSetBuffer;
-        private bool requestBufferRecreate = false;
+        private int texSetBufferCapacity = 0;
+
+        //Half open ranges of the slots changed since they were last sent to the gpu
+        private int dirtyTextureSetStart = int.MaxValue;
+        private int dirtyTextureSetEnd = 0;
+        private int dirtyTextureStart = int.MaxValue;
+        private int dirtyTextureEnd = 0;
+
+        //The variables the textures are bound to, kept so changes only update what changed instead of rebinding everything
+        private List<IShaderResourceVariable> boundTextureVars = new List<IShaderResourceVariable>();
+        private List<IShaderResourceVariable> boundTextureSetVars = new List<IShaderResourceVariable>();
+        private List<StateTransitionDesc> barriers = new List<StateTransitionDesc>(1);
 
         public IBuffer TexSetBuffer => texSetBuffer.Obj; //Need to bind this in the shader and setup variables
 
-        public ActiveTextures(TextureLoader textureLoader, IResourceProvider<ShaderLoader<RTShaders>> resourceProvider, RayTracingRenderer renderer, GraphicsEngine graphicsEngine)
+        public ActiveTextures(TextureLoader textureLoader, IResourceProvider<ShaderLoader<RTShaders>> resourceProvider, RayTracingRenderer renderer, GraphicsEngine graphicsEngine, RTOptions options)
         {
+            MaxTextures = options.MaxTextures;
             var barriers = new List<StateTransitionDesc>(1);
             using var placeholderStream = resourceProvider.openFile("assets/Placeholder.png");
 
@@ -73,10 +97,12 @@ namespace DiligentEngine.RT.Resources
 
             this.renderer = renderer;
             this.graphicsEngine = graphicsEngine;
+            renderer.OnUpdateShaderResources += UpdateShaderResources;
         }
 
         public void Dispose()
         {
+            renderer.OnUpdateShaderResources -= UpdateShaderResources;
             DestroyShaderBuffers();
             placeholderTexture.Dispose();
         }
@@ -259,27 +285,27 @@ namespace DiligentEngine.RT.Resources
                 {
                     var slot = GetTextureSlot();
                     textureSets[binding.textureSetIndex].baseTexture = slot;
-                    textures[slot] = texture.BaseColorSRV;
+                    SetTexture(slot, texture.BaseColorSRV);
                 }
                 if (texture.NormalMapSRV != null)
                 {
                     var slot = GetTextureSlot();
                     textureSets[binding.textureSetIndex].normalTexture = slot;
-                    textures[slot] = texture.NormalMapSRV;
+                    SetTexture(slot, texture.NormalMapSRV);
                 }
                 if (texture.PhysicalDescriptorMapSRV != null)
                 {
                     var slot = GetTextureSlot();
                     textureSets[binding.textureSetIndex].physicalTexture = slot;
-                    textures[slot] = texture.PhysicalDescriptorMapSRV;
+                    SetTexture(slot, texture.PhysicalDescriptorMapSRV);
                 }
                 if (texture.EmissiveSRV != null)
                 {
                     var slot = GetTextureSlot();
                     textureSets[binding.textureSetIndex].emissiveTexture = slot;
-                    textures[slot] = texture.EmissiveSRV;
+                    SetTexture(slot, texture.EmissiveSRV);
                 }
-                RequestTextureSetUpdate();
+                RequestTextureSetUpdate(binding.textureSetIndex);
             }
             binding.count++;
             return binding.textureSetIndex;
@@ -305,26 +331,25 @@ namespace DiligentEngine.RT.Resources
                     if (texture.BaseColorSRV != null)
                     {
                         ReturnTextureSlot(textureSet.baseTexture);
-                        textures[textureSet.baseTexture] = placeholderTextureDeviceObject;
+                        SetTexture(textureSet.baseTexture, placeholderTextureDeviceObject);
                     }
                     if (texture.NormalMapSRV != null)
                     {
                         ReturnTextureSlot(textureSet.normalTexture);
-                        textures[textureSet.normalTexture] = placeholderTextureDeviceObject;
+                        SetTexture(textureSet.normalTexture, placeholderTextureDeviceObject);
                     }
                     if (texture.PhysicalDescriptorMapSRV != null)
                     {
                         ReturnTextureSlot(textureSet.physicalTexture);
-                        textures[textureSet.physicalTexture] = placeholderTextureDeviceObject;
+                        SetTexture(textureSet.physicalTexture, placeholderTextureDeviceObject);
                     }
                     if (texture.EmissiveSRV != null)
                     {
                         ReturnTextureSlot(textureSet.emissiveTexture);
-                        textures[textureSet.emissiveTexture] = placeholderTextureDeviceObject;
+                        SetTexture(textureSet.emissiveTexture, placeholderTextureDeviceObject);
                     }
                     ReturnTextureSetSlot(binding.textureSetIndex);
                     cc0Textures.Remove(texture);
-                    RequestTextureSetUpdate();
                 }
             }
         }
@@ -353,7 +378,7 @@ namespace DiligentEngine.RT.Resources
                 {
                     var slot = GetTextureSlot();
                     textureSets[binding.textureSetIndex].baseTexture = slot;
-                    textures[slot] = texture.ColorTexture.GetDefaultView(TEXTURE_VIEW_TYPE.TEXTURE_VIEW_SHADER_RESOURCE);
+                    SetTexture(slot, texture.ColorTexture.GetDefaultView(TEXTURE_VIEW_TYPE.TEXTURE_VIEW_SHADER_RESOURCE));
                 }
 
                 SpriteMaterialTextureBinding spriteMaterialTextureBinding;
@@ -365,13 +390,13 @@ namespace DiligentEngine.RT.Resources
                     {
                         var slot = GetTextureSlot();
                         spriteMaterialTextureBinding.normalIndex = slot; 
-                        textures[slot] = texture.Textures.NormalTexture.GetDefaultView(TEXTURE_VIEW_TYPE.TEXTURE_VIEW_SHADER_RESOURCE);
+                        SetTexture(slot, texture.Textures.NormalTexture.GetDefaultView(TEXTURE_VIEW_TYPE.TEXTURE_VIEW_SHADER_RESOURCE));
                     }
                     if (texture.Textures.PhysicalTexture != null)
                     {
                         var slot = GetTextureSlot();
                         spriteMaterialTextureBinding.physicalIndex = slot;
-                        textures[slot] = texture.Textures.PhysicalTexture.GetDefaultView(TEXTURE_VIEW_TYPE.TEXTURE_VIEW_SHADER_RESOURCE);
+                        SetTexture(slot, texture.Textures.PhysicalTexture.GetDefaultView(TEXTURE_VIEW_TYPE.TEXTURE_VIEW_SHADER_RESOURCE));
                     }
                 }
                 spriteMaterialTextureBinding.count++;
@@ -379,7 +404,7 @@ namespace DiligentEngine.RT.Resources
                 textureSets[binding.textureSetIndex].normalTexture = spriteMaterialTextureBinding.normalIndex;
                 textureSets[binding.textureSetIndex].physicalTexture = spriteMaterialTextureBinding.physicalIndex;
 
-                RequestTextureSetUpdate();
+                RequestTextureSetUpdate(binding.textureSetIndex);
             }
             binding.count++;
 
@@ -406,7 +431,7 @@ namespace DiligentEngine.RT.Resources
                     if (texture.ColorTexture != null)
                     {
                         ReturnTextureSlot(textureSet.baseTexture);
-                        textures[textureSet.baseTexture] = placeholderTextureDeviceObject;
+                        SetTexture(textureSet.baseTexture, placeholderTextureDeviceObject);
                     }
 
                     if(spriteMaterialTextures.TryGetValue(texture.Textures, out var spriteMaterialTextureBinding))
@@ -417,12 +442,12 @@ namespace DiligentEngine.RT.Resources
                             if (texture.Textures.NormalTexture != null)
                             {
                                 ReturnTextureSlot(textureSet.normalTexture);
-                                textures[textureSet.normalTexture] = placeholderTextureDeviceObject;
+                                SetTexture(textureSet.normalTexture, placeholderTextureDeviceObject);
                             }
                             if (texture.Textures.PhysicalTexture != null)
                             {
                                 ReturnTextureSlot(textureSet.physicalTexture);
-                                textures[textureSet.physicalTexture] = placeholderTextureDeviceObject;
+                                SetTexture(textureSet.physicalTexture, placeholderTextureDeviceObject);
                             }
                             spriteMaterialTextures.Remove(texture.Textures);
                         }
@@ -430,7 +455,6 @@ namespace DiligentEngine.RT.Resources
 
                     ReturnTextureSetSlot(binding.textureSetIndex);
                     spriteTextures.Remove(texture);
-                    RequestTextureSetUpdate();
                 }
             }
         }
@@ -439,7 +463,18 @@ namespace DiligentEngine.RT.Resources
         {
             if(availableSlots.Count == 0)
             {
-                throw new InvalidOperationException($"Ran out of texture slots. The current max is {this.MaxTextures}.");
+                //Double the texture array, the new slots show the placeholder until they are used
+                var oldSize = MaxTextures;
+                MaxTextures = Math.Max(oldSize * 2, 1);
+                for (var i = oldSize; i < MaxTextures; ++i)
+                {
+                    textures.Add(placeholderTextureDeviceObject);
+                }
+                for (var i = MaxTextures - 1; i >= oldSize; --i)
+                {
+                    availableSlots.Push(i);
+                }
+                OnMaxTexturesChanged?.Invoke();
             }
             return availableSlots.Pop();
         }
@@ -453,7 +488,14 @@ namespace DiligentEngine.RT.Resources
         {
             if (availableSetSlots.Count == 0)
             {
-                throw new InvalidOperationException($"Ran out of texture set slots. The current max is {this.MaxTextures}.");
+                //Double the texture sets, the buffer is recreated at the new size on the next update
+                var oldSize = textureSets.Length;
+                var newSize = Math.Max(oldSize * 2, 1);
+                Array.Resize(ref textureSets, newSize);
+                for (var i = newSize - 1; i >= oldSize; --i)
+                {
+                    availableSetSlots.Push(i);
+                }
             }
             return availableSetSlots.Pop();
         }
@@ -463,57 +505,122 @@ namespace DiligentEngine.RT.Resources
             availableSetSlots.Push(slot);
         }
 
-        private void RequestTextureSetUpdate()
+        private void SetTexture(int slot, IDeviceObject texture)
+        {
+            textures[slot] = texture;
+            dirtyTextureStart = Math.Min(dirtyTextureStart, slot);
+            dirtyTextureEnd = Math.Max(dirtyTextureEnd, slot + 1);
+        }
+
+        private void RequestTextureSetUpdate(int textureSetIndex)
         {
-            renderer.RequestRebind();
-            requestBufferRecreate = true;
+            dirtyTextureSetStart = Math.Min(dirtyTextureSetStart, textureSetIndex);
+            dirtyTextureSetEnd = Math.Max(dirtyTextureSetEnd, textureSetIndex + 1);
         }
 
         private void DestroyShaderBuffers()
         {
             texSetBuffer?.Dispose();
             texSetBuffer = null;
+            texSetBufferCapacity = 0;
         }
 
-        public void UpdateSharedBuffers()
+        /// <summary>
+        /// Bind the textures and texture sets to the variables with these names in the srb. The variables
+        /// are kept until the next bind, after that any changes only update the slots that changed.
+        /// </summary>
+        public void Bind(IShaderResourceBinding srb, String texturesVarName, String textureSetsVarName)
         {
-            if (requestBufferRecreate)
+            //Every bind sets all the variables again, so only keep the ones from this bind
+            boundTextureVars.Clear();
+            boundTextureSetVars.Clear();
+
+            UpdateTextureSetBuffer(graphicsEngine.ImmediateContext);
+            var texSetView = texSetBuffer.Obj.GetDefaultView(BUFFER_VIEW_TYPE.BUFFER_VIEW_SHADER_RESOURCE);
+            foreach (var stage in BoundStages)
             {
-                requestBufferRecreate = false;
-                var barriers = new List<StateTransitionDesc>();
-                var m_pDevice = graphicsEngine.RenderDevice;
+                var textureSetsVar = srb.GetVariableByName(stage, textureSetsVarName);
+                if (textureSetsVar != null)
+                {
+                    textureSetsVar.Set(texSetView);
+                    boundTextureSetVars.Add(textureSetsVar);
+                }
 
-                DestroyShaderBuffers();
+                var texturesVar = srb.GetVariableByName(stage, texturesVarName);
+                if (texturesVar != null)
+                {
+                    texturesVar.SetArray(textures);
+                    boundTextureVars.Add(texturesVar);
+                }
+            }
+        }
+
+        private void UpdateShaderResources(IDeviceContext immediateContext)
+        {
+            UpdateTextureSetBuffer(immediateContext);
 
-                // Create attribs vertex buffer
-                unsafe
+            if (dirtyTextureEnd > dirtyTextureStart)
+            {
+                var count = (uint)(dirtyTextureEnd - dirtyTextureStart);
+                foreach (var texturesVar in boundTextureVars)
                 {
-                    if (textureSets.Length == 0)
-                    {
-                        return; //No texture sets, bail
-                    }
+                    texturesVar.SetArrayRange(textures, (uint)dirtyTextureStart, count);
+                }
+                dirtyTextureStart = int.MaxValue;
+                dirtyTextureEnd = 0;
+            }
+        }
 
-                    var BuffDesc = new BufferDesc();
-                    BuffDesc.Name = "Texture set buffer";
-                    BuffDesc.Usage = USAGE.USAGE_IMMUTABLE;
-                    BuffDesc.BindFlags = BIND_FLAGS.BIND_SHADER_RESOURCE;
-                    BuffDesc.ElementByteStride = (uint)sizeof(TextureSet);
-                    BuffDesc.Mode = BUFFER_MODE.BUFFER_MODE_STRUCTURED;
+        private unsafe void UpdateTextureSetBuffer(IDeviceContext immediateContext)
+        {
+            if (texSetBuffer == null || texSetBufferCapacity != textureSets.Length)
+            {
+                DestroyShaderBuffers();
 
-                    BufferData BufData = new BufferData();
-                    fixed (TextureSet* p_vertices = textureSets)
-                    {
-                        BufData.pData = new IntPtr(p_vertices);
-                        BufData.DataSize = BuffDesc.Size = BuffDesc.ElementByteStride * (uint)textureSets.Length;
-                        texSetBuffer = m_pDevice.CreateBuffer(BuffDesc, BufData)
-                            ?? throw new InvalidOperationException("Cannot create texture set buffer");
-                    }
+                var BuffDesc = new BufferDesc();
+                BuffDesc.Name = "Texture set buffer";
+                BuffDesc.Usage = USAGE.USAGE_DEFAULT;
+                BuffDesc.BindFlags = BIND_FLAGS.BIND_SHADER_RESOURCE;
+                BuffDesc.ElementByteStride = (uint)sizeof(TextureSet);
+                BuffDesc.Mode = BUFFER_MODE.BUFFER_MODE_STRUCTURED;
 
-                    barriers.Add(new StateTransitionDesc { pResource = texSetBuffer.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_SHADER_RESOURCE, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
+                BufferData BufData = new BufferData();
+                fixed (TextureSet* pTextureSets = textureSets)
+                {
+                    BufData.pData = new IntPtr(pTextureSets);
+                    BufData.DataSize = BuffDesc.Size = BuffDesc.ElementByteStride * (uint)textureSets.Length;
+                    texSetBuffer = graphicsEngine.RenderDevice.CreateBuffer(BuffDesc, BufData)
+                        ?? throw new InvalidOperationException("Cannot create texture set buffer");
                 }
+                texSetBufferCapacity = textureSets.Length;
 
-                graphicsEngine.ImmediateContext.TransitionResourceStates(barriers);
+                //Only the texture set variables need the new buffer, nothing else has to be rebound
+                var texSetView = texSetBuffer.Obj.GetDefaultView(BUFFER_VIEW_TYPE.BUFFER_VIEW_SHADER_RESOURCE);
+                foreach (var textureSetsVar in boundTextureSetVars)
+                {
+                    textureSetsVar.Set(texSetView);
+                }
+            }
+            else if (dirtyTextureSetEnd > dirtyTextureSetStart)
+            {
+                var stride = (uint)sizeof(TextureSet);
+                var count = (uint)(dirtyTextureSetEnd - dirtyTextureSetStart);
+                fixed (TextureSet* pTextureSets = &textureSets[dirtyTextureSetStart])
+                {
+                    immediateContext.UpdateBuffer(texSetBuffer.Obj, (ulong)(dirtyTextureSetStart * stride), count * stride, new IntPtr(pTextureSets), RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+                }
+            }
+            else
+            {
+                return;
             }
+
+            dirtyTextureSetStart = int.MaxValue;
+            dirtyTextureSetEnd = 0;
+
+            barriers.Clear();
+            barriers.Add(new StateTransitionDesc { pResource = texSetBuffer.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_SHADER_RESOURCE, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
+            immediateContext.TransitionResourceStates(barriers);
         }
     }
 }
@@ -4,6 +4,7 @@ using Engine.Resources;
 using FreeImageAPI;
 using System;
 using System.Collections.Generic;
+using System.IO;
 using System.Linq;
 using System.Text;
 using System.Threading.Tasks;
@@ -19,6 +20,14 @@ namespace DiligentEngine.RT.Resources
         private const uint DefaultPhysicalReflective = 0xFF00FF00; //Reflective loads the alpha channel
         private const uint DefaultPhysicalNoReflect = 0x0000FF00;
 
+        //The maps the TextureCompressor tool writes next to the source images, these are used instead if the device can load them
+        public const String CompressedColorMap = "Color";
+        public const String CompressedNormalMap = "Normal";
+        public const String CompressedPhysicalMap = "Physical";
+        public const String CompressedPhysicalReflectiveMap = "PhysicalReflective";
+        public const String CompressedAmbientOcclusionMap = "AmbientOcclusion";
+        public const String CompressedEmissiveMap = "Emission";
+
         public static uint GetDefaultPhysicalPixel(bool reflective)
         {
             if (reflective)
@@ -28,15 +37,30 @@ namespace DiligentEngine.RT.Resources
             return DefaultPhysicalNoReflect;
         }
 
+        public static String GetCompressedPath(String baseName, String map)
+        {
+            return $"{baseName}_{map}.dds";
+        }
+
+        /// <summary>
+        /// The physical map has the reflective flag baked into its alpha, so each setting gets its own file.
+        /// </summary>
+        public static String GetCompressedPhysicalMap(bool reflective)
+        {
+            return reflective ? CompressedPhysicalReflectiveMap : CompressedPhysicalMap;
+        }
+
         private readonly TextureLoader textureLoader;
         private readonly IResourceProvider<CC0TextureLoader> resourceProvider;
         private readonly GraphicsEngine graphicsEngine;
+        private readonly MipGenerator mipGenerator;
 
-        public CC0TextureLoader(TextureLoader textureLoader, IResourceProvider<CC0TextureLoader> resourceProvider, GraphicsEngine graphicsEngine)
+        public CC0TextureLoader(TextureLoader textureLoader, IResourceProvider<CC0TextureLoader> resourceProvider, GraphicsEngine graphicsEngine, MipGenerator mipGenerator)
         {
             this.textureLoader = textureLoader;
             this.resourceProvider = resourceProvider;
             this.graphicsEngine = graphicsEngine;
+            this.mipGenerator = mipGenerator;
         }
 
         public async Task<CC0TextureResult> LoadTextureSet(CCOTextureBindingDescription desc)
@@ -54,56 +78,96 @@ namespace DiligentEngine.RT.Resources
 
             var Barriers = new List<StateTransitionDesc>(5);
 
+            //Block compressed versions are used when they exist, the source images for those maps are not read at all.
+            var compressed = graphicsEngine.RenderDevice.DeviceFeatures_TextureCompressionBC;
+            var colorDds = GetCompressedIfExists(compressed, desc.BaseName, CompressedColorMap);
+            var normalDds = GetCompressedIfExists(compressed, desc.BaseName, CompressedNormalMap);
+            var physicalDds = GetCompressedIfExists(compressed, desc.BaseName, GetCompressedPhysicalMap(desc.Reflective));
+            var ambientOcclusionDds = GetCompressedIfExists(compressed, desc.BaseName, CompressedAmbientOcclusionMap);
+            var emissiveDds = GetCompressedIfExists(compressed, desc.BaseName, CompressedEmissiveMap);
+            var noRead = Task.FromResult<byte[]>(null);
+
+            //Start all the reads up front so they are in flight together, decoding happens once they are all in.
+            var colorRead = ReadIfExists(colorDds ?? colorMapPath);
+            var opacityRead = desc.AllowOpacityMapLoad && colorDds == null ? ReadIfExists(opacityFile) : noRead;
+            var normalRead = ReadIfExists(normalDds ?? normalMapPath);
+            var physicalRead = physicalDds != null ? ReadIfExists(physicalDds) : noRead;
+            var roughnessRead = physicalDds == null ? ReadIfExists(roughnessMapPath) : noRead;
+            var metalnessRead = physicalDds == null ? ReadIfExists(metalnessMapPath) : noRead;
+            var ambientOcclusionRead = ReadIfExists(ambientOcclusionDds ?? ambientOcclusionMapPath);
+            var emissiveRead = ReadIfExists(emissiveDds ?? emissiveMapPath);
+            await Task.WhenAll(colorRead, opacityRead, normalRead, physicalRead, roughnessRead, metalnessRead, ambientOcclusionRead, emissiveRead);
+
             await Task.Run(() =>
             {
-                if (resourceProvider.fileExists(colorMapPath))
+                if (colorDds != null && colorRead.Result != null)
+                {
+                    var dds = DdsFile.Read(colorRead.Result);
+                    //The tool marks the alpha as straight when it baked an opacity map in
+                    bool hasOpacity = desc.AllowOpacityMapLoad && dds.AlphaMode == DdsAlphaMode.Straight;
+                    var baseColorMap = textureLoader.CreateTextureFromDds(dds, desc.MipLevels, "baseColorMap from cc0", RESOURCE_DIMENSION.RESOURCE_DIM_TEX_2D);
+                    result.SetBaseColorMap(baseColorMap, hasOpacity, desc.Reflective);
+                    Barriers.Add(new StateTransitionDesc { pResource = baseColorMap.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_SHADER_RESOURCE, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
+                }
+                else if (colorRead.Result != null)
                 {
-                    using (var stream = resourceProvider.openFile(colorMapPath))
+                    using (var stream = new MemoryStream(colorRead.Result))
                     {
                         using var bmp = FreeImageBitmap.FromStream(stream);
                         bool hasOpacity = false;
-                        if (desc.AllowOpacityMapLoad && resourceProvider.exists(opacityFile))
+                        if (opacityRead.Result != null)
                         {
                             //Jam opacity map into color alpha channel if it exists
                             bmp.ConvertColorDepth(FREE_IMAGE_COLOR_DEPTH.FICD_32_BPP);
-                            using var opacityStream = resourceProvider.openFile(opacityFile);
+                            using var opacityStream = new MemoryStream(opacityRead.Result);
                             using var opacityBmp = FreeImageBitmap.FromStream(opacityStream);
                             opacityBmp.ConvertColorDepth(FREE_IMAGE_COLOR_DEPTH.FICD_08_BPP);
                             bmp.SetChannel(opacityBmp, FREE_IMAGE_COLOR_CHANNEL.FICC_ALPHA);
                             hasOpacity = true;
                         }
-                        var baseColorMap = textureLoader.CreateTextureFromImage(bmp, desc.MipLevels, "baseColorMap from cc0", RESOURCE_DIMENSION.RESOURCE_DIM_TEX_2D, true);
+                        var baseColorMap = CreateTextureFromImage(bmp, desc.MipLevels, "baseColorMap from cc0", true, mipGenerator.ColorFilter, Barriers);
                         result.SetBaseColorMap(baseColorMap, hasOpacity, desc.Reflective);
-                        Barriers.Add(new StateTransitionDesc { pResource = baseColorMap.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_SHADER_RESOURCE, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
                     }
                 }
 
-                if (resourceProvider.fileExists(normalMapPath))
+                if (normalDds != null && normalRead.Result != null)
                 {
-                    using (var stream = resourceProvider.openFile(normalMapPath))
+                    var normalMap = textureLoader.CreateTextureFromDds(DdsFile.Read(normalRead.Result), desc.MipLevels, "normalTexture from cc0", RESOURCE_DIMENSION.RESOURCE_DIM_TEX_2D);
+                    result.SetNormalMap(normalMap);
+                    Barriers.Add(new StateTransitionDesc { pResource = normalMap.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_SHADER_RESOURCE, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
+                }
+                else if (normalRead.Result != null)
+                {
+                    using (var stream = new MemoryStream(normalRead.Result))
                     {
                         using var map = FreeImageBitmap.FromStream(stream);
 
-                        var normalMap = textureLoader.CreateTextureFromImage(map, desc.MipLevels, "normalTexture from cc0", RESOURCE_DIMENSION.RESOURCE_DIM_TEX_2D, false);
+                        var normalMap = CreateTextureFromImage(map, desc.MipLevels, "normalTexture from cc0", false, MipFilter.Normal, Barriers);
                         result.SetNormalMap(normalMap);
-                        Barriers.Add(new StateTransitionDesc { pResource = normalMap.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_SHADER_RESOURCE, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
                     }
                 }
 
+                if (physicalDds != null && physicalRead.Result != null)
+                {
+                    var physicalDescriptorMap = textureLoader.CreateTextureFromDds(DdsFile.Read(physicalRead.Result), desc.MipLevels, "physicalDescriptorMap", RESOURCE_DIMENSION.RESOURCE_DIM_TEX_2D);
+                    result.SetPhysicalDescriptorMap(physicalDescriptorMap);
+                    Barriers.Add(new StateTransitionDesc { pResource = physicalDescriptorMap.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_SHADER_RESOURCE, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
+                }
+                else
                 {
                     FreeImageBitmap roughnessBmp = null;
                     FreeImageBitmap metalnessBmp = null;
                     try
                     {
-                        if (resourceProvider.fileExists(roughnessMapPath))
+                        if (roughnessRead.Result != null)
                         {
-                            using var stream = resourceProvider.openFile(roughnessMapPath);
+                            using var stream = new MemoryStream(roughnessRead.Result);
                             roughnessBmp = FreeImageBitmap.FromStream(stream);
                         }
 
-                        if (resourceProvider.fileExists(metalnessMapPath))
+                        if (metalnessRead.Result != null)
                         {
-                            using var stream = resourceProvider.openFile(metalnessMapPath);
+                            using var stream = new MemoryStream(metalnessRead.Result);
                             metalnessBmp = FreeImageBitmap.FromStream(stream);
                         }
 
@@ -146,9 +210,9 @@ namespace DiligentEngine.RT.Resources
                                 physicalDescriptorBmp.SetChannel(roughnessBmp, FREE_IMAGE_COLOR_CHANNEL.FICC_GREEN);
                             }
 
-                            var physicalDescriptorMap = textureLoader.CreateTextureFromImage(physicalDescriptorBmp, desc.MipLevels, "physicalDescriptorMap", RESOURCE_DIMENSION.RESOURCE_DIM_TEX_2D, false);
+                            //Keep the roughest value in the lower mips so rough surfaces don't turn shiny in the distance
+                            var physicalDescriptorMap = CreateTextureFromImage(physicalDescriptorBmp, desc.MipLevels, "physicalDescriptorMap", false, MipFilter.RoughnessMax, Barriers);
                             result.SetPhysicalDescriptorMap(physicalDescriptorMap);
-                            Barriers.Add(new StateTransitionDesc { pResource = physicalDescriptorMap.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_SHADER_RESOURCE, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
                         }
                     }
                     finally
@@ -159,23 +223,35 @@ namespace DiligentEngine.RT.Resources
 
                 }
 
-                if (resourceProvider.fileExists(ambientOcclusionMapPath))
+                if (ambientOcclusionDds != null && ambientOcclusionRead.Result != null)
+                {
+                    var map = textureLoader.CreateTextureFromDds(DdsFile.Read(ambientOcclusionRead.Result), 0, "ambientOcclusionMap", RESOURCE_DIMENSION.RESOURCE_DIM_TEX_2D);
+                    result.SetAmbientOcclusionMap(map);
+                    Barriers.Add(new StateTransitionDesc { pResource = map.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_SHADER_RESOURCE, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
+                }
+                else if (ambientOcclusionRead.Result != null)
                 {
-                    using (var stream = resourceProvider.openFile(ambientOcclusionMapPath))
+                    using (var stream = new MemoryStream(ambientOcclusionRead.Result))
                     {
-                        var map = textureLoader.LoadTexture(stream, "ambientOcclusionMap", RESOURCE_DIMENSION.RESOURCE_DIM_TEX_2D, false);
+                        using var bmp = FreeImageBitmap.FromStream(stream);
+                        var map = CreateTextureFromImage(bmp, 0, "ambientOcclusionMap", false, MipFilter.Box, Barriers);
                         result.SetAmbientOcclusionMap(map);
-                        Barriers.Add(new StateTransitionDesc { pResource = map.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_SHADER_RESOURCE, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
                     }
                 }
 
-                if (resourceProvider.fileExists(emissiveMapPath))
+                if (emissiveDds != null && emissiveRead.Result != null)
+                {
+                    var map = textureLoader.CreateTextureFromDds(DdsFile.Read(emissiveRead.Result), 0, "emissiveMap", RESOURCE_DIMENSION.RESOURCE_DIM_TEX_2D);
+                    result.SetEmissiveMap(map);
+                    Barriers.Add(new StateTransitionDesc { pResource = map.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_SHADER_RESOURCE, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
+                }
+                else if (emissiveRead.Result != null)
                 {
-                    using (var stream = resourceProvider.openFile(emissiveMapPath))
+                    using (var stream = new MemoryStream(emissiveRead.Result))
                     {
-                        var map = textureLoader.LoadTexture(stream, "emissiveMap", RESOURCE_DIMENSION.RESOURCE_DIM_TEX_2D, false);
+                        using var bmp = FreeImageBitmap.FromStream(stream);
+                        var map = CreateTextureFromImage(bmp, 0, "emissiveMap", false, mipGenerator.ColorFilter, Barriers);
                         result.SetEmissiveMap(map);
-                        Barriers.Add(new StateTransitionDesc { pResource = map.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_SHADER_RESOURCE, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
                     }
                 }
             });
@@ -184,5 +260,66 @@ namespace DiligentEngine.RT.Resources
 
             return result;
         }
+
+        /// <summary>
+        /// Create a texture from an image. If the MipGenerator is on only mip 0 is uploaded and the rest are
+        /// made on the gpu with filter, otherwise the cpu makes them with the matching MipFilters function. The
+        /// generator moves its textures to be read once their mips are written, so a barrier is only added for
+        /// textures with cpu mips.
+        /// </summary>
+        private AutoPtr<ITexture> CreateTextureFromImage(FreeImageBitmap bmp, int mipLevels, String name, bool isSRGB, MipFilter filter, List<StateTransitionDesc> barriers)
+        {
+            if (mipGenerator.Enabled)
+            {
+                var source = textureLoader.CreateTextureFromImage(bmp, 1, $"{name} mip 0", RESOURCE_DIMENSION.RESOURCE_DIM_TEX_2D, isSRGB);
+                return mipGenerator.CreateMipChain(source, mipLevels, isSRGB, filter, name);
+            }
+
+            var texture = textureLoader.CreateTextureFromImage(bmp, mipLevels, name, RESOURCE_DIMENSION.RESOURCE_DIM_TEX_2D, isSRGB, GetCpuMipFilter(filter));
+            barriers.Add(new StateTransitionDesc { pResource = texture.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_SHADER_RESOURCE, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
+            return texture;
+        }
+
+        /// <summary>
+        /// The cpu version of a mip filter. Kaiser only runs on the gpu, FreeImage rescales those mips instead.
+        /// </summary>
+        private static MipFilters.Filter GetCpuMipFilter(MipFilter filter)
+        {
+            switch (filter)
+            {
+                case MipFilter.Box:
+                    return MipFilters.Box;
+                case MipFilter.Normal:
+                    return MipFilters.Normal;
+                case MipFilter.RoughnessMax:
+                    return MipFilters.RoughnessMax;
+                case MipFilter.RoughnessMin:
+                    return MipFilters.RoughnessMin;
+                default:
+                    return null;
+            }
+        }
+
+        private String GetCompressedIfExists(bool compressed, String baseName, String map)
+        {
+            if (compressed)
+            {
+                var file = GetCompressedPath(baseName, map);
+                if (resourceProvider.fileExists(file))
+                {
+                    return file;
+                }
+            }
+            return null;
+        }
+
+        private Task<byte[]> ReadIfExists(String file)
+        {
+            if (resourceProvider.fileExists(file))
+            {
+                return resourceProvider.readAllBytesAsync(file);
+            }
+            return Task.FromResult<byte[]>(null);
+        }
     }
 }
@@ -0,0 +1,402 @@
+﻿using Engine;
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Runtime.InteropServices;
+using System.Text;
+using System.Threading.Tasks;
+
+namespace DiligentEngine.RT.Resources
+{
+    /// <summary>
+    /// How the texels of a mip are made from the one above it.
+    /// </summary>
+    public enum MipFilter
+    {
+        /// <summary>
+        /// Average the 2x2 texels above.
+        /// </summary>
+        Box = 0,
+        /// <summary>
+        /// A kaiser windowed sinc over 8x8 texels. Keeps more detail than box, use it for color.
+        /// </summary>
+        Kaiser = 1,
+        /// <summary>
+        /// Average the 2x2 normals above and renormalize them.
+        /// </summary>
+        Normal = 2,
+        /// <summary>
+        /// Box, but green keeps the roughest of the 4 texels. This is for the physical descriptor map.
+        /// </summary>
+        RoughnessMax = 3,
+        /// <summary>
+        /// Box, but green keeps the smoothest of the 4 texels. This is for the physical descriptor map.
+        /// </summary>
+        RoughnessMin = 4,
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 0)]
+    struct MipConstants
+    {
+        public int InputWidth;
+        public int InputHeight;
+        public int OutputWidth;
+        public int OutputHeight;
+
+        public int Filter;
+        public int IsSRGB;
+        public int CopyInput;
+        public int padding0;
+
+        public Vector4 KaiserWeights;
+    }
+
+    /// <summary>
+    /// Builds the mip chain of a texture on the gpu. Loaders upload only mip 0 and CreateMipChain makes
+    /// the full texture, which is filled in by compute passes at the start of the next frame. This is
+    /// much cheaper than scaling every mip on the cpu and lets normal maps be renormalized.
+    /// </summary>
+    public class MipGenerator : IDisposable
+    {
+        const uint ThreadGroupSize = 8;
+        const float KaiserAlpha = 4.0f;
+
+        class MipJob : IDisposable
+        {
+            public AutoPtr<ITexture> Source;
+            public AutoPtr<ITexture> Target;
+            public uint Width;
+            public uint Height;
+            public uint MipLevels;
+            public bool IsSRGB;
+            public MipFilter Filter;
+
+            public void Dispose()
+            {
+                Source.Dispose();
+                Target.Dispose();
+            }
+        }
+
+        private readonly GraphicsEngine graphicsEngine;
+        private readonly RTOptions options;
+
+        private AutoPtr<IPipelineState> mipPSO;
+        private AutoPtr<IShaderResourceBinding> mipSRB;
+        private AutoPtr<IBuffer> mipCB;
+        private IShaderResourceVariable inputVariable;
+        private IShaderResourceVariable outputVariable;
+        private Vector4 kaiserWeights;
+
+        //Jobs are added from loading threads, the render thread swaps the lists to take them
+        private readonly Object jobLock = new Object();
+        private List<MipJob> pendingJobs = new List<MipJob>();
+        private List<MipJob> processingJobs = new List<MipJob>();
+        private readonly List<StateTransitionDesc> barriers = new List<StateTransitionDesc>(4);
+
+        public MipGenerator(GraphicsEngine graphicsEngine, ShaderLoader<RTShaders> shaderLoader, ShaderCache shaderCache, RTOptions options)
+        {
+            this.graphicsEngine = graphicsEngine;
+            this.options = options;
+            if (!options.GpuMipGeneration)
+            {
+                return;
+            }
+
+            var m_pDevice = graphicsEngine.RenderDevice;
+
+            ShaderCreateInfo ShaderCI = new ShaderCreateInfo();
+            ShaderCI.UseCombinedTextureSamplers = false;
+            ShaderCI.ShaderCompiler = SHADER_COMPILER.SHADER_COMPILER_DXC;
+            ShaderCI.HLSLVersion = new ShaderVersion { Major = 6, Minor = 5 };
+            ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE.SHADER_SOURCE_LANGUAGE_HLSL;
+
+            ShaderCI.Desc.ShaderType = SHADER_TYPE.SHADER_TYPE_COMPUTE;
+            ShaderCI.Desc.Name = "Mip generation CS";
+            ShaderCI.Source = shaderLoader.LoadShader("assets/MipGeneration.csh");
+            ShaderCI.EntryPoint = "main";
+            using var pCS = shaderCache.CreateShader(ShaderCI)
+                ?? throw new InvalidOperationException($"Could not create '{ShaderCI.Desc.Name}'");
+
+            var PSOCreateInfo = new ComputePipelineStateCreateInfo();
+            PSOCreateInfo.PSODesc.Name = "Mip generation PSO";
+            PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE.PIPELINE_TYPE_COMPUTE;
+            //The input and output change for every mip
+            PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE.SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC;
+            PSOCreateInfo.pCS = pCS.Obj;
+            PSOCreateInfo.pPSOCache = shaderCache.PipelineStateCache;
+
+            mipPSO = m_pDevice.CreateComputePipelineState(PSOCreateInfo)
+                ?? throw new InvalidOperationException("Cannot create mip generation pipeline state");
+
+            mipSRB = mipPSO.Obj.CreateShaderResourceBinding(true)
+                ?? throw new InvalidOperationException("Cannot create mip generation shader resource binding");
+
+            unsafe
+            {
+                var BuffDesc = new BufferDesc();
+                BuffDesc.Name = "Mip generation constant buffer";
+                BuffDesc.Usage = USAGE.USAGE_DEFAULT;
+                BuffDesc.BindFlags = BIND_FLAGS.BIND_UNIFORM_BUFFER;
+                BuffDesc.Size = (uint)sizeof(MipConstants);
+                mipCB = m_pDevice.CreateBuffer(BuffDesc)
+                    ?? throw new InvalidOperationException("Cannot create mip generation constant buffer");
+            }
+
+            mipSRB.Obj.GetVariableByName(SHADER_TYPE.SHADER_TYPE_COMPUTE, "g_MipCB").Set(mipCB.Obj);
+            inputVariable = mipSRB.Obj.GetVariableByName(SHADER_TYPE.SHADER_TYPE_COMPUTE, "g_Input");
+            outputVariable = mipSRB.Obj.GetVariableByName(SHADER_TYPE.SHADER_TYPE_COMPUTE, "g_Output");
+
+            kaiserWeights = ComputeKaiserWeights();
+        }
+
+        public void Dispose()
+        {
+            foreach (var job in pendingJobs.Concat(processingJobs))
+            {
+                job.Dispose();
+            }
+            pendingJobs.Clear();
+            processingJobs.Clear();
+            mipCB?.Dispose();
+            mipSRB?.Dispose();
+            mipPSO?.Dispose();
+        }
+
+        /// <summary>
+        /// True if RTOptions.GpuMipGeneration was set. If this is false loaders should make their mips on the cpu.
+        /// </summary>
+        public bool Enabled => mipPSO != null;
+
+        /// <summary>
+        /// The filter to use for color textures.
+        /// </summary>
+        public MipFilter ColorFilter => options.ColorMipFilter;
+
+        /// <summary>
+        /// Create a texture with a full mip chain from a texture that only has mip 0, which can be any 8
+        /// bit rgba or bgra format. This takes ownership of source and releases it once the mips are
+        /// written. The texture can be bound right away, the mips are written before the next frame traces
+        /// rays. If MipLevels is more than 0 the chain stops after that many mips.
+        /// </summary>
+        public AutoPtr<ITexture> CreateMipChain(AutoPtr<ITexture> source, int MipLevels, bool isSRGB, MipFilter filter, String name)
+        {
+            var sourceDesc = new TextureDescPassStruct();
+            source.Obj.GetDesc(ref sourceDesc);
+
+            var mipLevels = ComputeMipLevelsCount(Math.Max(sourceDesc.Width, sourceDesc.Height));
+            if (MipLevels > 0)
+            {
+                mipLevels = Math.Min(mipLevels, (uint)MipLevels);
+            }
+
+            TextureDesc TexDesc = new TextureDesc();
+            TexDesc.Name = name;
+            TexDesc.Type = RESOURCE_DIMENSION.RESOURCE_DIM_TEX_2D;
+            TexDesc.Width = sourceDesc.Width;
+            TexDesc.Height = sourceDesc.Height;
+            TexDesc.MipLevels = mipLevels;
+            TexDesc.Usage = USAGE.USAGE_DEFAULT;
+            //Rgba since bgra can't always be written from a shader. Generate mips makes the texture writable
+            //with a linear view even if it is srgb, it needs to be a render target to be allowed.
+            TexDesc.Format = isSRGB ? TEXTURE_FORMAT.TEX_FORMAT_RGBA8_UNORM_SRGB : TEXTURE_FORMAT.TEX_FORMAT_RGBA8_UNORM;
+            TexDesc.BindFlags = BIND_FLAGS.BIND_SHADER_RESOURCE | BIND_FLAGS.BIND_UNORDERED_ACCESS | BIND_FLAGS.BIND_RENDER_TARGET;
+            TexDesc.MiscFlags = MISC_TEXTURE_FLAGS.MISC_TEXTURE_FLAG_GENERATE_MIPS;
+            TexDesc.CPUAccessFlags = CPU_ACCESS_FLAGS.CPU_ACCESS_NONE;
+
+            var target = graphicsEngine.RenderDevice.CreateTexture(TexDesc, null);
+            if (target == null)
+            {
+                source.Dispose();
+                return null;
+            }
+
+            var job = new MipJob
+            {
+                Source = source,
+                Target = new AutoPtr<ITexture>(target.Obj), //The job keeps its own reference in case the texture is released before it runs
+                Width = sourceDesc.Width,
+                Height = sourceDesc.Height,
+                MipLevels = mipLevels,
+                IsSRGB = isSRGB,
+                Filter = filter,
+            };
+
+            lock (jobLock)
+            {
+                pendingJobs.Add(job);
+            }
+
+            return target;
+        }
+
+        /// <summary>
+        /// Take the jobs added so far. Call this before the TextureUploader records its copies, so every
+        /// source texture taken has been staged by the time Process runs.
+        /// </summary>
+        internal void BeginFrame()
+        {
+            lock (jobLock)
+            {
+                var swap = processingJobs;
+                processingJobs = pendingJobs;
+                pendingJobs = swap;
+            }
+        }
+
+        /// <summary>
+        /// Record the passes for the jobs taken by BeginFrame on the immediate context. Call this after
+        /// the TextureUploader records its copies.
+        /// </summary>
+        internal void Process(IDeviceContext immediateContext)
+        {
+            if (processingJobs.Count == 0)
+            {
+                return;
+            }
+
+            immediateContext.SetPipelineState(mipPSO.Obj);
+            foreach (var job in processingJobs)
+            {
+                Generate(immediateContext, job);
+                //Diligent keeps the textures alive until the gpu is done with them
+                job.Dispose();
+            }
+            processingJobs.Clear();
+        }
+
+        private unsafe void Generate(IDeviceContext immediateContext, MipJob job)
+        {
+            var target = job.Target.Obj;
+
+            barriers.Clear();
+            barriers.Add(new StateTransitionDesc { pResource = job.Source.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_SHADER_RESOURCE, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
+            barriers.Add(new StateTransitionDesc { pResource = target, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_UNORDERED_ACCESS, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
+            immediateContext.TransitionResourceStates(barriers);
+
+            var constants = new MipConstants
+            {
+                Filter = (int)job.Filter,
+                IsSRGB = job.IsSRGB ? 1 : 0,
+                KaiserWeights = kaiserWeights,
+            };
+
+            AutoPtr<ITextureView> inputView = null;
+            try
+            {
+                for (uint mip = 0; mip < job.MipLevels; ++mip)
+                {
+                    barriers.Clear();
+                    if (mip == 0)
+                    {
+                        //The first pass copies the uploaded image into mip 0
+                        inputVariable.Set(job.Source.Obj.GetDefaultView(TEXTURE_VIEW_TYPE.TEXTURE_VIEW_SHADER_RESOURCE));
+                        constants.InputWidth = (int)job.Width;
+                        constants.InputHeight = (int)job.Height;
+                        constants.CopyInput = 1;
+                    }
+                    else
+                    {
+                        //Only the mip above is moved to be read. Updating the state of part of a texture makes its
+                        //state unknown, so the old state is always given from here on.
+                        barriers.Add(new StateTransitionDesc { pResource = target, FirstMipLevel = mip - 1, MipLevelsCount = 1, OldState = RESOURCE_STATE.RESOURCE_STATE_UNORDERED_ACCESS, NewState = RESOURCE_STATE.RESOURCE_STATE_SHADER_RESOURCE, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
+
+                        inputView?.Dispose();
+                        inputView = target.CreateView(new TextureViewDesc
+                        {
+                            Name = "Mip generation input",
+                            ViewType = TEXTURE_VIEW_TYPE.TEXTURE_VIEW_SHADER_RESOURCE,
+                            MostDetailedMip = mip - 1,
+                            NumMipLevels = 1,
+                        });
+                        inputVariable.Set(inputView.Obj);
+                        constants.InputWidth = constants.OutputWidth;
+                        constants.InputHeight = constants.OutputHeight;
+                        constants.CopyInput = 0;
+                    }
+
+                    constants.OutputWidth = (int)Math.Max(job.Width >> (int)mip, 1u);
+                    constants.OutputHeight = (int)Math.Max(job.Height >> (int)mip, 1u);
+
+                    using var outputView = target.CreateView(new TextureViewDesc
+                    {
+                        Name = "Mip generation output",
+                        ViewType = TEXTURE_VIEW_TYPE.TEXTURE_VIEW_UNORDERED_ACCESS,
+                        //Srgb can't be written, the shader encodes it instead
+                        Format = TEXTURE_FORMAT.TEX_FORMAT_RGBA8_UNORM,
+                        MostDetailedMip = mip,
+                        NumMipLevels = 1,
+                        AccessFlags = UAV_ACCESS_FLAG.UAV_ACCESS_FLAG_WRITE,
+                    });
+                    outputVariable.Set(outputView.Obj);
+
+                    immediateContext.UpdateBuffer(mipCB.Obj, 0, (uint)sizeof(MipConstants), new IntPtr(&constants), RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+                    barriers.Add(new StateTransitionDesc { pResource = mipCB.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_CONSTANT_BUFFER, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
+                    immediateContext.TransitionResourceStates(barriers);
+
+                    //The states are handled here since one texture is read and written in different mips
+                    immediateContext.CommitShaderResources(mipSRB.Obj, RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_NONE);
+
+                    var Attribs = new DispatchComputeAttribs();
+                    Attribs.ThreadGroupCountX = ((uint)constants.OutputWidth + ThreadGroupSize - 1) / ThreadGroupSize;
+                    Attribs.ThreadGroupCountY = ((uint)constants.OutputHeight + ThreadGroupSize - 1) / ThreadGroupSize;
+                    immediateContext.DispatchCompute(Attribs);
+                }
+            }
+            finally
+            {
+                inputView?.Dispose();
+            }
+
+            //Move the last mip over, then set the state for the whole texture now that every mip matches
+            barriers.Clear();
+            barriers.Add(new StateTransitionDesc { pResource = target, FirstMipLevel = job.MipLevels - 1, MipLevelsCount = 1, OldState = RESOURCE_STATE.RESOURCE_STATE_UNORDERED_ACCESS, NewState = RESOURCE_STATE.RESOURCE_STATE_SHADER_RESOURCE, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
+            barriers.Add(new StateTransitionDesc { pResource = target, OldState = RESOURCE_STATE.RESOURCE_STATE_SHADER_RESOURCE, NewState = RESOURCE_STATE.RESOURCE_STATE_SHADER_RESOURCE, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
+            immediateContext.TransitionResourceStates(barriers);
+        }
+
+        /// <summary>
+        /// The weights of the kaiser windowed sinc for the taps 0.5, 1.5, 2.5 and 3.5 input texels from
+        /// the center of an output texel, normalized so both sides add to 1.
+        /// </summary>
+        private static Vector4 ComputeKaiserWeights()
+        {
+            Span<float> weights = stackalloc float[4];
+            float total = 0.0f;
+            for (int i = 0; i < 4; ++i)
+            {
+                //In output texels, the filter reaches 2 output texels to either side
+                var x = (i + 0.5f) * 0.5f;
+                var sinc = MathF.Sin(MathF.PI * x) / (MathF.PI * x);
+                var window = BesselI0(KaiserAlpha * MathF.Sqrt(1.0f - (x / 2.0f) * (x / 2.0f))) / BesselI0(KaiserAlpha);
+                weights[i] = sinc * window;
+                total += weights[i] * 2.0f;
+            }
+            return new Vector4(weights[0] / total, weights[1] / total, weights[2] / total, weights[3] / total);
+        }
+
+        private static float BesselI0(float x)
+        {
+            //Power series, converges quickly for the small values used here
+            float sum = 1.0f;
+            float term = 1.0f;
+            float halfX = x * 0.5f;
+            for (int k = 1; k < 16; ++k)
+            {
+                term *= (halfX / k) * (halfX / k);
+                sum += term;
+            }
+            return sum;
+        }
+
+        private static uint ComputeMipLevelsCount(uint width)
+        {
+            uint mipLevels = 0;
+            while ((width >> (int)mipLevels) > 0)
+            {
+                ++mipLevels;
+            }
+            return mipLevels;
+        }
+    }
+}
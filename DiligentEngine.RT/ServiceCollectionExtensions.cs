@@ -20,6 +20,8 @@ namespace Microsoft.Extensions.DependencyInjection
             var options = new RTOptions();
             configure?.Invoke(options);
 
+            services.AddSingleton<RTOptions>(options);
+
             services.AddSingleton<IResourceProvider<ShaderLoader<RTShaders>>>(s =>
                 new EmbeddedResourceProvider<ShaderLoader<RTShaders>>(Assembly.GetExecutingAssembly(), "DiligentEngine.RT."));
 
@@ -29,6 +31,9 @@ namespace Microsoft.Extensions.DependencyInjection
             services.AddSingleton<SpritePlaneBLAS>();
             services.AddTransient<MeshBLAS>();
             services.AddSingleton<RTCameraAndLight>();
+            services.AddSingleton<LightCulling>();
+            services.AddSingleton<CheckerboardReconstruction>();
+            services.AddSingleton<MipGenerator>();
             services.AddSingleton<RayTracingRenderer>();
             services.AddSingleton<CC0TextureLoader>();
             services.AddSingleton<TextureManager>();
@@ -19,15 +19,13 @@ namespace DiligentEngine.RT.ShaderSets
         private readonly GraphicsEngine graphicsEngine;
         private readonly ShaderLoader shaderLoader;
         private readonly ActiveTextures activeTextures;
-        private readonly RTCameraAndLight cameraAndLight;
         private readonly RayTracingRenderer renderer;
 
-        public GeneralShaders(GraphicsEngine graphicsEngine, ShaderLoader<RTShaders> shaderLoader, ActiveTextures activeTextures, RTCameraAndLight cameraAndLight, RayTracingRenderer renderer, string textureVarName, string textureSetsVarName)
+        public GeneralShaders(GraphicsEngine graphicsEngine, ShaderLoader<RTShaders> shaderLoader, ShaderCache shaderCache, ActiveTextures activeTextures, RayTracingRenderer renderer, RTOptions options, string textureVarName, string textureSetsVarName)
         {
             this.graphicsEngine = graphicsEngine;
             this.shaderLoader = shaderLoader;
             this.activeTextures = activeTextures;
-            this.cameraAndLight = cameraAndLight;
             this.renderer = renderer;
         
             var shaderVars = new Dictionary<string, string>()
@@ -37,11 +35,10 @@ namespace DiligentEngine.RT.ShaderSets
                 { "G_TEXTURESETS", textureSetsVarName },
             };
 
-            var m_pDevice = graphicsEngine.RenderDevice;
-
             // Define shader macros
             ShaderMacroHelper Macros = new ShaderMacroHelper();
-            Macros.AddShaderMacro("NUM_LIGHTS", cameraAndLight.NumLights);
+            Macros.AddShaderMacro("CHECKERBOARD", options.Checkerboard);
+            Macros.AddShaderMacro("ITERATIVE_BOUNCES", options.IterativeBounces);
 
             ShaderCreateInfo ShaderCI = new ShaderCreateInfo();
             // We will not be using combined texture samplers as they
@@ -62,7 +59,7 @@ namespace DiligentEngine.RT.ShaderSets
             ShaderCI.Desc.Name = "Ray tracing RG";
             ShaderCI.Source = shaderLoader.LoadShader("assets/RayTrace.hlsl");
             ShaderCI.EntryPoint = "main";
-            pRayGen = m_pDevice.CreateShader(ShaderCI, Macros)
+            pRayGen = shaderCache.CreateShader(ShaderCI, Macros)
                 ?? throw new InvalidOperationException($"Could not create '{ShaderCI.Desc.Name}'");
 
             // Create miss shaders.
@@ -70,13 +67,13 @@ namespace DiligentEngine.RT.ShaderSets
             ShaderCI.Desc.Name = "Primary ray miss shader";
             ShaderCI.Source = shaderLoader.LoadShader(shaderVars, "assets/PrimaryMiss.hlsl");
             ShaderCI.EntryPoint = "main";
-            pPrimaryMiss = m_pDevice.CreateShader(ShaderCI, Macros)
+            pPrimaryMiss = shaderCache.CreateShader(ShaderCI, Macros)
                 ?? throw new InvalidOperationException($"Could not create '{ShaderCI.Desc.Name}'");
 
             ShaderCI.Desc.Name = "Shadow ray miss shader";
             ShaderCI.Source = shaderLoader.LoadShader("assets/ShadowMiss.hlsl");
             ShaderCI.EntryPoint = "main";
-            pShadowMiss = m_pDevice.CreateShader(ShaderCI, Macros)
+            pShadowMiss = shaderCache.CreateShader(ShaderCI, Macros)
                 ?? throw new InvalidOperationException($"Could not create '{ShaderCI.Desc.Name}'");
 
             // Ray generation shader is an entry point for a ray tracing pipeline.
@@ -2,6 +2,7 @@
 using Engine;
 using System;
 using System.Collections.Generic;
+using System.Text;
 using System.Threading.Tasks;
 
 namespace DiligentEngine.RT.ShaderSets
@@ -23,26 +24,29 @@ namespace DiligentEngine.RT.ShaderSets
             private readonly GraphicsEngine graphicsEngine;
             private readonly ShaderLoader<RTShaders> shaderLoader;
             private readonly RayTracingRenderer rayTracingRenderer;
-            private readonly RTCameraAndLight cameraAndLight;
             private readonly BLASBuilder blasBuilder;
             private readonly ActiveTextures activeTextures;
+            private readonly ShaderCache shaderCache;
+            private readonly RTOptions options;
 
             public Factory
             (
                 GraphicsEngine graphicsEngine,
                 ShaderLoader<RTShaders> shaderLoader,
                 RayTracingRenderer rayTracingRenderer,
-                RTCameraAndLight cameraAndLight,
                 BLASBuilder blasBuilder,
-                ActiveTextures activeTextures
+                ActiveTextures activeTextures,
+                ShaderCache shaderCache,
+                RTOptions options
             )
             {
                 this.graphicsEngine = graphicsEngine;
                 this.shaderLoader = shaderLoader;
                 this.rayTracingRenderer = rayTracingRenderer;
-                this.cameraAndLight = cameraAndLight;
                 this.blasBuilder = blasBuilder;
                 this.activeTextures = activeTextures;
+                this.shaderCache = shaderCache;
+                this.options = options;
             }
 
             /// <summary>
@@ -55,8 +59,8 @@ namespace DiligentEngine.RT.ShaderSets
             {
                 return pooledResources.Checkout(key, async () =>
                 {
-                    var shader = new PrimaryHitShader(activeTextures, rayTracingRenderer, blasBuilder);
-                    await shader.SetupShaders(graphicsEngine, shaderLoader, cameraAndLight);
+                    var shader = new PrimaryHitShader(activeTextures, rayTracingRenderer, blasBuilder, options);
+                    await shader.SetupShaders(graphicsEngine, shaderLoader, shaderCache);
                     return pooledResources.CreateResult(shader);
                 });
             }
@@ -91,137 +95,286 @@ namespace DiligentEngine.RT.ShaderSets
 
         private String primaryShaderGroupName;
         private String shadowShaderGroupName;
+        private uint primaryShaderGroupNameId;
+        private uint shadowShaderGroupNameId;
         private RayTracingTriangleHitShaderGroup primaryHitShaderGroup;
         private RayTracingTriangleHitShaderGroup shadowHitShaderGroup;
 
         private GeneralShaders generalShaders;
 
-        public PrimaryHitShader(ActiveTextures activeTextures, RayTracingRenderer renderer, BLASBuilder builder)
+        private class SpecializedHitGroup : IDisposable
+        {
+            public uint DispatchType;
+            public AutoPtr<IShader> ClosestHit;
+            public uint NameId;
+            public RayTracingTriangleHitShaderGroup HitGroup;
+
+            public void Dispose()
+            {
+                ClosestHit.Dispose();
+                NameTable.Release(NameId);
+            }
+        }
+
+        //The dispatch types used by any run, these are created with the rest of the shaders at startup
+        private const String PermutationsFile = "PrimaryHitPermutations";
+
+        private readonly RTOptions options;
+        private ShaderCache shaderCache;
+        private ShaderLoader<RTShaders> shaderLoader;
+        private GraphicsEngine graphicsEngine;
+        private String shaderId;
+        private int shaderSlot = -1;
+        private String primaryHitSource;
+        private bool disposed;
+
+        //Hit groups in the current pipeline by dispatch type, pending ones are added when the pipeline is next created
+        private readonly Dictionary<uint, SpecializedHitGroup> specializedHitGroups = new Dictionary<uint, SpecializedHitGroup>();
+        private readonly List<SpecializedHitGroup> pendingHitGroups = new List<SpecializedHitGroup>();
+        private readonly HashSet<uint> requestedDispatchTypes = new HashSet<uint>();
+
+        public PrimaryHitShader(ActiveTextures activeTextures, RayTracingRenderer renderer, BLASBuilder builder, RTOptions options)
         {
             this.builder = builder;
             this.renderer = renderer;
             this.activeTextures = activeTextures;
+            this.options = options;
         }
 
-        private async Task SetupShaders(GraphicsEngine graphicsEngine, ShaderLoader<RTShaders> shaderLoader, RTCameraAndLight cameraAndLight)
+        //The slots of the live shaders, the names only have to be unique between these
+        private static readonly List<bool> usedShaderSlots = new List<bool>();
+
+        /// <summary>
+        /// Take the lowest slot no live shader is using. A new shader gets the same slot and so the same
+        /// names and shader source as the one before it, which keeps the shader cache hitting and bounds
+        /// the number of variations it can hold.
+        /// </summary>
+        private static int TakeShaderSlot()
         {
-            var id = RTId.CreateId("PrimaryHitShaderVariable").Replace("-", "");
+            lock (usedShaderSlots)
+            {
+                var slot = usedShaderSlots.IndexOf(false);
+                if (slot == -1)
+                {
+                    slot = usedShaderSlots.Count;
+                    usedShaderSlots.Add(true);
+                }
+                else
+                {
+                    usedShaderSlots[slot] = true;
+                }
+                return slot;
+            }
+        }
+
+        private static void ReturnShaderSlot(int slot)
+        {
+            lock (usedShaderSlots)
+            {
+                usedShaderSlots[slot] = false;
+            }
+        }
+
+        private async Task SetupShaders(GraphicsEngine graphicsEngine, ShaderLoader<RTShaders> shaderLoader, ShaderCache shaderCache)
+        {
+            shaderSlot = TakeShaderSlot();
+            var id = shaderSlot.ToString();
+            this.shaderId = id;
+            this.shaderCache = shaderCache;
+            this.shaderLoader = shaderLoader;
+            this.graphicsEngine = graphicsEngine;
 
             TextureVarName = TextureVarName + id;
             TextureSetsVarName = TextureSetsVarName + id;
             VerticesVarName = VerticesVarName + id;
             IndicesVarName = IndicesVarName + id;
 
-            generalShaders = new GeneralShaders(graphicsEngine, shaderLoader, activeTextures, cameraAndLight, renderer, TextureVarName, TextureSetsVarName);
+            generalShaders = new GeneralShaders(graphicsEngine, shaderLoader, shaderCache, activeTextures, renderer, options, TextureVarName, TextureSetsVarName);
 
             this.numTextures = activeTextures.MaxTextures;
 
             await Task.Run(() =>
             {
-                this.primaryShaderGroupName = $"{Guid.NewGuid()}PrimaryHit";
-                this.shadowShaderGroupName = $"{Guid.NewGuid()}ShadowHit";
+                this.primaryShaderGroupName = $"PrimaryHit{id}";
+                this.shadowShaderGroupName = $"ShadowHit{id}";
+                this.primaryShaderGroupNameId = NameTable.Register(primaryShaderGroupName);
+                this.shadowShaderGroupNameId = NameTable.Register(shadowShaderGroupName);
 
-                var m_pDevice = graphicsEngine.RenderDevice;
-
-                // Define shader macros
-                ShaderMacroHelper Macros = new ShaderMacroHelper();
-                Macros.AddShaderMacro("NUM_LIGHTS", cameraAndLight.NumLights);
-                Macros.AddShaderMacro("MAX_DISPERS_SAMPLES", 16);
-
-                ShaderCreateInfo ShaderCI = new ShaderCreateInfo();
-                // We will not be using combined texture samplers as they
-                // are only required for compatibility with OpenGL, and ray
-                // tracing is not supported in OpenGL backend.
-                ShaderCI.UseCombinedTextureSamplers = false;
-
-                // Only new DXC compiler can compile HLSL ray tracing shaders.
-                ShaderCI.ShaderCompiler = SHADER_COMPILER.SHADER_COMPILER_DXC;
-
-                // Shader model 6.3 is required for DXR 1.0, shader model 6.5 is required for DXR 1.1 and enables additional features.
-                // Use 6.3 for compatibility with DXR 1.0 and VK_NV_ray_tracing.
-                ShaderCI.HLSLVersion = new ShaderVersion { Major = 6, Minor = 5 };
-                ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE.SHADER_SOURCE_LANGUAGE_HLSL;
-
-                var shaderVars = new Dictionary<string, string>()
-                {
-                    { "NUM_TEXTURES", numTextures.ToString() },
-                    { "G_TEXTURES", TextureVarName },
-                    { "G_TEXTURESETS", TextureSetsVarName },
-                    { "G_VERTICES", VerticesVarName },
-                    { "G_INDICES", IndicesVarName },
-                    { "MESH_DATA_TYPE", HLSL.BlasInstanceDataConstants.MeshData.ToString() },
-                    { "SPRITE_DATA_TYPE", HLSL.BlasInstanceDataConstants.SpriteData.ToString() },
-                    { "LIGHTANDSHADEBASE", HLSL.BlasInstanceDataConstants.LightAndShadeBase.ToString() },
-                    { "LIGHTANDSHADEBASEEMISSIVE", HLSL.BlasInstanceDataConstants.LightAndShadeBaseEmissive.ToString() },
-                    { "LIGHTANDSHADEBASENORMAL", HLSL.BlasInstanceDataConstants.LightAndShadeBaseNormal.ToString() },
-                    { "LIGHTANDSHADEBASENORMALEMISSIVE", HLSL.BlasInstanceDataConstants.LightAndShadeBaseNormalEmissive.ToString() },
-                    { "LIGHTANDSHADEBASENORMALPHYSICAL", HLSL.BlasInstanceDataConstants.LightAndShadeBaseNormalPhysical.ToString() },
-                    { "LIGHTANDSHADEBASENORMALPHYSICALEMISSIVE", HLSL.BlasInstanceDataConstants.LightAndShadeBaseNormalPhysicalEmissive.ToString() },
-                    { "LIGHTANDSHADEBASENORMALPHYSICALREFLECTIVE", HLSL.BlasInstanceDataConstants.LightAndShadeBaseNormalPhysicalReflective.ToString() },
-                    { "LIGHTANDSHADEBASENORMALPHYSICALREFLECTIVEEMISSIVE", HLSL.BlasInstanceDataConstants.LightAndShadeBaseNormalPhysicalReflectiveEmissive.ToString() },
-                    { "GLASSMATERIAL", HLSL.BlasInstanceDataConstants.Glass.ToString() },
-                    { "WATERMATERIAL", HLSL.BlasInstanceDataConstants.Water.ToString() },
-                };
-
-                // Create closest hit shaders.
-                ShaderCI.Desc.ShaderType = SHADER_TYPE.SHADER_TYPE_RAY_CLOSEST_HIT;
-                ShaderCI.Desc.Name = $"primary ray closest hit shader";
-                ShaderCI.Source = shaderLoader.LoadShader(shaderVars, $"assets/PrimaryHit.hlsl");
-                ShaderCI.EntryPoint = "main";
-                pCubePrimaryHit = m_pDevice.CreateShader(ShaderCI, Macros)
-                  ?? throw new InvalidOperationException($"Could not create '{ShaderCI.Desc.Name}'");
-
-                // Create primary any hit shaders.
-                Macros.AddShaderMacro("PRIMARY_HIT", 1);
-                ShaderCI.Desc.ShaderType = SHADER_TYPE.SHADER_TYPE_RAY_ANY_HIT;
-                ShaderCI.Desc.Name = $"primary ray any hit shader";
-                ShaderCI.Source = shaderLoader.LoadShader(shaderVars, $"assets/AnyHit.hlsl");
-                ShaderCI.EntryPoint = "main";
-                pCubeAnyHit = m_pDevice.CreateShader(ShaderCI, Macros)
-                  ?? throw new InvalidOperationException($"Could not create '{ShaderCI.Desc.Name}'");
-
-                Macros.RemoveMacro("PRIMARY_HIT");
-                Macros.AddShaderMacro("SHADOW_HIT", 1);
-                ShaderCI.Desc.ShaderType = SHADER_TYPE.SHADER_TYPE_RAY_ANY_HIT;
-                ShaderCI.Desc.Name = $"shadow ray any hit shader";
-                ShaderCI.Source = shaderLoader.LoadShader(shaderVars, $"assets/AnyHit.hlsl");
-                ShaderCI.EntryPoint = "main";
-                pShadowAnyHit = m_pDevice.CreateShader(ShaderCI, Macros)
-                  ?? throw new InvalidOperationException($"Could not create '{ShaderCI.Desc.Name}'");
-
-                // Primary ray hit group for the textured cube.
-                primaryHitShaderGroup = new RayTracingTriangleHitShaderGroup { Name = primaryShaderGroupName, pClosestHitShader = pCubePrimaryHit.Obj, pAnyHitShader = pCubeAnyHit.Obj };
-                shadowHitShaderGroup = new RayTracingTriangleHitShaderGroup { Name = shadowShaderGroupName, pClosestHitShader = pCubePrimaryHit.Obj, pAnyHitShader = pShadowAnyHit.Obj };
+                CreateHitShaders();
 
                 //TODO: Remove SHADER_TYPE.SHADER_TYPE_RAY_GEN below, seems you don't need it, but needs testing
                 verticesDesc = new ShaderResourceVariableDesc { ShaderStages = SHADER_TYPE.SHADER_TYPE_RAY_GEN | SHADER_TYPE.SHADER_TYPE_RAY_CLOSEST_HIT | SHADER_TYPE.SHADER_TYPE_RAY_ANY_HIT, Name = VerticesVarName, Type = SHADER_RESOURCE_VARIABLE_TYPE.SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC };
                 indicesDesc = new ShaderResourceVariableDesc { ShaderStages = SHADER_TYPE.SHADER_TYPE_RAY_GEN | SHADER_TYPE.SHADER_TYPE_RAY_CLOSEST_HIT | SHADER_TYPE.SHADER_TYPE_RAY_ANY_HIT, Name = IndicesVarName, Type = SHADER_RESOURCE_VARIABLE_TYPE.SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC };
                 texturesDesc = new ShaderResourceVariableDesc { ShaderStages = SHADER_TYPE.SHADER_TYPE_RAY_GEN | SHADER_TYPE.SHADER_TYPE_RAY_CLOSEST_HIT | SHADER_TYPE.SHADER_TYPE_RAY_ANY_HIT | SHADER_TYPE.SHADER_TYPE_RAY_MISS, Name = TextureVarName, Type = SHADER_RESOURCE_VARIABLE_TYPE.SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC };
                 textureSetsDesc = new ShaderResourceVariableDesc { ShaderStages = SHADER_TYPE.SHADER_TYPE_RAY_GEN | SHADER_TYPE.SHADER_TYPE_RAY_CLOSEST_HIT | SHADER_TYPE.SHADER_TYPE_RAY_ANY_HIT | SHADER_TYPE.SHADER_TYPE_RAY_MISS, Name = TextureSetsVarName, Type = SHADER_RESOURCE_VARIABLE_TYPE.SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC };
+
+                if (options.SpecializeHitGroups)
+                {
+                    foreach (var dispatchType in LoadPermutations())
+                    {
+                        requestedDispatchTypes.Add(dispatchType);
+                        var hitGroup = CreateSpecializedHitGroup(dispatchType, primaryHitSource, pCubeAnyHit.Obj);
+                        if (hitGroup != null)
+                        {
+                            pendingHitGroups.Add(hitGroup);
+                        }
+                    }
+                }
             });
 
             renderer.AddShaderResourceBinder(Bind);
             renderer.AddTlasShaderResourceBinder(BindTlas);
             renderer.OnSetupCreateInfo += Renderer_OnSetupCreateInfo;
+            activeTextures.OnMaxTexturesChanged += ActiveTextures_OnMaxTexturesChanged;
+        }
+
+        /// <summary>
+        /// The texture array grew. Its size is compiled into every shader that reads it, so they are all
+        /// created again at the new size and the pipeline is rebuilt with them before the next frame.
+        /// </summary>
+        private void ActiveTextures_OnMaxTexturesChanged()
+        {
+            numTextures = activeTextures.MaxTextures;
+
+            generalShaders.Dispose();
+            generalShaders = new GeneralShaders(graphicsEngine, shaderLoader, shaderCache, activeTextures, renderer, options, TextureVarName, TextureSetsVarName);
+
+            pShadowAnyHit.Dispose();
+            pCubeAnyHit.Dispose();
+            pCubePrimaryHit.Dispose();
+            CreateHitShaders();
+
+            //The specialized hit groups are made from the primary hit source, so they are replaced too
+            foreach (var hitGroup in specializedHitGroups.Values)
+            {
+                pendingHitGroups.Add(hitGroup);
+            }
+            specializedHitGroups.Clear();
+            var oldHitGroups = pendingHitGroups.ToArray();
+            pendingHitGroups.Clear();
+            foreach (var oldHitGroup in oldHitGroups)
+            {
+                oldHitGroup.Dispose();
+                var hitGroup = CreateSpecializedHitGroup(oldHitGroup.DispatchType, primaryHitSource, pCubeAnyHit.Obj);
+                if (hitGroup != null)
+                {
+                    pendingHitGroups.Add(hitGroup);
+                }
+            }
+
+            renderer.RequestPipelineRebuild();
+        }
+
+        /// <summary>
+        /// Create the hit shaders and their groups for the current size of the texture array.
+        /// </summary>
+        private void CreateHitShaders()
+        {
+            // Define shader macros
+            ShaderMacroHelper Macros = CreateMacros();
+
+            ShaderCreateInfo ShaderCI = CreateShaderCI();
+
+            var shaderVars = new Dictionary<string, string>()
+            {
+                { "NUM_TEXTURES", numTextures.ToString() },
+                { "G_TEXTURES", TextureVarName },
+                { "G_TEXTURESETS", TextureSetsVarName },
+                { "G_VERTICES", VerticesVarName },
+                { "G_INDICES", IndicesVarName },
+                { "MESH_DATA_TYPE", HLSL.BlasInstanceDataConstants.MeshData.ToString() },
+                { "SPRITE_DATA_TYPE", HLSL.BlasInstanceDataConstants.SpriteData.ToString() },
+                { "LIGHTANDSHADEBASE", HLSL.BlasInstanceDataConstants.LightAndShadeBase.ToString() },
+                { "LIGHTANDSHADEBASEEMISSIVE", HLSL.BlasInstanceDataConstants.LightAndShadeBaseEmissive.ToString() },
+                { "LIGHTANDSHADEBASENORMAL", HLSL.BlasInstanceDataConstants.LightAndShadeBaseNormal.ToString() },
+                { "LIGHTANDSHADEBASENORMALEMISSIVE", HLSL.BlasInstanceDataConstants.LightAndShadeBaseNormalEmissive.ToString() },
+                { "LIGHTANDSHADEBASENORMALPHYSICAL", HLSL.BlasInstanceDataConstants.LightAndShadeBaseNormalPhysical.ToString() },
+                { "LIGHTANDSHADEBASENORMALPHYSICALEMISSIVE", HLSL.BlasInstanceDataConstants.LightAndShadeBaseNormalPhysicalEmissive.ToString() },
+                { "LIGHTANDSHADEBASENORMALPHYSICALREFLECTIVE", HLSL.BlasInstanceDataConstants.LightAndShadeBaseNormalPhysicalReflective.ToString() },
+                { "LIGHTANDSHADEBASENORMALPHYSICALREFLECTIVEEMISSIVE", HLSL.BlasInstanceDataConstants.LightAndShadeBaseNormalPhysicalReflectiveEmissive.ToString() },
+                { "GLASSMATERIAL", HLSL.BlasInstanceDataConstants.Glass.ToString() },
+                { "WATERMATERIAL", HLSL.BlasInstanceDataConstants.Water.ToString() },
+            };
+
+            // Create closest hit shaders.
+            ShaderCI.Desc.ShaderType = SHADER_TYPE.SHADER_TYPE_RAY_CLOSEST_HIT;
+            ShaderCI.Desc.Name = $"primary ray closest hit shader";
+            ShaderCI.Source = shaderLoader.LoadShader(shaderVars, $"assets/PrimaryHit.hlsl");
+            ShaderCI.EntryPoint = "main";
+            pCubePrimaryHit = shaderCache.CreateShader(ShaderCI, Macros)
+              ?? throw new InvalidOperationException($"Could not create '{ShaderCI.Desc.Name}'");
+            primaryHitSource = ShaderCI.Source;
+
+            // Create primary any hit shaders.
+            Macros.AddShaderMacro("PRIMARY_HIT", 1);
+            ShaderCI.Desc.ShaderType = SHADER_TYPE.SHADER_TYPE_RAY_ANY_HIT;
+            ShaderCI.Desc.Name = $"primary ray any hit shader";
+            ShaderCI.Source = shaderLoader.LoadShader(shaderVars, $"assets/AnyHit.hlsl");
+            ShaderCI.EntryPoint = "main";
+            pCubeAnyHit = shaderCache.CreateShader(ShaderCI, Macros)
+              ?? throw new InvalidOperationException($"Could not create '{ShaderCI.Desc.Name}'");
+
+            Macros.RemoveMacro("PRIMARY_HIT");
+            Macros.AddShaderMacro("SHADOW_HIT", 1);
+            ShaderCI.Desc.ShaderType = SHADER_TYPE.SHADER_TYPE_RAY_ANY_HIT;
+            ShaderCI.Desc.Name = $"shadow ray any hit shader";
+            ShaderCI.Source = shaderLoader.LoadShader(shaderVars, $"assets/AnyHit.hlsl");
+            ShaderCI.EntryPoint = "main";
+            pShadowAnyHit = shaderCache.CreateShader(ShaderCI, Macros)
+              ?? throw new InvalidOperationException($"Could not create '{ShaderCI.Desc.Name}'");
+
+            // Primary ray hit group for the textured cube.
+            primaryHitShaderGroup = new RayTracingTriangleHitShaderGroup { Name = primaryShaderGroupName, pClosestHitShader = pCubePrimaryHit.Obj, pAnyHitShader = pCubeAnyHit.Obj };
+            shadowHitShaderGroup = new RayTracingTriangleHitShaderGroup { Name = shadowShaderGroupName, pClosestHitShader = pCubePrimaryHit.Obj, pAnyHitShader = pShadowAnyHit.Obj };
         }
 
         public void Dispose()
         {
+            disposed = true;
+            activeTextures.OnMaxTexturesChanged -= ActiveTextures_OnMaxTexturesChanged;
             renderer.OnSetupCreateInfo -= Renderer_OnSetupCreateInfo;
             renderer.RemoveTlasShaderResourceBinder(BindTlas);
             renderer.RemoveShaderResourceBinder(Bind);
 
+            foreach (var hitGroup in specializedHitGroups.Values)
+            {
+                hitGroup.Dispose();
+            }
+            foreach (var hitGroup in pendingHitGroups)
+            {
+                hitGroup.Dispose();
+            }
+
             pShadowAnyHit?.Dispose();
             pCubeAnyHit?.Dispose();
             pCubePrimaryHit?.Dispose();
 
             generalShaders.Dispose();
+
+            NameTable.Release(primaryShaderGroupNameId);
+            NameTable.Release(shadowShaderGroupNameId);
+
+            if (shaderSlot != -1)
+            {
+                ReturnShaderSlot(shaderSlot);
+                shaderSlot = -1;
+            }
         }
 
         private void Renderer_OnSetupCreateInfo(RayTracingPipelineStateCreateInfo PSOCreateInfo)
         {
             PSOCreateInfo.pTriangleHitShaders.Add(primaryHitShaderGroup);
             PSOCreateInfo.pTriangleHitShaders.Add(shadowHitShaderGroup);
+
+            foreach (var hitGroup in pendingHitGroups)
+            {
+                specializedHitGroups[hitGroup.DispatchType] = hitGroup;
+            }
+            pendingHitGroups.Clear();
+            foreach (var hitGroup in specializedHitGroups.Values)
+            {
+                PSOCreateInfo.pTriangleHitShaders.Add(hitGroup.HitGroup);
+            }
             //TODO: Adding this to the triangle hit shaders here assumes the BLAS is already created. This is setup to work ok now, but hopefully this can be unbound later
 
             PSOCreateInfo.PSODesc.ResourceLayout.Variables.Add(verticesDesc);
@@ -236,6 +389,150 @@ namespace DiligentEngine.RT.ShaderSets
             sbt.BindHitGroupForInstance(tlas, instanceName, RtStructures.SHADOW_RAY_INDEX, shadowShaderGroupName, data, size);
         }
 
+        /// <summary>
+        /// Bind the sbt for an instance by index. This is batched with the other bindings for the frame.
+        /// </summary>
+        public void BindSbt(TLASInstanceData instance, IShaderBindingTable sbt, ITopLevelAS tlas, IntPtr data, uint size)
+        {
+            var rtInstances = instance.RTInstances;
+            rtInstances.BindHitGroup(instance, sbt, tlas, RtStructures.PRIMARY_RAY_INDEX, GetPrimaryShaderGroupNameId(data, size), data, size);
+            rtInstances.BindHitGroup(instance, sbt, tlas, RtStructures.SHADOW_RAY_INDEX, shadowShaderGroupNameId, data, size);
+        }
+
+        /// <summary>
+        /// Get the primary hit group for the record's dispatch type. If the type does not have a specialized
+        /// hit group yet one is created in the background and the switching hit group is used until then.
+        /// </summary>
+        private unsafe uint GetPrimaryShaderGroupNameId(IntPtr data, uint size)
+        {
+            if (!options.SpecializeHitGroups || size < sizeof(HLSL.BlasInstanceData))
+            {
+                return primaryShaderGroupNameId;
+            }
+
+            var dispatchType = ((HLSL.BlasInstanceData*)data.ToPointer())->dispatchType;
+            if (specializedHitGroups.TryGetValue(dispatchType, out var hitGroup))
+            {
+                return hitGroup.NameId;
+            }
+
+            if (requestedDispatchTypes.Add(dispatchType))
+            {
+                _ = AddSpecializedHitGroup(dispatchType);
+            }
+
+            return primaryShaderGroupNameId;
+        }
+
+        private async Task AddSpecializedHitGroup(uint dispatchType)
+        {
+            var source = primaryHitSource;
+            var anyHit = pCubeAnyHit.Obj;
+            var hitGroup = await Task.Run(() => CreateSpecializedHitGroup(dispatchType, source, anyHit));
+            if (hitGroup == null)
+            {
+                return;
+            }
+
+            if (disposed)
+            {
+                hitGroup.Dispose();
+                return;
+            }
+
+            if (!ReferenceEquals(source, primaryHitSource))
+            {
+                //The texture array grew while this was compiling, make it again from the new source
+                hitGroup.Dispose();
+                _ = AddSpecializedHitGroup(dispatchType);
+                return;
+            }
+
+            pendingHitGroups.Add(hitGroup);
+            renderer.RequestPipelineRebuild();
+            SavePermutations();
+        }
+
+        private SpecializedHitGroup CreateSpecializedHitGroup(uint dispatchType, String source, IShader anyHit)
+        {
+            ShaderMacroHelper Macros = CreateMacros();
+            Macros.AddShaderMacro("DISPATCH_TYPE", dispatchType);
+
+            ShaderCreateInfo ShaderCI = CreateShaderCI();
+            ShaderCI.Desc.ShaderType = SHADER_TYPE.SHADER_TYPE_RAY_CLOSEST_HIT;
+            ShaderCI.Desc.Name = $"primary ray closest hit shader {dispatchType}";
+            ShaderCI.Source = source;
+            ShaderCI.EntryPoint = "main";
+            var closestHit = shaderCache.CreateShader(ShaderCI, Macros);
+            if (closestHit == null)
+            {
+                //Keep using the switching hit group for this type
+                return null;
+            }
+
+            var name = $"PrimaryHit{shaderId}_{dispatchType}";
+            return new SpecializedHitGroup
+            {
+                DispatchType = dispatchType,
+                ClosestHit = closestHit,
+                NameId = NameTable.Register(name),
+                HitGroup = new RayTracingTriangleHitShaderGroup { Name = name, pClosestHitShader = closestHit.Obj, pAnyHitShader = anyHit },
+            };
+        }
+
+        private IEnumerable<uint> LoadPermutations()
+        {
+            var data = shaderCache.LoadData(PermutationsFile);
+            if (data == null)
+            {
+                yield break;
+            }
+
+            foreach (var line in Encoding.UTF8.GetString(data).Split('\n', StringSplitOptions.RemoveEmptyEntries))
+            {
+                if (uint.TryParse(line, out var dispatchType))
+                {
+                    yield return dispatchType;
+                }
+            }
+        }
+
+        private void SavePermutations()
+        {
+            var permutations = new StringBuilder();
+            foreach (var dispatchType in requestedDispatchTypes)
+            {
+                permutations.Append(dispatchType).Append('\n');
+            }
+            shaderCache.SaveData(PermutationsFile, Encoding.UTF8.GetBytes(permutations.ToString()));
+        }
+
+        private ShaderMacroHelper CreateMacros()
+        {
+            ShaderMacroHelper Macros = new ShaderMacroHelper();
+            Macros.AddShaderMacro("MAX_DISPERS_SAMPLES", 16);
+            Macros.AddShaderMacro("ITERATIVE_BOUNCES", options.IterativeBounces);
+            return Macros;
+        }
+
+        private static ShaderCreateInfo CreateShaderCI()
+        {
+            ShaderCreateInfo ShaderCI = new ShaderCreateInfo();
+            // We will not be using combined texture samplers as they
+            // are only required for compatibility with OpenGL, and ray
+            // tracing is not supported in OpenGL backend.
+            ShaderCI.UseCombinedTextureSamplers = false;
+
+            // Only new DXC compiler can compile HLSL ray tracing shaders.
+            ShaderCI.ShaderCompiler = SHADER_COMPILER.SHADER_COMPILER_DXC;
+
+            // Shader model 6.3 is required for DXR 1.0, shader model 6.5 is required for DXR 1.1 and enables additional features.
+            // Use 6.3 for compatibility with DXR 1.0 and VK_NV_ray_tracing.
+            ShaderCI.HLSLVersion = new ShaderVersion { Major = 6, Minor = 5 };
+            ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE.SHADER_SOURCE_LANGUAGE_HLSL;
+            return ShaderCI;
+        }
+
         private void Bind(IShaderResourceBinding rayTracingSRB)
         {
             if (builder.AttrBuffer != null)
@@ -247,14 +544,7 @@ namespace DiligentEngine.RT.ShaderSets
                 rayTracingSRB.GetVariableByName(SHADER_TYPE.SHADER_TYPE_RAY_ANY_HIT, IndicesVarName)?.Set(builder.IndexBuffer.GetDefaultView(BUFFER_VIEW_TYPE.BUFFER_VIEW_SHADER_RESOURCE));
             }
 
-            activeTextures.UpdateSharedBuffers();
-            rayTracingSRB.GetVariableByName(SHADER_TYPE.SHADER_TYPE_RAY_CLOSEST_HIT, TextureSetsVarName).Set(activeTextures.TexSetBuffer.GetDefaultView(BUFFER_VIEW_TYPE.BUFFER_VIEW_SHADER_RESOURCE));
-            rayTracingSRB.GetVariableByName(SHADER_TYPE.SHADER_TYPE_RAY_ANY_HIT, TextureSetsVarName)?.Set(activeTextures.TexSetBuffer.GetDefaultView(BUFFER_VIEW_TYPE.BUFFER_VIEW_SHADER_RESOURCE));
-            rayTracingSRB.GetVariableByName(SHADER_TYPE.SHADER_TYPE_RAY_MISS, TextureSetsVarName)?.Set(activeTextures.TexSetBuffer.GetDefaultView(BUFFER_VIEW_TYPE.BUFFER_VIEW_SHADER_RESOURCE));
-
-            rayTracingSRB.GetVariableByName(SHADER_TYPE.SHADER_TYPE_RAY_CLOSEST_HIT, TextureVarName)?.SetArray(activeTextures.Textures);
-            rayTracingSRB.GetVariableByName(SHADER_TYPE.SHADER_TYPE_RAY_ANY_HIT, TextureVarName)?.SetArray(activeTextures.Textures);
-            rayTracingSRB.GetVariableByName(SHADER_TYPE.SHADER_TYPE_RAY_MISS, TextureVarName)?.SetArray(activeTextures.Textures);
+            activeTextures.Bind(rayTracingSRB, TextureVarName, TextureSetsVarName);
         }
 
         private void BindTlas(IShaderBindingTable sbt, ITopLevelAS tlas)
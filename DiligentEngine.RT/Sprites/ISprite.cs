@@ -10,11 +10,20 @@ namespace DiligentEngine.RT.Sprites
         Vector3 BaseScale { get; }
         SpriteFrame GetCurrentFrame();
         void SetAnimation(string animationName);
+        void SetAnimation(int animationId);
         void Update(Clock clock);
         void RandomizeFrameTime();
 
         int FrameIndex { get; }
         String CurrentAnimationName { get; }
+        int CurrentAnimationId { get; }
         IReadOnlyDictionary<String, SpriteAnimation> Animations { get; }
+        SpriteAnimationTable AnimationTable { get; }
+
+        /// <summary>
+        /// Set when the current frame changes. The sprite only has to be bound to the sbt again while this is set.
+        /// </summary>
+        bool FrameDirty { get; }
+        void ClearFrameDirty();
     }
 }
\ No newline at end of file
@@ -84,13 +84,15 @@ namespace DiligentEngine.RT.Sprites
             }
         };
 
-        private Dictionary<String, SpriteAnimation> animations;
-        private SpriteAnimation current;
-        private String currentName;
+        private SpriteAnimationTable table;
+        private int currentId = SpriteAnimationTable.InvalidId;
+        private int firstFrame;
+        private int frameCount;
         private long frameTime;
         private long duration;
         private int frame;
         private bool keepTime;
+        private bool frameDirty = true;
 
         public Vector3 BaseScale { get; set; } = Vector3.ScaleIdentity;
 
@@ -104,44 +106,62 @@ namespace DiligentEngine.RT.Sprites
 
         public Sprite(Dictionary<String, SpriteAnimation> animations)
         {
-            this.animations = animations;
-            SetAnimation(animations.Keys.First());
+            this.table = SpriteAnimationTable.Get(animations);
+            SetAnimation(0);
         }
 
         public void SetAnimation(String animationName)
         {
-            if(animationName == currentName)
+            if (animationName == CurrentAnimationName)
             {
                 return;
             }
 
-            currentName = animationName;
+            SetAnimation(table.GetId(animationName));
+        }
+
+        public void SetAnimation(int animationId)
+        {
+            if (animationId < 0 || animationId >= table.Count)
+            {
+                animationId = 0;
+            }
 
-            if (!animations.TryGetValue(animationName, out current))
+            if (animationId == currentId)
             {
-                var first = animations.First();
-                current = first.Value;
-                currentName = first.Key;
+                return;
             }
 
-            duration = current.duration;
+            var oldFrame = firstFrame + frame;
+
+            currentId = animationId;
+            firstFrame = table.GetFirstFrame(animationId);
+            frameCount = table.GetFrameCount(animationId);
+            duration = table.GetDuration(animationId);
             if (keepTime)
             {
                 frameTime %= duration;
-                frame = (int)((float)frameTime / duration * current.frames.Length);
+                frame = (int)((float)frameTime / duration * frameCount);
             }
             else
             {
                 frameTime = 0;
                 frame = 0;
             }
+
+            frameDirty |= firstFrame + frame != oldFrame;
         }
 
         public void Update(Clock clock)
         {
             frameTime += clock.DeltaTimeMicro;
             frameTime %= duration;
-            frame = (int)((float)frameTime / duration * current.frames.Length);
+            var newFrame = (int)((float)frameTime / duration * frameCount);
+            if (newFrame != frame)
+            {
+                frame = newFrame;
+                frameDirty = true;
+            }
         }
 
         public void RandomizeFrameTime()
@@ -154,14 +174,25 @@ namespace DiligentEngine.RT.Sprites
 
         public SpriteFrame GetCurrentFrame()
         {
-            return current.frames[frame];
+            return table.GetFrame(firstFrame + frame);
         }
 
-        public String CurrentAnimationName => currentName;
+        public String CurrentAnimationName => table.GetName(currentId);
+
+        public int CurrentAnimationId => currentId;
 
         public int FrameIndex => frame;
 
-        public IReadOnlyDictionary<String, SpriteAnimation> Animations => animations;
+        public IReadOnlyDictionary<String, SpriteAnimation> Animations => table.Source;
+
+        public SpriteAnimationTable AnimationTable => table;
+
+        public bool FrameDirty => frameDirty;
+
+        public void ClearFrameDirty()
+        {
+            frameDirty = false;
+        }
     }
 
     public class EventSprite : ISprite
@@ -174,8 +205,14 @@ namespace DiligentEngine.RT.Sprites
 
         public string CurrentAnimationName => wrapped.CurrentAnimationName;
 
+        public int CurrentAnimationId => wrapped.CurrentAnimationId;
+
         public IReadOnlyDictionary<string, SpriteAnimation> Animations => wrapped.Animations;
 
+        public SpriteAnimationTable AnimationTable => wrapped.AnimationTable;
+
+        public bool FrameDirty => wrapped.FrameDirty;
+
         public event Action<ISprite> AnimationChanged;
         public event Action<ISprite> FrameChanged;
 
@@ -211,6 +248,23 @@ namespace DiligentEngine.RT.Sprites
             AnimationChanged?.Invoke(this);
         }
 
+        public void SetAnimation(int animationId)
+        {
+            if (animationId == wrapped.CurrentAnimationId)
+            {
+                return;
+            }
+
+            wrapped.SetAnimation(animationId);
+
+            AnimationChanged?.Invoke(this);
+        }
+
+        public void ClearFrameDirty()
+        {
+            wrapped.ClearFrameDirty();
+        }
+
         public void Update(Clock clock)
         {
             var oldFrame = wrapped.FrameIndex;
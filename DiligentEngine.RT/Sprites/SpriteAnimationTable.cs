@@ -0,0 +1,100 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Runtime.CompilerServices;
+
+namespace DiligentEngine.RT.Sprites
+{
+    /// <summary>
+    /// The animations of a sprite compiled into flat arrays so a frame can be found by index instead of
+    /// by name. Animations get an integer id in the order of the source dictionary and the frames of
+    /// every animation are stored back to back in Frames. Tables are cached per animation dictionary, so
+    /// sprites made from the same dictionary share one. Don't change a dictionary once a sprite uses it.
+    /// </summary>
+    public class SpriteAnimationTable
+    {
+        public const int InvalidId = -1;
+
+        private static readonly ConditionalWeakTable<Dictionary<String, SpriteAnimation>, SpriteAnimationTable> tables
+            = new ConditionalWeakTable<Dictionary<String, SpriteAnimation>, SpriteAnimationTable>();
+
+        public static SpriteAnimationTable Get(Dictionary<String, SpriteAnimation> animations)
+        {
+            return tables.GetValue(animations, i => new SpriteAnimationTable(i));
+        }
+
+        private readonly Dictionary<String, int> ids;
+        private readonly String[] names;
+        private readonly int[] firstFrames;
+        private readonly int[] frameCounts;
+        private readonly long[] durations;
+        private readonly SpriteFrame[] frames;
+
+        private SpriteAnimationTable(Dictionary<String, SpriteAnimation> animations)
+        {
+            Source = animations;
+            var count = animations.Count;
+            ids = new Dictionary<String, int>(count);
+            names = new String[count];
+            firstFrames = new int[count];
+            frameCounts = new int[count];
+            durations = new long[count];
+
+            var totalFrames = 0;
+            foreach (var animation in animations.Values)
+            {
+                totalFrames += animation.frames.Length;
+            }
+            frames = new SpriteFrame[totalFrames];
+
+            var id = 0;
+            var frame = 0;
+            var hasMultipleFrames = false;
+            foreach (var animation in animations)
+            {
+                var animationFrames = animation.Value.frames;
+                ids.Add(animation.Key, id);
+                names[id] = animation.Key;
+                firstFrames[id] = frame;
+                frameCounts[id] = animationFrames.Length;
+                durations[id] = animation.Value.duration;
+                Array.Copy(animationFrames, 0, frames, frame, animationFrames.Length);
+                hasMultipleFrames |= animationFrames.Length > 1;
+                frame += animationFrames.Length;
+                ++id;
+            }
+            HasMultipleFrames = hasMultipleFrames;
+        }
+
+        /// <summary>
+        /// Get the id of an animation or InvalidId if there is no animation with that name.
+        /// </summary>
+        public int GetId(String name)
+        {
+            return ids.TryGetValue(name, out var id) ? id : InvalidId;
+        }
+
+        public String GetName(int id) => names[id];
+
+        public int GetFirstFrame(int id) => firstFrames[id];
+
+        public int GetFrameCount(int id) => frameCounts[id];
+
+        public long GetDuration(int id) => durations[id];
+
+        public int Count => names.Length;
+
+        /// <summary>
+        /// Get a frame by its index in the table, an animation's frames start at GetFirstFrame.
+        /// </summary>
+        public SpriteFrame GetFrame(int frame) => frames[frame];
+
+        public int FrameCount => frames.Length;
+
+        /// <summary>
+        /// True if any animation has more than 1 frame, otherwise the sprite never needs updating.
+        /// </summary>
+        public bool HasMultipleFrames { get; }
+
+        public IReadOnlyDictionary<String, SpriteAnimation> Source { get; }
+    }
+}
@@ -53,11 +53,16 @@ namespace DiligentEngine.RT.Sprites
         }
 
         /// <summary>
-        /// This happens after the tlas is created and binds the instance data into it.
+        /// This happens after the tlas is created and binds the instance data into it. Nothing is bound if
+        /// the sbt already has the sprite's current frame for this instance.
         /// </summary>
-        public unsafe void Bind(String instanceName, IShaderBindingTable sbt, ITopLevelAS tlas, ISprite sprite)
+        public unsafe void Bind(TLASInstanceData instance, IShaderBindingTable sbt, ITopLevelAS tlas, ISprite sprite)
         {
-            String currentAnimation = sprite.CurrentAnimationName;
+            if (!instance.RTInstances.NeedsSpriteBind(sprite))
+            {
+                return;
+            }
+
             var frame = sprite.GetCurrentFrame();
             blasInstanceData.vertexOffset = spritePlaneBLAS.Instance.VertexOffset;
             blasInstanceData.indexOffset = spritePlaneBLAS.Instance.IndexOffset;
@@ -68,7 +73,7 @@ namespace DiligentEngine.RT.Sprites
 
             fixed (HLSL.BlasInstanceData* ptr = &this.blasInstanceData)
             {
-                primaryHitShader.BindSbt(instanceName, sbt, tlas, new IntPtr(ptr), (uint)sizeof(HLSL.BlasInstanceData));
+                primaryHitShader.BindSbt(instance, sbt, tlas, new IntPtr(ptr), (uint)sizeof(HLSL.BlasInstanceData));
             }
         }
     }
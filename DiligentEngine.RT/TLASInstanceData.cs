@@ -27,6 +27,8 @@ namespace DiligentEngine.RT
         int instanceIndex = DefaultRTInstanceIndex;
         RTInstances rTInstances = DefaultRTInstance;
         private String instanceName;
+        private Uint32 instanceNameId = NameTable.NullId;
+        private IntPtr instanceNamePtr = IntPtr.Zero;
         private IBottomLevelAS pblas;
         private InstanceMatrix transform;
         private Uint32 customId;
@@ -48,8 +50,15 @@ namespace DiligentEngine.RT
             set
             {
                 instanceName = value;
+                if (rTInstances != DefaultRTInstance)
+                {
+                    //Only instances that are added hold a name in the NameTable
+                    var oldNameId = instanceNameId;
+                    InstanceNameId = NameTable.Register(value);
+                    NameTable.Release(oldNameId);
+                }
                 ref var modInstance = ref rTInstances.passInstances[instanceIndex];
-                modInstance.InstanceName = value;
+                modInstance.InstanceName = instanceNamePtr;
             }
         }
 
@@ -149,6 +158,21 @@ namespace DiligentEngine.RT
             }
         }
 
+        internal Uint32 InstanceNameId
+        {
+            get
+            {
+                return instanceNameId;
+            }
+            set
+            {
+                instanceNameId = value;
+                instanceNamePtr = NameTable.GetName(value);
+            }
+        }
+
+        internal IntPtr InstanceNamePtr => instanceNamePtr;
+
         internal RTInstances RTInstances
         {
             get
@@ -10,4 +10,6 @@ cbuffer FSRConstants
 {
     uint2 inputSize;
     uint2 outSize;
+    uint2 viewportSize; //The part of the input in the top left that was rendered this frame
+    uint2 padding;
 };
\ No newline at end of file
@@ -1,13 +1,3 @@
-// Simulate light absorption inside glass.
-float3 LightAbsorption(float3 color1, float depth, float GlassAbsorption, float3 GlassMaterialColor)
-{
-    float  factor1 = depth * 0.25;
-    float  factor2 = pow(depth * GlassAbsorption, 2.2) * 0.25;
-    float  factor  = clamp(factor1 + factor2 + 0.05, 0.0, 1.0); 
-    float3 color2  = color1 * GlassMaterialColor.rgb;
-    return lerp(color1, color2, factor);
-}
-
 float3 BlendWithReflection(float3 srcColor, float3 reflectionColor, float factor, float3 GlassReflectionColorMask)
 {
     return lerp(srcColor, reflectionColor * GlassReflectionColorMask.rgb, factor);
@@ -91,6 +81,10 @@ void Glass(inout PrimaryRayPayload payload, float3 barycentrics,
         ray.Origin    = WorldRayOrigin() + WorldRayDirection() * RayTCurrent() + normal * SMALL_OFFSET;
         ray.Direction = reflect(WorldRayDirection(), normal);
 
+#if ITERATIVE_BOUNCES
+        AddBounce(payload, ray, fresnel * GlassReflectionColorMask, rayConeAtOrigin,
+            HitKind() == HIT_KIND_TRIANGLE_BACK_FACE ? GlassAbsorption : NO_ABSORPTION, GlassMaterialColor);
+#else
         PrimaryRayPayload reflPayload = CastPrimaryRay(ray, payload.Recursion + 1, rayConeAtOrigin);
         reflColor = reflPayload.Color;
             
@@ -98,6 +92,7 @@ void Glass(inout PrimaryRayPayload payload, float3 barycentrics,
         {
             reflColor = LightAbsorption(reflColor, reflPayload.Depth, GlassAbsorption, GlassMaterialColor);
         }
+#endif
     }
         
     // Refraction
@@ -106,6 +101,10 @@ void Glass(inout PrimaryRayPayload payload, float3 barycentrics,
         ray.Origin    = WorldRayOrigin() + WorldRayDirection() * RayTCurrent();
         ray.Direction = rayDir;
 
+#if ITERATIVE_BOUNCES
+        AddBounce(payload, ray, (1.0 - fresnel).xxx, rayConeAtOrigin,
+            HitKind() == HIT_KIND_TRIANGLE_FRONT_FACE || payload.Recursion == 0 ? GlassAbsorption : NO_ABSORPTION, GlassMaterialColor);
+#else
         PrimaryRayPayload nextPayload = CastPrimaryRay(ray, payload.Recursion + 1, rayConeAtOrigin);
         resultColor = nextPayload.Color;
             
@@ -113,11 +112,17 @@ void Glass(inout PrimaryRayPayload payload, float3 barycentrics,
         {
             resultColor = LightAbsorption(resultColor, nextPayload.Depth, GlassAbsorption, GlassMaterialColor);
         }
+#endif
     }
         
+#if ITERATIVE_BOUNCES
+    //The blend is in the bounce weights, all the color comes from the bounces
+    payload.Color = float3(0.0, 0.0, 0.0);
+#else
     resultColor = BlendWithReflection(resultColor, reflColor, fresnel, GlassReflectionColorMask);
 
     payload.Color = resultColor;
+#endif
     payload.Depth = RayTCurrent();
 }
 
@@ -172,11 +177,22 @@ void Water(inout PrimaryRayPayload payload, float3 barycentrics,
     float  fresnel = Fresnel(relIOR, dot(WorldRayDirection(), -normal));
     float3 reflColor;
 
+#if ITERATIVE_BOUNCES
+    //Lighting scales the blended color, so it scales both bounces
+    float3 lightScale, lightOffset;
+    float3 rayOrigin = WorldRayOrigin() + WorldRayDirection() * RayTCurrent();
+    GetLighting(rayOrigin, normal, normal, payload.Recursion + 1, lightScale, lightOffset);
+#endif
+
     // Reflection
     {
         ray.Origin = WorldRayOrigin() + WorldRayDirection() * RayTCurrent() + normal * SMALL_OFFSET;
         ray.Direction = reflect(WorldRayDirection(), normal);
 
+#if ITERATIVE_BOUNCES
+        AddBounce(payload, ray, fresnel * GlassReflectionColorMask * lightScale, rayConeAtOrigin,
+            HitKind() == HIT_KIND_TRIANGLE_BACK_FACE ? GlassAbsorption : NO_ABSORPTION, GlassMaterialColor);
+#else
         PrimaryRayPayload reflPayload = CastPrimaryRay(ray, payload.Recursion + 1, rayConeAtOrigin);
         reflColor = reflPayload.Color;
 
@@ -184,6 +200,7 @@ void Water(inout PrimaryRayPayload payload, float3 barycentrics,
         {
             reflColor = LightAbsorption(reflColor, reflPayload.Depth, GlassAbsorption, GlassMaterialColor);
         }
+#endif
     }
 
     // Refraction
@@ -192,6 +209,10 @@ void Water(inout PrimaryRayPayload payload, float3 barycentrics,
         ray.Origin = WorldRayOrigin() + WorldRayDirection() * RayTCurrent();
         ray.Direction = rayDir;
 
+#if ITERATIVE_BOUNCES
+        AddBounce(payload, ray, (1.0 - fresnel) * lightScale, rayConeAtOrigin,
+            HitKind() == HIT_KIND_TRIANGLE_FRONT_FACE || payload.Recursion == 0 ? GlassAbsorption : NO_ABSORPTION, GlassMaterialColor);
+#else
         PrimaryRayPayload nextPayload = CastPrimaryRay(ray, payload.Recursion + 1, rayConeAtOrigin);
         resultColor = nextPayload.Color;
 
@@ -199,8 +220,13 @@ void Water(inout PrimaryRayPayload payload, float3 barycentrics,
         {
             resultColor = LightAbsorption(resultColor, nextPayload.Depth, GlassAbsorption, GlassMaterialColor);
         }
+#endif
     }
 
+#if ITERATIVE_BOUNCES
+    payload.Color = lightOffset;
+    payload.Depth = RayTCurrent();
+#else
     resultColor = BlendWithReflection(resultColor, reflColor, fresnel, GlassReflectionColorMask);
 
     payload.Color = resultColor;
@@ -208,4 +234,5 @@ void Water(inout PrimaryRayPayload payload, float3 barycentrics,
 
     float3 rayOrigin = WorldRayOrigin() + WorldRayDirection() * RayTCurrent();
     LightingPass(payload.Color, rayOrigin, normal, normal, payload.Recursion + 1);
+#endif
 }
\ No newline at end of file
@@ -113,7 +113,46 @@ void BRDF(in float3                 PointToLight,
     }
 }
 
-void LightingPass(inout float3 Color, float3 Pos, float3 Norm, float3 pertbNorm, uint Recursion)
+StructuredBuffer<LightData> g_Lights;
+StructuredBuffer<uint>      g_TileLights;
+
+#define ALL_LIGHTS 0xffffffff
+
+//Find the lights for the screen tile Pos projects into, these were culled in LightCulling.csh. Returns the
+//number of lights to check. If Pos is off screen or its tile has too many lights tileStart is ALL_LIGHTS
+//and every active light is checked.
+uint GetTileLights(float3 Pos, out uint tileStart)
+{
+    tileStart = ALL_LIGHTS;
+    uint numLights = uint(g_ConstantsCB.NumActiveLights);
+
+    float2 uv;
+    if (!GetScreenUv(Pos - g_ConstantsCB.CameraPos.xyz, g_ConstantsCB.FrustumRayLB.xyz, g_ConstantsCB.FrustumRayRB.xyz, g_ConstantsCB.FrustumRayLT.xyz, uv)
+        || any(uv < 0.0) || any(uv >= 1.0))
+    {
+        return numLights;
+    }
+
+    uint2 tile = uint2(uv * float2(g_ConstantsCB.RenderWidth, g_ConstantsCB.RenderHeight)) / uint(g_ConstantsCB.LightTileSize);
+    uint start = (tile.y * uint(g_ConstantsCB.LightTilesX) + tile.x) * uint(g_ConstantsCB.MaxTileLights + 1);
+    uint count = g_TileLights[start];
+    if (count > uint(g_ConstantsCB.MaxTileLights))
+    {
+        return numLights;
+    }
+
+    tileStart = start + 1;
+    return count;
+}
+
+uint GetLightIndex(uint tileStart, uint i)
+{
+    return tileStart == ALL_LIGHTS ? i : g_TileLights[tileStart + i];
+}
+
+//Lighting is Color * scale + offset, this finds the scale and offset so a color that is not known yet,
+//like a reflection raygen will trace later, can be lit the same way.
+void GetLighting(float3 Pos, float3 Norm, float3 pertbNorm, uint Recursion, out float3 scale, out float3 offset)
 {
     RayDesc ray;
     float3  col = float3(0.0, 0.0, 0.0);
@@ -122,17 +161,21 @@ void LightingPass(inout float3 Color, float3 Pos, float3 Norm, float3 pertbNorm,
     ray.Origin = Pos + Norm * instanceData.raycastSmallOffset;
     ray.TMin = 0.0;
 
-    for (int i = 0; i < g_ConstantsCB.NumActiveLights; ++i)
+    uint tileStart;
+    uint numLights = GetTileLights(Pos, tileStart);
+    for (uint i = 0; i < numLights; ++i)
     {
+        LightData light = g_Lights[GetLightIndex(tileStart, i)];
+
         // Limit max ray length by distance to light source.
-        ray.TMax = distance(g_ConstantsCB.LightPos[i].xyz, Pos) * 1.01;
+        ray.TMax = distance(light.Pos.xyz, Pos) * 1.01;
 
         //Only shoot ray if we are close enough to hit the light
-        if (ray.TMax < g_ConstantsCB.LightColor[i].a)
+        if (ray.TMax < light.Color.a)
         {
-            float3 rayDir = normalize(g_ConstantsCB.LightPos[i].xyz - Pos);
+            float3 rayDir = normalize(light.Pos.xyz - Pos);
             float  NdotL = max(0.0, dot(pertbNorm, rayDir));
-            float attenuation = 1.0f - (ray.TMax / g_ConstantsCB.LightColor[i].a);
+            float attenuation = 1.0f - (ray.TMax / light.Color.a);
 
             // Optimization - don't trace rays if NdotL is zero or negative
             if (NdotL > 0.0)
@@ -141,22 +184,32 @@ void LightingPass(inout float3 Color, float3 Pos, float3 Norm, float3 pertbNorm,
                 ray.Direction = rayDir;
                 float shading = saturate(CastShadow(ray, Recursion).Shading);
 
-                col += Color * (g_ConstantsCB.LightColor[i].rgb * attenuation) * NdotL * shading;
+                col += (light.Color.rgb * attenuation) * NdotL * shading;
                 //These commented lines and the eyeDir above give crappy specular highlights
                 //float3 halfVec = normalize(eyeDir + rayDir);
                 //float specularLight = pow(saturate(dot(pertbNorm, halfVec)), 250);
                 //col += specularLight;
             }
         }
-        col += Color * g_ConstantsCB.Darkness;
     }
-    Color = col * (1.0 / float(g_ConstantsCB.NumActiveLights)) + g_ConstantsCB.AmbientColor.rgb;
+    //Every active light used to add the darkness, culled lights still count toward it
+    scale = col * (1.0 / float(max(g_ConstantsCB.NumActiveLights, 1))) + g_ConstantsCB.Darkness;
+    offset = g_ConstantsCB.AmbientColor.rgb;
 }
 
-void LightingPass(inout float3 Color, float3 Pos, float3 Norm, float3 pertbNorm, uint Recursion, float4 physicalInfo)
+void LightingPass(inout float3 Color, float3 Pos, float3 Norm, float3 pertbNorm, uint Recursion)
+{
+    float3 scale, offset;
+    GetLighting(Pos, Norm, pertbNorm, Recursion, scale, offset);
+    Color = Color * scale + offset;
+}
+
+//The specular part depends on Color, so it goes in the offset
+void GetLighting(float3 Color, float3 Pos, float3 Norm, float3 pertbNorm, uint Recursion, float4 physicalInfo, out float3 scale, out float3 offset)
 {
     RayDesc ray;
     float3  col = float3(0.0, 0.0, 0.0);
+    float3  spec = float3(0.0, 0.0, 0.0);
 
     // Add a small offset to avoid self-intersections.
     ray.Origin = Pos + Norm * instanceData.raycastSmallOffset;
@@ -165,17 +218,21 @@ void LightingPass(inout float3 Color, float3 Pos, float3 Norm, float3 pertbNorm,
     float3 view = g_ConstantsCB.CameraPos.xyz - Pos;
     SurfaceReflectanceInfo surfInfo = GetSurfaceReflectance(Color, physicalInfo);
 
-    for (int i = 0; i < g_ConstantsCB.NumActiveLights; ++i)
+    uint tileStart;
+    uint numLights = GetTileLights(Pos, tileStart);
+    for (uint i = 0; i < numLights; ++i)
     {
+        LightData light = g_Lights[GetLightIndex(tileStart, i)];
+
         // Limit max ray length by distance to light source.
-        ray.TMax = distance(g_ConstantsCB.LightPos[i].xyz, Pos) * 1.01;
+        ray.TMax = distance(light.Pos.xyz, Pos) * 1.01;
 
         //Only shoot ray if we are close enough to hit the light
-        if (ray.TMax < g_ConstantsCB.LightColor[i].a)
+        if (ray.TMax < light.Color.a)
         {
-            float3 rayDir = normalize(g_ConstantsCB.LightPos[i].xyz - Pos);
+            float3 rayDir = normalize(light.Pos.xyz - Pos);
             float  NdotL;// = max(0.0, dot(pertbNorm, rayDir));
-            float attenuation = 1.0f - (ray.TMax / g_ConstantsCB.LightColor[i].a);
+            float attenuation = 1.0f - (ray.TMax / light.Color.a);
             float3 SpecContrib;
             BRDF(rayDir, pertbNorm, view, surfInfo,
                 SpecContrib, NdotL);
@@ -187,12 +244,23 @@ void LightingPass(inout float3 Color, float3 Pos, float3 Norm, float3 pertbNorm,
                 ray.Direction = rayDir;
                 float shading = saturate(CastShadow(ray, Recursion).Shading);
 
-                col += (Color + SpecContrib) * (g_ConstantsCB.LightColor[i].rgb * attenuation) * NdotL * shading;
+                float3 lightColor = (light.Color.rgb * attenuation) * NdotL * shading;
+                col += lightColor;
+                spec += SpecContrib * lightColor;
             }
         }
-        col += Color * g_ConstantsCB.Darkness;
     }
-    Color = col * (1.0 / float(g_ConstantsCB.NumActiveLights)) + g_ConstantsCB.AmbientColor.rgb;
+    //Every active light used to add the darkness, culled lights still count toward it
+    float lightScale = 1.0 / float(max(g_ConstantsCB.NumActiveLights, 1));
+    scale = col * lightScale + g_ConstantsCB.Darkness;
+    offset = spec * lightScale + g_ConstantsCB.AmbientColor.rgb;
+}
+
+void LightingPass(inout float3 Color, float3 Pos, float3 Norm, float3 pertbNorm, uint Recursion, float4 physicalInfo)
+{
+    float3 scale, offset;
+    GetLighting(Color, Pos, Norm, pertbNorm, Recursion, physicalInfo, scale, offset);
+    Color = Color * scale + offset;
 }
 
 float3 GetPerterbedNormal(
@@ -317,6 +385,29 @@ void LightAndShadeBaseNormalPhysicalReflective
     float roughness = physical.g;
     float reflective = physical.a;
 
+#if ITERATIVE_BOUNCES
+    //The reflection is not known yet, so the specular reflectance comes from the base color alone
+    float3 rayOrigin = WorldRayOrigin() + WorldRayDirection() * RayTCurrent();
+    float3 lightScale, lightOffset;
+    GetLighting(baseColor, rayOrigin, normal, pertNormal, payload.Recursion + 1, physical, lightScale, lightOffset);
+
+    if (reflective > 0.5)
+    {
+        // Reflect from the normal
+        RayDesc ray;
+        ray.Origin = rayOrigin + normal * instanceData.raycastSmallOffset;
+        ray.TMin = 0.0;
+        ray.TMax = 100.0;
+        ray.Direction = reflect(WorldRayDirection(), pertNormal);
+        AddBounce(payload, ray, (1.0f - roughness) * lightScale, float2(0, g_ConstantsCB.eyeToPixelConeSpreadAngle));
+
+        payload.Color = baseColor * roughness * lightScale + lightOffset;
+    }
+    else
+    {
+        payload.Color = baseColor * lightScale + lightOffset;
+    }
+#else
     if (reflective > 0.5)
     {
         // Reflect from the normal
@@ -338,6 +429,7 @@ void LightAndShadeBaseNormalPhysicalReflective
     // Apply lighting.
     float3 rayOrigin = WorldRayOrigin() + WorldRayDirection() * RayTCurrent();
     LightingPass(payload.Color, rayOrigin, normal, pertNormal, payload.Recursion + 1, physical);
+#endif
 
     payload.Depth = RayTCurrent();
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "Structures.hlsl"
 #include "RayUtils.hlsl"
 #include "Data.hlsl"
+#include "ScreenProjection.hlsl"
 #include "Lighting.hlsl"
 #include "GlassPrimaryHit.hlsl"
 #include "TexturesRC.hlsl"
@@ -21,7 +22,14 @@ void main(inout PrimaryRayPayload payload, in BuiltInTriangleIntersectionAttribu
     float3 emissiveColor;
     float2 currentRayCone = payload.RayConeAtOrigin;
 
-    [forcecase] switch (instanceData.dispatchType) 
+#ifdef DISPATCH_TYPE
+    //Specialized hit group, the switch folds down to the one case for this material
+    const uint dispatchType = DISPATCH_TYPE;
+#else
+    const uint dispatchType = instanceData.dispatchType;
+#endif
+
+    [forcecase] switch (dispatchType) 
     {
         case $$(LIGHTANDSHADEBASE):
             GetInstanceDataMesh(attr, barycentrics, posX, posY, posZ, uv, globalUv, uvAreaFromCone, currentRayCone);
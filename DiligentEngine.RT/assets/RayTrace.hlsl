@@ -4,12 +4,79 @@
 
 RWTexture2D<float4> g_ColorBuffer;
 
+#if CHECKERBOARD
+RWTexture2D<float>  g_DepthBuffer;
+#endif
+
+#if ITERATIVE_BOUNCES
+//Bounces waiting to be traced. Each level of bounces leaves at most one ray behind while the other is
+//followed, so this is more than the deepest MaxRecursion needs.
+#define MAX_PENDING_BOUNCES 16
+
+//Trace the primary ray and then the bounces its hits ask for in a loop instead of the hit shaders
+//recursing. The pipeline only needs enough stack for a hit shader's shadow rays.
+PrimaryRayPayload TraceBounces(RayDesc ray)
+{
+    PrimaryRayPayload payload = CastPrimaryRay(ray, /*recursion*/0);
+
+    BounceRay pending[MAX_PENDING_BOUNCES];
+    uint numPending = 0;
+    for (uint i = 0; i < payload.NumBounces; ++i)
+    {
+        pending[numPending++] = payload.Bounces[i];
+    }
+
+    while (numPending > 0)
+    {
+        BounceRay bounce = pending[--numPending];
+
+        RayDesc bounceRay;
+        bounceRay.Origin = bounce.Origin;
+        bounceRay.TMin = bounce.TMin;
+        bounceRay.Direction = bounce.Direction;
+        bounceRay.TMax = bounce.TMax;
+
+        PrimaryRayPayload bouncePayload = CastPrimaryRay(bounceRay, bounce.Recursion, bounce.RayConeAtOrigin);
+
+        //Absorption scales everything the ray finds, including its own bounces
+        float3 weight = bounce.Weight;
+        if (bounce.GlassAbsorption != NO_ABSORPTION)
+        {
+            weight = LightAbsorption(weight, bouncePayload.Depth, bounce.GlassAbsorption, bounce.GlassMaterialColor);
+        }
+        payload.Color += bouncePayload.Color * weight;
+
+        for (uint j = 0; j < bouncePayload.NumBounces && numPending < MAX_PENDING_BOUNCES; ++j)
+        {
+            BounceRay next = bouncePayload.Bounces[j];
+            next.Weight *= weight;
+            pending[numPending++] = next;
+        }
+    }
+
+    return payload;
+}
+#endif
+
 [shader("raygeneration")]
 void main()
 {
+#if CHECKERBOARD
+    //Rays are dispatched for half the width, each row traces the odd or even pixels
+    uint2   pixel     = uint2(DispatchRaysIndex().x * 2 + ((DispatchRaysIndex().y + g_ConstantsCB.CheckerboardParity) & 1), DispatchRaysIndex().y);
+    float2  size      = float2(g_ConstantsCB.RenderWidth, g_ConstantsCB.RenderHeight);
+    if (pixel.x >= uint(g_ConstantsCB.RenderWidth))
+    {
+        return;
+    }
+#else
+    uint2   pixel     = DispatchRaysIndex().xy;
+    float2  size      = float2(DispatchRaysDimensions().xy);
+#endif
+
     // Calculate ray direction by interpolating frustum corner rays.
     float3  rayOrigin = g_ConstantsCB.CameraPos.xyz;
-    float2  uv        = (float2(DispatchRaysIndex().xy) + float2(0.5, 0.5)) / float2(DispatchRaysDimensions().xy);
+    float2  uv        = (float2(pixel) + float2(0.5, 0.5)) / size;
     float3  rayDir    = normalize(lerp(lerp(g_ConstantsCB.FrustumRayLB.xyz, g_ConstantsCB.FrustumRayRB.xyz, uv.x),
                                        lerp(g_ConstantsCB.FrustumRayLT.xyz, g_ConstantsCB.FrustumRayRT.xyz, uv.x), uv.y));
 
@@ -19,7 +86,15 @@ void main()
     ray.TMin      = g_ConstantsCB.ClipPlanes.x;
     ray.TMax      = g_ConstantsCB.ClipPlanes.y;
 
+#if ITERATIVE_BOUNCES
+    PrimaryRayPayload payload = TraceBounces(ray);
+#else
     PrimaryRayPayload payload = CastPrimaryRay(ray, /*recursion*/0);
+#endif
 
-    g_ColorBuffer[DispatchRaysIndex().xy] = float4(payload.Color, 1.0);
+    g_ColorBuffer[pixel] = float4(payload.Color, 1.0);
+#if CHECKERBOARD
+    //The reconstruction uses the depth to find where the pixels that were not traced were last frame
+    g_DepthBuffer[pixel] = payload.Depth;
+#endif
 }
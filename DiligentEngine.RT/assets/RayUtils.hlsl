@@ -7,7 +7,14 @@ ConstantBuffer<Constants>       g_ConstantsCB;
 
 PrimaryRayPayload CastPrimaryRay(RayDesc ray, uint Recursion, float2 RayConeAtOrigin)
 {
-    PrimaryRayPayload payload = { float3(0, 0, 0), 0.0, Recursion, RayConeAtOrigin };
+    PrimaryRayPayload payload;
+    payload.Color = float3(0, 0, 0);
+    payload.Depth = 0.0;
+    payload.Recursion = Recursion;
+    payload.RayConeAtOrigin = RayConeAtOrigin;
+#if ITERATIVE_BOUNCES
+    payload.NumBounces = 0;
+#endif
 
     // Manually terminate the recusrion as the driver doesn't check the recursion depth.
     if (Recursion >= g_ConstantsCB.MaxRecursion)
@@ -33,6 +40,45 @@ PrimaryRayPayload CastPrimaryRay(RayDesc ray, uint Recursion)
     return CastPrimaryRay(ray, Recursion, float2(0, g_ConstantsCB.eyeToPixelConeSpreadAngle));
 }
 
+#if ITERATIVE_BOUNCES
+//Ask raygen to trace ray after this hit and add the color it finds times weight. This replaces
+//calling CastPrimaryRay from a hit shader.
+void AddBounce(inout PrimaryRayPayload payload, RayDesc ray, float3 weight, float2 RayConeAtOrigin, float GlassAbsorption, float3 GlassMaterialColor)
+{
+    if (payload.NumBounces >= MAX_BOUNCE_RAYS)
+    {
+        return;
+    }
+
+    BounceRay bounce;
+    bounce.Origin = ray.Origin;
+    bounce.TMin = ray.TMin;
+    bounce.Direction = ray.Direction;
+    bounce.TMax = ray.TMax;
+    bounce.Weight = weight;
+    bounce.Recursion = payload.Recursion + 1;
+    bounce.GlassMaterialColor = GlassMaterialColor;
+    bounce.GlassAbsorption = GlassAbsorption;
+    bounce.RayConeAtOrigin = RayConeAtOrigin;
+    payload.Bounces[payload.NumBounces++] = bounce;
+}
+
+void AddBounce(inout PrimaryRayPayload payload, RayDesc ray, float3 weight, float2 RayConeAtOrigin)
+{
+    AddBounce(payload, ray, weight, RayConeAtOrigin, NO_ABSORPTION, float3(1, 1, 1));
+}
+#endif
+
+// Simulate light absorption inside glass.
+float3 LightAbsorption(float3 color1, float depth, float GlassAbsorption, float3 GlassMaterialColor)
+{
+    float  factor1 = depth * 0.25;
+    float  factor2 = pow(depth * GlassAbsorption, 2.2) * 0.25;
+    float  factor  = clamp(factor1 + factor2 + 0.05, 0.0, 1.0); 
+    float3 color2  = color1 * GlassMaterialColor.rgb;
+    return lerp(color1, color2, factor);
+}
+
 ShadowRayPayload CastShadow(RayDesc ray, uint Recursion)
 {
     // By default initialize Shading with 0.
@@ -0,0 +1,20 @@
+//Find the screen uv a direction from the camera goes through. This is the inverse of how RayTrace.hlsl
+//makes rays from the frustum corner rays, the corner rays end on a plane so the direction is extended to
+//that plane and measured along its edges. Returns false if the direction points away from the plane.
+bool GetScreenUv(float3 dir, float3 frustumRayLB, float3 frustumRayRB, float3 frustumRayLT, out float2 uv)
+{
+    float3 right = frustumRayRB - frustumRayLB;
+    float3 up = frustumRayLT - frustumRayLB;
+    float3 forward = cross(right, up);
+    float planeDist = dot(frustumRayLB, forward);
+    float dirDist = dot(dir, forward);
+    if (dirDist * planeDist <= 0.0)
+    {
+        uv = float2(-1.0, -1.0);
+        return false;
+    }
+
+    float3 onPlane = dir * (planeDist / dirDist) - frustumRayLB;
+    uv = float2(dot(onPlane, right) / dot(right, right), dot(onPlane, up) / dot(up, up));
+    return true;
+}
@@ -44,12 +44,38 @@ struct CubeAttribVertex {
   int pad3;
 };
 
+#if ITERATIVE_BOUNCES
+//The most rays a hit shader can ask raygen to trace after it, glass needs one to reflect and one to refract
+#define MAX_BOUNCE_RAYS 2
+
+//Used as the GlassAbsorption of bounces that do not go through glass
+#define NO_ABSORPTION -1.0
+
+struct BounceRay
+{
+    float3 Origin;
+    float  TMin;
+    float3 Direction;
+    float  TMax;
+    float3 Weight;             //The color this ray finds is scaled by this
+    uint   Recursion;
+    float3 GlassMaterialColor;
+    float  GlassAbsorption;    //If this is not NO_ABSORPTION LightAbsorption is applied with the depth the ray finds
+    float2 RayConeAtOrigin;
+};
+#endif
+
 struct PrimaryRayPayload
 {
     float3 Color;
     float  Depth;
     uint   Recursion;
     float2 RayConeAtOrigin;
+#if ITERATIVE_BOUNCES
+    //Rays raygen traces after this hit, their color times their weight is added to Color
+    uint      NumBounces;
+    BounceRay Bounces[MAX_BOUNCE_RAYS];
+#endif
 };
 
 struct EmissiveRayPayload
@@ -88,8 +114,6 @@ struct Constants
 
     // Light properties
     float4  AmbientColor;
-    float4  LightPos[NUM_LIGHTS];
-    float4  LightColor[NUM_LIGHTS]; //Light color stores length of the light in a/w
 
     //Sky properties
     float4 Pallete[6];
@@ -105,6 +129,24 @@ struct Constants
     float2 missUvOffset;
     
     float padding1;
+
+    //Light culling tiles, the lights for each tile are in g_TileLights
+    int LightTileSize;
+    int LightTilesX;
+    int LightTilesY;
+    int MaxTileLights;
+    int RenderWidth;
+    int RenderHeight;
+
+    //Set when only every other pixel is traced, the parity picks which ones this frame
+    int Checkerboard;
+    int CheckerboardParity;
+};
+
+struct LightData
+{
+    float4 Pos;
+    float4 Color; //Light color stores length of the light in a/w
 };
 
 struct SurfaceReflectanceInfo
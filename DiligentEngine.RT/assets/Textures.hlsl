@@ -51,16 +51,27 @@ int GetTextureSet(in int texIdx)
 	return tex;
 }
 
+//BC5 normal maps only store x and y and read 0 for blue, which no real normal has. Rebuild z for those.
+float3 DecodeSampledNormal(float3 sampled)
+{
+	if (sampled.b == 0.0)
+	{
+		float2 xy = sampled.rg * 2.0 - 1.0;
+		sampled.b = sqrt(saturate(1.0 - dot(xy, xy))) * 0.5 + 0.5;
+	}
+	return sampled;
+}
+
 float3 GetSampledNormal(in float mip, in float2 uv)
 {
 	int tex = instanceData.tex0;
-	return $$(G_TEXTURES)[NonUniformResourceIndex($$(G_TEXTURESETS)[NonUniformResourceIndex(tex)].normalTexture)].SampleLevel(g_SamLinearWrap, uv, mip).rgb;
+	return DecodeSampledNormal($$(G_TEXTURES)[NonUniformResourceIndex($$(G_TEXTURESETS)[NonUniformResourceIndex(tex)].normalTexture)].SampleLevel(g_SamLinearWrap, uv, mip).rgb);
 }
 
 float3 GetSampledNormal(in float mip, in float2 uv, in int texIdx)
 {
 	int tex = GetTextureSet(texIdx);
-	return $$(G_TEXTURES)[NonUniformResourceIndex($$(G_TEXTURESETS)[NonUniformResourceIndex(tex)].normalTexture)].SampleLevel(g_SamLinearWrap, uv, mip).rgb;
+	return DecodeSampledNormal($$(G_TEXTURES)[NonUniformResourceIndex($$(G_TEXTURESETS)[NonUniformResourceIndex(tex)].normalTexture)].SampleLevel(g_SamLinearWrap, uv, mip).rgb);
 }
 
 float4 GetPhysical(in float mip, in float2 uv)
@@ -10,7 +10,7 @@ float3 GetSampledNormalRC(in float2 uvAreaFromCone, in float2 uv)
 	int tex = instanceData.tex0;
 	Texture2D resolvedTex = $$(G_TEXTURES)[NonUniformResourceIndex($$(G_TEXTURESETS)[NonUniformResourceIndex(tex)].normalTexture)];
 	float mip = GetTexLOD(uvAreaFromCone, resolvedTex);
-	return resolvedTex.SampleLevel(g_SamLinearWrap, uv, mip).rgb;
+	return DecodeSampledNormal(resolvedTex.SampleLevel(g_SamLinearWrap, uv, mip).rgb);
 }
 
 float3 GetSampledNormalRC(in float2 uvAreaFromCone, in float2 uv, in int texIdx)
@@ -18,7 +18,7 @@ float3 GetSampledNormalRC(in float2 uvAreaFromCone, in float2 uv, in int texIdx)
 	int tex = GetTextureSet(texIdx);
 	Texture2D resolvedTex = $$(G_TEXTURES)[NonUniformResourceIndex($$(G_TEXTURESETS)[NonUniformResourceIndex(tex)].normalTexture)];
 	float mip = GetTexLOD(uvAreaFromCone, resolvedTex);
-	return resolvedTex.SampleLevel(g_SamLinearWrap, uv, mip).rgb;
+	return DecodeSampledNormal(resolvedTex.SampleLevel(g_SamLinearWrap, uv, mip).rgb);
 }
 
 float4 GetPhysicalRC(in float2 uvAreaFromCone, in float2 uv)
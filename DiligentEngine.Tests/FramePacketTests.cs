@@ -0,0 +1,129 @@
+﻿using DiligentEngine;
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Text;
+using System.Threading.Tasks;
+using Xunit;
+
+namespace DiligentEngine.Tests
+{
+    public class FramePacketTests
+    {
+        static FramePacketTests()
+        {
+            //The wrapper is copied to x64 like it is for the apps, the platform normally puts that on the path
+            var nativeLibPath = Path.Combine(AppContext.BaseDirectory, "x64");
+            Environment.SetEnvironmentVariable("PATH", $"{nativeLibPath}{Path.PathSeparator}{Environment.GetEnvironmentVariable("PATH")}");
+        }
+
+        private static FramePacket CreatePacket()
+        {
+            var packet = new FramePacket();
+            packet.DispatchCompute(new DispatchComputeAttribs { ThreadGroupCountX = 4, ThreadGroupCountY = 2, ThreadGroupCountZ = 1 });
+            packet.Draw(new DrawAttribs { NumVertices = 3, NumInstances = 1 });
+            packet.TransitionResourceStates(new List<StateTransitionDesc>());
+            return packet;
+        }
+
+        private static void SetCommandSize(byte[] data, int offset, uint size)
+        {
+            BitConverter.GetBytes(size).CopyTo(data, offset + 4);
+        }
+
+        [Fact]
+        public void RoundTrip()
+        {
+            using var packet = CreatePacket();
+            Assert.Equal(3u, packet.CommandCount);
+
+            var result = packet.Validate(out var checksum);
+            Assert.Equal(FramePacketError.None, result.Error);
+            Assert.Equal(3u, result.NumCommands);
+            Assert.Equal((uint)packet.Size, result.BytesRead);
+
+            //The same bytes decode the same way when they are copied out
+            var copy = FramePacket.Validate(packet.Data.ToArray(), out var copyChecksum);
+            Assert.Equal(FramePacketError.None, copy.Error);
+            Assert.Equal(3u, copy.NumCommands);
+            Assert.NotEqual(0ul, copyChecksum);
+        }
+
+        [Fact]
+        public void ResetClears()
+        {
+            using var packet = CreatePacket();
+            packet.Reset();
+            Assert.Equal(0, packet.Size);
+
+            var result = packet.Validate(out _);
+            Assert.Equal(FramePacketError.None, result.Error);
+            Assert.Equal(0u, result.NumCommands);
+        }
+
+        [Fact]
+        public void TruncatedCommand()
+        {
+            using var packet = CreatePacket();
+            var data = packet.Data.ToArray();
+            var lastStart = data.Length - 16; //The empty transition is a header and 8 bytes
+
+            var result = FramePacket.Validate(data.AsSpan(0, data.Length - 8), out _);
+            Assert.Equal(FramePacketError.Truncated, result.Error);
+            Assert.Equal(2u, result.NumCommands);
+            Assert.Equal((uint)lastStart, result.ErrorOffset);
+        }
+
+        [Fact]
+        public void TruncatedHeader()
+        {
+            using var packet = CreatePacket();
+            var data = packet.Data.ToArray();
+            var lastStart = data.Length - 16;
+
+            var result = FramePacket.Validate(data.AsSpan(0, lastStart + 4), out _);
+            Assert.Equal(FramePacketError.Truncated, result.Error);
+            Assert.Equal(2u, result.NumCommands);
+            Assert.Equal((uint)lastStart, result.ErrorOffset);
+        }
+
+        [Fact]
+        public void SizeNotAligned()
+        {
+            using var packet = CreatePacket();
+            var data = packet.Data.ToArray();
+            SetCommandSize(data, 0, 20);
+
+            var result = FramePacket.Validate(data, out _);
+            Assert.Equal(FramePacketError.BadSize, result.Error);
+            Assert.Equal(0u, result.NumCommands);
+            Assert.Equal(0u, result.ErrorOffset);
+        }
+
+        [Fact]
+        public void SizeTooSmallForCommand()
+        {
+            using var packet = CreatePacket();
+            var data = packet.Data.ToArray();
+            //Dispatch is a 16 byte struct, only leave room for 8 of it
+            SetCommandSize(data, 0, 16);
+
+            var result = FramePacket.Validate(data, out _);
+            Assert.Equal(FramePacketError.BadSize, result.Error);
+            Assert.Equal(0u, result.NumCommands);
+        }
+
+        [Fact]
+        public void UnknownCommand()
+        {
+            using var packet = CreatePacket();
+            var data = packet.Data.ToArray();
+            BitConverter.GetBytes((ushort)0xFFFF).CopyTo(data, 0);
+
+            var result = FramePacket.Validate(data, out _);
+            Assert.Equal(FramePacketError.UnknownCommand, result.Error);
+            Assert.Equal(0u, result.NumCommands);
+        }
+    }
+}
@@ -0,0 +1,109 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Threading.Tasks;
+
+namespace DiligentEngine
+{
+    /// <summary>
+    /// Records commands on a worker thread into one of the deferred contexts from the GraphicsEngine.
+    /// Start recording with Begin and pass the result to Execute on the render thread once the commands
+    /// should run, they are then executed on the immediate context at that point. If no deferred context
+    /// is free the recording runs on the immediate context when Execute is called instead, so callers do
+    /// not need to check. Begin and Execute must be called from the render thread.
+    ///
+    /// Recordings run at the same time as whatever the render thread is doing, so they should not
+    /// transition the states of resources the render thread uses. Do the transitions on the immediate
+    /// context before calling Execute and use RESOURCE_STATE_TRANSITION_MODE_NONE or VERIFY when recording.
+    /// </summary>
+    public class DeferredCommandRecorder
+    {
+        public class Recording
+        {
+            internal IDeviceContext Context;
+            internal Action<IDeviceContext> Record;
+            internal Task<AutoPtr<ICommandList>> Task;
+        }
+
+        private readonly GraphicsEngine graphicsEngine;
+        private readonly Stack<IDeviceContext> freeContexts = new Stack<IDeviceContext>();
+        private readonly ICommandList[] commandLists = new ICommandList[1];
+
+        public DeferredCommandRecorder(GraphicsEngine graphicsEngine)
+        {
+            this.graphicsEngine = graphicsEngine;
+            foreach (var context in graphicsEngine.DeferredContexts)
+            {
+                freeContexts.Push(context);
+            }
+        }
+
+        /// <summary>
+        /// The number of deferred contexts that are not recording right now.
+        /// </summary>
+        public int FreeContexts => freeContexts.Count;
+
+        /// <summary>
+        /// Start recording commands. The record function runs on a worker thread if there is a deferred
+        /// context available.
+        /// </summary>
+        public Recording Begin(Action<IDeviceContext> record)
+        {
+            var recording = new Recording();
+            if (freeContexts.Count == 0)
+            {
+                recording.Record = record;
+                return recording;
+            }
+
+            var context = freeContexts.Pop();
+            recording.Context = context;
+            recording.Task = Task.Run(() =>
+            {
+                //There is only ever one immediate context, it has id 0
+                context.Begin(0);
+                try
+                {
+                    record(context);
+                }
+                catch
+                {
+                    context.FinishCommandList()?.Dispose();
+                    throw;
+                }
+                return context.FinishCommandList();
+            });
+            return recording;
+        }
+
+        /// <summary>
+        /// Wait for the recording to finish and execute its commands on the immediate context. Any
+        /// exception from the record function is rethrown here.
+        /// </summary>
+        public void Execute(Recording recording)
+        {
+            var immediateContext = graphicsEngine.ImmediateContext;
+            if (recording.Context == null)
+            {
+                recording.Record(immediateContext);
+                return;
+            }
+
+            try
+            {
+                using var commandList = recording.Task.GetAwaiter().GetResult();
+                if (commandList != null)
+                {
+                    commandLists[0] = commandList.Obj;
+                    immediateContext.ExecuteCommandLists(commandLists);
+                    commandLists[0] = null;
+                }
+            }
+            finally
+            {
+                //Dynamic resources the deferred context used are released after its commands have been submitted
+                recording.Context.FinishFrame();
+                freeContexts.Push(recording.Context);
+            }
+        }
+    }
+}
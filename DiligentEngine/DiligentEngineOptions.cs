@@ -28,5 +28,39 @@ namespace DiligentEngine
         public UpsamplingMethod UpsamplingMethod { get; set; } = UpsamplingMethod.None;
 
         public float FSR1RenderPercentage { get; set; } = 0.75f;
+
+        /// <summary>
+        /// Change the FSR1 render percentage every frame to hold FSR1TargetFrameRate. The color buffer is
+        /// created at FSR1RenderPercentage, which is the largest it can go, and rays are traced into part of it.
+        /// </summary>
+        public bool FSR1DynamicResolution { get; set; }
+
+        /// <summary>
+        /// The smallest render percentage dynamic resolution can go down to.
+        /// </summary>
+        public float FSR1MinRenderPercentage { get; set; } = 0.5f;
+
+        /// <summary>
+        /// The frame rate dynamic resolution tries to hold.
+        /// </summary>
+        public float FSR1TargetFrameRate { get; set; } = 60.0f;
+
+        /// <summary>
+        /// The size of the staging ring textures loaded off the render thread are streamed through.
+        /// Set to 0 to always create immutable textures.
+        /// </summary>
+        public UInt64 TextureUploadRingSize { get; set; } = 64 * 1024 * 1024;
+
+        /// <summary>
+        /// The folder compiled shader bytecode and the pipeline state cache are saved to. Leave null to
+        /// compile everything on every run.
+        /// </summary>
+        public String ShaderCacheDirectory { get; set; }
+
+        /// <summary>
+        /// The number of deferred contexts to create for recording commands on other threads. The
+        /// DeferredCommandRecorder records on the immediate context when this is 0.
+        /// </summary>
+        public UInt32 NumDeferredContexts { get; set; }
     }
 }
@@ -23,7 +23,12 @@ namespace DiligentEngine
             this.engineFactory = new GraphicsEngine();
 
             serviceCollection.AddSingleton<GraphicsEngine>(this.engineFactory); //Externally managed
+            serviceCollection.AddSingleton<TextureUploader>();
             serviceCollection.AddSingleton<TextureLoader>();
+            serviceCollection.AddSingleton<ShaderCache>();
+            serviceCollection.AddSingleton<GpuTimer>();
+            serviceCollection.AddSingleton<DeferredCommandRecorder>();
+            serviceCollection.AddSingleton<GpuMemoryTracker>();
         }
 
         public void Link(PluginManager pluginManager, IServiceProvider serviceProvider)
@@ -31,7 +36,7 @@ namespace DiligentEngine
             var window = serviceProvider.GetRequiredService<OSWindow>();
             var options = serviceProvider.GetRequiredService<DiligentEngineOptions>();
             var swapChainDesc = new SwapChainDesc();
-            this.engineFactory.CreateDeviceAndSwapChain(window.WindowHandle, swapChainDesc, options.Features, options.RenderApi, options.DeviceId);
+            this.engineFactory.CreateDeviceAndSwapChain(window.WindowHandle, swapChainDesc, options.Features, options.RenderApi, options.DeviceId, options.NumDeferredContexts);
 
             window.Resized += w =>
             {
@@ -0,0 +1,32 @@
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using System.Text;
+
+using Uint8 = System.Byte;
+using Int8 = System.SByte;
+using Bool = System.Boolean;
+using Uint32 = System.UInt32;
+using Uint64 = System.UInt64;
+using Float32 = System.Single;
+using Uint16 = System.UInt16;
+using PVoid = System.IntPtr;
+using float4 = Engine.Vector4;
+using float3 = Engine.Vector3;
+using float2 = Engine.Vector2;
+using float4x4 = Engine.Matrix4x4;
+using BOOL = System.Boolean;
+
+namespace DiligentEngine
+{
+    public enum QUERY_TYPE :  Uint8
+    {
+        QUERY_TYPE_UNDEFINED = 0,
+        QUERY_TYPE_OCCLUSION,
+        QUERY_TYPE_BINARY_OCCLUSION,
+        QUERY_TYPE_TIMESTAMP,
+        QUERY_TYPE_PIPELINE_STATISTICS,
+        QUERY_TYPE_DURATION,
+        QUERY_TYPE_NUM_TYPES,
+    }
+}
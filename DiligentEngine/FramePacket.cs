@@ -0,0 +1,278 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using System.Text;
+
+using Uint8 = System.Byte;
+using Uint16 = System.UInt16;
+using Uint32 = System.UInt32;
+using Uint64 = System.UInt64;
+
+namespace DiligentEngine
+{
+    public enum FramePacketError : int
+    {
+        None = 0,
+        Truncated = 1,
+        BadSize = 2,
+        UnknownCommand = 3,
+        NullObject = 4,
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct FramePacketResult
+    {
+        public Uint32 NumCommands;
+        public Uint32 BytesRead;
+        public FramePacketError Error;
+        public Uint32 ErrorOffset;
+    }
+
+    /// <summary>
+    /// A reusable buffer of device context commands that are replayed natively in one call with
+    /// IDeviceContext.ExecutePacket. Write the commands for a frame in order, execute and the packet
+    /// is reset for the next frame. The buffer lives in native memory so it never moves and is only
+    /// reallocated when it has to grow.
+    ///
+    /// The format must match FramePacket.h in the wrapper. Every command is an 8 byte header
+    /// (command, reserved, size) followed by a fixed struct and then any trailing arrays, padded
+    /// to 8 bytes. Object pointers are always written as 64 bits.
+    /// </summary>
+    public unsafe class FramePacket : IDisposable
+    {
+        enum Command : Uint16
+        {
+            UpdateBuffer = 1,
+            TransitionResourceStates = 2,
+            UpdateSBT = 3,
+            SetPipelineState = 4,
+            CommitShaderResources = 5,
+            SetRenderTarget = 6,
+            TraceRays = 7,
+            Draw = 8,
+            DrawIndexed = 9,
+            SetVertexBuffer = 10,
+            SetIndexBuffer = 11,
+            DispatchCompute = 12,
+        }
+
+        private const int HeaderSize = 8;
+
+        private byte* buffer;
+        private int capacity;
+        private int size;
+        private Uint32 commandCount;
+
+        public FramePacket(int initialCapacity = 16 * 1024)
+        {
+            capacity = Math.Max(initialCapacity, 256);
+            buffer = (byte*)Marshal.AllocHGlobal(capacity);
+        }
+
+        public void Dispose()
+        {
+            if (buffer != null)
+            {
+                Marshal.FreeHGlobal(new IntPtr(buffer));
+                buffer = null;
+            }
+        }
+
+        /// <summary>
+        /// The number of bytes written so far.
+        /// </summary>
+        public int Size => size;
+
+        /// <summary>
+        /// The number of commands written so far.
+        /// </summary>
+        public Uint32 CommandCount => commandCount;
+
+        internal IntPtr Buffer => new IntPtr(buffer);
+
+        /// <summary>
+        /// The bytes written so far. This is only good until the next command is written.
+        /// </summary>
+        public ReadOnlySpan<byte> Data => new ReadOnlySpan<byte>(buffer, size);
+
+        /// <summary>
+        /// Clear the packet so it can be written again.
+        /// </summary>
+        public void Reset()
+        {
+            size = 0;
+            commandCount = 0;
+        }
+
+        public void UpdateBuffer(IBuffer pBuffer, Uint64 Offset, Uint32 Size, IntPtr pData, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+        {
+            var body = BeginCommand(Command.UpdateBuffer, 32 + (int)Size);
+            WritePtr(body, pBuffer);
+            *(Uint64*)(body + 8) = Offset;
+            *(Uint64*)(body + 16) = Size;
+            *(Uint32*)(body + 24) = (Uint32)StateTransitionMode;
+            System.Buffer.MemoryCopy(pData.ToPointer(), body + 32, Size, Size);
+        }
+
+        public void TransitionResourceStates(List<StateTransitionDesc> pResourceBarriers)
+        {
+            var count = pResourceBarriers.Count;
+            var body = BeginCommand(Command.TransitionResourceStates, 8 + count * sizeof(StateTransitionDescPassStruct));
+            *(Uint32*)body = (Uint32)count;
+            var barriers = (StateTransitionDescPassStruct*)(body + 8);
+            for (int i = 0; i < count; ++i)
+            {
+                var barrier = pResourceBarriers[i];
+                barriers[i] = new StateTransitionDescPassStruct
+                {
+                    pResourceBefore = barrier.pResourceBefore == null ? IntPtr.Zero : barrier.pResourceBefore.objPtr,
+                    pResource = barrier.pResource == null ? IntPtr.Zero : barrier.pResource.objPtr,
+                    FirstMipLevel = barrier.FirstMipLevel,
+                    MipLevelsCount = barrier.MipLevelsCount,
+                    FirstArraySlice = barrier.FirstArraySlice,
+                    ArraySliceCount = barrier.ArraySliceCount,
+                    OldState = barrier.OldState,
+                    NewState = barrier.NewState,
+                    TransitionType = barrier.TransitionType,
+                    Flags = barrier.Flags,
+                };
+            }
+        }
+
+        public void UpdateSBT(IShaderBindingTable pSBT)
+        {
+            var body = BeginCommand(Command.UpdateSBT, 8);
+            WritePtr(body, pSBT);
+        }
+
+        public void SetPipelineState(IPipelineState pPipelineState)
+        {
+            var body = BeginCommand(Command.SetPipelineState, 8);
+            WritePtr(body, pPipelineState);
+        }
+
+        public void CommitShaderResources(IShaderResourceBinding pShaderResourceBinding, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+        {
+            var body = BeginCommand(Command.CommitShaderResources, 16);
+            WritePtr(body, pShaderResourceBinding);
+            *(Uint32*)(body + 8) = (Uint32)StateTransitionMode;
+        }
+
+        public void SetRenderTarget(ITextureView renderTarget, ITextureView depthStencil, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+        {
+            var body = BeginCommand(Command.SetRenderTarget, 24);
+            WritePtr(body, renderTarget);
+            WritePtr(body + 8, depthStencil);
+            *(Uint32*)(body + 16) = (Uint32)StateTransitionMode;
+        }
+
+        public void TraceRays(TraceRaysAttribs Attribs)
+        {
+            var body = BeginCommand(Command.TraceRays, 24);
+            WritePtr(body, Attribs.pSBT);
+            *(Uint32*)(body + 8) = Attribs.DimensionX;
+            *(Uint32*)(body + 12) = Attribs.DimensionY;
+            *(Uint32*)(body + 16) = Attribs.DimensionZ;
+        }
+
+        public void Draw(DrawAttribs Attribs)
+        {
+            var body = (Uint32*)BeginCommand(Command.Draw, 24);
+            body[0] = Attribs.NumVertices;
+            body[1] = (Uint32)Attribs.Flags;
+            body[2] = Attribs.NumInstances;
+            body[3] = Attribs.StartVertexLocation;
+            body[4] = Attribs.FirstInstanceLocation;
+        }
+
+        public void DrawIndexed(DrawIndexedAttribs Attribs)
+        {
+            var body = (Uint32*)BeginCommand(Command.DrawIndexed, 32);
+            body[0] = Attribs.NumIndices;
+            body[1] = (Uint32)Attribs.IndexType;
+            body[2] = (Uint32)Attribs.Flags;
+            body[3] = Attribs.NumInstances;
+            body[4] = Attribs.FirstIndexLocation;
+            body[5] = Attribs.BaseVertex;
+            body[6] = Attribs.FirstInstanceLocation;
+        }
+
+        public void SetVertexBuffer(Uint32 StartSlot, IBuffer pBuffer, Uint64 Offset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode, SET_VERTEX_BUFFERS_FLAGS Flags)
+        {
+            var body = BeginCommand(Command.SetVertexBuffer, 32);
+            WritePtr(body, pBuffer);
+            *(Uint64*)(body + 8) = Offset;
+            *(Uint32*)(body + 16) = StartSlot;
+            *(Uint32*)(body + 20) = (Uint32)StateTransitionMode;
+            *(Uint32*)(body + 24) = (Uint32)Flags;
+        }
+
+        public void SetIndexBuffer(IBuffer pIndexBuffer, Uint64 ByteOffset, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
+        {
+            var body = BeginCommand(Command.SetIndexBuffer, 24);
+            WritePtr(body, pIndexBuffer);
+            *(Uint64*)(body + 8) = ByteOffset;
+            *(Uint32*)(body + 16) = (Uint32)StateTransitionMode;
+        }
+
+        public void DispatchCompute(DispatchComputeAttribs Attribs)
+        {
+            var body = (Uint32*)BeginCommand(Command.DispatchCompute, 16);
+            body[0] = Attribs.ThreadGroupCountX;
+            body[1] = Attribs.ThreadGroupCountY;
+            body[2] = Attribs.ThreadGroupCountZ;
+        }
+
+        /// <summary>
+        /// Decode the packet natively without touching a device. This checks the packet is well formed
+        /// and can be used to time the cost of decoding on its own. The checksum is computed from the
+        /// decoded commands so the work can't be skipped.
+        /// </summary>
+        public FramePacketResult Validate(out Uint64 checksum)
+        {
+            return Validate(Data, out checksum);
+        }
+
+        /// <summary>
+        /// Decode packet data natively without touching a device, see Validate.
+        /// </summary>
+        public static FramePacketResult Validate(ReadOnlySpan<byte> packet, out Uint64 checksum)
+        {
+            FramePacketResult result;
+            Uint64 sum;
+            fixed (byte* data = packet)
+            {
+                FramePacket_Validate(new IntPtr(data), (Uint32)packet.Length, &result, &sum);
+            }
+            checksum = sum;
+            return result;
+        }
+
+        private byte* BeginCommand(Command command, int bodySize)
+        {
+            var commandSize = (HeaderSize + bodySize + 7) & ~7;
+            if (size + commandSize > capacity)
+            {
+                var newCapacity = Math.Max(capacity * 2, size + commandSize);
+                buffer = (byte*)Marshal.ReAllocHGlobal(new IntPtr(buffer), new IntPtr(newCapacity));
+                capacity = newCapacity;
+            }
+
+            var start = buffer + size;
+            new Span<byte>(start, commandSize).Clear();
+            *(Uint16*)start = (Uint16)command;
+            *(Uint32*)(start + 4) = (Uint32)commandSize;
+            size += commandSize;
+            ++commandCount;
+            return start + HeaderSize;
+        }
+
+        private static void WritePtr(byte* dest, IObject obj)
+        {
+            *(Uint64*)dest = obj == null ? 0 : (Uint64)obj.objPtr.ToInt64();
+        }
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void FramePacket_Validate(IntPtr pPacket, Uint32 Size, FramePacketResult* pResult, Uint64* pChecksum);
+    }
+}
@@ -0,0 +1,125 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Text;
+
+using Uint32 = System.UInt32;
+using Uint64 = System.UInt64;
+
+namespace DiligentEngine
+{
+    /// <summary>
+    /// Sub allocates per frame data out of one USAGE_DYNAMIC buffer so it can be written straight into
+    /// mapped memory instead of going through UpdateBuffer, which copies through a staging buffer and
+    /// needs a state transition. The first Map after Reset uses MAP_FLAG_DISCARD, which gets fresh memory
+    /// from the context's upload ring, and the rest use MAP_FLAG_NO_OVERWRITE at increasing offsets.
+    /// Dynamic memory only lasts for the frame it was mapped in, so call Reset and write everything again
+    /// every frame the buffer is used. Each context keeps its own dynamic memory, only map a ring from one
+    /// context a frame. Constant buffers are bound whole, give them a ring sized for one write.
+    /// </summary>
+    public class FrameRingBuffer : IDisposable
+    {
+        private AutoPtr<IBuffer> buffer;
+        private Uint64 head;
+        private bool discarded;
+
+        public FrameRingBuffer(IRenderDevice device, String name, Uint64 size, BIND_FLAGS bindFlags)
+        {
+            var desc = new BufferDesc();
+            desc.Name = name;
+            desc.Usage = USAGE.USAGE_DYNAMIC;
+            desc.BindFlags = bindFlags;
+            desc.CPUAccessFlags = CPU_ACCESS_FLAGS.CPU_ACCESS_WRITE;
+            desc.Size = size;
+            buffer = device.CreateBuffer(desc)
+                ?? throw new InvalidOperationException($"Cannot create frame ring buffer '{name}'");
+            Size = size;
+        }
+
+        public void Dispose()
+        {
+            buffer.Dispose();
+        }
+
+        public IBuffer Buffer => buffer.Obj;
+
+        public Uint64 Size { get; private set; }
+
+        /// <summary>
+        /// The bytes allocated since the last Reset.
+        /// </summary>
+        public Uint64 Used => head;
+
+        /// <summary>
+        /// Start a new frame, the next Map discards everything written before.
+        /// </summary>
+        public void Reset()
+        {
+            head = 0;
+            discarded = false;
+        }
+
+        /// <summary>
+        /// Map size bytes at the next offset that is a multiple of alignment. Returns IntPtr.Zero if the
+        /// ring does not have room this frame. Call Unmap once the data is written.
+        /// </summary>
+        public IntPtr Map(IDeviceContext context, Uint64 size, Uint64 alignment, out Uint64 offset)
+        {
+            var start = (head + alignment - 1) / alignment * alignment;
+            if (start + size > Size)
+            {
+                offset = 0;
+                return IntPtr.Zero;
+            }
+
+            var data = context.MapBuffer(buffer.Obj, MAP_TYPE.MAP_WRITE, discarded ? MAP_FLAGS.MAP_FLAG_NO_OVERWRITE : MAP_FLAGS.MAP_FLAG_DISCARD);
+            if (data == IntPtr.Zero)
+            {
+                offset = 0;
+                return IntPtr.Zero;
+            }
+
+            discarded = true;
+            head = start + size;
+            offset = start;
+            return new IntPtr(data.ToInt64() + (long)start);
+        }
+
+        public void Unmap(IDeviceContext context)
+        {
+            context.UnmapBuffer(buffer.Obj, MAP_TYPE.MAP_WRITE);
+        }
+
+        /// <summary>
+        /// Copy a value into the ring and return its offset. Throws if the ring is full.
+        /// </summary>
+        public unsafe Uint64 Write<T>(IDeviceContext context, in T value, Uint64 alignment = 16)
+            where T : unmanaged
+        {
+            var data = Map(context, (Uint64)sizeof(T), alignment, out var offset);
+            if (data == IntPtr.Zero)
+            {
+                throw new InvalidOperationException($"Frame ring buffer is full, it has {Size} bytes and {head} are used.");
+            }
+            *(T*)data.ToPointer() = value;
+            Unmap(context);
+            return offset;
+        }
+
+        /// <summary>
+        /// Copy a span into the ring and return its offset. Throws if the ring is full.
+        /// </summary>
+        public unsafe Uint64 Write<T>(IDeviceContext context, ReadOnlySpan<T> values, Uint64 alignment = 16)
+            where T : unmanaged
+        {
+            var size = (Uint64)(sizeof(T) * values.Length);
+            var data = Map(context, size, alignment, out var offset);
+            if (data == IntPtr.Zero)
+            {
+                throw new InvalidOperationException($"Frame ring buffer is full, it has {Size} bytes and {head} are used.");
+            }
+            values.CopyTo(new Span<T>(data.ToPointer(), values.Length));
+            Unmap(context);
+            return offset;
+        }
+    }
+}
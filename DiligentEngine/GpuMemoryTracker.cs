@@ -0,0 +1,182 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using System.Text;
+
+using Uint32 = System.UInt32;
+using Uint64 = System.UInt64;
+
+namespace DiligentEngine
+{
+    /// <summary>
+    /// Must match GpuMemoryCategory in GpuMemoryTracker.h
+    /// </summary>
+    public enum GpuMemoryCategory : Uint32
+    {
+        Buffer,
+        Staging,
+        Texture,
+        /// <summary>
+        /// Textures that can be rendered or written to, these are usually screen sized.
+        /// </summary>
+        RenderTarget,
+        /// <summary>
+        /// Blas, tlas and the buffers used to build them.
+        /// </summary>
+        AccelerationStructure,
+    }
+
+    public struct GpuMemoryEntry
+    {
+        public String Name;
+        public GpuMemoryCategory Category;
+        public Uint64 Size;
+        /// <summary>
+        /// True if the backend could not report the size and Size is an estimate. This happens for
+        /// acceleration structures on anything but D3D12.
+        /// </summary>
+        public bool Estimated;
+    }
+
+    /// <summary>
+    /// A soft limit on gpu memory, either for one category or for everything. While the tracked memory is
+    /// over the limit OverBudget fires every time the tracker updates, so a cache can trim some of what it
+    /// holds each frame until it is back under.
+    /// </summary>
+    public class GpuMemoryBudget
+    {
+        public delegate void OverBudgetHandler(GpuMemoryBudget budget, Uint64 used);
+
+        public GpuMemoryBudget(Uint64 limit, GpuMemoryCategory? category = null)
+        {
+            this.Limit = limit;
+            this.Category = category;
+        }
+
+        /// <summary>
+        /// The category this budget covers, null for all of them.
+        /// </summary>
+        public GpuMemoryCategory? Category { get; private set; }
+
+        public Uint64 Limit { get; set; }
+
+        /// <summary>
+        /// True if the memory was over the limit the last time the tracker updated.
+        /// </summary>
+        public bool IsOver { get; internal set; }
+
+        public event OverBudgetHandler OverBudget;
+
+        internal void FireOverBudget(Uint64 used)
+        {
+            OverBudget?.Invoke(this, used);
+        }
+    }
+
+    /// <summary>
+    /// Reports the gpu memory held by buffers, textures and acceleration structures created through the
+    /// wrapper. The native side records every object as it is created and forgets it once it is released.
+    /// Call Update once a frame on the render thread to refresh the totals and check the budgets.
+    /// </summary>
+    public class GpuMemoryTracker
+    {
+        private const int CategoryCount = (int)GpuMemoryCategory.AccelerationStructure + 1;
+
+        [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi)]
+        struct GpuMemoryEntryPassStruct
+        {
+            public Uint64 Size;
+            public GpuMemoryCategory Category;
+            [MarshalAs(UnmanagedType.U1)]
+            public bool Estimated;
+            [MarshalAs(UnmanagedType.ByValTStr, SizeConst = 64)]
+            public String Name;
+        }
+
+        private readonly Uint64[] totals = new Uint64[CategoryCount];
+        private readonly List<GpuMemoryBudget> budgets = new List<GpuMemoryBudget>();
+
+        /// <summary>
+        /// The bytes in all categories as of the last update.
+        /// </summary>
+        public Uint64 Total { get; private set; }
+
+        /// <summary>
+        /// The bytes in a category as of the last update.
+        /// </summary>
+        public Uint64 GetTotal(GpuMemoryCategory category)
+        {
+            return totals[(int)category];
+        }
+
+        public void AddBudget(GpuMemoryBudget budget)
+        {
+            budgets.Add(budget);
+        }
+
+        public void RemoveBudget(GpuMemoryBudget budget)
+        {
+            budgets.Remove(budget);
+        }
+
+        /// <summary>
+        /// Refresh the totals and fire OverBudget on any budget that is over its limit.
+        /// </summary>
+        public void Update()
+        {
+            GpuMemoryTracker_GetTotals(totals);
+            Uint64 total = 0;
+            foreach (var size in totals)
+            {
+                total += size;
+            }
+            Total = total;
+
+            //Backwards so a handler can remove its own budget
+            for (var i = budgets.Count - 1; i >= 0; --i)
+            {
+                var budget = budgets[i];
+                var used = budget.Category != null ? GetTotal(budget.Category.Value) : Total;
+                budget.IsOver = used > budget.Limit;
+                if (budget.IsOver)
+                {
+                    budget.FireOverBudget(used);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Get every tracked object that has not been released. Names longer than 63 characters are cut off.
+        /// This allocates, use it to find what is using the memory, not every frame.
+        /// </summary>
+        public List<GpuMemoryEntry> GetSnapshot()
+        {
+            var pass = new GpuMemoryEntryPassStruct[0];
+            Uint32 count;
+            //Objects can be created between the calls, so try again until everything fits
+            while ((count = GpuMemoryTracker_GetSnapshot(pass, (Uint32)pass.Length)) > pass.Length)
+            {
+                pass = new GpuMemoryEntryPassStruct[count + 16];
+            }
+
+            var result = new List<GpuMemoryEntry>((int)count);
+            for (var i = 0; i < count; ++i)
+            {
+                result.Add(new GpuMemoryEntry()
+                {
+                    Name = pass[i].Name,
+                    Category = pass[i].Category,
+                    Size = pass[i].Size,
+                    Estimated = pass[i].Estimated,
+                });
+            }
+            return result;
+        }
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void GpuMemoryTracker_GetTotals([Out] Uint64[] pTotals);
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern Uint32 GpuMemoryTracker_GetSnapshot([In, Out] GpuMemoryEntryPassStruct[] pEntries, Uint32 Capacity);
+    }
+}
@@ -0,0 +1,190 @@
+﻿using Engine;
+using System;
+using System.Collections.Generic;
+
+namespace DiligentEngine
+{
+    /// <summary>
+    /// Times named sections of gpu work with timestamp queries. Results are read back FrameLatency
+    /// frames later so the cpu never waits on the gpu and are sent to the PerformanceMonitor as
+    /// "GPU name" timelapses next to the cpu timings. Does nothing if the device does not support
+    /// timestamp queries. Only use this from the render thread.
+    /// </summary>
+    public class GpuTimer : IDisposable
+    {
+        /// <summary>
+        /// The number of frames of queries kept in flight before their results are read.
+        /// </summary>
+        public const int FrameLatency = 4;
+
+        class Scope
+        {
+            public AutoPtr<IQuery> Begin;
+            public AutoPtr<IQuery> End;
+            public String Name;
+            public String RecordName;
+            public bool Pending;
+        }
+
+        private readonly GraphicsEngine graphicsEngine;
+        private readonly Dictionary<String, Scope>[] frames = new Dictionary<String, Scope>[FrameLatency];
+        private readonly Dictionary<String, TimeSpan> lastDurations = new Dictionary<String, TimeSpan>();
+        private int frameIndex = 0;
+
+        public GpuTimer(GraphicsEngine graphicsEngine)
+        {
+            this.graphicsEngine = graphicsEngine;
+            for (int i = 0; i < FrameLatency; ++i)
+            {
+                frames[i] = new Dictionary<String, Scope>();
+            }
+            Enabled = graphicsEngine.RenderDevice.DeviceFeatures_TimestampQueries;
+        }
+
+        public void Dispose()
+        {
+            foreach (var frame in frames)
+            {
+                foreach (var scope in frame.Values)
+                {
+                    scope.Begin.Dispose();
+                    scope.End.Dispose();
+                }
+                frame.Clear();
+            }
+        }
+
+        /// <summary>
+        /// True if the device supports timestamp queries.
+        /// </summary>
+        public bool Enabled { get; private set; }
+
+        /// <summary>
+        /// Call once at the start of each frame before any scopes. This moves to the next set of queries
+        /// and publishes the results from FrameLatency frames ago. Anything the gpu has still not finished
+        /// by then is dropped.
+        /// </summary>
+        public void BeginFrame()
+        {
+            if (!Enabled)
+            {
+                return;
+            }
+
+            frameIndex = (frameIndex + 1) % FrameLatency;
+            foreach (var scope in frames[frameIndex].Values)
+            {
+                if (!scope.Pending)
+                {
+                    continue;
+                }
+                scope.Pending = false;
+
+                //Read the end first, if it is ready the begin is too
+                if (scope.End.Obj.GetData_Timestamp(out var endCounter, out var frequency)
+                    && scope.Begin.Obj.GetData_Timestamp(out var beginCounter, out _)
+                    && frequency > 0 && endCounter >= beginCounter)
+                {
+                    lastDurations[scope.Name] = TimeSpan.FromSeconds((double)(endCounter - beginCounter) / frequency);
+                    PerformanceMonitor.record(scope.RecordName, ToMilliseconds(beginCounter, frequency), ToMilliseconds(endCounter, frequency));
+                }
+                else
+                {
+                    scope.Begin.Obj.Invalidate();
+                    scope.End.Obj.Invalidate();
+                }
+            }
+        }
+
+        /// <summary>
+        /// Write the start timestamp for a named section. Each name can be used once per frame.
+        /// </summary>
+        public void Begin(String name)
+        {
+            if (!Enabled)
+            {
+                return;
+            }
+
+            var frame = frames[frameIndex];
+            if (!frame.TryGetValue(name, out var scope))
+            {
+                var device = graphicsEngine.RenderDevice;
+                scope = new Scope()
+                {
+                    Begin = device.CreateQuery($"{name} GPU Begin", QUERY_TYPE.QUERY_TYPE_TIMESTAMP),
+                    End = device.CreateQuery($"{name} GPU End", QUERY_TYPE.QUERY_TYPE_TIMESTAMP),
+                    Name = name,
+                    RecordName = $"GPU {name}",
+                };
+                if (scope.Begin == null || scope.End == null)
+                {
+                    scope.Begin?.Dispose();
+                    scope.End?.Dispose();
+                    Enabled = false;
+                    return;
+                }
+                frame.Add(name, scope);
+            }
+
+            graphicsEngine.ImmediateContext.EndQuery(scope.Begin.Obj);
+        }
+
+        /// <summary>
+        /// Write the end timestamp for a named section started with Begin.
+        /// </summary>
+        public void End(String name)
+        {
+            if (!Enabled)
+            {
+                return;
+            }
+
+            if (frames[frameIndex].TryGetValue(name, out var scope))
+            {
+                graphicsEngine.ImmediateContext.EndQuery(scope.End.Obj);
+                scope.Pending = true;
+            }
+        }
+
+        /// <summary>
+        /// Time everything until the returned value is disposed, use with a using statement.
+        /// </summary>
+        public TimerScope Time(String name)
+        {
+            Begin(name);
+            return new TimerScope(this, name);
+        }
+
+        /// <summary>
+        /// Get the last gpu time read back for a named section. This is FrameLatency frames old.
+        /// </summary>
+        public bool TryGetDuration(String name, out TimeSpan duration)
+        {
+            return lastDurations.TryGetValue(name, out duration);
+        }
+
+        //Split the division so large counters keep their sub millisecond precision
+        private static double ToMilliseconds(ulong counter, ulong frequency)
+        {
+            return counter / frequency * 1000.0 + counter % frequency * 1000.0 / frequency;
+        }
+
+        public struct TimerScope : IDisposable
+        {
+            private readonly GpuTimer timer;
+            private readonly String name;
+
+            internal TimerScope(GpuTimer timer, String name)
+            {
+                this.timer = timer;
+                this.name = name;
+            }
+
+            public void Dispose()
+            {
+                timer.End(name);
+            }
+        }
+    }
+}
@@ -1,5 +1,7 @@
 ﻿using Engine;
 using System;
+using System.Collections.Generic;
+using System.Linq;
 using System.Runtime.InteropServices;
 
 using Uint8 = System.Byte;
@@ -31,6 +33,8 @@ namespace DiligentEngine
         AutoPtr<IRenderDevice> RenderDevicePtr;
         AutoPtr<IDeviceContext> ImmediateContextPtr;
         AutoPtr<ISwapChain> SwapChainPtr;
+        AutoPtr<IDeviceContext>[] DeferredContextPtrs = new AutoPtr<IDeviceContext>[0];
+        IDeviceContext[] deferredContexts = new IDeviceContext[0];
 
         [StructLayout(LayoutKind.Sequential)]
         struct CreateDeviceAndSwapChainResult
@@ -44,13 +48,18 @@ namespace DiligentEngine
         {
             this.ImmediateContext.Flush(); //The sample app flushes this out when it shuts down
 
+            foreach (var context in this.DeferredContextPtrs)
+            {
+                context.Dispose();
+            }
             this.RenderDevicePtr.Dispose();
             this.ImmediateContextPtr.Dispose();
             this.SwapChainPtr.Dispose();
         }
 
-        internal void CreateDeviceAndSwapChain(IntPtr hwnd, SwapChainDesc swapChainDesc, FeatureFlags features, RenderApi renderApi, UInt32? deviceId)
+        internal void CreateDeviceAndSwapChain(IntPtr hwnd, SwapChainDesc swapChainDesc, FeatureFlags features, RenderApi renderApi, UInt32? deviceId, UInt32 numDeferredContexts)
         {
+            var deferredContextPtrs = new IntPtr[numDeferredContexts];
             var result = GenericEngineFactory_CreateDeviceAndSwapChain(
             hwnd
             , features
@@ -66,6 +75,8 @@ namespace DiligentEngine
             , swapChainDesc.DefaultStencilValue
             , swapChainDesc.IsPrimary
             , deviceId.HasValue ? deviceId.Value + 1 : 0
+            , numDeferredContexts
+            , deferredContextPtrs
             );
 
             if(result.m_pDevice == IntPtr.Zero)
@@ -81,6 +92,11 @@ namespace DiligentEngine
             this.RenderDevicePtr = new AutoPtr<IRenderDevice>(new IRenderDevice(result.m_pDevice), false);
             this.ImmediateContextPtr = new AutoPtr<IDeviceContext>(new IDeviceContext(result.m_pImmediateContext), false);
             this.SwapChainPtr = new AutoPtr<ISwapChain>(new ISwapChain(result.m_pSwapChain), false);
+            this.DeferredContextPtrs = deferredContextPtrs
+                .Where(i => i != IntPtr.Zero)
+                .Select(i => new AutoPtr<IDeviceContext>(new IDeviceContext(i), false))
+                .ToArray();
+            this.deferredContexts = this.DeferredContextPtrs.Select(i => i.Obj).ToArray();
         }
 
         public IRenderDevice RenderDevice => this.RenderDevicePtr.Obj;
@@ -89,6 +105,12 @@ namespace DiligentEngine
 
         public ISwapChain SwapChain => this.SwapChainPtr.Obj;
 
+        /// <summary>
+        /// The deferred contexts created with the device. Each one can record commands on its own thread,
+        /// see DeferredCommandRecorder.
+        /// </summary>
+        public IReadOnlyList<IDeviceContext> DeferredContexts => this.deferredContexts;
+
         [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
         private static extern CreateDeviceAndSwapChainResult GenericEngineFactory_CreateDeviceAndSwapChain(
             IntPtr hWnd
@@ -105,6 +127,8 @@ namespace DiligentEngine
             , Uint8 DefaultStencilValue          
             , [MarshalAs(UnmanagedType.I1)] bool IsPrimary
             , UInt32 deviceId
+            , Uint32 NumDeferredContexts
+            , [Out] IntPtr[] ppDeferredContexts
             );
     }
 }
@@ -26,19 +26,14 @@ namespace DiligentEngine
     /// </summary>
     public partial class IBottomLevelAS
     {
-        public UInt32 ScratchBufferSizes_Build => IBottomLevelAS_GetScratchBufferSizes_Build(this.objPtr);
-
-        public UInt32 ScratchBufferSizes_Update => IBottomLevelAS_GetScratchBufferSizes_Update(this.objPtr);
-
-
-        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
-        private static extern UInt32 IBottomLevelAS_GetScratchBufferSizes_Build(
-            IntPtr objPtr
-        );
+        /// <summary>
+        /// The size of the memory backing this blas in bytes. This is 0 if the backend can't report it.
+        /// </summary>
+        public Uint64 MemorySize => IBottomLevelAS_GetMemorySize(this.objPtr);
 
 
         [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
-        private static extern UInt32 IBottomLevelAS_GetScratchBufferSizes_Update(
+        private static extern Uint64 IBottomLevelAS_GetMemorySize(
             IntPtr objPtr
         );
     }
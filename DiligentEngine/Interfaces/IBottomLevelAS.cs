@@ -32,7 +32,22 @@ namespace DiligentEngine
             this._ConstructorCalled();
         }
         partial void _ConstructorCalled();
+        /// <summary>
+        /// Fill out result from GetScratchBufferSizes() with one call.
+        /// </summary>
+        public void GetScratchBufferSizes(ref ScratchBufferSizesPassStruct result)
+        {
+            IBottomLevelAS_GetScratchBufferSizes(
+                this.objPtr
+                , ref result
+            );
+        }
 
 
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void IBottomLevelAS_GetScratchBufferSizes(
+            IntPtr objPtr
+            , ref ScratchBufferSizesPassStruct result
+        );
     }
 }
@@ -52,6 +52,16 @@ namespace DiligentEngine
             );
             return theReturnValue != IntPtr.Zero ? new IBufferView(theReturnValue) : null;
         }
+        /// <summary>
+        /// Fill out result from GetDesc() with one call.
+        /// </summary>
+        public void GetDesc(ref BufferDescPassStruct result)
+        {
+            IBuffer_GetDesc(
+                this.objPtr
+                , ref result
+            );
+        }
 
 
         [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
@@ -59,5 +69,10 @@ namespace DiligentEngine
             IntPtr objPtr
             , BUFFER_VIEW_TYPE ViewType
         );
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void IBuffer_GetDesc(
+            IntPtr objPtr
+            , ref BufferDescPassStruct result
+        );
     }
 }
@@ -55,6 +55,21 @@ namespace DiligentEngine
                 , Attribs.Update
             );
         }
+        /// <summary>
+        /// Replay all the commands written to the packet in one call and reset it. Throws if the
+        /// packet is malformed; commands before the bad one have already been executed at that point.
+        /// </summary>
+        public unsafe void ExecutePacket(FramePacket packet)
+        {
+            FramePacketResult result;
+            IDeviceContext_ExecutePacket(this.objPtr, packet.Buffer, (Uint32)packet.Size, &result);
+            packet.Reset();
+            if (result.Error != FramePacketError.None)
+            {
+                throw new InvalidOperationException($"Frame packet error '{result.Error}' at offset {result.ErrorOffset} after {result.NumCommands} commands.");
+            }
+        }
+
         public void SetRenderTarget(ITextureView renderTarget, ITextureView depthStencil, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
         {
             IDeviceContext_SetRenderTarget(objPtr,
@@ -140,6 +155,124 @@ namespace DiligentEngine
             );
         }
 
+        /// <summary>
+        /// Write the size pBLAS will have after compaction to pDestBuffer at DestBufferOffset as a Uint64.
+        /// The BLAS must be built with RAYTRACING_BUILD_AS_ALLOW_COMPACTION.
+        /// </summary>
+        public void WriteBLASCompactedSize(IBottomLevelAS pBLAS, IBuffer pDestBuffer, Uint64 DestBufferOffset, RESOURCE_STATE_TRANSITION_MODE BLASTransitionMode, RESOURCE_STATE_TRANSITION_MODE BufferTransitionMode)
+        {
+            IDeviceContext_WriteBLASCompactedSize(this.objPtr, pBLAS.objPtr, pDestBuffer.objPtr, DestBufferOffset, BLASTransitionMode, BufferTransitionMode);
+        }
+
+        /// <summary>
+        /// Copy pSrc into pDst. With COPY_AS_MODE_COMPACT pDst must be created with BottomLevelASDesc.CompactedSize
+        /// set to the size from WriteBLASCompactedSize.
+        /// </summary>
+        public void CopyBLAS(IBottomLevelAS pSrc, IBottomLevelAS pDst, COPY_AS_MODE Mode, RESOURCE_STATE_TRANSITION_MODE SrcTransitionMode, RESOURCE_STATE_TRANSITION_MODE DstTransitionMode)
+        {
+            IDeviceContext_CopyBLAS(this.objPtr, pSrc.objPtr, pDst.objPtr, Mode, SrcTransitionMode, DstTransitionMode);
+        }
+
+        /// <summary>
+        /// Get the compacted sizes of the given blases into compactedSizes. This waits for the gpu to be idle
+        /// to read the sizes back, so only use it while loading. Throws if the readback buffers can't be created.
+        /// </summary>
+        public void ReadBLASCompactedSizes(IRenderDevice device, IBottomLevelAS[] blases, Uint64[] compactedSizes)
+        {
+            if (compactedSizes.Length < blases.Length)
+            {
+                throw new ArgumentException("The compactedSizes array must be at least as long as the blases array.", nameof(compactedSizes));
+            }
+
+            if (!IDeviceContext_ReadBLASCompactedSizes(this.objPtr, device.objPtr, (Uint32)blases.Length, blases.Select(i => i.objPtr).ToArray(), compactedSizes))
+            {
+                throw new InvalidOperationException("Cannot create the buffers to read back blas compacted sizes");
+            }
+        }
+
+        /// <summary>
+        /// Copy Size bytes from pSrcBuffer at SrcOffset to pDstBuffer at DstOffset.
+        /// </summary>
+        public void CopyBuffer(IBuffer pSrcBuffer, Uint64 SrcOffset, RESOURCE_STATE_TRANSITION_MODE SrcBufferTransitionMode, IBuffer pDstBuffer, Uint64 DstOffset, Uint64 Size, RESOURCE_STATE_TRANSITION_MODE DstBufferTransitionMode)
+        {
+            IDeviceContext_CopyBuffer(this.objPtr, pSrcBuffer.objPtr, SrcOffset, SrcBufferTransitionMode, pDstBuffer.objPtr, DstOffset, Size, DstBufferTransitionMode);
+        }
+
+        /// <summary>
+        /// Records all commands in a deferred context into a command list. The context can be used
+        /// again after calling Begin. Returns null if nothing was recorded or this is an immediate context.
+        /// </summary>
+        public AutoPtr<ICommandList> FinishCommandList()
+        {
+            var ptr = IDeviceContext_FinishCommandList(this.objPtr);
+            if (ptr == IntPtr.Zero)
+            {
+                return null;
+            }
+            return new AutoPtr<ICommandList>(new ICommandList(ptr), false);
+        }
+
+        /// <summary>
+        /// Execute command lists recorded by deferred contexts, in order. Only immediate contexts can
+        /// execute command lists. Call FinishFrame on the deferred contexts after this.
+        /// </summary>
+        public void ExecuteCommandLists(IEnumerable<ICommandList> commandLists)
+        {
+            var ptrs = commandLists.Select(i => i.objPtr).ToArray();
+            if (ptrs.Length > 0)
+            {
+                IDeviceContext_ExecuteCommandLists(this.objPtr, (Uint32)ptrs.Length, ptrs);
+            }
+        }
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr IDeviceContext_FinishCommandList(IntPtr objPtr);
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void IDeviceContext_ExecuteCommandLists(IntPtr objPtr,
+            Uint32 NumCommandLists,
+            IntPtr[] ppCommandLists);
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void IDeviceContext_CopyBuffer(IntPtr objPtr,
+            IntPtr pSrcBuffer,
+            Uint64 SrcOffset,
+            RESOURCE_STATE_TRANSITION_MODE SrcBufferTransitionMode,
+            IntPtr pDstBuffer,
+            Uint64 DstOffset,
+            Uint64 Size,
+            RESOURCE_STATE_TRANSITION_MODE DstBufferTransitionMode);
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void IDeviceContext_WriteBLASCompactedSize(IntPtr objPtr,
+            IntPtr pBLAS,
+            IntPtr pDestBuffer,
+            Uint64 DestBufferOffset,
+            RESOURCE_STATE_TRANSITION_MODE BLASTransitionMode,
+            RESOURCE_STATE_TRANSITION_MODE BufferTransitionMode);
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void IDeviceContext_CopyBLAS(IntPtr objPtr,
+            IntPtr pSrc,
+            IntPtr pDst,
+            COPY_AS_MODE Mode,
+            RESOURCE_STATE_TRANSITION_MODE SrcTransitionMode,
+            RESOURCE_STATE_TRANSITION_MODE DstTransitionMode);
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        private static extern bool IDeviceContext_ReadBLASCompactedSizes(IntPtr objPtr,
+            IntPtr pDevice,
+            Uint32 Count,
+            IntPtr[] ppBLAS,
+            [Out] Uint64[] pCompactedSizes);
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern unsafe void IDeviceContext_ExecutePacket(IntPtr objPtr,
+            IntPtr pPacket,
+            Uint32 Size,
+            FramePacketResult* pResult);
+
         [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
         private static extern void IDeviceContext_SetRenderTarget(IntPtr objPtr,
             IntPtr ppRenderTarget,
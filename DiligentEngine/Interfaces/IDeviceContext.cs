@@ -33,6 +33,25 @@ namespace DiligentEngine
         }
         partial void _ConstructorCalled();
         /// <summary>
+        /// Begins recording commands in the deferred context.
+        /// 
+        /// This method must be called before any command in the deferred context may be recorded.
+        /// 
+        /// \param [in] ImmediateContextId - the ID of the immediate context where commands from this
+        /// deferred context will be executed,
+        /// see Diligent::DeviceContextDesc::ContextId.
+        /// 
+        /// \warning Command list recorded by the context must not be submitted to any other immediate context
+        /// other than one identified by ImmediateContextId.
+        /// </summary>
+        public void Begin(Uint32 ImmediateContextId)
+        {
+            IDeviceContext_Begin(
+                this.objPtr
+                , ImmediateContextId
+            );
+        }
+        /// <summary>
         /// Sets the pipeline state.
         /// \param [in] pPipelineState - Pointer to IPipelineState interface to bind to the context.
         /// 
@@ -218,6 +237,21 @@ namespace DiligentEngine
             );
         }
         /// <summary>
+        /// Executes a dispatch compute command.
+        /// \param [in] Attribs - Dispatch compute command attributes, see Diligent::DispatchComputeAttribs for details.
+        /// 
+        /// \remarks Supported contexts: graphics, compute.
+        /// </summary>
+        public void DispatchCompute(DispatchComputeAttribs Attribs)
+        {
+            IDeviceContext_DispatchCompute(
+                this.objPtr
+                , Attribs.ThreadGroupCountX
+                , Attribs.ThreadGroupCountY
+                , Attribs.ThreadGroupCountZ
+            );
+        }
+        /// <summary>
         /// Clears a depth-stencil view.
         /// \param [in] pView               - Pointer to ITextureView interface to clear. The view type must be
         /// Diligent::TEXTURE_VIEW_DEPTH_STENCIL.
@@ -290,6 +324,59 @@ namespace DiligentEngine
             );
         }
         /// <summary>
+        /// Tells the GPU to set a fence to a specified value after all previous work has completed.
+        /// \param [in] pFence - The fence to signal
+        /// \param [in] Value  - The value to set the fence to. This value must be greater than the
+        /// previously signaled value on the same fence.
+        /// 
+        /// \note The method does not flush the context (an application can do this explicitly if needed)
+        /// and the fence will be signaled only when the command context is flushed next time.
+        /// If an application needs to wait for the fence in a loop, it must flush the context
+        /// after signalling the fence.
+        /// 
+        /// \remarks Supported contexts: graphics, compute, transfer.
+        /// </summary>
+        public void EnqueueSignal(IFence pFence, Uint64 Value)
+        {
+            IDeviceContext_EnqueueSignal(
+                this.objPtr
+                , pFence.objPtr
+                , Value
+            );
+        }
+        /// <summary>
+        /// Marks the beginning of a query.
+        /// \param [in] pQuery - A pointer to a query object.
+        /// 
+        /// \remarks Only immediate contexts support queries.
+        /// 
+        /// \remarks Supported contexts: graphics, compute.
+        /// </summary>
+        public void BeginQuery(IQuery pQuery)
+        {
+            IDeviceContext_BeginQuery(
+                this.objPtr
+                , pQuery.objPtr
+            );
+        }
+        /// <summary>
+        /// Marks the end of a query.
+        /// \param [in] pQuery - A pointer to a query object.
+        /// 
+        /// \remarks A query must be ended by the same context that began it.
+        /// 
+        /// \remarks Timestamp queries only use EndQuery, BeginQuery must not be called for them.
+        /// 
+        /// \remarks Supported contexts: graphics, compute.
+        /// </summary>
+        public void EndQuery(IQuery pQuery)
+        {
+            IDeviceContext_EndQuery(
+                this.objPtr
+                , pQuery.objPtr
+            );
+        }
+        /// <summary>
         /// Submits all pending commands in the context for execution to the command queue.
         /// \remarks    Only immediate contexts can be flushed.\n
         /// Internally the method resets the state of the current command list/buffer.
@@ -362,6 +449,26 @@ namespace DiligentEngine
             );
         }
         /// <summary>
+        /// Finishes the current frame and releases dynamic resources allocated by the context.
+        /// 
+        /// For immediate context, this method is called automatically by ISwapChain::Present() of the primary
+        /// swap chain, but can also be called explicitly. For deferred contexts, the method must be called by the
+        /// application to release dynamic resources. The method has some overhead, so it is better to call it once
+        /// per frame, though it can be called with different frequency. Note that unless the GPU is idled,
+        /// the resources may actually be released several frames after the one they were used in last time.
+        /// \note After the call all dynamic resources become invalid and must be written again before the next use.
+        /// Also, all committed resources become invalid.\n
+        /// For deferred contexts, this method must be called after all command lists referencing dynamic resources
+        /// have been executed through immediate context.\n
+        /// The method does not Flush() the context.
+        /// </summary>
+        public void FinishFrame()
+        {
+            IDeviceContext_FinishFrame(
+                this.objPtr
+            );
+        }
+        /// <summary>
         /// Builds a bottom-level acceleration structure with the specified geometries.
         /// \param [in] Attribs - Structure describing build BLAS command attributes, see Diligent::BuildBLASAttribs for details.
         /// 
@@ -466,6 +573,11 @@ namespace DiligentEngine
         }
 
 
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void IDeviceContext_Begin(
+            IntPtr objPtr
+            , Uint32 ImmediateContextId
+        );
         [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
         private static extern void IDeviceContext_SetPipelineState(
             IntPtr objPtr
@@ -515,6 +627,13 @@ namespace DiligentEngine
             , Uint32 Attribs_FirstInstanceLocation
         );
         [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void IDeviceContext_DispatchCompute(
+            IntPtr objPtr
+            , Uint32 Attribs_ThreadGroupCountX
+            , Uint32 Attribs_ThreadGroupCountY
+            , Uint32 Attribs_ThreadGroupCountZ
+        );
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
         private static extern void IDeviceContext_ClearDepthStencil(
             IntPtr objPtr
             , IntPtr pView
@@ -531,6 +650,22 @@ namespace DiligentEngine
             , RESOURCE_STATE_TRANSITION_MODE StateTransitionMode
         );
         [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void IDeviceContext_EnqueueSignal(
+            IntPtr objPtr
+            , IntPtr pFence
+            , Uint64 Value
+        );
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void IDeviceContext_BeginQuery(
+            IntPtr objPtr
+            , IntPtr pQuery
+        );
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void IDeviceContext_EndQuery(
+            IntPtr objPtr
+            , IntPtr pQuery
+        );
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
         private static extern void IDeviceContext_Flush(
             IntPtr objPtr
         );
@@ -557,6 +692,10 @@ namespace DiligentEngine
             , MAP_TYPE MapType
         );
         [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void IDeviceContext_FinishFrame(
+            IntPtr objPtr
+        );
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
         private static extern void IDeviceContext_BuildBLAS(
             IntPtr objPtr
             , IntPtr Attribs_pBLAS
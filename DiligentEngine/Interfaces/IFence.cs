@@ -0,0 +1,70 @@
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using System.Text;
+using System.Linq;
+using Engine;
+
+using Uint8 = System.Byte;
+using Int8 = System.SByte;
+using Bool = System.Boolean;
+using Uint32 = System.UInt32;
+using Uint64 = System.UInt64;
+using Float32 = System.Single;
+using Uint16 = System.UInt16;
+using PVoid = System.IntPtr;
+using float4 = Engine.Vector4;
+using float3 = Engine.Vector3;
+using float2 = Engine.Vector2;
+using float4x4 = Engine.Matrix4x4;
+using BOOL = System.Boolean;
+
+namespace DiligentEngine
+    /// <summary>
+    /// Fence interface
+    /// </summary>
+    public partial class IFence :  IDeviceObject
+    {
+        public IFence(IntPtr objPtr)
+            : base(objPtr)
+        {
+            this._ConstructorCalled();
+        }
+        partial void _ConstructorCalled();
+        /// <summary>
+        /// Sets the fence to the specified value.
+        /// \param [in] Value - New value to set the fence to.
+        /// The value must be greater than the current value of the fence.
+        /// </summary>
+        public void Signal(Uint64 Value)
+        {
+            IFence_Signal(
+                this.objPtr
+                , Value
+            );
+        }
+        /// <summary>
+        /// Waits until the fence reaches or exceeds the specified value, on the host.
+        /// \param [in] Value - The value that the fence is waiting for to reach.
+        /// </summary>
+        public void Wait(Uint64 Value)
+        {
+            IFence_Wait(
+                this.objPtr
+                , Value
+            );
+        }
+
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void IFence_Signal(
+            IntPtr objPtr
+            , Uint64 Value
+        );
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void IFence_Wait(
+            IntPtr objPtr
+            , Uint64 Value
+        );
+    }
+}
@@ -0,0 +1,55 @@
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using System.Text;
+using System.Linq;
+using Engine;
+
+using Uint8 = System.Byte;
+using Int8 = System.SByte;
+using Bool = System.Boolean;
+using Uint32 = System.UInt32;
+using Uint64 = System.UInt64;
+using Float32 = System.Single;
+using Uint16 = System.UInt16;
+using PVoid = System.IntPtr;
+using float4 = Engine.Vector4;
+using float3 = Engine.Vector3;
+using float2 = Engine.Vector2;
+using float4x4 = Engine.Matrix4x4;
+using BOOL = System.Boolean;
+
+namespace DiligentEngine
+{
+    public partial class IPipelineStateCache :  IDeviceObject
+    {
+        /// <summary>
+        /// Get the cache contents so they can be saved and passed to IRenderDevice.CreatePipelineStateCache
+        /// on the next run. Returns null if there is nothing to save.
+        /// </summary>
+        public unsafe byte[] GetData()
+        {
+            IntPtr pData;
+            Uint64 size;
+            var pBlob = IPipelineStateCache_GetData(this.objPtr, &pData, &size);
+            if (pBlob == IntPtr.Zero)
+            {
+                return null;
+            }
+
+            try
+            {
+                var data = new byte[size];
+                Marshal.Copy(pData, data, 0, (int)size);
+                return data;
+            }
+            finally
+            {
+                new IObject(pBlob).Release();
+            }
+        }
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern unsafe IntPtr IPipelineStateCache_GetData(IntPtr objPtr, IntPtr* ppData, Uint64* pSize);
+    }
+}
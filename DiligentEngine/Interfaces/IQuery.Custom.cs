@@ -0,0 +1,58 @@
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using System.Text;
+using System.Linq;
+using Engine;
+
+using Uint8 = System.Byte;
+using Int8 = System.SByte;
+using Bool = System.Boolean;
+using Uint32 = System.UInt32;
+using Uint64 = System.UInt64;
+using Float32 = System.Single;
+using Uint16 = System.UInt16;
+using PVoid = System.IntPtr;
+using float4 = Engine.Vector4;
+using float3 = Engine.Vector3;
+using float2 = Engine.Vector2;
+using float4x4 = Engine.Matrix4x4;
+using BOOL = System.Boolean;
+
+namespace DiligentEngine
+{
+    public partial class IQuery :  IDeviceObject
+    {
+        /// <summary>
+        /// Get the result of a QUERY_TYPE_TIMESTAMP query. Returns false if the gpu has not reached the query yet.
+        /// </summary>
+        public unsafe bool GetData_Timestamp(out Uint64 counter, out Uint64 frequency, bool autoInvalidate = true)
+        {
+            Uint64 c, f;
+            var result = IQuery_GetData_Timestamp(this.objPtr, &c, &f, autoInvalidate);
+            counter = c;
+            frequency = f;
+            return result;
+        }
+
+        /// <summary>
+        /// Get the result of a QUERY_TYPE_DURATION query. Returns false if the gpu has not reached the end of the query yet.
+        /// </summary>
+        public unsafe bool GetData_Duration(out Uint64 duration, out Uint64 frequency, bool autoInvalidate = true)
+        {
+            Uint64 d, f;
+            var result = IQuery_GetData_Duration(this.objPtr, &d, &f, autoInvalidate);
+            duration = d;
+            frequency = f;
+            return result;
+        }
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        private static extern unsafe bool IQuery_GetData_Timestamp(IntPtr objPtr, Uint64* pCounter, Uint64* pFrequency, [MarshalAs(UnmanagedType.I1)] bool AutoInvalidate);
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        private static extern unsafe bool IQuery_GetData_Duration(IntPtr objPtr, Uint64* pDuration, Uint64* pFrequency, [MarshalAs(UnmanagedType.I1)] bool AutoInvalidate);
+    }
+}
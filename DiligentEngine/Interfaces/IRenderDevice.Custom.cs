@@ -100,10 +100,143 @@ namespace DiligentEngine
             , Uint32 macrosCount
         );
 
+        /// <summary>
+        /// Create a shader from bytecode saved with IShader.GetBytecode, this skips compilation. The
+        /// FilePath, Source and CompileFlags of the create info are ignored. Returns null on failure.
+        /// </summary>
+        public unsafe AutoPtr<IShader> CreateShader(ShaderCreateInfo ShaderCI, byte[] byteCode)
+        {
+            IntPtr theReturnValue;
+            fixed (byte* pByteCode = byteCode)
+            {
+                theReturnValue = IRenderDevice_CreateShader_ByteCode(
+                    this.objPtr
+                    , ShaderCI.EntryPoint
+                    , ShaderCI.UseCombinedTextureSamplers
+                    , ShaderCI.CombinedSamplerSuffix
+                    , ShaderCI.Desc.ShaderType
+                    , ShaderCI.Desc.Name
+                    , ShaderCI.SourceLanguage
+                    , ShaderCI.ShaderCompiler
+                    , ShaderCI.HLSLVersion.Major
+                    , ShaderCI.HLSLVersion.Minor
+                    , new IntPtr(pByteCode)
+                    , (Uint64)byteCode.Length
+                );
+            }
+            if (theReturnValue == IntPtr.Zero)
+            {
+                return null;
+            }
+            return new AutoPtr<IShader>(new IShader(theReturnValue), false);
+        }
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr IRenderDevice_CreateShader_ByteCode(
+            IntPtr objPtr
+            , String ShaderCI_EntryPoint
+            , [MarshalAs(UnmanagedType.I1)] bool ShaderCI_UseCombinedTextureSamplers
+            , String ShaderCI_CombinedSamplerSuffix
+            , SHADER_TYPE ShaderCI_Desc_ShaderType
+            , String ShaderCI_Desc_Name
+            , SHADER_SOURCE_LANGUAGE ShaderCI_SourceLanguage
+            , SHADER_COMPILER ShaderCI_ShaderCompiler
+            , Uint32 ShaderCI_HLSLVersion_Major
+            , Uint32 ShaderCI_HLSLVersion_Minor
+            , IntPtr ShaderCI_ByteCode
+            , Uint64 ShaderCI_ByteCodeSize
+        );
+
+        /// <summary>
+        /// Create a pipeline state cache, pass data from IPipelineStateCache.GetData to start from a saved
+        /// cache or null to start empty. Returns null if the backend does not support pipeline caches.
+        /// </summary>
+        public unsafe AutoPtr<IPipelineStateCache> CreatePipelineStateCache(String name, PSO_CACHE_MODE mode, byte[] data)
+        {
+            IntPtr theReturnValue;
+            fixed (byte* pData = data)
+            {
+                theReturnValue = IRenderDevice_CreatePipelineStateCache(
+                    this.objPtr
+                    , name
+                    , mode
+                    , new IntPtr(pData)
+                    , data != null ? (Uint32)data.Length : 0
+                );
+            }
+            if (theReturnValue == IntPtr.Zero)
+            {
+                return null;
+            }
+            return new AutoPtr<IPipelineStateCache>(new IPipelineStateCache(theReturnValue), false);
+        }
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr IRenderDevice_CreatePipelineStateCache(
+            IntPtr objPtr
+            , String Desc_Name
+            , PSO_CACHE_MODE Desc_Mode
+            , IntPtr pCacheData
+            , Uint32 CacheDataSize
+        );
+
+        public Uint32 AdapterInfo_VendorId => IRenderDevice_GetAdapterInfo_VendorId(this.objPtr);
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern Uint32 IRenderDevice_GetAdapterInfo_VendorId(IntPtr objPtr);
+
+        public Uint32 AdapterInfo_DeviceId => IRenderDevice_GetAdapterInfo_DeviceId(this.objPtr);
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern Uint32 IRenderDevice_GetAdapterInfo_DeviceId(IntPtr objPtr);
+
+        /// <summary>
+        /// True if the device was created with timestamp query support, check this before creating timestamp or duration queries.
+        /// </summary>
+        public bool DeviceFeatures_TimestampQueries => IRenderDevice_DeviceFeatures_TimestampQueries(this.objPtr);
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        private static extern bool IRenderDevice_DeviceFeatures_TimestampQueries(IntPtr objPtr);
+
+        /// <summary>
+        /// True if the device was created with bc texture support, check this before creating BC4, BC5 or BC7 textures.
+        /// </summary>
+        public bool DeviceFeatures_TextureCompressionBC => IRenderDevice_DeviceFeatures_TextureCompressionBC(this.objPtr);
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        private static extern bool IRenderDevice_DeviceFeatures_TextureCompressionBC(IntPtr objPtr);
+
+        public AutoPtr<IQuery> CreateQuery(String name, QUERY_TYPE type)
+        {
+            var theReturnValue = IRenderDevice_CreateQuery(this.objPtr, name, type);
+            return theReturnValue != IntPtr.Zero ? new AutoPtr<IQuery>(new IQuery(theReturnValue), false) : null;
+        }
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr IRenderDevice_CreateQuery(
+            IntPtr objPtr
+            , String Desc_Name
+            , QUERY_TYPE Desc_Type
+        );
+
+        public AutoPtr<IFence> CreateFence(String name, FENCE_TYPE type = FENCE_TYPE.FENCE_TYPE_CPU_WAIT_ONLY)
+        {
+            var theReturnValue = IRenderDevice_CreateFence(this.objPtr, name, type);
+            return theReturnValue != IntPtr.Zero ? new AutoPtr<IFence>(new IFence(theReturnValue), false) : null;
+        }
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr IRenderDevice_CreateFence(
+            IntPtr objPtr
+            , String Desc_Name
+            , FENCE_TYPE Desc_Type
+        );
+
+        /// <summary>
+        /// Get the ndc attribs as a new class, use GetNDCAttribs with a pass struct instead if this is needed often.
+        /// </summary>
         public NDCAttribs GetDeviceCaps_GetNDCAttribs()
         {
-            //This is not fast, does this on the unmanaged side too
-            var result = IRenderDevice_GetDeviceCaps_GetNDCAttribs(this.objPtr);
+            var result = new NDCAttribsPassStruct();
+            GetNDCAttribs(ref result);
             return new NDCAttribs()
             {
                 MinZ = result.MinZ,
@@ -112,9 +245,6 @@ namespace DiligentEngine
             };
         }
 
-        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
-        private static extern NDCAttribsPassStruct IRenderDevice_GetDeviceCaps_GetNDCAttribs(IntPtr objPtr);
-
         public Uint32 DeviceProperties_MaxRayTracingRecursionDepth => IRenderDevice_DeviceProperties_MaxRayTracingRecursionDepth(this.objPtr);
 
         [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
@@ -265,6 +265,36 @@ namespace DiligentEngine
                 , ImmutableSamplerDescPassStruct.ToStruct(PSOCreateInfo.PSODesc.ResourceLayout?.ImmutableSamplers)
                 , PSOCreateInfo.PSODesc.Name
                 , PSOCreateInfo.Flags
+                , PSOCreateInfo.pPSOCache?.objPtr ?? IntPtr.Zero
+            );
+            return theReturnValue != IntPtr.Zero ? new AutoPtr<IPipelineState>(new IPipelineState(theReturnValue), false) : null;
+        }
+        /// <summary>
+        /// Creates a new compute pipeline state object
+        /// \param [in]  PSOCreateInfo   - Compute pipeline state create info, see Diligent::ComputePipelineStateCreateInfo for details.
+        /// \param [out] ppPipelineState - Address of the memory location where a pointer to the
+        /// pipeline state interface will be written.
+        /// The function calls AddRef(), so that the new object will have
+        /// one reference.
+        /// </summary>
+        public AutoPtr<IPipelineState> CreateComputePipelineState(ComputePipelineStateCreateInfo PSOCreateInfo)
+        {
+            var theReturnValue = 
+            IRenderDevice_CreateComputePipelineState(
+                this.objPtr
+                , PSOCreateInfo.pCS?.objPtr ?? IntPtr.Zero
+                , PSOCreateInfo.PSODesc.PipelineType
+                , PSOCreateInfo.PSODesc.SRBAllocationGranularity
+                , PSOCreateInfo.PSODesc.ImmediateContextMask
+                , PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType
+                , PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableMergeStages
+                , PSOCreateInfo.PSODesc.ResourceLayout?.Variables != null ? (Uint32)PSOCreateInfo.PSODesc.ResourceLayout.Variables.Count : 0
+                , ShaderResourceVariableDescPassStruct.ToStruct(PSOCreateInfo.PSODesc.ResourceLayout?.Variables)
+                , PSOCreateInfo.PSODesc.ResourceLayout?.ImmutableSamplers != null ? (Uint32)PSOCreateInfo.PSODesc.ResourceLayout.ImmutableSamplers.Count : 0
+                , ImmutableSamplerDescPassStruct.ToStruct(PSOCreateInfo.PSODesc.ResourceLayout?.ImmutableSamplers)
+                , PSOCreateInfo.PSODesc.Name
+                , PSOCreateInfo.Flags
+                , PSOCreateInfo.pPSOCache?.objPtr ?? IntPtr.Zero
             );
             return theReturnValue != IntPtr.Zero ? new AutoPtr<IPipelineState>(new IPipelineState(theReturnValue), false) : null;
         }
@@ -303,6 +333,7 @@ namespace DiligentEngine
                 , ImmutableSamplerDescPassStruct.ToStruct(PSOCreateInfo.PSODesc.ResourceLayout?.ImmutableSamplers)
                 , PSOCreateInfo.PSODesc.Name
                 , PSOCreateInfo.Flags
+                , PSOCreateInfo.pPSOCache?.objPtr ?? IntPtr.Zero
             );
             return theReturnValue != IntPtr.Zero ? new AutoPtr<IPipelineState>(new IPipelineState(theReturnValue), false) : null;
         }
@@ -369,6 +400,16 @@ namespace DiligentEngine
             );
             return theReturnValue != IntPtr.Zero ? new AutoPtr<IShaderBindingTable>(new IShaderBindingTable(theReturnValue), false) : null;
         }
+        /// <summary>
+        /// Fill out result from GetDeviceInfo().GetNDCAttribs() with one call.
+        /// </summary>
+        public void GetNDCAttribs(ref NDCAttribsPassStruct result)
+        {
+            IRenderDevice_GetNDCAttribs(
+                this.objPtr
+                , ref result
+            );
+        }
 
 
         [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
@@ -520,6 +561,24 @@ namespace DiligentEngine
             , ImmutableSamplerDescPassStruct[] PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers
             , String PSOCreateInfo_PSODesc_Name
             , PSO_CREATE_FLAGS PSOCreateInfo_Flags
+            , IntPtr PSOCreateInfo_pPSOCache
+        );
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr IRenderDevice_CreateComputePipelineState(
+            IntPtr objPtr
+            , IntPtr PSOCreateInfo_pCS
+            , PIPELINE_TYPE PSOCreateInfo_PSODesc_PipelineType
+            , Uint32 PSOCreateInfo_PSODesc_SRBAllocationGranularity
+            , Uint64 PSOCreateInfo_PSODesc_ImmediateContextMask
+            , SHADER_RESOURCE_VARIABLE_TYPE PSOCreateInfo_PSODesc_ResourceLayout_DefaultVariableType
+            , SHADER_TYPE PSOCreateInfo_PSODesc_ResourceLayout_DefaultVariableMergeStages
+            , Uint32 PSOCreateInfo_PSODesc_ResourceLayout_NumVariables
+            , ShaderResourceVariableDescPassStruct[] PSOCreateInfo_PSODesc_ResourceLayout_Variables
+            , Uint32 PSOCreateInfo_PSODesc_ResourceLayout_NumImmutableSamplers
+            , ImmutableSamplerDescPassStruct[] PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers
+            , String PSOCreateInfo_PSODesc_Name
+            , PSO_CREATE_FLAGS PSOCreateInfo_Flags
+            , IntPtr PSOCreateInfo_pPSOCache
         );
         [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
         private static extern IntPtr IRenderDevice_CreateRayTracingPipelineState(
@@ -546,6 +605,7 @@ namespace DiligentEngine
             , ImmutableSamplerDescPassStruct[] PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers
             , String PSOCreateInfo_PSODesc_Name
             , PSO_CREATE_FLAGS PSOCreateInfo_Flags
+            , IntPtr PSOCreateInfo_pPSOCache
         );
         [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
         private static extern IntPtr IRenderDevice_CreateBLAS(
@@ -574,5 +634,10 @@ namespace DiligentEngine
             , IntPtr Desc_pPSO
             , String Desc_Name
         );
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void IRenderDevice_GetNDCAttribs(
+            IntPtr objPtr
+            , ref NDCAttribsPassStruct result
+        );
     }
 }
@@ -0,0 +1,47 @@
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using System.Text;
+using System.Linq;
+using Engine;
+
+using Uint8 = System.Byte;
+using Int8 = System.SByte;
+using Bool = System.Boolean;
+using Uint32 = System.UInt32;
+using Uint64 = System.UInt64;
+using Float32 = System.Single;
+using Uint16 = System.UInt16;
+using PVoid = System.IntPtr;
+using float4 = Engine.Vector4;
+using float3 = Engine.Vector3;
+using float2 = Engine.Vector2;
+using float4x4 = Engine.Matrix4x4;
+using BOOL = System.Boolean;
+
+namespace DiligentEngine
+{
+    public partial class IShader :  IDeviceObject
+    {
+        /// <summary>
+        /// Copy the compiled bytecode out of the shader, this is DXIL for D3D12 and SPIRV for Vulkan.
+        /// Returns null if the shader has no bytecode.
+        /// </summary>
+        public unsafe byte[] GetBytecode()
+        {
+            Uint64 size;
+            var pBytecode = IShader_GetBytecode(this.objPtr, &size);
+            if (pBytecode == IntPtr.Zero || size == 0)
+            {
+                return null;
+            }
+
+            var bytecode = new byte[size];
+            Marshal.Copy(pBytecode, bytecode, 0, (int)size);
+            return bytecode;
+        }
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern unsafe IntPtr IShader_GetBytecode(IntPtr objPtr, Uint64* pSize);
+    }
+}
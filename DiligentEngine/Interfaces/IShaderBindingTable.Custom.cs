@@ -0,0 +1,86 @@
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using System.Text;
+using System.Linq;
+using Engine;
+
+using Uint8 = System.Byte;
+using Int8 = System.SByte;
+using Bool = System.Boolean;
+using Uint32 = System.UInt32;
+using Uint64 = System.UInt64;
+using Float32 = System.Single;
+using Uint16 = System.UInt16;
+using PVoid = System.IntPtr;
+using float4 = Engine.Vector4;
+using float3 = Engine.Vector3;
+using float2 = Engine.Vector2;
+using float4x4 = Engine.Matrix4x4;
+using BOOL = System.Boolean;
+
+namespace DiligentEngine
+{
+    public partial class IShaderBindingTable :  IDeviceObject
+    {
+        /// <summary>
+        /// Bind count hit groups in one call. Each entry binds the shader group with NameTable id shaderGroupNameIds[i] at
+        /// bindingIndices[i] with dataSizes[i] bytes of shader record data from data starting at dataOffsets[i].
+        /// The binding index is the instance hit group index from ITopLevelAS.GetInstanceHitGroupIndices
+        /// plus the ray offset.
+        /// 
+        /// \note Access to the SBT and TLAS must be externally synchronized.
+        /// </summary>
+        public void BindHitGroupsByIndex(Uint32 count, Uint32[] bindingIndices, Uint32[] shaderGroupNameIds, byte[] data, Uint32[] dataOffsets, Uint32[] dataSizes)
+        {
+            IShaderBindingTable_BindHitGroupsByIndex(
+                this.objPtr
+                , count
+                , bindingIndices
+                , shaderGroupNameIds
+                , data
+                , dataOffsets
+                , dataSizes
+            );
+        }
+
+        /// <summary>
+        /// The same as BindHitGroupForInstance, but the instance and shader group names are NameTable ids.
+        /// </summary>
+        public void BindHitGroupForInstance(ITopLevelAS pTLAS, Uint32 InstanceNameId, Uint32 RayOffsetInHitGroupIndex, Uint32 ShaderGroupNameId, IntPtr pData, Uint32 DataSize)
+        {
+            IShaderBindingTable_BindHitGroupForInstanceById(
+                this.objPtr
+                , pTLAS.objPtr
+                , InstanceNameId
+                , RayOffsetInHitGroupIndex
+                , ShaderGroupNameId
+                , pData
+                , DataSize
+            );
+        }
+
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void IShaderBindingTable_BindHitGroupsByIndex(
+            IntPtr objPtr
+            , Uint32 Count
+            , Uint32[] pBindingIndices
+            , Uint32[] pShaderGroupNameIds
+            , byte[] pData
+            , Uint32[] pDataOffsets
+            , Uint32[] pDataSizes
+        );
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void IShaderBindingTable_BindHitGroupForInstanceById(
+            IntPtr objPtr
+            , IntPtr pTLAS
+            , Uint32 InstanceNameId
+            , Uint32 RayOffsetInHitGroupIndex
+            , Uint32 ShaderGroupNameId
+            , IntPtr pData
+            , Uint32 DataSize
+        );
+    }
+}
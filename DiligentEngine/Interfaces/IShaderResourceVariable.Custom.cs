@@ -46,6 +46,30 @@ namespace DiligentEngine
             );
         }
 
+        private IntPtr[] rangeObjects = new IntPtr[0];
+
+        /// <summary>
+        /// Bind NumElements objects starting at FirstElement in ppObjects to the same elements of the
+        /// array. Use this to update a few elements of a large array without marshalling all of it.
+        /// </summary>
+        public void SetArrayRange(List<IDeviceObject> ppObjects, Uint32 FirstElement, Uint32 NumElements)
+        {
+            if (rangeObjects.Length < NumElements)
+            {
+                rangeObjects = new IntPtr[NumElements];
+            }
+            for (var i = 0; i < NumElements; ++i)
+            {
+                rangeObjects[i] = ppObjects[(int)FirstElement + i].objPtr;
+            }
+            IShaderResourceVariable_SetArray(
+                this.objPtr
+                , rangeObjects
+                , FirstElement
+                , NumElements
+            );
+        }
+
         [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
         private static extern void IShaderResourceVariable_SetArray(
             IntPtr objPtr
@@ -21,7 +21,9 @@ namespace DiligentEngine
 
         partial void _ConstructorCalled()
         {
-            BackBufferRtvs = new ITextureView[this.GetDesc_BufferCount];
+            var desc = new SwapChainDescPassStruct();
+            GetDesc(ref desc);
+            BackBufferRtvs = new ITextureView[desc.BufferCount];
         }
         /// <summary>
         /// Returns render target view of the current back buffer in the swap chain
@@ -57,43 +59,6 @@ namespace DiligentEngine
             return currentBackBuffer;
         }
 
-        public TEXTURE_FORMAT GetDesc_ColorBufferFormat => ISwapChain_GetDesc_ColorBufferFormat(objPtr);
-
-        public TEXTURE_FORMAT GetDesc_DepthBufferFormat => ISwapChain_GetDesc_DepthBufferFormat(objPtr);
-
-        public Uint32 GetDesc_BufferCount => ISwapChain_GetDesc_BufferCount(objPtr);
-
-        public Uint32 GetDesc_Width => ISwapChain_GetDesc_Width(objPtr);
-
-        public Uint32 GetDesc_Height => ISwapChain_GetDesc_Height(objPtr);
-
-        public SURFACE_TRANSFORM GetDesc_PreTransform => ISwapChain_GetDesc_PreTransform(objPtr);
-
-
-        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
-        private static extern TEXTURE_FORMAT ISwapChain_GetDesc_ColorBufferFormat(
-            IntPtr objPtr
-        );
-        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
-        private static extern TEXTURE_FORMAT ISwapChain_GetDesc_DepthBufferFormat(
-            IntPtr objPtr
-        );
-        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
-        private static extern Uint32 ISwapChain_GetDesc_BufferCount(
-            IntPtr objPtr
-        );
-        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
-        private static extern Uint32 ISwapChain_GetDesc_Width(
-            IntPtr objPtr
-        );
-        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
-        private static extern Uint32 ISwapChain_GetDesc_Height(
-            IntPtr objPtr
-        );
-        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
-        private static extern SURFACE_TRANSFORM ISwapChain_GetDesc_PreTransform(
-            IntPtr objPtr
-        );
         [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
         private static extern IntPtr ISwapChain_GetCurrentBackBufferRTV(
             IntPtr objPtr
@@ -87,6 +87,16 @@ namespace DiligentEngine
             }
             return _GetDepthBufferDSV;
         }
+        /// <summary>
+        /// Fill out result from GetDesc() with one call.
+        /// </summary>
+        public void GetDesc(ref SwapChainDescPassStruct result)
+        {
+            ISwapChain_GetDesc(
+                this.objPtr
+                , ref result
+            );
+        }
 
 
         [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
@@ -105,5 +115,10 @@ namespace DiligentEngine
         private static extern IntPtr ISwapChain_GetDepthBufferDSV(
             IntPtr objPtr
         );
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void ISwapChain_GetDesc(
+            IntPtr objPtr
+            , ref SwapChainDescPassStruct result
+        );
     }
 }
@@ -87,6 +87,16 @@ namespace DiligentEngine
             );
             return theReturnValue != IntPtr.Zero ? new ITextureView(theReturnValue) : null;
         }
+        /// <summary>
+        /// Fill out result from GetDesc() with one call.
+        /// </summary>
+        public void GetDesc(ref TextureDescPassStruct result)
+        {
+            ITexture_GetDesc(
+                this.objPtr
+                , ref result
+            );
+        }
 
 
         [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
@@ -108,5 +118,10 @@ namespace DiligentEngine
             IntPtr objPtr
             , TEXTURE_VIEW_TYPE ViewType
         );
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void ITexture_GetDesc(
+            IntPtr objPtr
+            , ref TextureDescPassStruct result
+        );
     }
 }
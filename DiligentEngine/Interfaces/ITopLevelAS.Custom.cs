@@ -29,20 +29,23 @@ namespace DiligentEngine
         public const Uint32 TLAS_INSTANCE_DATA_SIZE = 64;
         public const Uint32 TLAS_INSTANCE_OFFSET_AUTO = ~0u;
 
-        public UInt32 ScratchBufferSizes_Build => ITopLevelAS_GetScratchBufferSizes_Build(this.objPtr);
-
-        public UInt32 ScratchBufferSizes_Update => ITopLevelAS_GetScratchBufferSizes_Update(this.objPtr);
-
-
-        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
-        private static extern UInt32 ITopLevelAS_GetScratchBufferSizes_Build(
-            IntPtr objPtr
-        );
+        /// <summary>
+        /// Look up the ContributionToHitGroupIndex for count instances by their NameTable id. This is the base index
+        /// for the instance's hit groups in the shader binding table, add the ray offset to get the
+        /// index to pass to IShaderBindingTable.BindHitGroupsByIndex. These stay valid until the tlas is rebuilt.
+        /// </summary>
+        public void GetInstanceHitGroupIndices(Uint32 count, Uint32[] instanceNameIds, Uint32[] hitGroupIndices)
+        {
+            ITopLevelAS_GetInstanceHitGroupIndices(this.objPtr, count, instanceNameIds, hitGroupIndices);
+        }
 
 
         [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
-        private static extern UInt32 ITopLevelAS_GetScratchBufferSizes_Update(
+        private static extern void ITopLevelAS_GetInstanceHitGroupIndices(
             IntPtr objPtr
+            , Uint32 Count
+            , Uint32[] pInstanceNameIds
+            , [Out] Uint32[] pHitGroupIndices
         );
     }
 }
@@ -0,0 +1,61 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using System.Text;
+
+using Uint32 = System.UInt32;
+
+namespace DiligentEngine
+{
+    /// <summary>
+    /// Native table of interned names. Register a name once to get a stable id and pass the id or the
+    /// native string for it to Diligent instead of marshalling a String every call. The native string
+    /// for an id is valid until the last reference is released. Id 0 is always null.
+    /// </summary>
+    public static class NameTable
+    {
+        public const Uint32 NullId = 0;
+
+        /// <summary>
+        /// Register a name, adding a reference if it already exists. Every call must be balanced by a
+        /// call to Release.
+        /// </summary>
+        public static Uint32 Register(String name)
+        {
+            if (name == null)
+            {
+                return NullId;
+            }
+            return NameTable_Register(name);
+        }
+
+        public static void Release(Uint32 id)
+        {
+            if (id != NullId)
+            {
+                NameTable_Release(id);
+            }
+        }
+
+        /// <summary>
+        /// Get the native string for an id. This can be stored in pass structs that take a char*.
+        /// </summary>
+        public static IntPtr GetName(Uint32 id)
+        {
+            if (id == NullId)
+            {
+                return IntPtr.Zero;
+            }
+            return NameTable_GetName(id);
+        }
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern Uint32 NameTable_Register(String name);
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void NameTable_Release(Uint32 id);
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr NameTable_GetName(Uint32 id);
+    }
+}
@@ -0,0 +1,249 @@
+﻿using Microsoft.Extensions.Logging;
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Security.Cryptography;
+using System.Text;
+using System.Threading;
+
+namespace DiligentEngine
+{
+    /// <summary>
+    /// Saves compiled shader bytecode and the pipeline state cache to disk so later runs can skip
+    /// compilation. Bytecode is keyed by a hash of the final shader source from the ShaderLoader, the
+    /// macros, the compile settings and the adapter, so any change to those compiles again. Nothing is
+    /// saved if DiligentEngineOptions.ShaderCacheDirectory is null.
+    /// </summary>
+    public class ShaderCache : IDisposable
+    {
+        //Change this if the cache format or the key changes so old files are ignored
+        private const int Version = 1;
+
+        private readonly GraphicsEngine graphicsEngine;
+        private readonly DiligentEngineOptions options;
+        private readonly ILogger<ShaderCache> logger;
+        private readonly String shaderDirectory;
+        private readonly String pipelineCacheFile;
+        private readonly object pipelineCacheLock = new object();
+        private AutoPtr<IPipelineStateCache> pipelineCache;
+        private bool pipelineCacheCreated = false;
+        private int hits;
+        private int misses;
+        private long compileTicks;
+
+        public ShaderCache(GraphicsEngine graphicsEngine, DiligentEngineOptions options, ILogger<ShaderCache> logger)
+        {
+            this.graphicsEngine = graphicsEngine;
+            this.options = options;
+            this.logger = logger;
+
+            if (options.ShaderCacheDirectory != null)
+            {
+                var device = graphicsEngine.RenderDevice;
+                var adapter = $"{options.RenderApi}_{device.AdapterInfo_VendorId:X4}_{device.AdapterInfo_DeviceId:X4}";
+                shaderDirectory = Path.Combine(options.ShaderCacheDirectory, adapter);
+                pipelineCacheFile = Path.Combine(shaderDirectory, $"PipelineCache{Version}.bin");
+            }
+        }
+
+        public void Dispose()
+        {
+            lock (pipelineCacheLock)
+            {
+                if (pipelineCache != null)
+                {
+                    var data = pipelineCache.Obj.GetData();
+                    if (data != null)
+                    {
+                        Save(pipelineCacheFile, data);
+                    }
+                    pipelineCache.Dispose();
+                    pipelineCache = null;
+                }
+            }
+        }
+
+        public bool Enabled => shaderDirectory != null;
+
+        /// <summary>
+        /// The number of shaders created from saved bytecode.
+        /// </summary>
+        public int Hits => hits;
+
+        /// <summary>
+        /// The number of shaders that had to be compiled.
+        /// </summary>
+        public int Misses => misses;
+
+        /// <summary>
+        /// The total time spent compiling shaders that were not in the cache.
+        /// </summary>
+        public TimeSpan CompileTime => TimeSpan.FromTicks(Interlocked.Read(ref compileTicks));
+
+        /// <summary>
+        /// True if every shader created so far came from the cache.
+        /// </summary>
+        public bool IsWarm => hits > 0 && misses == 0;
+
+        /// <summary>
+        /// The pipeline state cache to set as pPSOCache when creating pipelines. This is null if the cache
+        /// is disabled or the backend does not support pipeline caches.
+        /// </summary>
+        public IPipelineStateCache PipelineStateCache
+        {
+            get
+            {
+                lock (pipelineCacheLock)
+                {
+                    if (!pipelineCacheCreated && Enabled)
+                    {
+                        pipelineCacheCreated = true;
+                        var data = Load(pipelineCacheFile);
+                        pipelineCache = graphicsEngine.RenderDevice.CreatePipelineStateCache("Pipeline state cache", PSO_CACHE_MODE.PSO_CACHE_MODE_LOAD_STORE, data);
+                        if (pipelineCache == null && data != null)
+                        {
+                            //Saved data the driver will not take, start over with an empty cache
+                            logger.LogWarning($"Could not load pipeline cache '{pipelineCacheFile}', starting with an empty one.");
+                            pipelineCache = graphicsEngine.RenderDevice.CreatePipelineStateCache("Pipeline state cache", PSO_CACHE_MODE.PSO_CACHE_MODE_LOAD_STORE, null);
+                        }
+                    }
+                    return pipelineCache?.Obj;
+                }
+            }
+        }
+
+        public AutoPtr<IShader> CreateShader(ShaderCreateInfo ShaderCI)
+        {
+            return CreateShader(ShaderCI, null);
+        }
+
+        /// <summary>
+        /// Create a shader from saved bytecode if this exact shader has been compiled before, otherwise
+        /// compile it and save the bytecode. Returns null if the shader cannot be compiled.
+        /// </summary>
+        public AutoPtr<IShader> CreateShader(ShaderCreateInfo ShaderCI, ShaderMacroHelper macros)
+        {
+            var device = graphicsEngine.RenderDevice;
+            String file = null;
+            if (Enabled)
+            {
+                file = Path.Combine(shaderDirectory, $"{ComputeKey(ShaderCI, macros)}.bin");
+                var byteCode = Load(file);
+                if (byteCode != null)
+                {
+                    var cached = device.CreateShader(ShaderCI, byteCode);
+                    if (cached != null)
+                    {
+                        Interlocked.Increment(ref hits);
+                        return cached;
+                    }
+                    logger.LogWarning($"Could not create '{ShaderCI.Desc.Name}' from cached bytecode, compiling it again.");
+                }
+            }
+
+            var sw = Stopwatch.StartNew();
+            var shader = macros != null ? device.CreateShader(ShaderCI, macros) : device.CreateShader(ShaderCI);
+            sw.Stop();
+            Interlocked.Add(ref compileTicks, sw.Elapsed.Ticks);
+            Interlocked.Increment(ref misses);
+
+            if (file != null && shader?.Obj != null)
+            {
+                var byteCode = shader.Obj.GetBytecode();
+                if (byteCode != null)
+                {
+                    Save(file, byteCode);
+                }
+            }
+
+            return shader;
+        }
+
+        /// <summary>
+        /// Load a small named file saved with SaveData, like a list of shader permutations to create up
+        /// front. Returns null if there is no file or the cache is disabled.
+        /// </summary>
+        public byte[] LoadData(String name)
+        {
+            return Enabled ? Load(GetDataFile(name)) : null;
+        }
+
+        /// <summary>
+        /// Save a small named file next to the cached shaders. Does nothing if the cache is disabled.
+        /// </summary>
+        public void SaveData(String name, byte[] data)
+        {
+            if (Enabled)
+            {
+                Save(GetDataFile(name), data);
+            }
+        }
+
+        private String GetDataFile(String name)
+        {
+            return Path.Combine(shaderDirectory, $"{name}{Version}.dat");
+        }
+
+        private static String ComputeKey(ShaderCreateInfo ShaderCI, ShaderMacroHelper macros)
+        {
+            var key = new StringBuilder();
+            key.Append(Version).Append('\n');
+            key.Append(ShaderCI.Desc.ShaderType).Append('\n');
+            key.Append(ShaderCI.EntryPoint).Append('\n');
+            key.Append(ShaderCI.SourceLanguage).Append('\n');
+            key.Append(ShaderCI.ShaderCompiler).Append('\n');
+            key.Append(ShaderCI.HLSLVersion.Major).Append('.').Append(ShaderCI.HLSLVersion.Minor).Append('\n');
+            key.Append(ShaderCI.CompileFlags).Append('\n');
+            key.Append(ShaderCI.UseCombinedTextureSamplers).Append(ShaderCI.CombinedSamplerSuffix).Append('\n');
+            if (macros != null)
+            {
+                foreach (var macro in macros.Macros)
+                {
+                    key.Append(macro.name).Append('=').Append(macro.definition).Append('\n');
+                }
+            }
+            key.Append(ShaderCI.Source);
+
+            var hash = SHA256.HashData(Encoding.UTF8.GetBytes(key.ToString()));
+            return Convert.ToHexString(hash);
+        }
+
+        private byte[] Load(String file)
+        {
+            try
+            {
+                if (File.Exists(file))
+                {
+                    return File.ReadAllBytes(file);
+                }
+            }
+            catch (Exception ex)
+            {
+                logger.LogWarning($"{ex.GetType().Name} reading shader cache file '{file}'. Message: {ex.Message}");
+            }
+            return null;
+        }
+
+        private void Save(String file, byte[] data)
+        {
+            //Write to a temp file and move it so a crash or another thread never leaves a partial file behind
+            var tempFile = $"{file}.{Guid.NewGuid():N}.tmp";
+            try
+            {
+                Directory.CreateDirectory(Path.GetDirectoryName(file));
+                File.WriteAllBytes(tempFile, data);
+                File.Move(tempFile, file, true);
+            }
+            catch (Exception ex)
+            {
+                logger.LogWarning($"{ex.GetType().Name} writing shader cache file '{file}'. Message: {ex.Message}");
+                try
+                {
+                    File.Delete(tempFile);
+                }
+                catch { }
+            }
+        }
+    }
+}
@@ -32,6 +32,8 @@ namespace DiligentEngine
             }).ToArray();
         }
 
+        internal IEnumerable<(String name, String definition)> Macros => macros;
+
         public void RemoveMacro(String Name)
         {
             int index = GetIndex(Name);
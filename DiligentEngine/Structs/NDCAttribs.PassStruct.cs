@@ -21,7 +21,7 @@ using BOOL = System.Boolean;
 namespace DiligentEngine
 {
     [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi)]
-    struct NDCAttribsPassStruct
+    public struct NDCAttribsPassStruct
     {
         public float MinZ;
         public float ZtoDepthScale;
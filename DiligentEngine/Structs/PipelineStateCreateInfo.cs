@@ -28,6 +28,7 @@ namespace DiligentEngine
         }
         public PipelineStateDesc PSODesc { get; set; } = new PipelineStateDesc();
         public PSO_CREATE_FLAGS Flags { get; set; } = PSO_CREATE_FLAGS.PSO_CREATE_FLAG_NONE;
+        public IPipelineStateCache pPSOCache { get; set; }
 
 
     }
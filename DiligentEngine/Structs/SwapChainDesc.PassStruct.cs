@@ -0,0 +1,52 @@
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using System.Text;
+using System.Linq;
+
+using Uint8 = System.Byte;
+using Int8 = System.SByte;
+using Bool = System.Boolean;
+using Uint32 = System.UInt32;
+using Uint64 = System.UInt64;
+using Float32 = System.Single;
+using Uint16 = System.UInt16;
+using PVoid = System.IntPtr;
+using float4 = Engine.Vector4;
+using float3 = Engine.Vector3;
+using float2 = Engine.Vector2;
+using float4x4 = Engine.Matrix4x4;
+using BOOL = System.Boolean;
+
+namespace DiligentEngine
+{
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi)]
+    public struct SwapChainDescPassStruct
+    {
+        public Uint32 Width;
+        public Uint32 Height;
+        public TEXTURE_FORMAT ColorBufferFormat;
+        public TEXTURE_FORMAT DepthBufferFormat;
+        public SWAP_CHAIN_USAGE_FLAGS Usage;
+        public SURFACE_TRANSFORM PreTransform;
+        public Uint32 BufferCount;
+        public static SwapChainDescPassStruct[] ToStruct(IEnumerable<SwapChainDesc> vals)
+        {
+            if(vals == null)
+            {
+                return null;
+            }
+
+            return vals.Select(i => new SwapChainDescPassStruct
+            {
+                Width = i.Width,
+                Height = i.Height,
+                ColorBufferFormat = i.ColorBufferFormat,
+                DepthBufferFormat = i.DepthBufferFormat,
+                Usage = i.Usage,
+                PreTransform = i.PreTransform,
+                BufferCount = i.BufferCount,
+            }).ToArray();
+        }
+    }
+}
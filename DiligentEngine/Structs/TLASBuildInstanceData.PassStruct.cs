@@ -23,7 +23,7 @@ namespace DiligentEngine
     [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi)]
     public struct TLASBuildInstanceDataPassStruct
     {
-        public String InstanceName;
+        public IntPtr InstanceName;
         public IntPtr pBLAS;
         public InstanceMatrix Transform;
         public Uint32 CustomId;
@@ -39,7 +39,7 @@ namespace DiligentEngine
 
             return vals.Select(i => new TLASBuildInstanceDataPassStruct
             {
-                InstanceName = i.InstanceName,
+                InstanceName = i.InstanceNamePtr,
                 pBLAS = i.pBLAS == null ? IntPtr.Zero : i.pBLAS.objPtr,
                 Transform = i.Transform,
                 CustomId = i.CustomId,
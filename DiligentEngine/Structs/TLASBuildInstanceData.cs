@@ -26,7 +26,24 @@ namespace DiligentEngine
         {
             
         }
-        public String InstanceName { get; set; }
+        public String InstanceName
+        {
+            get
+            {
+                return instanceName;
+            }
+            set
+            {
+                var oldNameId = instanceNameId;
+                instanceName = value;
+                instanceNameId = NameTable.Register(value);
+                InstanceNamePtr = NameTable.GetName(instanceNameId);
+                NameTable.Release(oldNameId);
+            }
+        }
+        private String instanceName;
+        private Uint32 instanceNameId = NameTable.NullId;
+        internal IntPtr InstanceNamePtr { get; private set; }
         public IBottomLevelAS pBLAS { get; set; }
         public InstanceMatrix Transform { get; set; }
         public Uint32 CustomId { get; set; } = 0;
@@ -34,6 +51,11 @@ namespace DiligentEngine
         public Uint8 Mask { get; set; } = 0xFF;
         public Uint32 ContributionToHitGroupIndex { get; set; } = ITopLevelAS.TLAS_INSTANCE_OFFSET_AUTO;
 
+        ~TLASBuildInstanceData()
+        {
+            NameTable.Release(instanceNameId);
+        }
+
 
     }
 }
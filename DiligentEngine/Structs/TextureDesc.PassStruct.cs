@@ -0,0 +1,58 @@
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using System.Text;
+using System.Linq;
+
+using Uint8 = System.Byte;
+using Int8 = System.SByte;
+using Bool = System.Boolean;
+using Uint32 = System.UInt32;
+using Uint64 = System.UInt64;
+using Float32 = System.Single;
+using Uint16 = System.UInt16;
+using PVoid = System.IntPtr;
+using float4 = Engine.Vector4;
+using float3 = Engine.Vector3;
+using float2 = Engine.Vector2;
+using float4x4 = Engine.Matrix4x4;
+using BOOL = System.Boolean;
+
+namespace DiligentEngine
+{
+    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi)]
+    public struct TextureDescPassStruct
+    {
+        public RESOURCE_DIMENSION Type;
+        public Uint32 Width;
+        public Uint32 Height;
+        public Uint32 ArraySize;
+        public TEXTURE_FORMAT Format;
+        public Uint32 MipLevels;
+        public Uint32 SampleCount;
+        public BIND_FLAGS BindFlags;
+        public USAGE Usage;
+        public CPU_ACCESS_FLAGS CPUAccessFlags;
+        public static TextureDescPassStruct[] ToStruct(IEnumerable<TextureDesc> vals)
+        {
+            if(vals == null)
+            {
+                return null;
+            }
+
+            return vals.Select(i => new TextureDescPassStruct
+            {
+                Type = i.Type,
+                Width = i.Width,
+                Height = i.Height,
+                ArraySize = i.ArraySize,
+                Format = i.Format,
+                MipLevels = i.MipLevels,
+                SampleCount = i.SampleCount,
+                BindFlags = i.BindFlags,
+                Usage = i.Usage,
+                CPUAccessFlags = i.CPUAccessFlags,
+            }).ToArray();
+        }
+    }
+}
@@ -24,10 +24,12 @@ namespace DiligentEngine
     public class TextureLoader
     {
         private readonly GraphicsEngine graphicsEngine;
+        private readonly TextureUploader textureUploader;
 
-        public TextureLoader(GraphicsEngine graphicsEngine)
+        public TextureLoader(GraphicsEngine graphicsEngine, TextureUploader textureUploader)
         {
             this.graphicsEngine = graphicsEngine;
+            this.textureUploader = textureUploader;
         }
 
         TEXTURE_FORMAT GetFormat(FreeImageBitmap bitmap, bool isSRGB)
@@ -58,6 +60,15 @@ namespace DiligentEngine
         /// <param name="pDevice"></param>
         /// <returns></returns>
         public AutoPtr<ITexture> CreateTextureFromImage(FreeImageBitmap bitmap, int MipLevels, String name, RESOURCE_DIMENSION resouceDimension, bool isSRGB)
+        {
+            return CreateTextureFromImage(bitmap, MipLevels, name, resouceDimension, isSRGB, null);
+        }
+
+        /// <summary>
+        /// Create a texture from an image with each mip made from the one above it by filter. If filter is null
+        /// the mips are rescaled from the image with FreeImage instead.
+        /// </summary>
+        public AutoPtr<ITexture> CreateTextureFromImage(FreeImageBitmap bitmap, int MipLevels, String name, RESOURCE_DIMENSION resouceDimension, bool isSRGB, Engine.MipFilters.Filter filter)
         {
             var mips = new List<FreeImageBitmap>(MipLevels);
 
@@ -90,23 +101,32 @@ namespace DiligentEngine
                 //Mip maps
                 var MipWidth = TexDesc.Width;
                 var MipHeight = TexDesc.Height;
+                var previousMip = bitmap;
                 for (Uint32 m = 1; m < TexDesc.MipLevels; ++m)
                 {
                     var CoarseMipWidth = Math.Max(MipWidth / 2u, 1u);
                     var CoarseMipHeight = Math.Max(MipHeight / 2u, 1u);
-                    var mip = bitmap.Copy(0, 0, bitmap.Width, bitmap.Height);
-                    mip.Rescale(new Size((int)CoarseMipWidth, (int)CoarseMipHeight), FREE_IMAGE_FILTER.FILTER_BILINEAR);
-                    mips.Add(mip);
+                    FreeImageBitmap mip;
+                    if (filter != null)
+                    {
+                        mip = new FreeImageBitmap((int)CoarseMipWidth, (int)CoarseMipHeight, PixelFormat.Format32bppArgb);
+                        mips.Add(mip);
+                        FilterMip(previousMip, mip, filter);
+                        previousMip = mip;
+                    }
+                    else
+                    {
+                        mip = bitmap.Copy(0, 0, bitmap.Width, bitmap.Height);
+                        mip.Rescale(new Size((int)CoarseMipWidth, (int)CoarseMipHeight), FREE_IMAGE_FILTER.FILTER_BILINEAR);
+                        mips.Add(mip);
+                    }
                     AddBitmapToResources(mip, pSubResources);
 
                     MipWidth = CoarseMipWidth;
                     MipHeight = CoarseMipHeight;
                 }
 
-                TextureData TexData = new TextureData();
-                TexData.pSubResources = pSubResources;
-
-                return graphicsEngine.RenderDevice.CreateTexture(TexDesc, TexData); //This does not do anything with this pointer, just pass it along and let the caller handle it
+                return CreateTexture(TexDesc, pSubResources); //This does not do anything with this pointer, just pass it along and let the caller handle it
             }
             finally
             {
@@ -142,14 +162,70 @@ namespace DiligentEngine
                         Stride = sizeof(float) * width,
                     });
 
-                    TextureData TexData = new TextureData();
-                    TexData.pSubResources = pSubResources;
+                    return CreateTexture(TexDesc, pSubResources); //This does not do anything with this pointer, just pass it along and let the caller handle it
+                }
+            }
+        }
+
+        /// <summary>
+        /// Create a texture from the blocks in a dds file. If MipLevels is more than 0 only that many of the
+        /// mips in the file are used. Check DeviceFeatures_TextureCompressionBC before calling this.
+        /// </summary>
+        public AutoPtr<ITexture> CreateTextureFromDds(Engine.DdsFile dds, int MipLevels, String name, RESOURCE_DIMENSION resouceDimension)
+        {
+            TextureDesc TexDesc = new TextureDesc();
+            TexDesc.Name = name;
+            TexDesc.Type = resouceDimension;
+            TexDesc.Width = (uint)dds.Width;
+            TexDesc.Height = (uint)dds.Height;
+            TexDesc.MipLevels = (uint)dds.MipLevels;
+            if (MipLevels > 0)
+            {
+                TexDesc.MipLevels = (uint)Math.Min(TexDesc.MipLevels, MipLevels);
+            }
+            TexDesc.Usage = USAGE.USAGE_IMMUTABLE;
+            TexDesc.BindFlags = BIND_FLAGS.BIND_SHADER_RESOURCE;
+            TexDesc.Format = GetFormat(dds.Format);
+            TexDesc.CPUAccessFlags = CPU_ACCESS_FLAGS.CPU_ACCESS_NONE;
+
+            var pSubResources = new List<TextureSubResData>((int)TexDesc.MipLevels);
 
-                    return graphicsEngine.RenderDevice.CreateTexture(TexDesc, TexData); //This does not do anything with this pointer, just pass it along and let the caller handle it
+            unsafe
+            {
+                fixed (byte* texData = dds.Data)
+                {
+                    for (var m = 0; m < TexDesc.MipLevels; ++m)
+                    {
+                        //The stride is one row of blocks
+                        pSubResources.Add(new TextureSubResData()
+                        {
+                            pData = new IntPtr(texData + dds.GetMipOffset(m)),
+                            Stride = (ulong)dds.GetRowPitch(m),
+                        });
+                    }
+
+                    return CreateTexture(TexDesc, pSubResources); //This does not do anything with this pointer, just pass it along and let the caller handle it
                 }
             }
         }
 
+        TEXTURE_FORMAT GetFormat(Engine.DxgiFormat format)
+        {
+            switch (format)
+            {
+                case Engine.DxgiFormat.BC4_UNORM:
+                    return TEXTURE_FORMAT.TEX_FORMAT_BC4_UNORM;
+                case Engine.DxgiFormat.BC5_UNORM:
+                    return TEXTURE_FORMAT.TEX_FORMAT_BC5_UNORM;
+                case Engine.DxgiFormat.BC7_UNORM:
+                    return TEXTURE_FORMAT.TEX_FORMAT_BC7_UNORM;
+                case Engine.DxgiFormat.BC7_UNORM_SRGB:
+                    return TEXTURE_FORMAT.TEX_FORMAT_BC7_UNORM_SRGB;
+                default:
+                    throw new NotSupportedException($"Dxgi format {format} cannot be made into a texture.");
+            }
+        }
+
         [StructLayout(LayoutKind.Sequential)]
         public struct HalfRgTexturePixel
         {
@@ -182,34 +258,72 @@ namespace DiligentEngine
                         Stride = (ulong)sizeof(HalfRgTexturePixel) * width,
                     });
 
-                    TextureData TexData = new TextureData();
-                    TexData.pSubResources = pSubResources;
-
-                    return graphicsEngine.RenderDevice.CreateTexture(TexDesc, TexData); //This does not do anything with this pointer, just pass it along and let the caller handle it
+                    return CreateTexture(TexDesc, pSubResources); //This does not do anything with this pointer, just pass it along and let the caller handle it
                 }
             }
         }
 
-        private static void AddBitmapToResources(FreeImageBitmap bitmap, List<TextureSubResData> pSubResources)
+        /// <summary>
+        /// Create an immutable texture, unless this is a loading thread and the uploader can take it. Then
+        /// the texture is created empty and the data is streamed through the upload ring instead.
+        /// </summary>
+        private AutoPtr<ITexture> CreateTexture(TextureDesc TexDesc, List<TextureSubResData> pSubResources)
         {
-            if (bitmap.Stride > 0)
+            if (textureUploader.CanStage(TexDesc))
             {
-                pSubResources.Add(new TextureSubResData()
+                TexDesc.Usage = USAGE.USAGE_DEFAULT;
+                var texture = graphicsEngine.RenderDevice.CreateTexture(TexDesc, null);
+                if (texture != null)
                 {
-                    pData = bitmap.Scan0,
-                    Stride = (Uint32)(bitmap.Stride),
-                });
+                    if (textureUploader.Stage(texture.Obj, pSubResources))
+                    {
+                        return texture;
+                    }
+                    texture.Dispose();
+                }
+                TexDesc.Usage = USAGE.USAGE_IMMUTABLE;
             }
-            else
+
+            TextureData TexData = new TextureData();
+            TexData.pSubResources = pSubResources;
+
+            return graphicsEngine.RenderDevice.CreateTexture(TexDesc, TexData);
+        }
+
+        private static unsafe void FilterMip(FreeImageBitmap source, FreeImageBitmap dest, Engine.MipFilters.Filter filter)
+        {
+            var sourceRows = GetFirstRow(source, out var sourceStride);
+            var destRows = GetFirstRow(dest, out var destStride);
+            Engine.MipFilters.Downsample(
+                new ReadOnlySpan<byte>(sourceRows.ToPointer(), sourceStride * source.Height), source.Width, source.Height, sourceStride,
+                new Span<byte>(destRows.ToPointer(), destStride * dest.Height), dest.Width, dest.Height, destStride,
+                filter);
+        }
+
+        /// <summary>
+        /// Get the first row in memory of a bitmap and the positive stride to the rows after it.
+        /// </summary>
+        private static IntPtr GetFirstRow(FreeImageBitmap bitmap, out int stride)
+        {
+            if (bitmap.Stride > 0)
             {
-                //Freeimage scan0 gives the last line for some reason, this gives the first to allow the negative scan to become positive
-                var stride = -bitmap.Stride;
-                pSubResources.Add(new TextureSubResData()
-                {
-                    pData = bitmap.Scan0 - (stride * (bitmap.Height - 1)),
-                    Stride = (Uint32)stride,
-                });
+                stride = bitmap.Stride;
+                return bitmap.Scan0;
             }
+
+            //Freeimage scan0 gives the last line for some reason, this gives the first to allow the negative scan to become positive
+            stride = -bitmap.Stride;
+            return bitmap.Scan0 - (stride * (bitmap.Height - 1));
+        }
+
+        private static void AddBitmapToResources(FreeImageBitmap bitmap, List<TextureSubResData> pSubResources)
+        {
+            var firstRow = GetFirstRow(bitmap, out var stride);
+            pSubResources.Add(new TextureSubResData()
+            {
+                pData = firstRow,
+                Stride = (Uint32)stride,
+            });
         }
 
         /// <summary>
@@ -0,0 +1,117 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using System.Text;
+
+using Uint32 = System.UInt32;
+using Uint64 = System.UInt64;
+
+namespace DiligentEngine
+{
+    /// <summary>
+    /// Streams texture data through a persistently mapped staging ring. Loading threads copy their
+    /// subresources into the ring with Stage and the render thread records the copies with Process once
+    /// a frame. Ring space is reused once a fence shows the gpu has finished the copies. Staging only
+    /// starts once Process has been called, and never happens on the thread that calls Process, since a
+    /// full ring can only be drained by that thread. The TextureLoader falls back to immutable textures
+    /// whenever staging is not possible.
+    /// </summary>
+    public class TextureUploader : IDisposable
+    {
+        private readonly GraphicsEngine graphicsEngine;
+        private IntPtr uploader;
+        private volatile int processThreadId = -1;
+
+        public TextureUploader(GraphicsEngine graphicsEngine, DiligentEngineOptions options)
+        {
+            this.graphicsEngine = graphicsEngine;
+            if (options.TextureUploadRingSize > 0)
+            {
+                uploader = TextureUploader_Create(graphicsEngine.RenderDevice.objPtr, graphicsEngine.ImmediateContext.objPtr, options.TextureUploadRingSize);
+            }
+        }
+
+        public void Dispose()
+        {
+            if (uploader != IntPtr.Zero)
+            {
+                TextureUploader_Delete(uploader, graphicsEngine.ImmediateContext.objPtr);
+                uploader = IntPtr.Zero;
+            }
+        }
+
+        /// <summary>
+        /// The number of ring bytes waiting to be copied or for the gpu to finish with them.
+        /// </summary>
+        public Uint64 UsedSize => uploader != IntPtr.Zero ? TextureUploader_GetUsedSize(uploader) : 0;
+
+        /// <summary>
+        /// Record the copies staged since the last call and retire finished ones. Call this once a frame
+        /// on the render thread before anything that uses the textures is drawn.
+        /// </summary>
+        public Uint32 Process(IDeviceContext immediateContext)
+        {
+            if (uploader == IntPtr.Zero)
+            {
+                return 0;
+            }
+
+            processThreadId = Environment.CurrentManagedThreadId;
+            return TextureUploader_Process(uploader, immediateContext.objPtr);
+        }
+
+        /// <summary>
+        /// Returns true if a texture with this desc can be staged from the current thread. Only 2d textures
+        /// and arrays are supported, along with anything that fits in the ring.
+        /// </summary>
+        public bool CanStage(TextureDesc desc)
+        {
+            var threadId = processThreadId;
+            if (uploader == IntPtr.Zero || threadId == -1 || threadId == Environment.CurrentManagedThreadId)
+            {
+                return false;
+            }
+
+            if (desc.Type != RESOURCE_DIMENSION.RESOURCE_DIM_TEX_2D && desc.Type != RESOURCE_DIMENSION.RESOURCE_DIM_TEX_2D_ARRAY)
+            {
+                return false;
+            }
+
+            return TextureUploader_GetStagingSize(uploader, desc.Type, desc.Format, desc.Width, desc.Height, desc.ArraySize, desc.MipLevels) != 0;
+        }
+
+        /// <summary>
+        /// Copy the subresources into the ring, waiting for space if needed. The texture must be created
+        /// with USAGE_DEFAULT and no initial data. It is in RESOURCE_STATE_SHADER_RESOURCE once the
+        /// copy is recorded, which is always before the next frame renders. The uploader keeps a reference
+        /// to the texture until the copy is done so it can be released right away.
+        /// </summary>
+        public unsafe bool Stage(ITexture texture, List<TextureSubResData> pSubResources)
+        {
+            var subResources = TextureSubResDataPassStruct.ToStruct(pSubResources);
+            fixed (TextureSubResDataPassStruct* pData = subResources)
+            {
+                return TextureUploader_Stage(uploader, texture.objPtr, pData, (Uint32)subResources.Length, true);
+            }
+        }
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr TextureUploader_Create(IntPtr pDevice, IntPtr pContext, Uint64 RingSize);
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void TextureUploader_Delete(IntPtr objPtr, IntPtr pContext);
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        [return: MarshalAs(UnmanagedType.I1)]
+        private static extern unsafe bool TextureUploader_Stage(IntPtr objPtr, IntPtr pTexture, TextureSubResDataPassStruct* pSubResources, Uint32 NumSubresources, [MarshalAs(UnmanagedType.I1)] bool Wait);
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern Uint32 TextureUploader_Process(IntPtr objPtr, IntPtr pContext);
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern Uint64 TextureUploader_GetStagingSize(IntPtr objPtr, RESOURCE_DIMENSION Type, TEXTURE_FORMAT Format, Uint32 Width, Uint32 Height, Uint32 ArraySize, Uint32 MipLevels);
+
+        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern Uint64 TextureUploader_GetUsedSize(IntPtr objPtr);
+    }
+}
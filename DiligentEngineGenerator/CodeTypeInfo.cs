@@ -10,6 +10,11 @@ namespace DiligentEngineGenerator
 
         public Dictionary<String, CodeStruct> Structs { get; set; } = new Dictionary<string, CodeStruct>();
 
+        /// <summary>
+        /// Pass structs made from a subset of a struct, by struct name.
+        /// </summary>
+        public Dictionary<String, CodeStruct> PassStructs { get; set; } = new Dictionary<string, CodeStruct>();
+
         public Dictionary<String, CodeInterface> Interfaces { get; set; } = new Dictionary<string, CodeInterface>();
     }
 }
@@ -16,6 +16,8 @@ namespace DiligentEngineGenerator
 
         public List<InterfaceMethod> Methods { get; set; } = new List<InterfaceMethod>();
 
+        public List<InterfaceQuery> Queries { get; set; } = new List<InterfaceQuery>();
+
         public static CodeInterface Find(String file, string startLineContains, string endLineContains)
         {
             //This reads the file twice, but perf is not the primary concern here
@@ -81,6 +83,33 @@ namespace DiligentEngineGenerator
         /// Set this to true if you need to add a ref to this pointer. Default is false, which assumes the unmanaged side did it.
         /// </summary>
         public bool AddRefToAutoPtr { get; set; }
+
+        /// <summary>
+        /// A native statement written after the call and before returning, theReturnValue can be used in it.
+        /// </summary>
+        public String AfterCall { get; set; }
+    }
+
+    /// <summary>
+    /// A getter that fills out a blittable pass struct passed by ref in one call. Use these instead of a call per
+    /// field for anything read every frame, nothing is allocated on the managed side.
+    /// </summary>
+    class InterfaceQuery
+    {
+        /// <summary>
+        /// The name of the generated method.
+        /// </summary>
+        public String Name { get; set; }
+
+        /// <summary>
+        /// The native expression on objPtr that returns the struct to copy from, for example "GetDesc()".
+        /// </summary>
+        public String NativeCall { get; set; }
+
+        /// <summary>
+        /// The struct to fill, its PassStruct must be generated with the same properties.
+        /// </summary>
+        public CodeStruct Struct { get; set; }
     }
 
     class InterfaceMethodArgument
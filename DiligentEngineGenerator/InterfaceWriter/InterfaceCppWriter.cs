@@ -83,15 +83,7 @@ namespace DiligentEngineGenerator
                     }
                     else
                     {
-                        if (structCppWriterContext.HasDeletes)
-                        {
-                            writer.WriteLine($"	{item.ReturnType} theReturnValue = objPtr->{item.Name}(");
-                            hasReturnValue = true;
-                        }
-                        else
-                        {
-                            writer.WriteLine($"	return objPtr->{item.Name}(");
-                        }
+                        writer.WriteLine($"	return objPtr->{item.Name}(");
                     }
                 }
                 else
@@ -119,9 +111,9 @@ namespace DiligentEngineGenerator
                 }
                 writer.WriteLine("	);");
 
-                foreach (var del in structCppWriterContext.DeleteStatements)
+                if (item.AfterCall != null)
                 {
-                    writer.WriteLine($"    {del}");
+                    writer.WriteLine($"	{item.AfterCall}");
                 }
 
                 if (hasReturnValue)
@@ -131,6 +123,22 @@ namespace DiligentEngineGenerator
 
                 writer.WriteLine("}");
             }
+
+            //Queries
+            foreach (var item in code.Queries)
+            {
+                writer.WriteLine(
+@$"extern ""C"" _AnomalousExport void {code.Name}_{item.Name}(
+	{code.Name}* objPtr
+, {item.Struct.Name}PassStruct* pResult)
+{{
+	const auto& theReturnValue = objPtr->{item.NativeCall};");
+                foreach (var prop in item.Struct.Properties)
+                {
+                    writer.WriteLine($"	pResult->{prop.Name} = theReturnValue.{prop.Name};");
+                }
+                writer.WriteLine("}");
+            }
         }
     }
 }
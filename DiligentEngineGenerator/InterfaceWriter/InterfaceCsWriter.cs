@@ -152,6 +152,21 @@ namespace DiligentEngine
                 writer.WriteLine("        }");
             }
 
+            foreach (var item in code.Queries)
+            {
+                writer.WriteLine(
+@$"        /// <summary>
+        /// Fill out result from {item.NativeCall} with one call.
+        /// </summary>
+        public void {item.Name}(ref {item.Struct.Name}PassStruct result)
+        {{
+            {code.Name}_{item.Name}(
+                this.objPtr
+                , ref result
+            );
+        }}");
+            }
+
             writer.WriteLine();
             writer.WriteLine();
 
@@ -189,6 +204,16 @@ namespace DiligentEngine
                 writer.WriteLine($"        );");
             }
 
+            foreach (var item in code.Queries)
+            {
+                writer.WriteLine(
+@$"        [DllImport(LibraryInfo.LibraryName, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void {code.Name}_{item.Name}(
+            IntPtr objPtr
+            , ref {item.Struct.Name}PassStruct result
+        );");
+            }
+
             writer.WriteLine("    }");
 
             writer.WriteLine("}");
@@ -375,18 +375,36 @@ namespace DiligentEngineGenerator
                 EnumWriter.Write(STATE_TRANSITION_FLAGS, Path.Combine(baseEnumDir, $"{nameof(STATE_TRANSITION_FLAGS)}.cs"));
             }
 
+            {
+                var QUERY_TYPE = CodeEnum.Find(baseDir + "/DiligentCore/Graphics/GraphicsEngine/interface/GraphicsTypes.h", "DILIGENT_TYPED_ENUM(QUERY_TYPE,", "};");
+                codeTypeInfo.Enums[nameof(QUERY_TYPE)] = QUERY_TYPE;
+                EnumWriter.Write(QUERY_TYPE, Path.Combine(baseEnumDir, $"{nameof(QUERY_TYPE)}.cs"));
+            }
+
+            {
+                var FENCE_TYPE = CodeEnum.Find(baseDir + "/DiligentCore/Graphics/GraphicsEngine/interface/Fence.h", "DILIGENT_TYPED_ENUM(FENCE_TYPE,", "};");
+                codeTypeInfo.Enums[nameof(FENCE_TYPE)] = FENCE_TYPE;
+                EnumWriter.Write(FENCE_TYPE, Path.Combine(baseEnumDir, $"{nameof(FENCE_TYPE)}.cs"));
+            }
+
             //////////// Structs
             var baseStructDir = Path.Combine(baseCSharpOutDir, "Structs");
 
             {
                 var TLASBuildInstanceData = CodeStruct.Find(baseDir + "/DiligentCore/Graphics/GraphicsEngine/interface/DeviceContext.h", 1318, 1351);
                 codeTypeInfo.Structs[nameof(TLASBuildInstanceData)] = TLASBuildInstanceData;
+                TLASBuildInstanceData.LayoutCompatible = true;
 
                 {
                     var ContributionToHitGroupIndex = TLASBuildInstanceData.Properties.First(i => i.Name == "ContributionToHitGroupIndex");
                     ContributionToHitGroupIndex.DefaultValue = $"ITopLevelAS.{ContributionToHitGroupIndex.DefaultValue}";
                 }
 
+                {
+                    var InstanceName = TLASBuildInstanceData.Properties.First(i => i.Name == "InstanceName");
+                    InstanceName.InternedName = true;
+                }
+
                 var skip = new string[] {  };
                 TLASBuildInstanceData.Properties = TLASBuildInstanceData.Properties
                     .Where(i => !skip.Contains(i.Name)).ToList();
@@ -410,6 +428,16 @@ namespace DiligentEngineGenerator
                 codeWriter.AddWriter(new StructCsWriter(TraceRaysAttribs), Path.Combine(baseStructDir, $"{nameof(TraceRaysAttribs)}.cs"));
             }
 
+            {
+                var DispatchComputeAttribs = CodeStruct.Find(baseDir + "/DiligentCore/Graphics/GraphicsEngine/interface/DeviceContext.h", "struct DispatchComputeAttribs", "#if DILIGENT_CPP_INTERFACE");
+                codeTypeInfo.Structs[nameof(DispatchComputeAttribs)] = DispatchComputeAttribs;
+                //The thread group size is only used by metal, the shader declares it everywhere else
+                var skip = new List<String> { "MtlThreadGroupSizeX", "MtlThreadGroupSizeY", "MtlThreadGroupSizeZ" };
+                DispatchComputeAttribs.Properties = DispatchComputeAttribs.Properties
+                    .Where(i => !skip.Contains(i.Name)).ToList();
+                codeWriter.AddWriter(new StructCsWriter(DispatchComputeAttribs), Path.Combine(baseStructDir, $"{nameof(DispatchComputeAttribs)}.cs"));
+            }
+
             {
                 var TextureData = CodeStruct.Find(baseDir + "/DiligentCore/Graphics/GraphicsEngine/interface/Texture.h", 317, 337);
                 codeTypeInfo.Structs[nameof(TextureData)] = TextureData;
@@ -434,6 +462,7 @@ namespace DiligentEngineGenerator
             {
                 var TextureSubResData = CodeStruct.Find(baseDir + "/DiligentCore/Graphics/GraphicsEngine/interface/Texture.h", 259, 282);
                 codeTypeInfo.Structs[nameof(TextureSubResData)] = TextureSubResData;
+                TextureSubResData.LayoutCompatible = true;
                 codeWriter.AddWriter(new StructCsWriter(TextureSubResData), Path.Combine(baseStructDir, $"{nameof(TextureSubResData)}.cs"));
                 codeWriter.AddWriter(new StructCsPassStructWriter(TextureSubResData), Path.Combine(baseStructDir, $"{nameof(TextureSubResData)}.PassStruct.cs"));
                 codeWriter.AddWriter(new StructCppPassStructWriter(TextureSubResData), Path.Combine(baseCPlusPlusOutDir, $"{nameof(TextureSubResData)}.PassStruct.h"));
@@ -455,6 +484,12 @@ namespace DiligentEngineGenerator
                 var BufferDesc = CodeStruct.Find(baseDir + "/DiligentCore/Graphics/GraphicsEngine/interface/Buffer.h", 85, 132);
                 codeTypeInfo.Structs[nameof(BufferDesc)] = BufferDesc;
                 codeWriter.AddWriter(new StructCsWriter(BufferDesc), Path.Combine(baseStructDir, $"{nameof(BufferDesc)}.cs"));
+
+                //Only the blittable fields for IBuffer.GetDesc
+                var BufferDescPassStruct = BufferDesc.Subset("Size", "BindFlags", "Usage", "CPUAccessFlags", "ElementByteStride");
+                codeTypeInfo.PassStructs[nameof(BufferDesc)] = BufferDescPassStruct;
+                codeWriter.AddWriter(new StructCsPassStructWriter(BufferDescPassStruct) { MakePublic = true }, Path.Combine(baseStructDir, $"{nameof(BufferDesc)}.PassStruct.cs"));
+                codeWriter.AddWriter(new StructCppPassStructWriter(BufferDescPassStruct), Path.Combine(baseCPlusPlusOutDir, $"{nameof(BufferDesc)}.PassStruct.h"));
             }
 
             {
@@ -464,6 +499,12 @@ namespace DiligentEngineGenerator
                 SwapChainDesc.Properties.First(i => i.Name == "DefaultDepthValue").DefaultValue = SwapChainDesc.Properties.First(i => i.Name == "DefaultDepthValue").DefaultValue.Replace(".f", "f");
 
                 codeWriter.AddWriter(new StructCsWriter(SwapChainDesc), Path.Combine(baseStructDir, $"{nameof(SwapChainDesc)}.cs"));
+
+                //Only the blittable fields for ISwapChain.GetDesc
+                var SwapChainDescPassStruct = SwapChainDesc.Subset("Width", "Height", "ColorBufferFormat", "DepthBufferFormat", "Usage", "PreTransform", "BufferCount");
+                codeTypeInfo.PassStructs[nameof(SwapChainDesc)] = SwapChainDescPassStruct;
+                codeWriter.AddWriter(new StructCsPassStructWriter(SwapChainDescPassStruct) { MakePublic = true }, Path.Combine(baseStructDir, $"{nameof(SwapChainDesc)}.PassStruct.cs"));
+                codeWriter.AddWriter(new StructCppPassStructWriter(SwapChainDescPassStruct), Path.Combine(baseCPlusPlusOutDir, $"{nameof(SwapChainDesc)}.PassStruct.h"));
             }
 
             {
@@ -675,6 +716,15 @@ namespace DiligentEngineGenerator
                 codeWriter.AddWriter(new StructCsWriter(BLASBoundingBoxDesc), Path.Combine(baseStructDir, $"{nameof(BLASBoundingBoxDesc)}.cs"));
             }
 
+            {
+                var ScratchBufferSizes = CodeStruct.Find(baseDir + "/DiligentCore/Graphics/GraphicsEngine/interface/BottomLevelAS.h", "struct ScratchBufferSizes", "#if DILIGENT_CPP_INTERFACE");
+                codeTypeInfo.Structs[nameof(ScratchBufferSizes)] = ScratchBufferSizes;
+                codeTypeInfo.PassStructs[nameof(ScratchBufferSizes)] = ScratchBufferSizes;
+                codeWriter.AddWriter(new StructCsPassStructWriter(ScratchBufferSizes) { MakePublic = true }, Path.Combine(baseStructDir, $"{nameof(ScratchBufferSizes)}.PassStruct.cs"));
+                codeWriter.AddWriter(new StructCppPassStructWriter(ScratchBufferSizes), Path.Combine(baseCPlusPlusOutDir, $"{nameof(ScratchBufferSizes)}.PassStruct.h"));
+                codeWriter.AddWriter(new StructCsWriter(ScratchBufferSizes), Path.Combine(baseStructDir, $"{nameof(ScratchBufferSizes)}.cs"));
+            }
+
             {
                 var BottomLevelASDesc = CodeStruct.Find(baseDir + "/DiligentCore/Graphics/GraphicsEngine/interface/BottomLevelAS.h", "struct BottomLevelASDesc", "#if DILIGENT_CPP_INTERFACE");
                 codeTypeInfo.Structs[nameof(BottomLevelASDesc)] = BottomLevelASDesc;
@@ -780,7 +830,7 @@ namespace DiligentEngineGenerator
                 var PipelineStateCreateInfo = CodeStruct.Find(baseDir + "/DiligentCore/Graphics/GraphicsEngine/interface/PipelineState.h", "struct PipelineStateCreateInfo", "#ifdef DILIGENT_PLATFORM_32");
                 codeTypeInfo.Structs[nameof(PipelineStateCreateInfo)] = PipelineStateCreateInfo;
                 var remove = new List<String>() { 
-                    "pPSOCache", "ppResourceSignatures", "ResourceSignaturesCount", //TODO: These are what enable the shader caching and should be added eventually
+                    "ppResourceSignatures", "ResourceSignaturesCount",
                     "pInternalData", //This you never want
                 };
                 PipelineStateCreateInfo.Properties = PipelineStateCreateInfo.Properties.Where(i => !remove.Contains(i.Name)).ToList();
@@ -808,6 +858,12 @@ namespace DiligentEngineGenerator
                 codeWriter.AddWriter(new StructCsWriter(GraphicsPipelineStateCreateInfo), Path.Combine(baseStructDir, $"{nameof(GraphicsPipelineStateCreateInfo)}.cs"));
             }
 
+            {
+                var ComputePipelineStateCreateInfo = CodeStruct.Find(baseDir + "/DiligentCore/Graphics/GraphicsEngine/interface/PipelineState.h", "struct ComputePipelineStateCreateInfo", "#if DILIGENT_CPP_INTERFACE");
+                codeTypeInfo.Structs[nameof(ComputePipelineStateCreateInfo)] = ComputePipelineStateCreateInfo;
+                codeWriter.AddWriter(new StructCsWriter(ComputePipelineStateCreateInfo), Path.Combine(baseStructDir, $"{nameof(ComputePipelineStateCreateInfo)}.cs"));
+            }
+
             {
                 var StencilOpDesc = CodeStruct.Find(baseDir + "/DiligentCore/Graphics/GraphicsEngine/interface/DepthStencilState.h", "struct StencilOpDesc", "#if DILIGENT_CPP_INTERFACE");
                 codeTypeInfo.Structs[nameof(StencilOpDesc)] = StencilOpDesc;
@@ -829,6 +885,7 @@ namespace DiligentEngineGenerator
             {
                 var StateTransitionDesc = CodeStruct.Find(baseDir + "/DiligentCore/Graphics/GraphicsEngine/interface/DeviceContext.h", "struct StateTransitionDesc", "#if DILIGENT_CPP_INTERFACE");
                 codeTypeInfo.Structs[nameof(StateTransitionDesc)] = StateTransitionDesc;
+                StateTransitionDesc.LayoutCompatible = true;
                 codeWriter.AddWriter(new StructCsWriter(StateTransitionDesc), Path.Combine(baseStructDir, $"{nameof(StateTransitionDesc)}.cs"));
                 codeWriter.AddWriter(new StructCsPassStructWriter(StateTransitionDesc), Path.Combine(baseStructDir, $"{nameof(StateTransitionDesc)}.PassStruct.cs"));
                 codeWriter.AddWriter(new StructCppPassStructWriter(StateTransitionDesc), Path.Combine(baseCPlusPlusOutDir, $"{nameof(StateTransitionDesc)}.PassStruct.h"));
@@ -850,6 +907,12 @@ namespace DiligentEngineGenerator
                 var TextureDesc = CodeStruct.Find(baseDir + "/DiligentCore/Graphics/GraphicsEngine/interface/Texture.h", 79, 140, skipLines: Sequence(91, 92).Concat(Sequence(96, 98)));
                 codeTypeInfo.Structs[nameof(TextureDesc)] = TextureDesc;
                 codeWriter.AddWriter(new StructCsWriter(TextureDesc), Path.Combine(baseStructDir, $"{nameof(TextureDesc)}.cs"));
+
+                //Only the blittable fields for ITexture.GetDesc
+                var TextureDescPassStruct = TextureDesc.Subset("Type", "Width", "Height", "ArraySize", "Format", "MipLevels", "SampleCount", "BindFlags", "Usage", "CPUAccessFlags");
+                codeTypeInfo.PassStructs[nameof(TextureDesc)] = TextureDescPassStruct;
+                codeWriter.AddWriter(new StructCsPassStructWriter(TextureDescPassStruct) { MakePublic = true }, Path.Combine(baseStructDir, $"{nameof(TextureDesc)}.PassStruct.cs"));
+                codeWriter.AddWriter(new StructCppPassStructWriter(TextureDescPassStruct), Path.Combine(baseCPlusPlusOutDir, $"{nameof(TextureDesc)}.PassStruct.h"));
             }
 
             {
@@ -861,6 +924,7 @@ namespace DiligentEngineGenerator
             {
                 var BLASBuildTriangleData = CodeStruct.Find(baseDir + "/DiligentCore/Graphics/GraphicsEngine/interface/DeviceContext.h", "struct BLASBuildTriangleData", "typedef struct BLASBuildTriangleData BLASBuildTriangleData;");
                 codeTypeInfo.Structs[nameof(BLASBuildTriangleData)] = BLASBuildTriangleData;
+                BLASBuildTriangleData.LayoutCompatible = true;
                 codeWriter.AddWriter(new StructCsWriter(BLASBuildTriangleData), Path.Combine(baseStructDir, $"{nameof(BLASBuildTriangleData)}.cs"));
                 codeWriter.AddWriter(new StructCsPassStructWriter(BLASBuildTriangleData), Path.Combine(baseStructDir, $"{nameof(BLASBuildTriangleData)}.PassStruct.cs"));
                 codeWriter.AddWriter(new StructCppPassStructWriter(BLASBuildTriangleData), Path.Combine(baseCPlusPlusOutDir, $"{nameof(BLASBuildTriangleData)}.PassStruct.h"));
@@ -869,6 +933,7 @@ namespace DiligentEngineGenerator
             {
                 var BLASBuildBoundingBoxData = CodeStruct.Find(baseDir + "/DiligentCore/Graphics/GraphicsEngine/interface/DeviceContext.h", "struct BLASBuildBoundingBoxData", "typedef struct BLASBuildBoundingBoxData BLASBuildBoundingBoxData;");
                 codeTypeInfo.Structs[nameof(BLASBuildBoundingBoxData)] = BLASBuildBoundingBoxData;
+                BLASBuildBoundingBoxData.LayoutCompatible = true;
                 codeWriter.AddWriter(new StructCsWriter(BLASBuildBoundingBoxData), Path.Combine(baseStructDir, $"{nameof(BLASBuildBoundingBoxData)}.cs"));
                 codeWriter.AddWriter(new StructCsPassStructWriter(BLASBuildBoundingBoxData), Path.Combine(baseStructDir, $"{nameof(BLASBuildBoundingBoxData)}.PassStruct.cs"));
                 codeWriter.AddWriter(new StructCppPassStructWriter(BLASBuildBoundingBoxData), Path.Combine(baseCPlusPlusOutDir, $"{nameof(BLASBuildBoundingBoxData)}.PassStruct.h"));
@@ -938,7 +1003,8 @@ namespace DiligentEngineGenerator
                     prop.DefaultValue = prop.DefaultValue.Replace("0.f", "0.0f");
                 }
                 codeWriter.AddWriter(new StructCsWriter(NDCAttribs), Path.Combine(baseStructDir, $"{nameof(NDCAttribs)}.cs"));
-                codeWriter.AddWriter(new StructCsPassStructWriter(NDCAttribs), Path.Combine(baseStructDir, $"{nameof(NDCAttribs)}.PassStruct.cs"));
+                codeTypeInfo.PassStructs[nameof(NDCAttribs)] = NDCAttribs;
+                codeWriter.AddWriter(new StructCsPassStructWriter(NDCAttribs) { MakePublic = true }, Path.Combine(baseStructDir, $"{nameof(NDCAttribs)}.PassStruct.cs"));
                 codeWriter.AddWriter(new StructCppPassStructWriter(NDCAttribs), Path.Combine(baseCPlusPlusOutDir, $"{nameof(NDCAttribs)}.PassStruct.h"));
             }
 
@@ -969,6 +1035,7 @@ namespace DiligentEngineGenerator
                     var CreateTLAS = IRenderDevice.Methods.First(i => i.Name == "CreateTLAS");
                     CreateTLAS.ReturnType = "ITopLevelAS*";
                     CreateTLAS.ReturnAsAutoPtr = true;
+                    CreateTLAS.AfterCall = "GpuMemoryTracker::Get().Track(theReturnValue);";
                     var ppShader = CreateTLAS.Args.First(i => i.Name == "ppTLAS");
                     ppShader.MakeReturnVal = true;
                     ppShader.Type = "ITopLevelAS*";
@@ -978,6 +1045,7 @@ namespace DiligentEngineGenerator
                     var CreateBLAS = IRenderDevice.Methods.First(i => i.Name == "CreateBLAS");
                     CreateBLAS.ReturnType = "IBottomLevelAS*";
                     CreateBLAS.ReturnAsAutoPtr = true;
+                    CreateBLAS.AfterCall = "GpuMemoryTracker::Get().Track(theReturnValue);";
                     var ppShader = CreateBLAS.Args.First(i => i.Name == "ppBLAS");
                     ppShader.MakeReturnVal = true;
                     ppShader.Type = "IBottomLevelAS*";
@@ -1003,6 +1071,17 @@ namespace DiligentEngineGenerator
                     }
                 }
 
+                {
+                    var CreateComputePipelineState = IRenderDevice.Methods.First(i => i.Name == "CreateComputePipelineState");
+                    CreateComputePipelineState.ReturnType = "IPipelineState*";
+                    CreateComputePipelineState.ReturnAsAutoPtr = true;
+                    {
+                        var ppPipelineState = CreateComputePipelineState.Args.First(i => i.Name == "ppPipelineState");
+                        ppPipelineState.MakeReturnVal = true;
+                        ppPipelineState.Type = "IPipelineState*";
+                    }
+                }
+
                 {
                     var CreateRayTracingPipelineState = IRenderDevice.Methods.First(i => i.Name == "CreateRayTracingPipelineState");
                     CreateRayTracingPipelineState.ReturnType = "IPipelineState*";
@@ -1018,6 +1097,7 @@ namespace DiligentEngineGenerator
                     var CreateBuffer = IRenderDevice.Methods.First(i => i.Name == "CreateBuffer");
                     CreateBuffer.ReturnType = "IBuffer*";
                     CreateBuffer.ReturnAsAutoPtr = true;
+                    CreateBuffer.AfterCall = "GpuMemoryTracker::Get().Track(theReturnValue);";
                     {
                         var ppBuffer = CreateBuffer.Args.First(i => i.Name == "ppBuffer");
                         ppBuffer.MakeReturnVal = true;
@@ -1034,6 +1114,7 @@ namespace DiligentEngineGenerator
                     var CreateTexture = IRenderDevice.Methods.First(i => i.Name == "CreateTexture");
                     CreateTexture.ReturnType = "ITexture*";
                     CreateTexture.ReturnAsAutoPtr = true;
+                    CreateTexture.AfterCall = "GpuMemoryTracker::Get().Track(theReturnValue);";
                     {
                         var ppTexture = CreateTexture.Args.First(i => i.Name == "ppTexture");
                         ppTexture.MakeReturnVal = true;
@@ -1068,9 +1149,10 @@ namespace DiligentEngineGenerator
                     }
                 }
 
-                var allowedMethods = new List<String> { "CreateSBT", "CreateTLAS", "CreateBLAS", "CreateShader", "CreateGraphicsPipelineState", "CreateBuffer", "CreateTexture", "CreateSampler", "CreateRayTracingPipelineState" };
+                var allowedMethods = new List<String> { "CreateSBT", "CreateTLAS", "CreateBLAS", "CreateShader", "CreateGraphicsPipelineState", "CreateBuffer", "CreateTexture", "CreateSampler", "CreateRayTracingPipelineState", "CreateComputePipelineState" };
                 IRenderDevice.Methods = IRenderDevice.Methods
                     .Where(i => allowedMethods.Contains(i.Name)).ToList();
+                IRenderDevice.Queries.Add(new InterfaceQuery() { Name = "GetNDCAttribs", NativeCall = "GetDeviceInfo().GetNDCAttribs()", Struct = codeTypeInfo.PassStructs["NDCAttribs"] });
                 codeWriter.AddWriter(new InterfaceCsWriter(IRenderDevice), Path.Combine(baseCSharpInterfaceDir, $"{nameof(IRenderDevice)}.cs"));
                 var cppWriter = new InterfaceCppWriter(IRenderDevice, new List<String>()
                 {
@@ -1085,7 +1167,9 @@ namespace DiligentEngineGenerator
                     "RayTracingProceduralHitShaderGroup.PassStruct.h",
                     "RayTracingTriangleHitShaderGroup.PassStruct.h",
                     "BLASTriangleDesc.PassStruct.h",
-                    "BLASBoundingBoxDesc.PassStruct.h"
+                    "BLASBoundingBoxDesc.PassStruct.h",
+                    "NDCAttribs.PassStruct.h",
+                    "GpuMemoryTracker.h"
                 });
                 codeWriter.AddWriter(cppWriter, Path.Combine(baseCPlusPlusOutDir, $"{nameof(IRenderDevice)}.cpp"));
             }
@@ -1131,8 +1215,8 @@ namespace DiligentEngineGenerator
                     }
                 }
 
-                var allowedMethods = new List<String> { "UpdateSBT", "TraceRays", "UpdateBuffer", "BuildTLAS", "BuildBLAS", "DrawIndexed", "CommitShaderResources", "SetIndexBuffer", "Flush", "ClearRenderTarget", "ClearDepthStencil", "Draw", "SetPipelineState", "MapBuffer", "UnmapBuffer", "SetVertexBuffers" };
-                //The following have custom implementations: "SetRenderTargets"
+                var allowedMethods = new List<String> { "UpdateSBT", "TraceRays", "UpdateBuffer", "BuildTLAS", "BuildBLAS", "DrawIndexed", "CommitShaderResources", "SetIndexBuffer", "Flush", "ClearRenderTarget", "ClearDepthStencil", "Draw", "SetPipelineState", "MapBuffer", "UnmapBuffer", "SetVertexBuffers", "EnqueueSignal", "BeginQuery", "EndQuery", "Begin", "FinishFrame", "DispatchCompute" };
+                //The following have custom implementations: "SetRenderTargets", "FinishCommandList", "ExecuteCommandLists"
                 IDeviceContext.Methods = IDeviceContext.Methods
                     .Where(i => allowedMethods.Contains(i.Name)).ToList();
                 var rgbaArgs = IDeviceContext.Methods.First(i => i.Name == "ClearRenderTarget")
@@ -1178,10 +1262,12 @@ namespace DiligentEngineGenerator
                 //The following have custom implementations: "GetCurrentBackBufferRTV"
                 ISwapChain.Methods = ISwapChain.Methods
                     .Where(i => allowedMethods.Contains(i.Name)).ToList();
+                ISwapChain.Queries.Add(new InterfaceQuery() { Name = "GetDesc", NativeCall = "GetDesc()", Struct = codeTypeInfo.PassStructs["SwapChainDesc"] });
                 codeWriter.AddWriter(new InterfaceCsWriter(ISwapChain), Path.Combine(baseCSharpInterfaceDir, $"{nameof(ISwapChain)}.cs"));
                 var cppWriter = new InterfaceCppWriter(ISwapChain, new List<String>()
                 {
-                    "Graphics/GraphicsEngine/interface/SwapChain.h"
+                    "Graphics/GraphicsEngine/interface/SwapChain.h",
+                    "SwapChainDesc.PassStruct.h"
                 });
                 codeWriter.AddWriter(cppWriter, Path.Combine(baseCPlusPlusOutDir, $"{nameof(ISwapChain)}.cpp"));
             }
@@ -1233,6 +1319,7 @@ namespace DiligentEngineGenerator
                 var allowedMethods = new List<String> { "GetDefaultView", "CreateView" };
                 ITexture.Methods = ITexture.Methods
                     .Where(i => allowedMethods.Contains(i.Name)).ToList();
+                ITexture.Queries.Add(new InterfaceQuery() { Name = "GetDesc", NativeCall = "GetDesc()", Struct = codeTypeInfo.PassStructs["TextureDesc"] });
                 codeWriter.AddWriter(new InterfaceCsWriter(ITexture), Path.Combine(baseCSharpInterfaceDir, $"{nameof(ITexture)}.cs"));
 
                 {
@@ -1246,7 +1333,8 @@ namespace DiligentEngineGenerator
 
                 var cppWriter = new InterfaceCppWriter(ITexture, new List<String>()
                 {
-                    "Graphics/GraphicsEngine/interface/Texture.h"
+                    "Graphics/GraphicsEngine/interface/Texture.h",
+                    "TextureDesc.PassStruct.h"
                 });
                 codeWriter.AddWriter(cppWriter, Path.Combine(baseCPlusPlusOutDir, $"{nameof(ITexture)}.cpp"));
             }
@@ -1265,6 +1353,64 @@ namespace DiligentEngineGenerator
                 codeWriter.AddWriter(cppWriter, Path.Combine(baseCPlusPlusOutDir, $"{nameof(ISampler)}.cpp"));
             }
 
+            {
+                var IPipelineStateCache = CodeInterface.Find(baseDir + "/DiligentCore/Graphics/GraphicsEngine/interface/PipelineStateCache.h", "DILIGENT_BEGIN_INTERFACE(IPipelineStateCache,", "DILIGENT_END_INTERFACE");
+                codeTypeInfo.Interfaces[nameof(IPipelineStateCache)] = IPipelineStateCache;
+                var allowedMethods = new List<String> { };
+                IPipelineStateCache.Methods = IPipelineStateCache.Methods
+                    .Where(i => allowedMethods.Contains(i.Name)).ToList();
+                codeWriter.AddWriter(new InterfaceCsWriter(IPipelineStateCache), Path.Combine(baseCSharpInterfaceDir, $"{nameof(IPipelineStateCache)}.cs"));
+                var cppWriter = new InterfaceCppWriter(IPipelineStateCache, new List<String>()
+                {
+                    "Graphics/GraphicsEngine/interface/PipelineStateCache.h"
+                });
+                codeWriter.AddWriter(cppWriter, Path.Combine(baseCPlusPlusOutDir, $"{nameof(IPipelineStateCache)}.cpp"));
+            }
+
+            {
+                var IQuery = CodeInterface.Find(baseDir + "/DiligentCore/Graphics/GraphicsEngine/interface/Query.h", "DILIGENT_BEGIN_INTERFACE(IQuery,", "DILIGENT_END_INTERFACE");
+                codeTypeInfo.Interfaces[nameof(IQuery)] = IQuery;
+                var allowedMethods = new List<String> { "Invalidate" };
+                //The following have custom implementations: "GetData"
+                IQuery.Methods = IQuery.Methods
+                    .Where(i => allowedMethods.Contains(i.Name)).ToList();
+                codeWriter.AddWriter(new InterfaceCsWriter(IQuery), Path.Combine(baseCSharpInterfaceDir, $"{nameof(IQuery)}.cs"));
+                var cppWriter = new InterfaceCppWriter(IQuery, new List<String>()
+                {
+                    "Graphics/GraphicsEngine/interface/Query.h"
+                });
+                codeWriter.AddWriter(cppWriter, Path.Combine(baseCPlusPlusOutDir, $"{nameof(IQuery)}.cpp"));
+            }
+
+            {
+                var IFence = CodeInterface.Find(baseDir + "/DiligentCore/Graphics/GraphicsEngine/interface/Fence.h", "DILIGENT_BEGIN_INTERFACE(IFence,", "DILIGENT_END_INTERFACE");
+                codeTypeInfo.Interfaces[nameof(IFence)] = IFence;
+                var allowedMethods = new List<String> { "Signal", "Wait" };
+                //The following have custom implementations: "GetCompletedValue"
+                IFence.Methods = IFence.Methods
+                    .Where(i => allowedMethods.Contains(i.Name)).ToList();
+                codeWriter.AddWriter(new InterfaceCsWriter(IFence), Path.Combine(baseCSharpInterfaceDir, $"{nameof(IFence)}.cs"));
+                var cppWriter = new InterfaceCppWriter(IFence, new List<String>()
+                {
+                    "Graphics/GraphicsEngine/interface/Fence.h"
+                });
+                codeWriter.AddWriter(cppWriter, Path.Combine(baseCPlusPlusOutDir, $"{nameof(IFence)}.cpp"));
+            }
+
+            {
+                var ICommandList = CodeInterface.Find(baseDir + "/DiligentCore/Graphics/GraphicsEngine/interface/CommandList.h", "DILIGENT_BEGIN_INTERFACE(ICommandList,", "DILIGENT_END_INTERFACE");
+                codeTypeInfo.Interfaces[nameof(ICommandList)] = ICommandList;
+                var allowedMethods = new List<String> { };
+                ICommandList.Methods = ICommandList.Methods
+                    .Where(i => allowedMethods.Contains(i.Name)).ToList();
+                codeWriter.AddWriter(new InterfaceCsWriter(ICommandList), Path.Combine(baseCSharpInterfaceDir, $"{nameof(ICommandList)}.cs"));
+                var cppWriter = new InterfaceCppWriter(ICommandList, new List<String>()
+                {
+                    "Graphics/GraphicsEngine/interface/CommandList.h"
+                });
+                codeWriter.AddWriter(cppWriter, Path.Combine(baseCPlusPlusOutDir, $"{nameof(ICommandList)}.cpp"));
+            }
+
             {
                 var IPipelineState = CodeInterface.Find(baseDir + "/DiligentCore/Graphics/GraphicsEngine/interface/PipelineState.h", "DILIGENT_BEGIN_INTERFACE(IPipelineState,", "DILIGENT_END_INTERFACE");
                 codeTypeInfo.Interfaces[nameof(IPipelineState)] = IPipelineState;
@@ -1295,10 +1441,12 @@ namespace DiligentEngineGenerator
                 var allowedMethods = new List<String> { "GetDefaultView" };
                 IBuffer.Methods = IBuffer.Methods
                     .Where(i => allowedMethods.Contains(i.Name)).ToList();
+                IBuffer.Queries.Add(new InterfaceQuery() { Name = "GetDesc", NativeCall = "GetDesc()", Struct = codeTypeInfo.PassStructs["BufferDesc"] });
                 codeWriter.AddWriter(new InterfaceCsWriter(IBuffer), Path.Combine(baseCSharpInterfaceDir, $"{nameof(IBuffer)}.cs"));
                 var cppWriter = new InterfaceCppWriter(IBuffer, new List<String>()
                 {
-                    "Graphics/GraphicsEngine/interface/Buffer.h"
+                    "Graphics/GraphicsEngine/interface/Buffer.h",
+                    "BufferDesc.PassStruct.h"
                 });
                 codeWriter.AddWriter(cppWriter, Path.Combine(baseCPlusPlusOutDir, $"{nameof(IBuffer)}.cpp"));
             }
@@ -1337,10 +1485,12 @@ namespace DiligentEngineGenerator
                 var allowedMethods = new List<String> {  };
                 IBottomLevelAS.Methods = IBottomLevelAS.Methods
                     .Where(i => allowedMethods.Contains(i.Name)).ToList();
+                IBottomLevelAS.Queries.Add(new InterfaceQuery() { Name = "GetScratchBufferSizes", NativeCall = "GetScratchBufferSizes()", Struct = codeTypeInfo.PassStructs["ScratchBufferSizes"] });
                 codeWriter.AddWriter(new InterfaceCsWriter(IBottomLevelAS), Path.Combine(baseCSharpInterfaceDir, $"{nameof(IBottomLevelAS)}.cs"));
                 var cppWriter = new InterfaceCppWriter(IBottomLevelAS, new List<String>()
                 {
-                    "Graphics/GraphicsEngine/interface/BottomLevelAS.h"
+                    "Graphics/GraphicsEngine/interface/BottomLevelAS.h",
+                    "ScratchBufferSizes.PassStruct.h"
                 });
                 codeWriter.AddWriter(cppWriter, Path.Combine(baseCPlusPlusOutDir, $"{nameof(IBottomLevelAS)}.cpp"));
             }
@@ -1351,10 +1501,12 @@ namespace DiligentEngineGenerator
                 var allowedMethods = new List<String> { };
                 ITopLevelAS.Methods = ITopLevelAS.Methods
                     .Where(i => allowedMethods.Contains(i.Name)).ToList();
+                ITopLevelAS.Queries.Add(new InterfaceQuery() { Name = "GetScratchBufferSizes", NativeCall = "GetScratchBufferSizes()", Struct = codeTypeInfo.PassStructs["ScratchBufferSizes"] });
                 codeWriter.AddWriter(new InterfaceCsWriter(ITopLevelAS), Path.Combine(baseCSharpInterfaceDir, $"{nameof(ITopLevelAS)}.cs"));
                 var cppWriter = new InterfaceCppWriter(ITopLevelAS, new List<String>()
                 {
-                    "Graphics/GraphicsEngine/interface/TopLevelAS.h"
+                    "Graphics/GraphicsEngine/interface/TopLevelAS.h",
+                    "ScratchBufferSizes.PassStruct.h"
                 });
                 codeWriter.AddWriter(cppWriter, Path.Combine(baseCPlusPlusOutDir, $"{nameof(ITopLevelAS)}.cpp"));
             }
@@ -16,6 +16,12 @@ namespace DiligentEngineGenerator
 
         public List<StructProperty> Properties { get; set; } = new List<StructProperty>();
 
+        /// <summary>
+        /// Set this to true if the PassStruct has the exact same layout as the native struct. Arrays of these
+        /// are passed to Diligent directly instead of being copied. The generated code static_asserts the layout.
+        /// </summary>
+        public bool LayoutCompatible { get; set; }
+
         public static CodeStruct Find(String file, string startLineContains, string endLineContains)
         {
             //This reads the file twice, but perf is not the primary concern here
@@ -49,6 +55,21 @@ namespace DiligentEngineGenerator
 
             return code;
         }
+
+        /// <summary>
+        /// Make a copy of this struct that only has the named properties, in the order they are in this struct.
+        /// Use this to make pass structs that only carry the blittable fields that are needed.
+        /// </summary>
+        public CodeStruct Subset(params String[] propertyNames)
+        {
+            return new CodeStruct()
+            {
+                BaseType = BaseType,
+                Name = Name,
+                Comment = Comment,
+                Properties = Properties.Where(i => propertyNames.Contains(i.Name)).ToList()
+            };
+        }
     }
 
     class StructProperty
@@ -98,5 +119,12 @@ namespace DiligentEngineGenerator
         /// Pull the properties of this property into the struct when passing it back and forth.
         /// </summary>
         public bool PullPropertiesIntoStruct { get; set; }
+
+        /// <summary>
+        /// Pass this char* property as an IntPtr to a name interned in the native NameTable instead of marshalling
+        /// a String. This keeps the pass struct blittable. The class registers the name when it is set and
+        /// releases it when it is replaced or the class is finalized.
+        /// </summary>
+        public bool InternedName { get; set; }
     }
 }
@@ -43,14 +43,28 @@ namespace DiligentEngineGenerator
             {
                 if (item.IsArray)
                 {
-                    if (item.IsUnknownSizeArray)
+                    if (item.IsUnknownSizeArray && st.LayoutCompatible)
+                    {
+                        //Same layout on both sides, hand the pass struct array to Diligent as is
+                        writer.WriteLine($"{tabs}static_assert(sizeof({item.LookupType}) == sizeof({item.LookupType}PassStruct), \"{item.LookupType}PassStruct must match {item.LookupType}\");");
+                        foreach (var nestedProp in st.Properties)
+                        {
+                            writer.WriteLine($"{tabs}static_assert(offsetof({item.LookupType}, {nestedProp.Name}) == offsetof({item.LookupType}PassStruct, {nestedProp.Name}), \"{item.LookupType}PassStruct.{nestedProp.Name} offset must match\");");
+                        }
+                        writer.WriteLine($"{tabs}{setName}.{item.Name} = reinterpret_cast<const {item.LookupType}*>({argName}_{item.Name});");
+                    }
+                    else if (item.IsUnknownSizeArray)
                     {
                         var nativeArrayName = $"{argName}_{item.Name}_Native_Array";
 
-                        structCppWriterContext.DeleteStatements.Add($"delete[] {nativeArrayName};");
+                        if (!structCppWriterContext.HasScratchScope)
+                        {
+                            writer.WriteLine($"{tabs}ScratchArenaScope scratch;");
+                            structCppWriterContext.HasScratchScope = true;
+                        }
 
                         writer.WriteLine(
-@$"{tabs}{item.LookupType}* {nativeArrayName} = new {item.LookupType}[{argName}_{item.PutAutoSize}];
+@$"{tabs}{item.LookupType}* {nativeArrayName} = scratch.Alloc<{item.LookupType}>({argName}_{item.PutAutoSize});
 {tabs}if({argName}_{item.PutAutoSize} > 0)
 {tabs}{{
 {tabs}{tabs}for (Uint32 i = 0; i < {argName}_{item.PutAutoSize}; ++i)
@@ -6,8 +6,9 @@ namespace DiligentEngineGenerator
 {
     class StructCppWriterContext
     {
-        public List<String> DeleteStatements { get; set; } = new List<string>();
-
-        public bool HasDeletes => DeleteStatements.Count > 0;
+        /// <summary>
+        /// True once a ScratchArenaScope has been written into the current function.
+        /// </summary>
+        public bool HasScratchScope { get; set; }
     }
 }
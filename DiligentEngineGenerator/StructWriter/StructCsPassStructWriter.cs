@@ -138,6 +138,12 @@ $@"            }}).ToArray();
 
         private static String ConvertCSharpData(StructProperty item, CodeRendererContext context, String data)
         {
+            if (item.InternedName)
+            {
+                //Registered by the property setter, see StructCsWriter
+                return $"{data}Ptr";
+            }
+
             if (context.CodeTypeInfo.Interfaces.ContainsKey(item.LookupType))
             {
                 return $"{data} == null ? IntPtr.Zero : {data}.objPtr";
@@ -155,6 +161,11 @@ $@"            }}).ToArray();
 
         private static String GetCSharpType(StructProperty item, CodeRendererContext context)
         {
+            if (item.InternedName)
+            {
+                return "IntPtr";
+            }
+
             if (context.CodeTypeInfo.Interfaces.ContainsKey(item.LookupType))
             {
                 return "IntPtr";
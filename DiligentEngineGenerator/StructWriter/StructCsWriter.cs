@@ -69,12 +69,29 @@ $@"    {{
                         }
                     }
                 }
+                else if (item.InternedName)
+                {
+                    WriteInternedName(writer, item);
+                }
                 else
                 {
                     WriteItem(writer, context, item);
                 }
             }
 
+            var internedNames = code.Properties.Where(i => i.InternedName).ToList();
+            if (internedNames.Count > 0)
+            {
+                writer.WriteLine();
+                writer.WriteLine($"        ~{code.Name}()");
+                writer.WriteLine("        {");
+                foreach (var item in internedNames)
+                {
+                    writer.WriteLine($"            NameTable.Release({GetFieldName(item)}Id);");
+                }
+                writer.WriteLine("        }");
+            }
+
             //PInvoke
             writer.WriteLine();
             writer.WriteLine();
@@ -113,6 +130,38 @@ $@"    {{
             writer.WriteLine();
         }
 
+        /// <summary>
+        /// Interned names are registered when they are set, so making the pass struct only copies the pointer.
+        /// </summary>
+        private static void WriteInternedName(TextWriter writer, StructProperty item)
+        {
+            var field = GetFieldName(item);
+            writer.WriteLine(
+$@"        public String {item.Name}
+        {{
+            get
+            {{
+                return {field};
+            }}
+            set
+            {{
+                var oldNameId = {field}Id;
+                {field} = value;
+                {field}Id = NameTable.Register(value);
+                {item.Name}Ptr = NameTable.GetName({field}Id);
+                NameTable.Release(oldNameId);
+            }}
+        }}
+        private String {field};
+        private Uint32 {field}Id = NameTable.NullId;
+        internal IntPtr {item.Name}Ptr {{ get; private set; }}");
+        }
+
+        private static String GetFieldName(StructProperty item)
+        {
+            return Char.ToLowerInvariant(item.Name[0]) + item.Name.Substring(1);
+        }
+
         /// <summary>
         /// Get the c# value. Returns a string with the value or null to write nothing.
         /// </summary>
@@ -0,0 +1,15 @@
+#pragma once
+#include "Primitives/interface/BasicTypes.h"
+#include "Graphics/GraphicsEngine/interface/GraphicsTypes.h"
+
+namespace Diligent 
+{
+struct BufferDescPassStruct
+{
+        Uint64 Size;
+        BIND_FLAGS BindFlags;
+        USAGE Usage;
+        CPU_ACCESS_FLAGS CPUAccessFlags;
+        Uint32 ElementByteStride;
+};
+}
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include "StdAfx.h"
+#include "Graphics/GraphicsEngine/interface/DeviceContext.h"
+#include "Graphics/GraphicsEngine/interface/ShaderBindingTable.h"
+#include "StateTransitionDesc.PassStruct.h"
+#include "FramePacket.h"
+using namespace Diligent;
+
+template<typename T>
+static T* PacketObject(uint64_t ptr)
+{
+	return reinterpret_cast<T*>(static_cast<uintptr_t>(ptr));
+}
+
+//Replays commands on a device context.
+class ContextPacketExecutor
+{
+public:
+	ContextPacketExecutor(IDeviceContext* context)
+		:context(context)
+	{
+
+	}
+
+	void Execute(const FramePacketUpdateBuffer& c, const uint8_t* trailing)
+	{
+		context->UpdateBuffer(PacketObject<IBuffer>(c.pBuffer), c.Offset, c.Size, trailing, static_cast<RESOURCE_STATE_TRANSITION_MODE>(c.StateTransitionMode));
+	}
+
+	void Execute(const FramePacketTransitionResourceStates& c, const uint8_t* trailing)
+	{
+		static_assert(sizeof(StateTransitionDesc) == sizeof(StateTransitionDescPassStruct), "StateTransitionDescPassStruct must match StateTransitionDesc");
+		context->TransitionResourceStates(c.BarrierCount, reinterpret_cast<const StateTransitionDesc*>(trailing));
+	}
+
+	void Execute(const FramePacketUpdateSBT& c, const uint8_t*)
+	{
+		context->UpdateSBT(PacketObject<IShaderBindingTable>(c.pSBT));
+	}
+
+	void Execute(const FramePacketSetPipelineState& c, const uint8_t*)
+	{
+		context->SetPipelineState(PacketObject<IPipelineState>(c.pPipelineState));
+	}
+
+	void Execute(const FramePacketCommitShaderResources& c, const uint8_t*)
+	{
+		context->CommitShaderResources(PacketObject<IShaderResourceBinding>(c.pShaderResourceBinding), static_cast<RESOURCE_STATE_TRANSITION_MODE>(c.StateTransitionMode));
+	}
+
+	void Execute(const FramePacketSetRenderTarget& c, const uint8_t*)
+	{
+		ITextureView* renderTarget = PacketObject<ITextureView>(c.pRenderTarget);
+		context->SetRenderTargets(renderTarget != nullptr ? 1 : 0, &renderTarget, PacketObject<ITextureView>(c.pDepthStencil), static_cast<RESOURCE_STATE_TRANSITION_MODE>(c.StateTransitionMode));
+	}
+
+	void Execute(const FramePacketTraceRays& c, const uint8_t*)
+	{
+		TraceRaysAttribs Attribs;
+		Attribs.pSBT = PacketObject<IShaderBindingTable>(c.pSBT);
+		Attribs.DimensionX = c.DimensionX;
+		Attribs.DimensionY = c.DimensionY;
+		Attribs.DimensionZ = c.DimensionZ;
+		context->TraceRays(Attribs);
+	}
+
+	void Execute(const FramePacketDraw& c, const uint8_t*)
+	{
+		DrawAttribs Attribs;
+		Attribs.NumVertices = c.NumVertices;
+		Attribs.Flags = static_cast<DRAW_FLAGS>(c.Flags);
+		Attribs.NumInstances = c.NumInstances;
+		Attribs.StartVertexLocation = c.StartVertexLocation;
+		Attribs.FirstInstanceLocation = c.FirstInstanceLocation;
+		context->Draw(Attribs);
+	}
+
+	void Execute(const FramePacketDrawIndexed& c, const uint8_t*)
+	{
+		DrawIndexedAttribs Attribs;
+		Attribs.NumIndices = c.NumIndices;
+		Attribs.IndexType = static_cast<VALUE_TYPE>(c.IndexType);
+		Attribs.Flags = static_cast<DRAW_FLAGS>(c.Flags);
+		Attribs.NumInstances = c.NumInstances;
+		Attribs.FirstIndexLocation = c.FirstIndexLocation;
+		Attribs.BaseVertex = c.BaseVertex;
+		Attribs.FirstInstanceLocation = c.FirstInstanceLocation;
+		context->DrawIndexed(Attribs);
+	}
+
+	void Execute(const FramePacketSetVertexBuffer& c, const uint8_t*)
+	{
+		IBuffer* buffer = PacketObject<IBuffer>(c.pBuffer);
+		Uint64 offset = c.Offset;
+		context->SetVertexBuffers(c.StartSlot, 1, &buffer, &offset, static_cast<RESOURCE_STATE_TRANSITION_MODE>(c.StateTransitionMode), static_cast<SET_VERTEX_BUFFERS_FLAGS>(c.Flags));
+	}
+
+	void Execute(const FramePacketSetIndexBuffer& c, const uint8_t*)
+	{
+		context->SetIndexBuffer(PacketObject<IBuffer>(c.pBuffer), c.ByteOffset, static_cast<RESOURCE_STATE_TRANSITION_MODE>(c.StateTransitionMode));
+	}
+
+	void Execute(const FramePacketDispatchCompute& c, const uint8_t*)
+	{
+		DispatchComputeAttribs Attribs;
+		Attribs.ThreadGroupCountX = c.ThreadGroupCountX;
+		Attribs.ThreadGroupCountY = c.ThreadGroupCountY;
+		Attribs.ThreadGroupCountZ = c.ThreadGroupCountZ;
+		context->DispatchCompute(Attribs);
+	}
+
+private:
+	IDeviceContext* context;
+};
+
+//Decodes everything but never touches a device, used to check packets and to time the decode
+//on its own. The trailing data is read so the cost of walking it is included.
+class ValidatingPacketExecutor
+{
+public:
+	uint64_t checksum = 0;
+
+	template<typename T>
+	void Execute(const T&, const uint8_t* trailing)
+	{
+		checksum += sizeof(T);
+		checksum ^= reinterpret_cast<uintptr_t>(trailing);
+	}
+
+	void Execute(const FramePacketUpdateBuffer& c, const uint8_t* trailing)
+	{
+		for (uint64_t i = 0; i < c.Size; ++i)
+		{
+			checksum += trailing[i];
+		}
+	}
+
+	void Execute(const FramePacketTransitionResourceStates& c, const uint8_t* trailing)
+	{
+		const StateTransitionDescPassStruct* barriers = reinterpret_cast<const StateTransitionDescPassStruct*>(trailing);
+		for (uint32_t i = 0; i < c.BarrierCount; ++i)
+		{
+			checksum += static_cast<uint64_t>(barriers[i].NewState);
+		}
+	}
+};
+
+extern "C" _AnomalousExport void IDeviceContext_ExecutePacket(
+	IDeviceContext* objPtr
+	, Uint8* pPacket
+	, Uint32 Size
+	, FramePacketResult* pResult)
+{
+	ContextPacketExecutor executor(objPtr);
+	*pResult = DecodeFramePacket(pPacket, Size, executor);
+}
+
+extern "C" _AnomalousExport void FramePacket_Validate(
+	Uint8* pPacket
+	, Uint32 Size
+	, FramePacketResult* pResult
+	, Uint64* pChecksum)
+{
+	ValidatingPacketExecutor executor;
+	*pResult = DecodeFramePacket(pPacket, Size, executor);
+	*pChecksum = executor.checksum;
+}
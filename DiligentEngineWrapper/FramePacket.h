@@ -0,0 +1,291 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "StateTransitionDesc.PassStruct.h"
+
+//Binary command stream written by FramePacket on the managed side and replayed here in one call.
+//Every command starts with a FramePacketCommandHeader, Size is the full size of the command including
+//the header and any trailing arrays and is always a multiple of 8. Object pointers are always 64 bit
+//so the layout is the same for every target. Keep these in sync with FramePacket.cs.
+
+enum FramePacketCommand : uint16_t
+{
+	FramePacketCommand_UpdateBuffer = 1,
+	FramePacketCommand_TransitionResourceStates = 2,
+	FramePacketCommand_UpdateSBT = 3,
+	FramePacketCommand_SetPipelineState = 4,
+	FramePacketCommand_CommitShaderResources = 5,
+	FramePacketCommand_SetRenderTarget = 6,
+	FramePacketCommand_TraceRays = 7,
+	FramePacketCommand_Draw = 8,
+	FramePacketCommand_DrawIndexed = 9,
+	FramePacketCommand_SetVertexBuffer = 10,
+	FramePacketCommand_SetIndexBuffer = 11,
+	FramePacketCommand_DispatchCompute = 12,
+};
+
+enum FramePacketError : int32_t
+{
+	FramePacketError_None = 0,
+	FramePacketError_Truncated = 1,
+	FramePacketError_BadSize = 2,
+	FramePacketError_UnknownCommand = 3,
+	FramePacketError_NullObject = 4,
+};
+
+struct FramePacketCommandHeader
+{
+	uint16_t Command;
+	uint16_t Reserved;
+	uint32_t Size;
+};
+
+//Followed by Size bytes of data
+struct FramePacketUpdateBuffer
+{
+	uint64_t pBuffer;
+	uint64_t Offset;
+	uint64_t Size;
+	uint32_t StateTransitionMode;
+	uint32_t Reserved;
+};
+
+//Followed by BarrierCount StateTransitionDescPassStructs
+struct FramePacketTransitionResourceStates
+{
+	uint32_t BarrierCount;
+	uint32_t Reserved;
+};
+
+struct FramePacketUpdateSBT
+{
+	uint64_t pSBT;
+};
+
+struct FramePacketSetPipelineState
+{
+	uint64_t pPipelineState;
+};
+
+struct FramePacketCommitShaderResources
+{
+	uint64_t pShaderResourceBinding;
+	uint32_t StateTransitionMode;
+	uint32_t Reserved;
+};
+
+struct FramePacketSetRenderTarget
+{
+	uint64_t pRenderTarget;
+	uint64_t pDepthStencil;
+	uint32_t StateTransitionMode;
+	uint32_t Reserved;
+};
+
+struct FramePacketTraceRays
+{
+	uint64_t pSBT;
+	uint32_t DimensionX;
+	uint32_t DimensionY;
+	uint32_t DimensionZ;
+	uint32_t Reserved;
+};
+
+struct FramePacketDraw
+{
+	uint32_t NumVertices;
+	uint32_t Flags;
+	uint32_t NumInstances;
+	uint32_t StartVertexLocation;
+	uint32_t FirstInstanceLocation;
+	uint32_t Reserved;
+};
+
+struct FramePacketDrawIndexed
+{
+	uint32_t NumIndices;
+	uint32_t IndexType;
+	uint32_t Flags;
+	uint32_t NumInstances;
+	uint32_t FirstIndexLocation;
+	uint32_t BaseVertex;
+	uint32_t FirstInstanceLocation;
+	uint32_t Reserved;
+};
+
+struct FramePacketSetVertexBuffer
+{
+	uint64_t pBuffer;
+	uint64_t Offset;
+	uint32_t StartSlot;
+	uint32_t StateTransitionMode;
+	uint32_t Flags;
+	uint32_t Reserved;
+};
+
+struct FramePacketSetIndexBuffer
+{
+	uint64_t pBuffer;
+	uint64_t ByteOffset;
+	uint32_t StateTransitionMode;
+	uint32_t Reserved;
+};
+
+struct FramePacketDispatchCompute
+{
+	uint32_t ThreadGroupCountX;
+	uint32_t ThreadGroupCountY;
+	uint32_t ThreadGroupCountZ;
+	uint32_t Reserved;
+};
+
+//Result of decoding a packet, returned by both execute and validate.
+struct FramePacketResult
+{
+	uint32_t NumCommands;
+	uint32_t BytesRead;
+	int32_t Error;
+	uint32_t ErrorOffset;
+};
+
+//Check the fixed part and the trailing data fit in the command before executing it.
+template<typename T, typename Executor, typename TrailingSize, typename Valid>
+int32_t DecodeFramePacketCommand(const uint8_t* body, uint32_t bodySize, Executor& executor, TrailingSize trailingSize, Valid valid)
+{
+	if (bodySize < sizeof(T))
+	{
+		return FramePacketError_BadSize;
+	}
+
+	T command;
+	memcpy(&command, body, sizeof(T));
+	if (sizeof(T) + trailingSize(command) > bodySize)
+	{
+		return FramePacketError_BadSize;
+	}
+
+	if (!valid(command))
+	{
+		return FramePacketError_NullObject;
+	}
+
+	executor.Execute(command, body + sizeof(T));
+	return FramePacketError_None;
+}
+
+//Walk a packet and hand each command to the executor. The executor gets a reference to the fixed
+//part of the command and a pointer to whatever trailing data follows it. Decoding stops at the
+//first malformed command, nothing after it is executed. The executor needs one Execute overload
+//per command struct, taking (const T&, const uint8_t* trailing).
+template<typename Executor>
+FramePacketResult DecodeFramePacket(const uint8_t* packet, uint32_t size, Executor& executor)
+{
+	FramePacketResult result = { 0, 0, FramePacketError_None, 0 };
+	uint32_t offset = 0;
+	while (offset < size)
+	{
+		result.ErrorOffset = offset;
+		if (size - offset < sizeof(FramePacketCommandHeader))
+		{
+			result.Error = FramePacketError_Truncated;
+			return result;
+		}
+
+		FramePacketCommandHeader header;
+		memcpy(&header, packet + offset, sizeof(header));
+		if (header.Size < sizeof(FramePacketCommandHeader) || (header.Size & 7) != 0)
+		{
+			result.Error = FramePacketError_BadSize;
+			return result;
+		}
+		if (header.Size > size - offset)
+		{
+			result.Error = FramePacketError_Truncated;
+			return result;
+		}
+
+		const uint8_t* body = packet + offset + sizeof(FramePacketCommandHeader);
+		uint32_t bodySize = header.Size - sizeof(FramePacketCommandHeader);
+		int32_t error;
+		switch (header.Command)
+		{
+		case FramePacketCommand_UpdateBuffer:
+			error = DecodeFramePacketCommand<FramePacketUpdateBuffer>(body, bodySize, executor,
+				[](const FramePacketUpdateBuffer& c) { return c.Size; },
+				[](const FramePacketUpdateBuffer& c) { return c.pBuffer != 0; });
+			break;
+		case FramePacketCommand_TransitionResourceStates:
+			error = DecodeFramePacketCommand<FramePacketTransitionResourceStates>(body, bodySize, executor,
+				[](const FramePacketTransitionResourceStates& c) { return (uint64_t)c.BarrierCount * sizeof(Diligent::StateTransitionDescPassStruct); },
+				[](const FramePacketTransitionResourceStates&) { return true; });
+			break;
+		case FramePacketCommand_UpdateSBT:
+			error = DecodeFramePacketCommand<FramePacketUpdateSBT>(body, bodySize, executor,
+				[](const FramePacketUpdateSBT&) { return (uint64_t)0; },
+				[](const FramePacketUpdateSBT& c) { return c.pSBT != 0; });
+			break;
+		case FramePacketCommand_SetPipelineState:
+			error = DecodeFramePacketCommand<FramePacketSetPipelineState>(body, bodySize, executor,
+				[](const FramePacketSetPipelineState&) { return (uint64_t)0; },
+				[](const FramePacketSetPipelineState& c) { return c.pPipelineState != 0; });
+			break;
+		case FramePacketCommand_CommitShaderResources:
+			error = DecodeFramePacketCommand<FramePacketCommitShaderResources>(body, bodySize, executor,
+				[](const FramePacketCommitShaderResources&) { return (uint64_t)0; },
+				[](const FramePacketCommitShaderResources& c) { return c.pShaderResourceBinding != 0; });
+			break;
+		case FramePacketCommand_SetRenderTarget:
+			error = DecodeFramePacketCommand<FramePacketSetRenderTarget>(body, bodySize, executor,
+				[](const FramePacketSetRenderTarget&) { return (uint64_t)0; },
+				[](const FramePacketSetRenderTarget&) { return true; });
+			break;
+		case FramePacketCommand_TraceRays:
+			error = DecodeFramePacketCommand<FramePacketTraceRays>(body, bodySize, executor,
+				[](const FramePacketTraceRays&) { return (uint64_t)0; },
+				[](const FramePacketTraceRays& c) { return c.pSBT != 0; });
+			break;
+		case FramePacketCommand_Draw:
+			error = DecodeFramePacketCommand<FramePacketDraw>(body, bodySize, executor,
+				[](const FramePacketDraw&) { return (uint64_t)0; },
+				[](const FramePacketDraw&) { return true; });
+			break;
+		case FramePacketCommand_DrawIndexed:
+			error = DecodeFramePacketCommand<FramePacketDrawIndexed>(body, bodySize, executor,
+				[](const FramePacketDrawIndexed&) { return (uint64_t)0; },
+				[](const FramePacketDrawIndexed&) { return true; });
+			break;
+		case FramePacketCommand_SetVertexBuffer:
+			error = DecodeFramePacketCommand<FramePacketSetVertexBuffer>(body, bodySize, executor,
+				[](const FramePacketSetVertexBuffer&) { return (uint64_t)0; },
+				[](const FramePacketSetVertexBuffer&) { return true; });
+			break;
+		case FramePacketCommand_SetIndexBuffer:
+			error = DecodeFramePacketCommand<FramePacketSetIndexBuffer>(body, bodySize, executor,
+				[](const FramePacketSetIndexBuffer&) { return (uint64_t)0; },
+				[](const FramePacketSetIndexBuffer& c) { return c.pBuffer != 0; });
+			break;
+		case FramePacketCommand_DispatchCompute:
+			error = DecodeFramePacketCommand<FramePacketDispatchCompute>(body, bodySize, executor,
+				[](const FramePacketDispatchCompute&) { return (uint64_t)0; },
+				[](const FramePacketDispatchCompute&) { return true; });
+			break;
+		default:
+			error = FramePacketError_UnknownCommand;
+			break;
+		}
+
+		if (error != FramePacketError_None)
+		{
+			result.Error = error;
+			return result;
+		}
+
+		offset += header.Size;
+		++result.NumCommands;
+		result.BytesRead = offset;
+	}
+	result.ErrorOffset = 0;
+	return result;
+}
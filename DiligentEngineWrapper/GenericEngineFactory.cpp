@@ -47,9 +47,13 @@ extern "C" _AnomalousExport CreateDeviceAndSwapChainResult GenericEngineFactory_
 	, Uint8 DefaultStencilValue
 	, bool IsPrimary
     , Uint32 deviceId
+	, Uint32 NumDeferredContexts
+	, IDeviceContext** ppDeferredContexts
 )
 {
-	CreateDeviceAndSwapChainResult result;
+	CreateDeviceAndSwapChainResult result = {};
+	//The immediate context is first followed by the deferred contexts
+	std::vector<IDeviceContext*> Contexts(1 + NumDeferredContexts, nullptr);
 	SwapChainDesc SCDesc;
 	SCDesc.Width = Width;
 	SCDesc.Height = Height;
@@ -72,22 +76,27 @@ extern "C" _AnomalousExport CreateDeviceAndSwapChainResult GenericEngineFactory_
 
             EngineVkCreateInfo EngineCI;
             EngineCI.Features.RayTracing = (features & FeatureFlags_RAY_TRACING) == FeatureFlags_RAY_TRACING ? DEVICE_FEATURE_STATE_ENABLED : DEVICE_FEATURE_STATE_DISABLED;
+            EngineCI.Features.TimestampQueries = DEVICE_FEATURE_STATE_OPTIONAL;
+            EngineCI.Features.TextureCompressionBC = DEVICE_FEATURE_STATE_OPTIONAL;
+            EngineCI.NumDeferredContexts = NumDeferredContexts;
 
 #   ifdef DILIGENT_DEBUG
             EngineCI.EnableValidation = true;
 #   endif
 
             auto* pFactoryVk = GetEngineFactoryVk();
-            pFactoryVk->CreateDeviceAndContextsVk(EngineCI, &(result.m_pDevice), &(result.m_pImmediateContext));
+            pFactoryVk->CreateDeviceAndContextsVk(EngineCI, &(result.m_pDevice), Contexts.data());
 
             if (result.m_pDevice == NULL)
             {
                 //Fix for amd optimus switchable graphics
                 //https://github.com/KhronosGroup/Vulkan-Loader/issues/552
                 SetEnvironmentVariable(L"DISABLE_LAYER_AMD_SWITCHABLE_GRAPHICS_1", L"1");
-                pFactoryVk->CreateDeviceAndContextsVk(EngineCI, &(result.m_pDevice), &(result.m_pImmediateContext));
+                pFactoryVk->CreateDeviceAndContextsVk(EngineCI, &(result.m_pDevice), Contexts.data());
             }
 
+            result.m_pImmediateContext = Contexts[0];
+
             if (result.m_pDevice != NULL)
             {
                 Win32NativeWindow Window{ hWnd };
@@ -113,6 +122,9 @@ extern "C" _AnomalousExport CreateDeviceAndSwapChainResult GenericEngineFactory_
             EngineD3D12CreateInfo EngineCI;
             EngineCI.GraphicsAPIVersion = { 11, 0 };
             EngineCI.Features.RayTracing = (features & FeatureFlags_RAY_TRACING) == FeatureFlags_RAY_TRACING ? DEVICE_FEATURE_STATE_ENABLED : DEVICE_FEATURE_STATE_DISABLED;
+            EngineCI.Features.TimestampQueries = DEVICE_FEATURE_STATE_OPTIONAL;
+            EngineCI.Features.TextureCompressionBC = DEVICE_FEATURE_STATE_OPTIONAL;
+            EngineCI.NumDeferredContexts = NumDeferredContexts;
             //if (m_ValidationLevel >= 0)
             //    EngineCI.SetValidationLevel(static_cast<VALIDATION_LEVEL>(m_ValidationLevel));
 
@@ -175,7 +187,8 @@ extern "C" _AnomalousExport CreateDeviceAndSwapChainResult GenericEngineFactory_
             //    pFactoryD3D12->EnumerateDisplayModes(EngineCI.GraphicsAPIVersion, EngineCI.AdapterId, 0, TEX_FORMAT_RGBA8_UNORM_SRGB, NumDisplayModes, m_DisplayModes.data());
             //}
 
-            pFactoryD3D12->CreateDeviceAndContextsD3D12(EngineCI, &(result.m_pDevice), &(result.m_pImmediateContext));
+            pFactoryD3D12->CreateDeviceAndContextsD3D12(EngineCI, &(result.m_pDevice), Contexts.data());
+            result.m_pImmediateContext = Contexts[0];
 
             if (result.m_pDevice != NULL)
             {
@@ -185,6 +198,11 @@ extern "C" _AnomalousExport CreateDeviceAndSwapChainResult GenericEngineFactory_
             break;
         }
     }
+
+    for (Uint32 i = 0; i < NumDeferredContexts; ++i)
+    {
+        ppDeferredContexts[i] = Contexts[1 + i];
+    }
     
     return result;
 }
\ No newline at end of file
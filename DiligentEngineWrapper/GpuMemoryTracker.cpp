@@ -0,0 +1,218 @@
+#include "StdAfx.h"
+#include "Graphics/GraphicsAccessories/interface/GraphicsAccessories.hpp"
+#include "Graphics/GraphicsEngineD3D12/interface/BottomLevelASD3D12.h"
+#include "Graphics/GraphicsEngineD3D12/interface/TopLevelASD3D12.h"
+#include <algorithm>
+#include <cstring>
+#include "GpuMemoryTracker.h"
+using namespace Diligent;
+
+GpuMemoryTracker& GpuMemoryTracker::Get()
+{
+	static GpuMemoryTracker tracker;
+	return tracker;
+}
+
+GpuMemoryTracker::GpuMemoryTracker()
+	:totals()
+{
+
+}
+
+void GpuMemoryTracker::Track(IBuffer* buffer)
+{
+	if (buffer == nullptr)
+	{
+		return;
+	}
+
+	const BufferDesc& desc = buffer->GetDesc();
+	GpuMemoryCategory category = GpuMemoryCategory::Buffer;
+	if (desc.Usage == USAGE_STAGING)
+	{
+		category = GpuMemoryCategory::Staging;
+	}
+	else if ((desc.BindFlags & BIND_RAY_TRACING) != 0)
+	{
+		//Scratch, instance and geometry buffers for building acceleration structures
+		category = GpuMemoryCategory::AccelerationStructure;
+	}
+	Add(buffer, desc.Size, category);
+}
+
+void GpuMemoryTracker::Track(ITexture* texture)
+{
+	if (texture == nullptr)
+	{
+		return;
+	}
+
+	const TextureDesc& desc = texture->GetDesc();
+	GpuMemoryCategory category = GpuMemoryCategory::Texture;
+	if (desc.Usage == USAGE_STAGING)
+	{
+		category = GpuMemoryCategory::Staging;
+	}
+	else if ((desc.BindFlags & (BIND_RENDER_TARGET | BIND_DEPTH_STENCIL | BIND_UNORDERED_ACCESS)) != 0)
+	{
+		category = GpuMemoryCategory::RenderTarget;
+	}
+	Add(texture, GetTextureSize(desc), category);
+}
+
+void GpuMemoryTracker::Track(IBottomLevelAS* blas)
+{
+	if (blas == nullptr)
+	{
+		return;
+	}
+
+	//Diligent only reports the size of the acceleration structure itself through D3D12. A compacted blas
+	//is created with its exact size, anything else can only be estimated from the build scratch size.
+	Uint64 size = GetMemorySize(blas);
+	bool estimated = false;
+	if (size == 0)
+	{
+		const BottomLevelASDesc& desc = blas->GetDesc();
+		size = desc.CompactedSize;
+		if (size == 0)
+		{
+			size = blas->GetScratchBufferSizes().Build;
+			estimated = true;
+		}
+	}
+	Add(blas, size, GpuMemoryCategory::AccelerationStructure, estimated);
+}
+
+void GpuMemoryTracker::Track(ITopLevelAS* tlas)
+{
+	if (tlas == nullptr)
+	{
+		return;
+	}
+
+	Uint64 size = GetMemorySize(tlas);
+	bool estimated = false;
+	if (size == 0)
+	{
+		const TopLevelASDesc& desc = tlas->GetDesc();
+		size = desc.CompactedSize;
+		if (size == 0)
+		{
+			size = tlas->GetScratchBufferSizes().Build;
+			estimated = true;
+		}
+	}
+	Add(tlas, size, GpuMemoryCategory::AccelerationStructure, estimated);
+}
+
+void GpuMemoryTracker::Add(IDeviceObject* object, uint64_t size, GpuMemoryCategory category, bool estimated)
+{
+	const char* name = object->GetDesc().Name;
+
+	std::lock_guard<std::mutex> lock(mutex);
+	auto inserted = entries.emplace(object, Entry());
+	Entry& entry = inserted.first->second;
+	if (!inserted.second)
+	{
+		//The address was reused, the old object has been released
+		totals[static_cast<uint32_t>(entry.Category)] -= entry.Size;
+	}
+	entry.Object = RefCntWeakPtr<IDeviceObject>(object);
+	entry.Size = size;
+	entry.Category = category;
+	entry.Estimated = estimated;
+	entry.Name = name != nullptr ? name : "";
+	totals[static_cast<uint32_t>(category)] += size;
+}
+
+void GpuMemoryTracker::RemoveReleasedLocked()
+{
+	for (auto i = entries.begin(); i != entries.end();)
+	{
+		if (i->second.Object.IsValid())
+		{
+			++i;
+		}
+		else
+		{
+			totals[static_cast<uint32_t>(i->second.Category)] -= i->second.Size;
+			i = entries.erase(i);
+		}
+	}
+}
+
+void GpuMemoryTracker::GetTotals(uint64_t* totals)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	RemoveReleasedLocked();
+	memcpy(totals, this->totals, sizeof(this->totals));
+}
+
+uint32_t GpuMemoryTracker::GetSnapshot(GpuMemoryEntryPassStruct* entries, uint32_t capacity)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	RemoveReleasedLocked();
+	uint32_t count = 0;
+	for (const auto& i : this->entries)
+	{
+		if (count < capacity)
+		{
+			GpuMemoryEntryPassStruct& dest = entries[count];
+			dest.Size = i.second.Size;
+			dest.Category = i.second.Category;
+			dest.Estimated = i.second.Estimated;
+			//Long names are cut off, the snapshot is only for finding what is using the memory
+			size_t length = std::min(i.second.Name.size(), sizeof(dest.Name) - 1);
+			memcpy(dest.Name, i.second.Name.c_str(), length);
+			dest.Name[length] = '\0';
+		}
+		++count;
+	}
+	return count;
+}
+
+uint64_t GpuMemoryTracker::GetTextureSize(const TextureDesc& desc)
+{
+	//The depth of a 3d texture is included in its mip size, it shares the array size field
+	Uint32 slices = desc.Type == RESOURCE_DIM_TEX_3D ? 1 : desc.ArraySize;
+	Uint64 size = 0;
+	for (Uint32 mip = 0; mip < desc.MipLevels; ++mip)
+	{
+		size += GetMipLevelProperties(desc, mip).MipSize;
+	}
+	return size * slices * desc.SampleCount;
+}
+
+uint64_t GpuMemoryTracker::GetMemorySize(IBottomLevelAS* blas)
+{
+	RefCntAutoPtr<IBottomLevelASD3D12> pBLASD3D12(blas, IID_BottomLevelASD3D12);
+	if (pBLASD3D12)
+	{
+		return pBLASD3D12->GetD3D12BLAS()->GetDesc().Width;
+	}
+	return 0;
+}
+
+uint64_t GpuMemoryTracker::GetMemorySize(ITopLevelAS* tlas)
+{
+	RefCntAutoPtr<ITopLevelASD3D12> pTLASD3D12(tlas, IID_TopLevelASD3D12);
+	if (pTLASD3D12)
+	{
+		return pTLASD3D12->GetD3D12TLAS()->GetDesc().Width;
+	}
+	return 0;
+}
+
+extern "C" _AnomalousExport void GpuMemoryTracker_GetTotals(
+	Uint64* pTotals)
+{
+	GpuMemoryTracker::Get().GetTotals(pTotals);
+}
+
+extern "C" _AnomalousExport Uint32 GpuMemoryTracker_GetSnapshot(
+	GpuMemoryEntryPassStruct* pEntries
+	, Uint32 Capacity)
+{
+	return GpuMemoryTracker::Get().GetSnapshot(pEntries, Capacity);
+}
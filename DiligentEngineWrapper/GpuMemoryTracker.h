@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "Graphics/GraphicsEngine/interface/Buffer.h"
+#include "Graphics/GraphicsEngine/interface/Texture.h"
+#include "Graphics/GraphicsEngine/interface/BottomLevelAS.h"
+#include "Graphics/GraphicsEngine/interface/TopLevelAS.h"
+#include "Common/interface/RefCntAutoPtr.hpp"
+
+//Must match GpuMemoryCategory in GpuMemoryTracker.cs
+enum class GpuMemoryCategory : uint32_t
+{
+	Buffer,
+	Staging,
+	Texture,
+	RenderTarget,
+	AccelerationStructure,
+	Count,
+};
+
+struct GpuMemoryEntryPassStruct
+{
+	uint64_t Size;
+	GpuMemoryCategory Category;
+	bool Estimated;
+	char Name[64];
+};
+
+//Process wide record of the gpu memory held by buffers, textures and acceleration structures created
+//through the wrapper. Only weak references are kept, entries for released objects are dropped the next
+//time the totals or a snapshot are read, so read them once a frame to keep the totals current. Sizes
+//are what the desc asks for, the driver can round these up. Acceleration structures use the size of
+//their D3D12 resource, on other backends they are estimated and their entries are marked as such.
+class GpuMemoryTracker
+{
+public:
+	static GpuMemoryTracker& Get();
+
+	void Track(Diligent::IBuffer* buffer);
+
+	void Track(Diligent::ITexture* texture);
+
+	void Track(Diligent::IBottomLevelAS* blas);
+
+	void Track(Diligent::ITopLevelAS* tlas);
+
+	//Fill totals with the bytes in each category, it must have room for GpuMemoryCategory::Count values.
+	void GetTotals(uint64_t* totals);
+
+	//Copy up to capacity entries into entries and return the number of tracked objects.
+	uint32_t GetSnapshot(GpuMemoryEntryPassStruct* entries, uint32_t capacity);
+
+	static uint64_t GetTextureSize(const Diligent::TextureDesc& desc);
+
+	//Size of the resource backing an acceleration structure. Only D3D12 can report this, other backends return 0.
+	static uint64_t GetMemorySize(Diligent::IBottomLevelAS* blas);
+
+	static uint64_t GetMemorySize(Diligent::ITopLevelAS* tlas);
+
+private:
+	struct Entry
+	{
+		Diligent::RefCntWeakPtr<Diligent::IDeviceObject> Object;
+		uint64_t Size;
+		GpuMemoryCategory Category;
+		bool Estimated;
+		std::string Name;
+	};
+
+	GpuMemoryTracker();
+
+	void Add(Diligent::IDeviceObject* object, uint64_t size, GpuMemoryCategory category, bool estimated = false);
+
+	void RemoveReleasedLocked();
+
+	std::mutex mutex;
+	//Keyed by the object, an address can only be reused once the object it belonged to is gone
+	std::unordered_map<Diligent::IDeviceObject*, Entry> entries;
+	uint64_t totals[static_cast<uint32_t>(GpuMemoryCategory::Count)];
+};
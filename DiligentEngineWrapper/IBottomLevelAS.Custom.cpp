@@ -1,16 +1,11 @@
 #include "StdAfx.h"
 #include "Graphics/GraphicsEngine/interface/BottomLevelAS.h"
+#include "GpuMemoryTracker.h"
 using namespace Diligent;
-extern "C" _AnomalousExport Uint32 IBottomLevelAS_GetScratchBufferSizes_Build(
-	IBottomLevelAS* objPtr
-)
-{
-	return objPtr->GetScratchBufferSizes().Build;
-}
-
-extern "C" _AnomalousExport Uint32 IBottomLevelAS_GetScratchBufferSizes_Update(
+//Size of the memory backing the blas in bytes. Only D3D12 can report this, other backends return 0.
+extern "C" _AnomalousExport Uint64 IBottomLevelAS_GetMemorySize(
 	IBottomLevelAS * objPtr
 )
 {
-	return objPtr->GetScratchBufferSizes().Update;
-}
\ No newline at end of file
+	return GpuMemoryTracker::GetMemorySize(objPtr);
+}
@@ -1,5 +1,6 @@
 #include "StdAfx.h"
 #include "Graphics/GraphicsEngine/interface/Buffer.h"
+#include "BufferDesc.PassStruct.h"
 using namespace Diligent;
 extern "C" _AnomalousExport IBufferView* IBuffer_GetDefaultView(
 	IBuffer* objPtr
@@ -9,3 +10,14 @@ extern "C" _AnomalousExport IBufferView* IBuffer_GetDefaultView(
 		ViewType
 	);
 }
+extern "C" _AnomalousExport void IBuffer_GetDesc(
+	IBuffer* objPtr
+, BufferDescPassStruct* pResult)
+{
+	const auto& theReturnValue = objPtr->GetDesc();
+	pResult->Size = theReturnValue.Size;
+	pResult->BindFlags = theReturnValue.BindFlags;
+	pResult->Usage = theReturnValue.Usage;
+	pResult->CPUAccessFlags = theReturnValue.CPUAccessFlags;
+	pResult->ElementByteStride = theReturnValue.ElementByteStride;
+}
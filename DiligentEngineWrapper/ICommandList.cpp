@@ -0,0 +1,3 @@
+#include "StdAfx.h"
+#include "Graphics/GraphicsEngine/interface/CommandList.h"
+using namespace Diligent;
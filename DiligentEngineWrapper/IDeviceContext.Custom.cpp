@@ -1,6 +1,10 @@
 #include "StdAfx.h"
 
 #include "Graphics/GraphicsEngine/interface/DeviceContext.h"
+#include "Graphics/GraphicsEngine/interface/RenderDevice.h"
+#include "Graphics/GraphicsEngine/interface/CommandList.h"
+#include "Common/interface/RefCntAutoPtr.hpp"
+#include <cstring>
 #include "StateTransitionDesc.PassStruct.h"
 
 using namespace Diligent;
@@ -30,23 +34,147 @@ extern "C" _AnomalousExport void IDeviceContext_TransitionResourceStates(
 	, Uint32 BarrierCount
 	, StateTransitionDescPassStruct * pResourceBarriers)
 {
-	StateTransitionDesc* nativeArray = new StateTransitionDesc[BarrierCount];
-	for (Uint32 i = 0; i < BarrierCount; ++i) 
-	{
-		nativeArray[i].pResourceBefore = pResourceBarriers[i].pResourceBefore;
-		nativeArray[i].pResource = pResourceBarriers[i].pResource;
-		nativeArray[i].FirstMipLevel = pResourceBarriers[i].FirstMipLevel;
-		nativeArray[i].MipLevelsCount = pResourceBarriers[i].MipLevelsCount;
-		nativeArray[i].FirstArraySlice = pResourceBarriers[i].FirstArraySlice;
-		nativeArray[i].ArraySliceCount = pResourceBarriers[i].ArraySliceCount;
-		nativeArray[i].OldState = pResourceBarriers[i].OldState;
-		nativeArray[i].NewState = pResourceBarriers[i].NewState;
-		nativeArray[i].TransitionType = pResourceBarriers[i].TransitionType;
-		nativeArray[i].Flags = pResourceBarriers[i].Flags;
-	}
+	//The pass struct has the same layout as StateTransitionDesc, so it can be handed over without a copy.
+	static_assert(sizeof(StateTransitionDesc) == sizeof(StateTransitionDescPassStruct), "StateTransitionDescPassStruct must match StateTransitionDesc");
+	static_assert(offsetof(StateTransitionDesc, pResourceBefore) == offsetof(StateTransitionDescPassStruct, pResourceBefore), "StateTransitionDescPassStruct.pResourceBefore offset must match");
+	static_assert(offsetof(StateTransitionDesc, pResource) == offsetof(StateTransitionDescPassStruct, pResource), "StateTransitionDescPassStruct.pResource offset must match");
+	static_assert(offsetof(StateTransitionDesc, FirstMipLevel) == offsetof(StateTransitionDescPassStruct, FirstMipLevel), "StateTransitionDescPassStruct.FirstMipLevel offset must match");
+	static_assert(offsetof(StateTransitionDesc, MipLevelsCount) == offsetof(StateTransitionDescPassStruct, MipLevelsCount), "StateTransitionDescPassStruct.MipLevelsCount offset must match");
+	static_assert(offsetof(StateTransitionDesc, FirstArraySlice) == offsetof(StateTransitionDescPassStruct, FirstArraySlice), "StateTransitionDescPassStruct.FirstArraySlice offset must match");
+	static_assert(offsetof(StateTransitionDesc, ArraySliceCount) == offsetof(StateTransitionDescPassStruct, ArraySliceCount), "StateTransitionDescPassStruct.ArraySliceCount offset must match");
+	static_assert(offsetof(StateTransitionDesc, OldState) == offsetof(StateTransitionDescPassStruct, OldState), "StateTransitionDescPassStruct.OldState offset must match");
+	static_assert(offsetof(StateTransitionDesc, NewState) == offsetof(StateTransitionDescPassStruct, NewState), "StateTransitionDescPassStruct.NewState offset must match");
+	static_assert(offsetof(StateTransitionDesc, TransitionType) == offsetof(StateTransitionDescPassStruct, TransitionType), "StateTransitionDescPassStruct.TransitionType offset must match");
+	static_assert(offsetof(StateTransitionDesc, Flags) == offsetof(StateTransitionDescPassStruct, Flags), "StateTransitionDescPassStruct.Flags offset must match");
 	objPtr->TransitionResourceStates(
 		BarrierCount
-		, nativeArray
+		, reinterpret_cast<const StateTransitionDesc*>(pResourceBarriers)
 	);
-	delete[] nativeArray;
-}
\ No newline at end of file
+}
+
+extern "C" _AnomalousExport void IDeviceContext_WriteBLASCompactedSize(
+	IDeviceContext * objPtr
+	, IBottomLevelAS * pBLAS
+	, IBuffer * pDestBuffer
+	, Uint64 DestBufferOffset
+	, RESOURCE_STATE_TRANSITION_MODE BLASTransitionMode
+	, RESOURCE_STATE_TRANSITION_MODE BufferTransitionMode)
+{
+	WriteBLASCompactedSizeAttribs Attribs;
+	Attribs.pBLAS = pBLAS;
+	Attribs.pDestBuffer = pDestBuffer;
+	Attribs.DestBufferOffset = DestBufferOffset;
+	Attribs.BLASTransitionMode = BLASTransitionMode;
+	Attribs.BufferTransitionMode = BufferTransitionMode;
+	objPtr->WriteBLASCompactedSize(Attribs);
+}
+
+extern "C" _AnomalousExport void IDeviceContext_CopyBLAS(
+	IDeviceContext * objPtr
+	, IBottomLevelAS * pSrc
+	, IBottomLevelAS * pDst
+	, COPY_AS_MODE Mode
+	, RESOURCE_STATE_TRANSITION_MODE SrcTransitionMode
+	, RESOURCE_STATE_TRANSITION_MODE DstTransitionMode)
+{
+	CopyBLASAttribs Attribs;
+	Attribs.pSrc = pSrc;
+	Attribs.pDst = pDst;
+	Attribs.Mode = Mode;
+	Attribs.SrcTransitionMode = SrcTransitionMode;
+	Attribs.DstTransitionMode = DstTransitionMode;
+	objPtr->CopyBLAS(Attribs);
+}
+
+//Write the compacted sizes of Count blases and read them back to pCompactedSizes. The blases must be built
+//with RAYTRACING_BUILD_AS_ALLOW_COMPACTION. This waits for the gpu to go idle so it is only for load time.
+//Returns false if the buffers to read the sizes back could not be created or mapped.
+extern "C" _AnomalousExport Bool IDeviceContext_ReadBLASCompactedSizes(
+	IDeviceContext * objPtr
+	, IRenderDevice * pDevice
+	, Uint32 Count
+	, IBottomLevelAS * *ppBLAS
+	, Uint64 * pCompactedSizes)
+{
+	if (Count == 0)
+	{
+		return true;
+	}
+
+	const Uint64 Size = sizeof(Uint64) * Count;
+
+	BufferDesc BuffDesc;
+	BuffDesc.Name = "BLAS compacted sizes";
+	BuffDesc.Usage = USAGE_DEFAULT;
+	BuffDesc.BindFlags = BIND_UNORDERED_ACCESS;
+	BuffDesc.Mode = BUFFER_MODE_RAW;
+	BuffDesc.Size = Size;
+	RefCntAutoPtr<IBuffer> pSizeBuffer;
+	pDevice->CreateBuffer(BuffDesc, nullptr, &pSizeBuffer);
+
+	BufferDesc StagingDesc;
+	StagingDesc.Name = "BLAS compacted sizes readback";
+	StagingDesc.Usage = USAGE_STAGING;
+	StagingDesc.CPUAccessFlags = CPU_ACCESS_READ;
+	StagingDesc.Size = Size;
+	RefCntAutoPtr<IBuffer> pStagingBuffer;
+	pDevice->CreateBuffer(StagingDesc, nullptr, &pStagingBuffer);
+
+	if (!pSizeBuffer || !pStagingBuffer)
+	{
+		return false;
+	}
+
+	for (Uint32 i = 0; i < Count; ++i)
+	{
+		WriteBLASCompactedSizeAttribs Attribs;
+		Attribs.pBLAS = ppBLAS[i];
+		Attribs.pDestBuffer = pSizeBuffer;
+		Attribs.DestBufferOffset = sizeof(Uint64) * i;
+		Attribs.BLASTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+		Attribs.BufferTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+		objPtr->WriteBLASCompactedSize(Attribs);
+	}
+
+	objPtr->CopyBuffer(pSizeBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pStagingBuffer, 0, Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+	objPtr->WaitForIdle();
+
+	PVoid pData = nullptr;
+	objPtr->MapBuffer(pStagingBuffer, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+	if (pData == nullptr)
+	{
+		return false;
+	}
+	memcpy(pCompactedSizes, pData, static_cast<size_t>(Size));
+	objPtr->UnmapBuffer(pStagingBuffer, MAP_READ);
+	return true;
+}
+
+extern "C" _AnomalousExport void IDeviceContext_CopyBuffer(
+	IDeviceContext * objPtr
+	, IBuffer * pSrcBuffer
+	, Uint64 SrcOffset
+	, RESOURCE_STATE_TRANSITION_MODE SrcBufferTransitionMode
+	, IBuffer * pDstBuffer
+	, Uint64 DstOffset
+	, Uint64 Size
+	, RESOURCE_STATE_TRANSITION_MODE DstBufferTransitionMode)
+{
+	objPtr->CopyBuffer(pSrcBuffer, SrcOffset, SrcBufferTransitionMode, pDstBuffer, DstOffset, Size, DstBufferTransitionMode);
+}
+
+extern "C" _AnomalousExport ICommandList* IDeviceContext_FinishCommandList(
+	IDeviceContext * objPtr)
+{
+	ICommandList* pCommandList = nullptr;
+	objPtr->FinishCommandList(&pCommandList);
+	return pCommandList;
+}
+
+extern "C" _AnomalousExport void IDeviceContext_ExecuteCommandLists(
+	IDeviceContext * objPtr
+	, Uint32 NumCommandLists
+	, ICommandList * ppCommandLists[])
+{
+	objPtr->ExecuteCommandLists(NumCommandLists, ppCommandLists);
+}
@@ -5,6 +5,14 @@
 #include "BLASBuildTriangleData.PassStruct.h"
 #include "TLASBuildInstanceData.PassStruct.h"
 using namespace Diligent;
+extern "C" _AnomalousExport void IDeviceContext_Begin(
+	IDeviceContext* objPtr
+, Uint32 ImmediateContextId)
+{
+	objPtr->Begin(
+		ImmediateContextId
+	);
+}
 extern "C" _AnomalousExport void IDeviceContext_SetPipelineState(
 	IDeviceContext* objPtr
 , IPipelineState* pPipelineState)
@@ -87,6 +95,21 @@ extern "C" _AnomalousExport void IDeviceContext_DrawIndexed(
 		Attribs
 	);
 }
+extern "C" _AnomalousExport void IDeviceContext_DispatchCompute(
+	IDeviceContext* objPtr
+	, Uint32 Attribs_ThreadGroupCountX
+	, Uint32 Attribs_ThreadGroupCountY
+	, Uint32 Attribs_ThreadGroupCountZ
+)
+{
+	DispatchComputeAttribs Attribs;
+	Attribs.ThreadGroupCountX = Attribs_ThreadGroupCountX;
+	Attribs.ThreadGroupCountY = Attribs_ThreadGroupCountY;
+	Attribs.ThreadGroupCountZ = Attribs_ThreadGroupCountZ;
+	objPtr->DispatchCompute(
+		Attribs
+	);
+}
 extern "C" _AnomalousExport void IDeviceContext_ClearDepthStencil(
 	IDeviceContext* objPtr
 , ITextureView* pView, CLEAR_DEPTH_STENCIL_FLAGS ClearFlags, float fDepth, Uint8 Stencil, RESOURCE_STATE_TRANSITION_MODE StateTransitionMode)
@@ -109,6 +132,31 @@ extern "C" _AnomalousExport void IDeviceContext_ClearRenderTarget(
 		, StateTransitionMode
 	);
 }
+extern "C" _AnomalousExport void IDeviceContext_EnqueueSignal(
+	IDeviceContext* objPtr
+, IFence* pFence, Uint64 Value)
+{
+	objPtr->EnqueueSignal(
+		pFence
+		, Value
+	);
+}
+extern "C" _AnomalousExport void IDeviceContext_BeginQuery(
+	IDeviceContext* objPtr
+, IQuery* pQuery)
+{
+	objPtr->BeginQuery(
+		pQuery
+	);
+}
+extern "C" _AnomalousExport void IDeviceContext_EndQuery(
+	IDeviceContext* objPtr
+, IQuery* pQuery)
+{
+	objPtr->EndQuery(
+		pQuery
+	);
+}
 extern "C" _AnomalousExport void IDeviceContext_Flush(
 	IDeviceContext* objPtr
 )
@@ -150,6 +198,13 @@ extern "C" _AnomalousExport void IDeviceContext_UnmapBuffer(
 		, MapType
 	);
 }
+extern "C" _AnomalousExport void IDeviceContext_FinishFrame(
+	IDeviceContext* objPtr
+)
+{
+	objPtr->FinishFrame(
+	);
+}
 extern "C" _AnomalousExport void IDeviceContext_BuildBLAS(
 	IDeviceContext* objPtr
 	, IBottomLevelAS* Attribs_pBLAS
@@ -169,43 +224,31 @@ extern "C" _AnomalousExport void IDeviceContext_BuildBLAS(
 	Attribs.pBLAS = Attribs_pBLAS;
 	Attribs.BLASTransitionMode = Attribs_BLASTransitionMode;
 	Attribs.GeometryTransitionMode = Attribs_GeometryTransitionMode;
-	BLASBuildTriangleData* Attribs_pTriangleData_Native_Array = new BLASBuildTriangleData[Attribs_TriangleDataCount];
-	if(Attribs_TriangleDataCount > 0)
-	{
-		for (Uint32 i = 0; i < Attribs_TriangleDataCount; ++i)
-		{
-	    Attribs_pTriangleData_Native_Array[i].GeometryName = Attribs_pTriangleData[i].GeometryName;
-	    Attribs_pTriangleData_Native_Array[i].pVertexBuffer = Attribs_pTriangleData[i].pVertexBuffer;
-	    Attribs_pTriangleData_Native_Array[i].VertexOffset = Attribs_pTriangleData[i].VertexOffset;
-	    Attribs_pTriangleData_Native_Array[i].VertexStride = Attribs_pTriangleData[i].VertexStride;
-	    Attribs_pTriangleData_Native_Array[i].VertexCount = Attribs_pTriangleData[i].VertexCount;
-	    Attribs_pTriangleData_Native_Array[i].VertexValueType = Attribs_pTriangleData[i].VertexValueType;
-	    Attribs_pTriangleData_Native_Array[i].VertexComponentCount = Attribs_pTriangleData[i].VertexComponentCount;
-	    Attribs_pTriangleData_Native_Array[i].PrimitiveCount = Attribs_pTriangleData[i].PrimitiveCount;
-	    Attribs_pTriangleData_Native_Array[i].pIndexBuffer = Attribs_pTriangleData[i].pIndexBuffer;
-	    Attribs_pTriangleData_Native_Array[i].IndexOffset = Attribs_pTriangleData[i].IndexOffset;
-	    Attribs_pTriangleData_Native_Array[i].IndexType = Attribs_pTriangleData[i].IndexType;
-	    Attribs_pTriangleData_Native_Array[i].pTransformBuffer = Attribs_pTriangleData[i].pTransformBuffer;
-	    Attribs_pTriangleData_Native_Array[i].TransformBufferOffset = Attribs_pTriangleData[i].TransformBufferOffset;
-	    Attribs_pTriangleData_Native_Array[i].Flags = Attribs_pTriangleData[i].Flags;
-		}
-		Attribs.pTriangleData = Attribs_pTriangleData_Native_Array;  
-	}
+	static_assert(sizeof(BLASBuildTriangleData) == sizeof(BLASBuildTriangleDataPassStruct), "BLASBuildTriangleDataPassStruct must match BLASBuildTriangleData");
+	static_assert(offsetof(BLASBuildTriangleData, GeometryName) == offsetof(BLASBuildTriangleDataPassStruct, GeometryName), "BLASBuildTriangleDataPassStruct.GeometryName offset must match");
+	static_assert(offsetof(BLASBuildTriangleData, pVertexBuffer) == offsetof(BLASBuildTriangleDataPassStruct, pVertexBuffer), "BLASBuildTriangleDataPassStruct.pVertexBuffer offset must match");
+	static_assert(offsetof(BLASBuildTriangleData, VertexOffset) == offsetof(BLASBuildTriangleDataPassStruct, VertexOffset), "BLASBuildTriangleDataPassStruct.VertexOffset offset must match");
+	static_assert(offsetof(BLASBuildTriangleData, VertexStride) == offsetof(BLASBuildTriangleDataPassStruct, VertexStride), "BLASBuildTriangleDataPassStruct.VertexStride offset must match");
+	static_assert(offsetof(BLASBuildTriangleData, VertexCount) == offsetof(BLASBuildTriangleDataPassStruct, VertexCount), "BLASBuildTriangleDataPassStruct.VertexCount offset must match");
+	static_assert(offsetof(BLASBuildTriangleData, VertexValueType) == offsetof(BLASBuildTriangleDataPassStruct, VertexValueType), "BLASBuildTriangleDataPassStruct.VertexValueType offset must match");
+	static_assert(offsetof(BLASBuildTriangleData, VertexComponentCount) == offsetof(BLASBuildTriangleDataPassStruct, VertexComponentCount), "BLASBuildTriangleDataPassStruct.VertexComponentCount offset must match");
+	static_assert(offsetof(BLASBuildTriangleData, PrimitiveCount) == offsetof(BLASBuildTriangleDataPassStruct, PrimitiveCount), "BLASBuildTriangleDataPassStruct.PrimitiveCount offset must match");
+	static_assert(offsetof(BLASBuildTriangleData, pIndexBuffer) == offsetof(BLASBuildTriangleDataPassStruct, pIndexBuffer), "BLASBuildTriangleDataPassStruct.pIndexBuffer offset must match");
+	static_assert(offsetof(BLASBuildTriangleData, IndexOffset) == offsetof(BLASBuildTriangleDataPassStruct, IndexOffset), "BLASBuildTriangleDataPassStruct.IndexOffset offset must match");
+	static_assert(offsetof(BLASBuildTriangleData, IndexType) == offsetof(BLASBuildTriangleDataPassStruct, IndexType), "BLASBuildTriangleDataPassStruct.IndexType offset must match");
+	static_assert(offsetof(BLASBuildTriangleData, pTransformBuffer) == offsetof(BLASBuildTriangleDataPassStruct, pTransformBuffer), "BLASBuildTriangleDataPassStruct.pTransformBuffer offset must match");
+	static_assert(offsetof(BLASBuildTriangleData, TransformBufferOffset) == offsetof(BLASBuildTriangleDataPassStruct, TransformBufferOffset), "BLASBuildTriangleDataPassStruct.TransformBufferOffset offset must match");
+	static_assert(offsetof(BLASBuildTriangleData, Flags) == offsetof(BLASBuildTriangleDataPassStruct, Flags), "BLASBuildTriangleDataPassStruct.Flags offset must match");
+	Attribs.pTriangleData = reinterpret_cast<const BLASBuildTriangleData*>(Attribs_pTriangleData);
 	Attribs.TriangleDataCount = Attribs_TriangleDataCount;
-	BLASBuildBoundingBoxData* Attribs_pBoxData_Native_Array = new BLASBuildBoundingBoxData[Attribs_BoxDataCount];
-	if(Attribs_BoxDataCount > 0)
-	{
-		for (Uint32 i = 0; i < Attribs_BoxDataCount; ++i)
-		{
-	    Attribs_pBoxData_Native_Array[i].GeometryName = Attribs_pBoxData[i].GeometryName;
-	    Attribs_pBoxData_Native_Array[i].pBoxBuffer = Attribs_pBoxData[i].pBoxBuffer;
-	    Attribs_pBoxData_Native_Array[i].BoxOffset = Attribs_pBoxData[i].BoxOffset;
-	    Attribs_pBoxData_Native_Array[i].BoxStride = Attribs_pBoxData[i].BoxStride;
-	    Attribs_pBoxData_Native_Array[i].BoxCount = Attribs_pBoxData[i].BoxCount;
-	    Attribs_pBoxData_Native_Array[i].Flags = Attribs_pBoxData[i].Flags;
-		}
-		Attribs.pBoxData = Attribs_pBoxData_Native_Array;  
-	}
+	static_assert(sizeof(BLASBuildBoundingBoxData) == sizeof(BLASBuildBoundingBoxDataPassStruct), "BLASBuildBoundingBoxDataPassStruct must match BLASBuildBoundingBoxData");
+	static_assert(offsetof(BLASBuildBoundingBoxData, GeometryName) == offsetof(BLASBuildBoundingBoxDataPassStruct, GeometryName), "BLASBuildBoundingBoxDataPassStruct.GeometryName offset must match");
+	static_assert(offsetof(BLASBuildBoundingBoxData, pBoxBuffer) == offsetof(BLASBuildBoundingBoxDataPassStruct, pBoxBuffer), "BLASBuildBoundingBoxDataPassStruct.pBoxBuffer offset must match");
+	static_assert(offsetof(BLASBuildBoundingBoxData, BoxOffset) == offsetof(BLASBuildBoundingBoxDataPassStruct, BoxOffset), "BLASBuildBoundingBoxDataPassStruct.BoxOffset offset must match");
+	static_assert(offsetof(BLASBuildBoundingBoxData, BoxStride) == offsetof(BLASBuildBoundingBoxDataPassStruct, BoxStride), "BLASBuildBoundingBoxDataPassStruct.BoxStride offset must match");
+	static_assert(offsetof(BLASBuildBoundingBoxData, BoxCount) == offsetof(BLASBuildBoundingBoxDataPassStruct, BoxCount), "BLASBuildBoundingBoxDataPassStruct.BoxCount offset must match");
+	static_assert(offsetof(BLASBuildBoundingBoxData, Flags) == offsetof(BLASBuildBoundingBoxDataPassStruct, Flags), "BLASBuildBoundingBoxDataPassStruct.Flags offset must match");
+	Attribs.pBoxData = reinterpret_cast<const BLASBuildBoundingBoxData*>(Attribs_pBoxData);
 	Attribs.BoxDataCount = Attribs_BoxDataCount;
 	Attribs.pScratchBuffer = Attribs_pScratchBuffer;
 	Attribs.ScratchBufferOffset = Attribs_ScratchBufferOffset;
@@ -214,8 +257,6 @@ extern "C" _AnomalousExport void IDeviceContext_BuildBLAS(
 	objPtr->BuildBLAS(
 		Attribs
 	);
-    delete[] Attribs_pTriangleData_Native_Array;
-    delete[] Attribs_pBoxData_Native_Array;
 }
 extern "C" _AnomalousExport void IDeviceContext_BuildTLAS(
 	IDeviceContext* objPtr
@@ -240,21 +281,15 @@ extern "C" _AnomalousExport void IDeviceContext_BuildTLAS(
 	Attribs.pTLAS = Attribs_pTLAS;
 	Attribs.TLASTransitionMode = Attribs_TLASTransitionMode;
 	Attribs.BLASTransitionMode = Attribs_BLASTransitionMode;
-	TLASBuildInstanceData* Attribs_pInstances_Native_Array = new TLASBuildInstanceData[Attribs_InstanceCount];
-	if(Attribs_InstanceCount > 0)
-	{
-		for (Uint32 i = 0; i < Attribs_InstanceCount; ++i)
-		{
-	    Attribs_pInstances_Native_Array[i].InstanceName = Attribs_pInstances[i].InstanceName;
-	    Attribs_pInstances_Native_Array[i].pBLAS = Attribs_pInstances[i].pBLAS;
-	    Attribs_pInstances_Native_Array[i].Transform = Attribs_pInstances[i].Transform;
-	    Attribs_pInstances_Native_Array[i].CustomId = Attribs_pInstances[i].CustomId;
-	    Attribs_pInstances_Native_Array[i].Flags = Attribs_pInstances[i].Flags;
-	    Attribs_pInstances_Native_Array[i].Mask = Attribs_pInstances[i].Mask;
-	    Attribs_pInstances_Native_Array[i].ContributionToHitGroupIndex = Attribs_pInstances[i].ContributionToHitGroupIndex;
-		}
-		Attribs.pInstances = Attribs_pInstances_Native_Array;  
-	}
+	static_assert(sizeof(TLASBuildInstanceData) == sizeof(TLASBuildInstanceDataPassStruct), "TLASBuildInstanceDataPassStruct must match TLASBuildInstanceData");
+	static_assert(offsetof(TLASBuildInstanceData, InstanceName) == offsetof(TLASBuildInstanceDataPassStruct, InstanceName), "TLASBuildInstanceDataPassStruct.InstanceName offset must match");
+	static_assert(offsetof(TLASBuildInstanceData, pBLAS) == offsetof(TLASBuildInstanceDataPassStruct, pBLAS), "TLASBuildInstanceDataPassStruct.pBLAS offset must match");
+	static_assert(offsetof(TLASBuildInstanceData, Transform) == offsetof(TLASBuildInstanceDataPassStruct, Transform), "TLASBuildInstanceDataPassStruct.Transform offset must match");
+	static_assert(offsetof(TLASBuildInstanceData, CustomId) == offsetof(TLASBuildInstanceDataPassStruct, CustomId), "TLASBuildInstanceDataPassStruct.CustomId offset must match");
+	static_assert(offsetof(TLASBuildInstanceData, Flags) == offsetof(TLASBuildInstanceDataPassStruct, Flags), "TLASBuildInstanceDataPassStruct.Flags offset must match");
+	static_assert(offsetof(TLASBuildInstanceData, Mask) == offsetof(TLASBuildInstanceDataPassStruct, Mask), "TLASBuildInstanceDataPassStruct.Mask offset must match");
+	static_assert(offsetof(TLASBuildInstanceData, ContributionToHitGroupIndex) == offsetof(TLASBuildInstanceDataPassStruct, ContributionToHitGroupIndex), "TLASBuildInstanceDataPassStruct.ContributionToHitGroupIndex offset must match");
+	Attribs.pInstances = reinterpret_cast<const TLASBuildInstanceData*>(Attribs_pInstances);
 	Attribs.InstanceCount = Attribs_InstanceCount;
 	Attribs.pInstanceBuffer = Attribs_pInstanceBuffer;
 	Attribs.InstanceBufferOffset = Attribs_InstanceBufferOffset;
@@ -269,7 +304,6 @@ extern "C" _AnomalousExport void IDeviceContext_BuildTLAS(
 	objPtr->BuildTLAS(
 		Attribs
 	);
-    delete[] Attribs_pInstances_Native_Array;
 }
 extern "C" _AnomalousExport void IDeviceContext_TraceRays(
 	IDeviceContext* objPtr
@@ -0,0 +1,8 @@
+#include "StdAfx.h"
+#include "Graphics/GraphicsEngine/interface/Fence.h"
+using namespace Diligent;
+extern "C" _AnomalousExport Uint64 IFence_GetCompletedValue(
+	IFence* objPtr)
+{
+	return objPtr->GetCompletedValue();
+}
@@ -0,0 +1,19 @@
+#include "StdAfx.h"
+#include "Graphics/GraphicsEngine/interface/Fence.h"
+using namespace Diligent;
+extern "C" _AnomalousExport void IFence_Signal(
+	IFence* objPtr
+, Uint64 Value)
+{
+	objPtr->Signal(
+		Value
+	);
+}
+extern "C" _AnomalousExport void IFence_Wait(
+	IFence* objPtr
+, Uint64 Value)
+{
+	objPtr->Wait(
+		Value
+	);
+}
@@ -0,0 +1,25 @@
+#include "StdAfx.h"
+#include "Graphics/GraphicsEngine/interface/PipelineStateCache.h"
+#include "Primitives/interface/DataBlob.h"
+using namespace Diligent;
+
+//Get the cache contents to save to disk. The returned blob owns the data and must be released by the caller.
+extern "C" _AnomalousExport IDataBlob* IPipelineStateCache_GetData(
+	IPipelineStateCache * objPtr
+	, const void** ppData
+	, Uint64 * pSize)
+{
+	IDataBlob* pBlob = nullptr;
+	objPtr->GetData(&pBlob);
+	if (pBlob != nullptr)
+	{
+		*ppData = pBlob->GetConstDataPtr();
+		*pSize = pBlob->GetSize();
+	}
+	else
+	{
+		*ppData = nullptr;
+		*pSize = 0;
+	}
+	return pBlob;
+}
@@ -0,0 +1,3 @@
+#include "StdAfx.h"
+#include "Graphics/GraphicsEngine/interface/PipelineStateCache.h"
+using namespace Diligent;
@@ -0,0 +1,35 @@
+#include "StdAfx.h"
+#include "Graphics/GraphicsEngine/interface/Query.h"
+using namespace Diligent;
+//Returns false if the gpu has not finished with the query yet, the values are not written in that case.
+extern "C" _AnomalousExport bool IQuery_GetData_Timestamp(
+	IQuery* objPtr
+	, Uint64* pCounter
+	, Uint64* pFrequency
+	, bool AutoInvalidate)
+{
+	QueryDataTimestamp Data;
+	if (!objPtr->GetData(&Data, sizeof(Data), AutoInvalidate))
+	{
+		return false;
+	}
+	*pCounter = Data.Counter;
+	*pFrequency = Data.Frequency;
+	return true;
+}
+
+extern "C" _AnomalousExport bool IQuery_GetData_Duration(
+	IQuery* objPtr
+	, Uint64* pDuration
+	, Uint64* pFrequency
+	, bool AutoInvalidate)
+{
+	QueryDataDuration Data;
+	if (!objPtr->GetData(&Data, sizeof(Data), AutoInvalidate))
+	{
+		return false;
+	}
+	*pDuration = Data.Duration;
+	*pFrequency = Data.Frequency;
+	return true;
+}
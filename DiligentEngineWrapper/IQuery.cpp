@@ -0,0 +1,10 @@
+#include "StdAfx.h"
+#include "Graphics/GraphicsEngine/interface/Query.h"
+using namespace Diligent;
+extern "C" _AnomalousExport void IQuery_Invalidate(
+	IQuery* objPtr
+)
+{
+	objPtr->Invalidate(
+	);
+}
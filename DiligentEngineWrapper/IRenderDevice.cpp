@@ -11,6 +11,8 @@
 #include "RayTracingTriangleHitShaderGroup.PassStruct.h"
 #include "BLASTriangleDesc.PassStruct.h"
 #include "BLASBoundingBoxDesc.PassStruct.h"
+#include "NDCAttribs.PassStruct.h"
+#include "GpuMemoryTracker.h"
 using namespace Diligent;
 extern "C" _AnomalousExport IBuffer* IRenderDevice_CreateBuffer(
 	IRenderDevice* objPtr
@@ -48,6 +50,7 @@ extern "C" _AnomalousExport IBuffer* IRenderDevice_CreateBuffer(
 		, &pBuffData
 		, &theReturnValue
 	);
+	GpuMemoryTracker::Get().Track(theReturnValue);
 	return theReturnValue;
 }
 extern "C" _AnomalousExport IShader* IRenderDevice_CreateShader(
@@ -138,19 +141,13 @@ extern "C" _AnomalousExport ITexture* IRenderDevice_CreateTexture(
 	TexDesc.ImmediateContextMask = TexDesc_ImmediateContextMask;
 	TexDesc.Name = TexDesc_Name;
 	TextureData pData;
-	TextureSubResData* pData_pSubResources_Native_Array = new TextureSubResData[pData_NumSubresources];
-	if(pData_NumSubresources > 0)
-	{
-		for (Uint32 i = 0; i < pData_NumSubresources; ++i)
-		{
-	    pData_pSubResources_Native_Array[i].pData = pData_pSubResources[i].pData;
-	    pData_pSubResources_Native_Array[i].pSrcBuffer = pData_pSubResources[i].pSrcBuffer;
-	    pData_pSubResources_Native_Array[i].SrcOffset = pData_pSubResources[i].SrcOffset;
-	    pData_pSubResources_Native_Array[i].Stride = pData_pSubResources[i].Stride;
-	    pData_pSubResources_Native_Array[i].DepthStride = pData_pSubResources[i].DepthStride;
-		}
-		pData.pSubResources = pData_pSubResources_Native_Array;  
-	}
+	static_assert(sizeof(TextureSubResData) == sizeof(TextureSubResDataPassStruct), "TextureSubResDataPassStruct must match TextureSubResData");
+	static_assert(offsetof(TextureSubResData, pData) == offsetof(TextureSubResDataPassStruct, pData), "TextureSubResDataPassStruct.pData offset must match");
+	static_assert(offsetof(TextureSubResData, pSrcBuffer) == offsetof(TextureSubResDataPassStruct, pSrcBuffer), "TextureSubResDataPassStruct.pSrcBuffer offset must match");
+	static_assert(offsetof(TextureSubResData, SrcOffset) == offsetof(TextureSubResDataPassStruct, SrcOffset), "TextureSubResDataPassStruct.SrcOffset offset must match");
+	static_assert(offsetof(TextureSubResData, Stride) == offsetof(TextureSubResDataPassStruct, Stride), "TextureSubResDataPassStruct.Stride offset must match");
+	static_assert(offsetof(TextureSubResData, DepthStride) == offsetof(TextureSubResDataPassStruct, DepthStride), "TextureSubResDataPassStruct.DepthStride offset must match");
+	pData.pSubResources = reinterpret_cast<const TextureSubResData*>(pData_pSubResources);
 	pData.NumSubresources = pData_NumSubresources;
 	ITexture* theReturnValue = nullptr;
 	objPtr->CreateTexture(
@@ -158,7 +155,7 @@ extern "C" _AnomalousExport ITexture* IRenderDevice_CreateTexture(
 		, &pData
 		, &theReturnValue
 	);
-    delete[] pData_pSubResources_Native_Array;
+	GpuMemoryTracker::Get().Track(theReturnValue);
 	return theReturnValue;
 }
 extern "C" _AnomalousExport ISampler* IRenderDevice_CreateSampler(
@@ -275,6 +272,7 @@ extern "C" _AnomalousExport IPipelineState* IRenderDevice_CreateGraphicsPipeline
 	, ImmutableSamplerDescPassStruct* PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers
 	, Char* PSOCreateInfo_PSODesc_Name
 	, PSO_CREATE_FLAGS PSOCreateInfo_Flags
+	, IPipelineStateCache* PSOCreateInfo_pPSOCache
 )
 {
 	GraphicsPipelineStateCreateInfo PSOCreateInfo;
@@ -317,7 +315,8 @@ extern "C" _AnomalousExport IPipelineState* IRenderDevice_CreateGraphicsPipeline
 	PSOCreateInfo.GraphicsPipeline.DepthStencilDesc.BackFace.StencilDepthFailOp = PSOCreateInfo_GraphicsPipeline_DepthStencilDesc_BackFace_StencilDepthFailOp;
 	PSOCreateInfo.GraphicsPipeline.DepthStencilDesc.BackFace.StencilPassOp = PSOCreateInfo_GraphicsPipeline_DepthStencilDesc_BackFace_StencilPassOp;
 	PSOCreateInfo.GraphicsPipeline.DepthStencilDesc.BackFace.StencilFunc = PSOCreateInfo_GraphicsPipeline_DepthStencilDesc_BackFace_StencilFunc;
-	LayoutElement* PSOCreateInfo_GraphicsPipeline_InputLayout_LayoutElements_Native_Array = new LayoutElement[PSOCreateInfo_GraphicsPipeline_InputLayout_NumElements];
+	ScratchArenaScope scratch;
+	LayoutElement* PSOCreateInfo_GraphicsPipeline_InputLayout_LayoutElements_Native_Array = scratch.Alloc<LayoutElement>(PSOCreateInfo_GraphicsPipeline_InputLayout_NumElements);
 	if(PSOCreateInfo_GraphicsPipeline_InputLayout_NumElements > 0)
 	{
 		for (Uint32 i = 0; i < PSOCreateInfo_GraphicsPipeline_InputLayout_NumElements; ++i)
@@ -366,7 +365,7 @@ extern "C" _AnomalousExport IPipelineState* IRenderDevice_CreateGraphicsPipeline
 	PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = PSOCreateInfo_PSODesc_ResourceLayout_DefaultVariableType;
 	PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableMergeStages = PSOCreateInfo_PSODesc_ResourceLayout_DefaultVariableMergeStages;
 	PSOCreateInfo.PSODesc.ResourceLayout.NumVariables = PSOCreateInfo_PSODesc_ResourceLayout_NumVariables;
-	ShaderResourceVariableDesc* PSOCreateInfo_PSODesc_ResourceLayout_Variables_Native_Array = new ShaderResourceVariableDesc[PSOCreateInfo_PSODesc_ResourceLayout_NumVariables];
+	ShaderResourceVariableDesc* PSOCreateInfo_PSODesc_ResourceLayout_Variables_Native_Array = scratch.Alloc<ShaderResourceVariableDesc>(PSOCreateInfo_PSODesc_ResourceLayout_NumVariables);
 	if(PSOCreateInfo_PSODesc_ResourceLayout_NumVariables > 0)
 	{
 		for (Uint32 i = 0; i < PSOCreateInfo_PSODesc_ResourceLayout_NumVariables; ++i)
@@ -379,7 +378,7 @@ extern "C" _AnomalousExport IPipelineState* IRenderDevice_CreateGraphicsPipeline
 		PSOCreateInfo.PSODesc.ResourceLayout.Variables = PSOCreateInfo_PSODesc_ResourceLayout_Variables_Native_Array;  
 	}
 	PSOCreateInfo.PSODesc.ResourceLayout.NumImmutableSamplers = PSOCreateInfo_PSODesc_ResourceLayout_NumImmutableSamplers;
-	ImmutableSamplerDesc* PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers_Native_Array = new ImmutableSamplerDesc[PSOCreateInfo_PSODesc_ResourceLayout_NumImmutableSamplers];
+	ImmutableSamplerDesc* PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers_Native_Array = scratch.Alloc<ImmutableSamplerDesc>(PSOCreateInfo_PSODesc_ResourceLayout_NumImmutableSamplers);
 	if(PSOCreateInfo_PSODesc_ResourceLayout_NumImmutableSamplers > 0)
 	{
 		for (Uint32 i = 0; i < PSOCreateInfo_PSODesc_ResourceLayout_NumImmutableSamplers; ++i)
@@ -408,14 +407,88 @@ extern "C" _AnomalousExport IPipelineState* IRenderDevice_CreateGraphicsPipeline
 	}
 	PSOCreateInfo.PSODesc.Name = PSOCreateInfo_PSODesc_Name;
 	PSOCreateInfo.Flags = PSOCreateInfo_Flags;
+	PSOCreateInfo.pPSOCache = PSOCreateInfo_pPSOCache;
 	IPipelineState* theReturnValue = nullptr;
 	objPtr->CreateGraphicsPipelineState(
 		PSOCreateInfo
 		, &theReturnValue
 	);
-    delete[] PSOCreateInfo_GraphicsPipeline_InputLayout_LayoutElements_Native_Array;
-    delete[] PSOCreateInfo_PSODesc_ResourceLayout_Variables_Native_Array;
-    delete[] PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers_Native_Array;
+	return theReturnValue;
+}
+extern "C" _AnomalousExport IPipelineState* IRenderDevice_CreateComputePipelineState(
+	IRenderDevice* objPtr
+	, IShader* PSOCreateInfo_pCS
+	, PIPELINE_TYPE PSOCreateInfo_PSODesc_PipelineType
+	, Uint32 PSOCreateInfo_PSODesc_SRBAllocationGranularity
+	, Uint64 PSOCreateInfo_PSODesc_ImmediateContextMask
+	, SHADER_RESOURCE_VARIABLE_TYPE PSOCreateInfo_PSODesc_ResourceLayout_DefaultVariableType
+	, SHADER_TYPE PSOCreateInfo_PSODesc_ResourceLayout_DefaultVariableMergeStages
+	, Uint32 PSOCreateInfo_PSODesc_ResourceLayout_NumVariables
+	, ShaderResourceVariableDescPassStruct* PSOCreateInfo_PSODesc_ResourceLayout_Variables
+	, Uint32 PSOCreateInfo_PSODesc_ResourceLayout_NumImmutableSamplers
+	, ImmutableSamplerDescPassStruct* PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers
+	, Char* PSOCreateInfo_PSODesc_Name
+	, PSO_CREATE_FLAGS PSOCreateInfo_Flags
+	, IPipelineStateCache* PSOCreateInfo_pPSOCache
+)
+{
+	ComputePipelineStateCreateInfo PSOCreateInfo;
+	PSOCreateInfo.pCS = PSOCreateInfo_pCS;
+	PSOCreateInfo.PSODesc.PipelineType = PSOCreateInfo_PSODesc_PipelineType;
+	PSOCreateInfo.PSODesc.SRBAllocationGranularity = PSOCreateInfo_PSODesc_SRBAllocationGranularity;
+	PSOCreateInfo.PSODesc.ImmediateContextMask = PSOCreateInfo_PSODesc_ImmediateContextMask;
+	PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = PSOCreateInfo_PSODesc_ResourceLayout_DefaultVariableType;
+	PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableMergeStages = PSOCreateInfo_PSODesc_ResourceLayout_DefaultVariableMergeStages;
+	PSOCreateInfo.PSODesc.ResourceLayout.NumVariables = PSOCreateInfo_PSODesc_ResourceLayout_NumVariables;
+	ScratchArenaScope scratch;
+	ShaderResourceVariableDesc* PSOCreateInfo_PSODesc_ResourceLayout_Variables_Native_Array = scratch.Alloc<ShaderResourceVariableDesc>(PSOCreateInfo_PSODesc_ResourceLayout_NumVariables);
+	if(PSOCreateInfo_PSODesc_ResourceLayout_NumVariables > 0)
+	{
+		for (Uint32 i = 0; i < PSOCreateInfo_PSODesc_ResourceLayout_NumVariables; ++i)
+		{
+	    PSOCreateInfo_PSODesc_ResourceLayout_Variables_Native_Array[i].ShaderStages = PSOCreateInfo_PSODesc_ResourceLayout_Variables[i].ShaderStages;
+	    PSOCreateInfo_PSODesc_ResourceLayout_Variables_Native_Array[i].Name = PSOCreateInfo_PSODesc_ResourceLayout_Variables[i].Name;
+	    PSOCreateInfo_PSODesc_ResourceLayout_Variables_Native_Array[i].Type = PSOCreateInfo_PSODesc_ResourceLayout_Variables[i].Type;
+	    PSOCreateInfo_PSODesc_ResourceLayout_Variables_Native_Array[i].Flags = PSOCreateInfo_PSODesc_ResourceLayout_Variables[i].Flags;
+		}
+		PSOCreateInfo.PSODesc.ResourceLayout.Variables = PSOCreateInfo_PSODesc_ResourceLayout_Variables_Native_Array;  
+	}
+	PSOCreateInfo.PSODesc.ResourceLayout.NumImmutableSamplers = PSOCreateInfo_PSODesc_ResourceLayout_NumImmutableSamplers;
+	ImmutableSamplerDesc* PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers_Native_Array = scratch.Alloc<ImmutableSamplerDesc>(PSOCreateInfo_PSODesc_ResourceLayout_NumImmutableSamplers);
+	if(PSOCreateInfo_PSODesc_ResourceLayout_NumImmutableSamplers > 0)
+	{
+		for (Uint32 i = 0; i < PSOCreateInfo_PSODesc_ResourceLayout_NumImmutableSamplers; ++i)
+		{
+	    PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers_Native_Array[i].ShaderStages = PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers[i].ShaderStages;
+	    PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers_Native_Array[i].SamplerOrTextureName = PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers[i].SamplerOrTextureName;
+	    PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers_Native_Array[i].Desc.MinFilter = PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers[i].Desc_MinFilter;
+	    PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers_Native_Array[i].Desc.MagFilter = PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers[i].Desc_MagFilter;
+	    PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers_Native_Array[i].Desc.MipFilter = PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers[i].Desc_MipFilter;
+	    PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers_Native_Array[i].Desc.AddressU = PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers[i].Desc_AddressU;
+	    PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers_Native_Array[i].Desc.AddressV = PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers[i].Desc_AddressV;
+	    PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers_Native_Array[i].Desc.AddressW = PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers[i].Desc_AddressW;
+	    PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers_Native_Array[i].Desc.Flags = PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers[i].Desc_Flags;
+	    PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers_Native_Array[i].Desc.UnnormalizedCoords = PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers[i].Desc_UnnormalizedCoords;
+	    PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers_Native_Array[i].Desc.MipLODBias = PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers[i].Desc_MipLODBias;
+	    PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers_Native_Array[i].Desc.MaxAnisotropy = PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers[i].Desc_MaxAnisotropy;
+	    PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers_Native_Array[i].Desc.ComparisonFunc = PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers[i].Desc_ComparisonFunc;
+	    PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers_Native_Array[i].Desc.BorderColor[0] = PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers[i].Desc_BorderColor[0];
+	    PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers_Native_Array[i].Desc.BorderColor[1] = PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers[i].Desc_BorderColor[1];
+	    PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers_Native_Array[i].Desc.BorderColor[2] = PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers[i].Desc_BorderColor[2];
+	    PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers_Native_Array[i].Desc.BorderColor[3] = PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers[i].Desc_BorderColor[3];
+	    PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers_Native_Array[i].Desc.MinLOD = PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers[i].Desc_MinLOD;
+	    PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers_Native_Array[i].Desc.MaxLOD = PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers[i].Desc_MaxLOD;
+		}
+		PSOCreateInfo.PSODesc.ResourceLayout.ImmutableSamplers = PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers_Native_Array;  
+	}
+	PSOCreateInfo.PSODesc.Name = PSOCreateInfo_PSODesc_Name;
+	PSOCreateInfo.Flags = PSOCreateInfo_Flags;
+	PSOCreateInfo.pPSOCache = PSOCreateInfo_pPSOCache;
+	IPipelineState* theReturnValue = nullptr;
+	objPtr->CreateComputePipelineState(
+		PSOCreateInfo
+		, &theReturnValue
+	);
 	return theReturnValue;
 }
 extern "C" _AnomalousExport IPipelineState* IRenderDevice_CreateRayTracingPipelineState(
@@ -442,12 +515,14 @@ extern "C" _AnomalousExport IPipelineState* IRenderDevice_CreateRayTracingPipeli
 	, ImmutableSamplerDescPassStruct* PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers
 	, Char* PSOCreateInfo_PSODesc_Name
 	, PSO_CREATE_FLAGS PSOCreateInfo_Flags
+	, IPipelineStateCache* PSOCreateInfo_pPSOCache
 )
 {
 	RayTracingPipelineStateCreateInfo PSOCreateInfo;
 	PSOCreateInfo.RayTracingPipeline.ShaderRecordSize = PSOCreateInfo_RayTracingPipeline_ShaderRecordSize;
 	PSOCreateInfo.RayTracingPipeline.MaxRecursionDepth = PSOCreateInfo_RayTracingPipeline_MaxRecursionDepth;
-	RayTracingGeneralShaderGroup* PSOCreateInfo_pGeneralShaders_Native_Array = new RayTracingGeneralShaderGroup[PSOCreateInfo_GeneralShaderCount];
+	ScratchArenaScope scratch;
+	RayTracingGeneralShaderGroup* PSOCreateInfo_pGeneralShaders_Native_Array = scratch.Alloc<RayTracingGeneralShaderGroup>(PSOCreateInfo_GeneralShaderCount);
 	if(PSOCreateInfo_GeneralShaderCount > 0)
 	{
 		for (Uint32 i = 0; i < PSOCreateInfo_GeneralShaderCount; ++i)
@@ -458,7 +533,7 @@ extern "C" _AnomalousExport IPipelineState* IRenderDevice_CreateRayTracingPipeli
 		PSOCreateInfo.pGeneralShaders = PSOCreateInfo_pGeneralShaders_Native_Array;  
 	}
 	PSOCreateInfo.GeneralShaderCount = PSOCreateInfo_GeneralShaderCount;
-	RayTracingTriangleHitShaderGroup* PSOCreateInfo_pTriangleHitShaders_Native_Array = new RayTracingTriangleHitShaderGroup[PSOCreateInfo_TriangleHitShaderCount];
+	RayTracingTriangleHitShaderGroup* PSOCreateInfo_pTriangleHitShaders_Native_Array = scratch.Alloc<RayTracingTriangleHitShaderGroup>(PSOCreateInfo_TriangleHitShaderCount);
 	if(PSOCreateInfo_TriangleHitShaderCount > 0)
 	{
 		for (Uint32 i = 0; i < PSOCreateInfo_TriangleHitShaderCount; ++i)
@@ -470,7 +545,7 @@ extern "C" _AnomalousExport IPipelineState* IRenderDevice_CreateRayTracingPipeli
 		PSOCreateInfo.pTriangleHitShaders = PSOCreateInfo_pTriangleHitShaders_Native_Array;  
 	}
 	PSOCreateInfo.TriangleHitShaderCount = PSOCreateInfo_TriangleHitShaderCount;
-	RayTracingProceduralHitShaderGroup* PSOCreateInfo_pProceduralHitShaders_Native_Array = new RayTracingProceduralHitShaderGroup[PSOCreateInfo_ProceduralHitShaderCount];
+	RayTracingProceduralHitShaderGroup* PSOCreateInfo_pProceduralHitShaders_Native_Array = scratch.Alloc<RayTracingProceduralHitShaderGroup>(PSOCreateInfo_ProceduralHitShaderCount);
 	if(PSOCreateInfo_ProceduralHitShaderCount > 0)
 	{
 		for (Uint32 i = 0; i < PSOCreateInfo_ProceduralHitShaderCount; ++i)
@@ -492,7 +567,7 @@ extern "C" _AnomalousExport IPipelineState* IRenderDevice_CreateRayTracingPipeli
 	PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = PSOCreateInfo_PSODesc_ResourceLayout_DefaultVariableType;
 	PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableMergeStages = PSOCreateInfo_PSODesc_ResourceLayout_DefaultVariableMergeStages;
 	PSOCreateInfo.PSODesc.ResourceLayout.NumVariables = PSOCreateInfo_PSODesc_ResourceLayout_NumVariables;
-	ShaderResourceVariableDesc* PSOCreateInfo_PSODesc_ResourceLayout_Variables_Native_Array = new ShaderResourceVariableDesc[PSOCreateInfo_PSODesc_ResourceLayout_NumVariables];
+	ShaderResourceVariableDesc* PSOCreateInfo_PSODesc_ResourceLayout_Variables_Native_Array = scratch.Alloc<ShaderResourceVariableDesc>(PSOCreateInfo_PSODesc_ResourceLayout_NumVariables);
 	if(PSOCreateInfo_PSODesc_ResourceLayout_NumVariables > 0)
 	{
 		for (Uint32 i = 0; i < PSOCreateInfo_PSODesc_ResourceLayout_NumVariables; ++i)
@@ -505,7 +580,7 @@ extern "C" _AnomalousExport IPipelineState* IRenderDevice_CreateRayTracingPipeli
 		PSOCreateInfo.PSODesc.ResourceLayout.Variables = PSOCreateInfo_PSODesc_ResourceLayout_Variables_Native_Array;  
 	}
 	PSOCreateInfo.PSODesc.ResourceLayout.NumImmutableSamplers = PSOCreateInfo_PSODesc_ResourceLayout_NumImmutableSamplers;
-	ImmutableSamplerDesc* PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers_Native_Array = new ImmutableSamplerDesc[PSOCreateInfo_PSODesc_ResourceLayout_NumImmutableSamplers];
+	ImmutableSamplerDesc* PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers_Native_Array = scratch.Alloc<ImmutableSamplerDesc>(PSOCreateInfo_PSODesc_ResourceLayout_NumImmutableSamplers);
 	if(PSOCreateInfo_PSODesc_ResourceLayout_NumImmutableSamplers > 0)
 	{
 		for (Uint32 i = 0; i < PSOCreateInfo_PSODesc_ResourceLayout_NumImmutableSamplers; ++i)
@@ -534,16 +609,12 @@ extern "C" _AnomalousExport IPipelineState* IRenderDevice_CreateRayTracingPipeli
 	}
 	PSOCreateInfo.PSODesc.Name = PSOCreateInfo_PSODesc_Name;
 	PSOCreateInfo.Flags = PSOCreateInfo_Flags;
+	PSOCreateInfo.pPSOCache = PSOCreateInfo_pPSOCache;
 	IPipelineState* theReturnValue = nullptr;
 	objPtr->CreateRayTracingPipelineState(
 		PSOCreateInfo
 		, &theReturnValue
 	);
-    delete[] PSOCreateInfo_pGeneralShaders_Native_Array;
-    delete[] PSOCreateInfo_pTriangleHitShaders_Native_Array;
-    delete[] PSOCreateInfo_pProceduralHitShaders_Native_Array;
-    delete[] PSOCreateInfo_PSODesc_ResourceLayout_Variables_Native_Array;
-    delete[] PSOCreateInfo_PSODesc_ResourceLayout_ImmutableSamplers_Native_Array;
 	return theReturnValue;
 }
 extern "C" _AnomalousExport IBottomLevelAS* IRenderDevice_CreateBLAS(
@@ -559,7 +630,8 @@ extern "C" _AnomalousExport IBottomLevelAS* IRenderDevice_CreateBLAS(
 )
 {
 	BottomLevelASDesc Desc;
-	BLASTriangleDesc* Desc_pTriangles_Native_Array = new BLASTriangleDesc[Desc_TriangleCount];
+	ScratchArenaScope scratch;
+	BLASTriangleDesc* Desc_pTriangles_Native_Array = scratch.Alloc<BLASTriangleDesc>(Desc_TriangleCount);
 	if(Desc_TriangleCount > 0)
 	{
 		for (Uint32 i = 0; i < Desc_TriangleCount; ++i)
@@ -575,7 +647,7 @@ extern "C" _AnomalousExport IBottomLevelAS* IRenderDevice_CreateBLAS(
 		Desc.pTriangles = Desc_pTriangles_Native_Array;  
 	}
 	Desc.TriangleCount = Desc_TriangleCount;
-	BLASBoundingBoxDesc* Desc_pBoxes_Native_Array = new BLASBoundingBoxDesc[Desc_BoxCount];
+	BLASBoundingBoxDesc* Desc_pBoxes_Native_Array = scratch.Alloc<BLASBoundingBoxDesc>(Desc_BoxCount);
 	if(Desc_BoxCount > 0)
 	{
 		for (Uint32 i = 0; i < Desc_BoxCount; ++i)
@@ -595,8 +667,7 @@ extern "C" _AnomalousExport IBottomLevelAS* IRenderDevice_CreateBLAS(
 		Desc
 		, &theReturnValue
 	);
-    delete[] Desc_pTriangles_Native_Array;
-    delete[] Desc_pBoxes_Native_Array;
+	GpuMemoryTracker::Get().Track(theReturnValue);
 	return theReturnValue;
 }
 extern "C" _AnomalousExport ITopLevelAS* IRenderDevice_CreateTLAS(
@@ -619,6 +690,7 @@ extern "C" _AnomalousExport ITopLevelAS* IRenderDevice_CreateTLAS(
 		Desc
 		, &theReturnValue
 	);
+	GpuMemoryTracker::Get().Track(theReturnValue);
 	return theReturnValue;
 }
 extern "C" _AnomalousExport IShaderBindingTable* IRenderDevice_CreateSBT(
@@ -637,3 +709,12 @@ extern "C" _AnomalousExport IShaderBindingTable* IRenderDevice_CreateSBT(
 	);
 	return theReturnValue;
 }
+extern "C" _AnomalousExport void IRenderDevice_GetNDCAttribs(
+	IRenderDevice* objPtr
+, NDCAttribsPassStruct* pResult)
+{
+	const auto& theReturnValue = objPtr->GetDeviceInfo().GetNDCAttribs();
+	pResult->MinZ = theReturnValue.MinZ;
+	pResult->ZtoDepthScale = theReturnValue.ZtoDepthScale;
+	pResult->YtoVScale = theReturnValue.YtoVScale;
+}
@@ -5,7 +5,7 @@
 #include "Graphics/GraphicsTools/interface/ShaderMacroHelper.hpp"
 #include "Color.h"
 #include "MacroPassStruct.h";
-#include "NDCAttribs.PassStruct.h"
+#include "GpuMemoryTracker.h"
 using namespace Diligent;
 extern "C" _AnomalousExport IBuffer * IRenderDevice_CreateBuffer_Null_Data(
 	IRenderDevice * objPtr
@@ -36,6 +36,7 @@ extern "C" _AnomalousExport IBuffer * IRenderDevice_CreateBuffer_Null_Data(
 		, nullptr
 		, &ppBuffer
 	);
+	GpuMemoryTracker::Get().Track(ppBuffer);
 	return ppBuffer;
 }
 extern "C" _AnomalousExport IShader * IRenderDevice_CreateShader_Macros(
@@ -90,17 +91,125 @@ extern "C" _AnomalousExport IShader * IRenderDevice_CreateShader_Macros(
 	return theReturnValue;
 }
 
-extern "C" _AnomalousExport NDCAttribsPassStruct IRenderDevice_GetDeviceCaps_GetNDCAttribs(IRenderDevice * objPtr)
+extern "C" _AnomalousExport Uint32 IRenderDevice_DeviceProperties_MaxRayTracingRecursionDepth(IRenderDevice * objPtr)
 {
-	auto attribs = objPtr->GetDeviceInfo().GetNDCAttribs();
-	NDCAttribsPassStruct result;
-	result.MinZ = attribs.MinZ;
-	result.YtoVScale = attribs.YtoVScale;
-	result.ZtoDepthScale = attribs.ZtoDepthScale;
-	return result;
+	return objPtr->GetAdapterInfo().RayTracing.MaxRecursionDepth;
 }
 
-extern "C" _AnomalousExport Uint32 IRenderDevice_DeviceProperties_MaxRayTracingRecursionDepth(IRenderDevice * objPtr)
+//Create a shader from bytecode that was compiled before and saved with IShader_GetBytecode, this skips compilation.
+extern "C" _AnomalousExport IShader * IRenderDevice_CreateShader_ByteCode(
+	IRenderDevice * objPtr
+	, Char * ShaderCI_EntryPoint
+	, bool ShaderCI_UseCombinedTextureSamplers
+	, Char * ShaderCI_CombinedSamplerSuffix
+	, SHADER_TYPE ShaderCI_Desc_ShaderType
+	, Char * ShaderCI_Desc_Name
+	, SHADER_SOURCE_LANGUAGE ShaderCI_SourceLanguage
+	, SHADER_COMPILER ShaderCI_ShaderCompiler
+	, Uint32 ShaderCI_HLSLVersion_Major
+	, Uint32 ShaderCI_HLSLVersion_Minor
+	, void* ShaderCI_ByteCode
+	, Uint64 ShaderCI_ByteCodeSize
+)
 {
-	return objPtr->GetAdapterInfo().RayTracing.MaxRecursionDepth;
-}
\ No newline at end of file
+	ShaderCreateInfo ShaderCI;
+	ShaderCI.EntryPoint = ShaderCI_EntryPoint;
+	ShaderCI.UseCombinedTextureSamplers = ShaderCI_UseCombinedTextureSamplers;
+	ShaderCI.CombinedSamplerSuffix = ShaderCI_CombinedSamplerSuffix;
+	ShaderCI.Desc.ShaderType = ShaderCI_Desc_ShaderType;
+	ShaderCI.Desc.Name = ShaderCI_Desc_Name;
+	ShaderCI.SourceLanguage = ShaderCI_SourceLanguage;
+	ShaderCI.ShaderCompiler = ShaderCI_ShaderCompiler;
+	ShaderCI.HLSLVersion.Major = ShaderCI_HLSLVersion_Major;
+	ShaderCI.HLSLVersion.Minor = ShaderCI_HLSLVersion_Minor;
+	ShaderCI.ByteCode = ShaderCI_ByteCode;
+	ShaderCI.ByteCodeSize = static_cast<size_t>(ShaderCI_ByteCodeSize);
+
+	IShader* theReturnValue = nullptr;
+	objPtr->CreateShader(
+		ShaderCI
+		, &theReturnValue
+	);
+	return theReturnValue;
+}
+
+//Returns null if the backend has no pipeline cache. Pass null data to start an empty cache.
+extern "C" _AnomalousExport IPipelineStateCache * IRenderDevice_CreatePipelineStateCache(
+	IRenderDevice * objPtr
+	, Char * Desc_Name
+	, PSO_CACHE_MODE Desc_Mode
+	, void* pCacheData
+	, Uint32 CacheDataSize
+)
+{
+	PipelineStateCacheCreateInfo CreateInfo;
+	CreateInfo.Desc.Name = Desc_Name;
+	CreateInfo.Desc.Mode = Desc_Mode;
+	CreateInfo.pCacheData = pCacheData;
+	CreateInfo.CacheDataSize = CacheDataSize;
+
+	IPipelineStateCache* theReturnValue = nullptr;
+	objPtr->CreatePipelineStateCache(
+		CreateInfo
+		, &theReturnValue
+	);
+	return theReturnValue;
+}
+
+extern "C" _AnomalousExport Uint32 IRenderDevice_GetAdapterInfo_VendorId(IRenderDevice * objPtr)
+{
+	return objPtr->GetAdapterInfo().VendorId;
+}
+
+extern "C" _AnomalousExport Uint32 IRenderDevice_GetAdapterInfo_DeviceId(IRenderDevice * objPtr)
+{
+	return objPtr->GetAdapterInfo().DeviceId;
+}
+
+//Timestamp queries are requested as optional when the device is created, check this before creating any.
+extern "C" _AnomalousExport bool IRenderDevice_DeviceFeatures_TimestampQueries(IRenderDevice * objPtr)
+{
+	return objPtr->GetDeviceInfo().Features.TimestampQueries == DEVICE_FEATURE_STATE_ENABLED;
+}
+
+//Bc texture compression is requested as optional when the device is created, check this before loading dds textures.
+extern "C" _AnomalousExport bool IRenderDevice_DeviceFeatures_TextureCompressionBC(IRenderDevice * objPtr)
+{
+	return objPtr->GetDeviceInfo().Features.TextureCompressionBC == DEVICE_FEATURE_STATE_ENABLED;
+}
+
+extern "C" _AnomalousExport IQuery * IRenderDevice_CreateQuery(
+	IRenderDevice * objPtr
+	, Char * Desc_Name
+	, QUERY_TYPE Desc_Type
+)
+{
+	QueryDesc Desc;
+	Desc.Name = Desc_Name;
+	Desc.Type = Desc_Type;
+
+	IQuery* theReturnValue = nullptr;
+	objPtr->CreateQuery(
+		Desc
+		, &theReturnValue
+	);
+	return theReturnValue;
+}
+
+extern "C" _AnomalousExport IFence * IRenderDevice_CreateFence(
+	IRenderDevice * objPtr
+	, Char * Desc_Name
+	, FENCE_TYPE Desc_Type
+)
+{
+	FenceDesc Desc;
+	Desc.Name = Desc_Name;
+	Desc.Type = Desc_Type;
+
+	IFence* theReturnValue = nullptr;
+	objPtr->CreateFence(
+		Desc
+		, &theReturnValue
+	);
+	return theReturnValue;
+}
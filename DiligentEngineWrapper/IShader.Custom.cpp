@@ -0,0 +1,15 @@
+#include "StdAfx.h"
+#include "Graphics/GraphicsEngine/interface/Shader.h"
+using namespace Diligent;
+
+//Get the compiled bytecode, DXIL for D3D12 and SPIRV for Vulkan. The pointer is owned by the shader.
+extern "C" _AnomalousExport const void* IShader_GetBytecode(
+	IShader * objPtr
+	, Uint64 * pSize)
+{
+	const void* pBytecode = nullptr;
+	Uint64 Size = 0;
+	objPtr->GetBytecode(&pBytecode, Size);
+	*pSize = Size;
+	return pBytecode;
+}
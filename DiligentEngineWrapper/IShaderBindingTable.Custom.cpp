@@ -0,0 +1,52 @@
+#include "StdAfx.h"
+#include "Graphics/GraphicsEngine/interface/ShaderBindingTable.h"
+#include "NameTable.h"
+using namespace Diligent;
+//Bind a batch of hit groups by their sbt binding index. The binding indices come from
+//ITopLevelAS_GetInstanceHitGroupIndices plus the ray offset so no instance name lookups happen here.
+//Shader groups are passed as ids from the NameTable.
+extern "C" _AnomalousExport void IShaderBindingTable_BindHitGroupsByIndex(
+	IShaderBindingTable* objPtr
+	, Uint32 Count
+	, Uint32* pBindingIndices
+	, Uint32* pShaderGroupNameIds
+	, Uint8* pData
+	, Uint32* pDataOffsets
+	, Uint32* pDataSizes
+)
+{
+	NameTable& names = NameTable::Get();
+	std::lock_guard<std::mutex> lock(names.GetMutex());
+	for (Uint32 i = 0; i < Count; ++i)
+	{
+		objPtr->BindHitGroupByIndex(
+			pBindingIndices[i]
+			, names.GetNameLocked(pShaderGroupNameIds[i])
+			, pDataSizes[i] > 0 ? pData + pDataOffsets[i] : nullptr
+			, pDataSizes[i]
+		);
+	}
+}
+
+//Same as BindHitGroupForInstance but the instance and shader group names are NameTable ids.
+extern "C" _AnomalousExport void IShaderBindingTable_BindHitGroupForInstanceById(
+	IShaderBindingTable* objPtr
+	, ITopLevelAS* pTLAS
+	, Uint32 InstanceNameId
+	, Uint32 RayOffsetInHitGroupIndex
+	, Uint32 ShaderGroupNameId
+	, void* pData
+	, Uint32 DataSize
+)
+{
+	NameTable& names = NameTable::Get();
+	std::lock_guard<std::mutex> lock(names.GetMutex());
+	objPtr->BindHitGroupForInstance(
+		pTLAS
+		, names.GetNameLocked(InstanceNameId)
+		, RayOffsetInHitGroupIndex
+		, names.GetNameLocked(ShaderGroupNameId)
+		, pData
+		, DataSize
+	);
+}
@@ -1,5 +1,6 @@
 #include "StdAfx.h"
 #include "Graphics/GraphicsEngine/interface/SwapChain.h"
+#include "SwapChainDesc.PassStruct.h"
 using namespace Diligent;
 extern "C" _AnomalousExport void ISwapChain_Present(
 	ISwapChain* objPtr
@@ -26,3 +27,16 @@ extern "C" _AnomalousExport ITextureView* ISwapChain_GetDepthBufferDSV(
 	return objPtr->GetDepthBufferDSV(
 	);
 }
+extern "C" _AnomalousExport void ISwapChain_GetDesc(
+	ISwapChain* objPtr
+, SwapChainDescPassStruct* pResult)
+{
+	const auto& theReturnValue = objPtr->GetDesc();
+	pResult->Width = theReturnValue.Width;
+	pResult->Height = theReturnValue.Height;
+	pResult->ColorBufferFormat = theReturnValue.ColorBufferFormat;
+	pResult->DepthBufferFormat = theReturnValue.DepthBufferFormat;
+	pResult->Usage = theReturnValue.Usage;
+	pResult->PreTransform = theReturnValue.PreTransform;
+	pResult->BufferCount = theReturnValue.BufferCount;
+}
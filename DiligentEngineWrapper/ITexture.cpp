@@ -1,5 +1,6 @@
 #include "StdAfx.h"
 #include "Graphics/GraphicsEngine/interface/Texture.h"
+#include "TextureDesc.PassStruct.h"
 using namespace Diligent;
 extern "C" _AnomalousExport ITextureView* ITexture_CreateView(
 	ITexture* objPtr
@@ -41,3 +42,19 @@ extern "C" _AnomalousExport ITextureView* ITexture_GetDefaultView(
 		ViewType
 	);
 }
+extern "C" _AnomalousExport void ITexture_GetDesc(
+	ITexture* objPtr
+, TextureDescPassStruct* pResult)
+{
+	const auto& theReturnValue = objPtr->GetDesc();
+	pResult->Type = theReturnValue.Type;
+	pResult->Width = theReturnValue.Width;
+	pResult->Height = theReturnValue.Height;
+	pResult->ArraySize = theReturnValue.ArraySize;
+	pResult->Format = theReturnValue.Format;
+	pResult->MipLevels = theReturnValue.MipLevels;
+	pResult->SampleCount = theReturnValue.SampleCount;
+	pResult->BindFlags = theReturnValue.BindFlags;
+	pResult->Usage = theReturnValue.Usage;
+	pResult->CPUAccessFlags = theReturnValue.CPUAccessFlags;
+}
@@ -1,16 +1,18 @@
 #include "StdAfx.h"
 #include "Graphics/GraphicsEngine/interface/TopLevelAS.h"
+#include "NameTable.h"
 using namespace Diligent;
-extern "C" _AnomalousExport Uint32 ITopLevelAS_GetScratchBufferSizes_Build(
-	ITopLevelAS* objPtr
-)
-{
-	return objPtr->GetScratchBufferSizes().Build;
-}
-
-extern "C" _AnomalousExport Uint32 ITopLevelAS_GetScratchBufferSizes_Update(
+extern "C" _AnomalousExport void ITopLevelAS_GetInstanceHitGroupIndices(
 	ITopLevelAS * objPtr
+	, Uint32 Count
+	, Uint32* pInstanceNameIds
+	, Uint32* pHitGroupIndices
 )
 {
-	return objPtr->GetScratchBufferSizes().Update;
+	NameTable& names = NameTable::Get();
+	std::lock_guard<std::mutex> lock(names.GetMutex());
+	for (Uint32 i = 0; i < Count; ++i)
+	{
+		pHitGroupIndices[i] = objPtr->GetInstanceDesc(names.GetNameLocked(pInstanceNameIds[i])).ContributionToHitGroupIndex;
+	}
 }
\ No newline at end of file
@@ -1,3 +1,12 @@
 #include "StdAfx.h"
 #include "Graphics/GraphicsEngine/interface/TopLevelAS.h"
+#include "ScratchBufferSizes.PassStruct.h"
 using namespace Diligent;
+extern "C" _AnomalousExport void ITopLevelAS_GetScratchBufferSizes(
+	ITopLevelAS* objPtr
+, ScratchBufferSizesPassStruct* pResult)
+{
+	const auto& theReturnValue = objPtr->GetScratchBufferSizes();
+	pResult->Build = theReturnValue.Build;
+	pResult->Update = theReturnValue.Update;
+}
@@ -0,0 +1,91 @@
+#include "StdAfx.h"
+#include "NameTable.h"
+using namespace Diligent;
+
+NameTable& NameTable::Get()
+{
+	static NameTable table;
+	return table;
+}
+
+NameTable::NameTable()
+{
+	//Reserve id 0 as null
+	entries.push_back({ nullptr, 0 });
+}
+
+uint32_t NameTable::Register(const char* name)
+{
+	if (name == nullptr)
+	{
+		return 0;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	auto found = ids.find(name);
+	if (found != ids.end())
+	{
+		++entries[found->second].refCount;
+		return found->second;
+	}
+
+	uint32_t id;
+	if (!freeIds.empty())
+	{
+		id = freeIds.back();
+		freeIds.pop_back();
+	}
+	else
+	{
+		id = static_cast<uint32_t>(entries.size());
+		entries.push_back({ nullptr, 0 });
+	}
+
+	auto added = ids.emplace(name, id).first;
+	entries[id] = { added->first.c_str(), 1 };
+	return id;
+}
+
+void NameTable::Release(uint32_t id)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (id == 0 || id >= entries.size() || entries[id].refCount == 0)
+	{
+		return;
+	}
+
+	Entry& entry = entries[id];
+	if (--entry.refCount == 0)
+	{
+		ids.erase(entry.name);
+		entry.name = nullptr;
+		freeIds.push_back(id);
+	}
+}
+
+const char* NameTable::GetName(uint32_t id)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return GetNameLocked(id);
+}
+
+extern "C" _AnomalousExport Uint32 NameTable_Register(
+	char* name
+)
+{
+	return NameTable::Get().Register(name);
+}
+
+extern "C" _AnomalousExport void NameTable_Release(
+	Uint32 id
+)
+{
+	NameTable::Get().Release(id);
+}
+
+extern "C" _AnomalousExport const char* NameTable_GetName(
+	Uint32 id
+)
+{
+	return NameTable::Get().GetName(id);
+}
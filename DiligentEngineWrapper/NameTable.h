@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//Process wide table of interned names. Managed code registers a name once and refers to it by id
+//after that so strings do not have to be marshalled every time they are passed to Diligent. The
+//const char* for an id stays valid until the last reference to it is released. Id 0 is never used
+//and always resolves to null. Ids are reused once they are released.
+class NameTable
+{
+public:
+	static NameTable& Get();
+
+	uint32_t Register(const char* name);
+
+	void Release(uint32_t id);
+
+	const char* GetName(uint32_t id);
+
+	//Resolve an id while already holding the lock from GetMutex, use this to look up many ids at once.
+	const char* GetNameLocked(uint32_t id) const
+	{
+		if (id == 0 || id >= entries.size())
+		{
+			return nullptr;
+		}
+		return entries[id].name;
+	}
+
+	std::mutex& GetMutex()
+	{
+		return mutex;
+	}
+
+private:
+	struct Entry
+	{
+		const char* name;
+		uint32_t refCount;
+	};
+
+	NameTable();
+
+	std::mutex mutex;
+	//Node based, so the key strings never move and entries can point at them
+	std::unordered_map<std::string, uint32_t> ids;
+	std::vector<Entry> entries;
+	std::vector<uint32_t> freeIds;
+};
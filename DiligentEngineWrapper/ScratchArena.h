@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+//A thread local bump allocator for the temporary native arrays the wrappers rebuild from
+//pass structs. Memory is kept between calls, so once the arena has grown to fit a frame's
+//worth of calls the wrappers don't touch the heap at all. Memory is grown in chunks and
+//existing chunks never move, so earlier allocations stay valid while later ones are made.
+class ScratchArena
+{
+public:
+	static ScratchArena& ThreadInstance()
+	{
+		static thread_local ScratchArena arena;
+		return arena;
+	}
+
+	void* Alloc(size_t size, size_t alignment)
+	{
+		while (true)
+		{
+			if (currentChunk < chunks.size())
+			{
+				Chunk& chunk = chunks[currentChunk];
+				size_t aligned = (offset + alignment - 1) & ~(alignment - 1);
+				if (aligned + size <= chunk.size)
+				{
+					offset = aligned + size;
+					return chunk.data.get() + aligned;
+				}
+				++currentChunk;
+				offset = 0;
+			}
+			else
+			{
+				size_t chunkSize = size + alignment > DefaultChunkSize ? (size + alignment) * 2 : DefaultChunkSize;
+				chunks.push_back(Chunk{ std::unique_ptr<char[]>(new char[chunkSize]), chunkSize });
+			}
+		}
+	}
+
+private:
+	friend class ScratchArenaScope;
+
+	static const size_t DefaultChunkSize = 64 * 1024;
+
+	struct Chunk
+	{
+		std::unique_ptr<char[]> data;
+		size_t size;
+	};
+
+	std::vector<Chunk> chunks;
+	size_t currentChunk = 0;
+	size_t offset = 0;
+};
+
+//Everything allocated through a scope is released when the scope closes. Scopes can nest.
+class ScratchArenaScope
+{
+public:
+	ScratchArenaScope()
+		:arena(ScratchArena::ThreadInstance()),
+		savedChunk(arena.currentChunk),
+		savedOffset(arena.offset)
+	{
+
+	}
+
+	~ScratchArenaScope()
+	{
+		arena.currentChunk = savedChunk;
+		arena.offset = savedOffset;
+	}
+
+	ScratchArenaScope(const ScratchArenaScope&) = delete;
+	ScratchArenaScope& operator=(const ScratchArenaScope&) = delete;
+
+	//Allocate and default construct count items, the items are never destructed.
+	template<typename T>
+	T* Alloc(size_t count)
+	{
+		static_assert(std::is_trivially_destructible<T>::value, "Scratch arena items are never destructed");
+		if (count == 0)
+		{
+			return nullptr;
+		}
+		T* items = static_cast<T*>(arena.Alloc(sizeof(T) * count, alignof(T)));
+		for (size_t i = 0; i < count; ++i)
+		{
+			new (items + i) T();
+		}
+		return items;
+	}
+
+private:
+	ScratchArena& arena;
+	size_t savedChunk;
+	size_t savedOffset;
+};
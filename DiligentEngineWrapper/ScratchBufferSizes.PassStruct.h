@@ -0,0 +1,12 @@
+#pragma once
+#include "Primitives/interface/BasicTypes.h"
+#include "Graphics/GraphicsEngine/interface/GraphicsTypes.h"
+
+namespace Diligent 
+{
+struct ScratchBufferSizesPassStruct
+{
+        Uint32 Build;
+        Uint32 Update;
+};
+}
\ No newline at end of file
@@ -18,4 +18,6 @@
 #define _AnomalousExport __attribute__ ((visibility("default")))
 #endif
 
+#include "ScratchArena.h"
+
 #endif //PCH_H
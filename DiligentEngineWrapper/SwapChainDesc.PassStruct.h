@@ -0,0 +1,17 @@
+#pragma once
+#include "Primitives/interface/BasicTypes.h"
+#include "Graphics/GraphicsEngine/interface/GraphicsTypes.h"
+
+namespace Diligent 
+{
+struct SwapChainDescPassStruct
+{
+        Uint32 Width;
+        Uint32 Height;
+        TEXTURE_FORMAT ColorBufferFormat;
+        TEXTURE_FORMAT DepthBufferFormat;
+        SWAP_CHAIN_USAGE_FLAGS Usage;
+        SURFACE_TRANSFORM PreTransform;
+        Uint32 BufferCount;
+};
+}
\ No newline at end of file
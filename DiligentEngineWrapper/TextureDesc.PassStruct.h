@@ -0,0 +1,20 @@
+#pragma once
+#include "Primitives/interface/BasicTypes.h"
+#include "Graphics/GraphicsEngine/interface/GraphicsTypes.h"
+
+namespace Diligent 
+{
+struct TextureDescPassStruct
+{
+        RESOURCE_DIMENSION Type;
+        Uint32 Width;
+        Uint32 Height;
+        Uint32 ArraySize;
+        TEXTURE_FORMAT Format;
+        Uint32 MipLevels;
+        Uint32 SampleCount;
+        BIND_FLAGS BindFlags;
+        USAGE Usage;
+        CPU_ACCESS_FLAGS CPUAccessFlags;
+};
+}
\ No newline at end of file
@@ -0,0 +1,338 @@
+#include "StdAfx.h"
+#include "Graphics/GraphicsAccessories/interface/GraphicsAccessories.hpp"
+#include <cstring>
+#include "TextureUploader.h"
+#include "GpuMemoryTracker.h"
+using namespace Diligent;
+
+static Uint64 AlignUp(Uint64 value, Uint64 alignment)
+{
+	return (value + alignment - 1) & ~(alignment - 1);
+}
+
+TextureUploader::TextureUploader(IRenderDevice* device, IDeviceContext* context, Uint64 ringSize)
+	:ringSize(AlignUp(ringSize, PlacementAlignment))
+{
+	BufferDesc RingDesc;
+	RingDesc.Name = "Texture upload ring";
+	RingDesc.Usage = USAGE_STAGING;
+	RingDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+	RingDesc.Size = this->ringSize;
+	device->CreateBuffer(RingDesc, nullptr, &ring);
+	GpuMemoryTracker::Get().Track(ring);
+
+	FenceDesc UploadFenceDesc;
+	UploadFenceDesc.Name = "Texture upload fence";
+	device->CreateFence(UploadFenceDesc, &fence);
+
+	//Mapped for the whole life of the uploader, staging writes are never read back by the cpu so
+	//nothing needs to be flushed between the workers writing and the gpu reading.
+	PVoid pData = nullptr;
+	context->MapBuffer(ring, MAP_WRITE, MAP_FLAG_NONE, pData);
+	mapped = reinterpret_cast<Uint8*>(pData);
+}
+
+void TextureUploader::Destroy(IDeviceContext* context)
+{
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		destroyed = true;
+		spaceAvailable.notify_all();
+		//A woken thread still has to relock and a writing one is still in the ring, both must be out before
+		//the ring is unmapped and the uploader deleted
+		stagersDone.wait(lock, [this]() { return activeStagers == 0; });
+	}
+
+	if (mapped != nullptr)
+	{
+		context->UnmapBuffer(ring, MAP_WRITE);
+		mapped = nullptr;
+	}
+}
+
+Uint64 TextureUploader::LayoutCopies(const TextureDesc& desc, Uint32 numSubresources, std::vector<Copy>* copies)
+{
+	const TextureFormatAttribs& FmtAttribs = GetTextureFormatAttribs(desc.Format);
+	Uint64 size = 0;
+	for (Uint32 i = 0; i < numSubresources; ++i)
+	{
+		//Same order as TextureData, every mip of the first slice then the next slice
+		Uint32 mipLevel = i % desc.MipLevels;
+		MipLevelProperties MipProps = GetMipLevelProperties(desc, mipLevel);
+		Copy copy;
+		copy.Offset = size;
+		copy.RowSize = MipProps.RowSize;
+		copy.Stride = AlignUp(MipProps.RowSize, RowPitchAlignment);
+		copy.Rows = MipProps.StorageHeight / FmtAttribs.BlockHeight;
+		copy.MipLevel = mipLevel;
+		copy.Slice = i / desc.MipLevels;
+		copy.Width = MipProps.LogicalWidth;
+		copy.Height = MipProps.LogicalHeight;
+		if (copies != nullptr)
+		{
+			copies->push_back(copy);
+		}
+		size = AlignUp(size + copy.Stride * copy.Rows, PlacementAlignment);
+	}
+	return size;
+}
+
+Uint64 TextureUploader::GetStagingSize(const TextureDesc& desc, Uint32 numSubresources)
+{
+	return LayoutCopies(desc, numSubresources, nullptr);
+}
+
+bool TextureUploader::TryAllocateLocked(Uint64 size, Uint64& offset, Uint64& allocated)
+{
+	if (used == 0)
+	{
+		head = tail = 0;
+	}
+
+	if (head > tail || used == 0)
+	{
+		//Free space is from the head to the end and then from the start to the tail
+		if (ringSize - head >= size)
+		{
+			offset = head;
+			allocated = size;
+		}
+		else if (tail >= size)
+		{
+			//Skip the rest of the ring, that space comes back when this upload retires
+			offset = 0;
+			allocated = ringSize - head + size;
+		}
+		else
+		{
+			return false;
+		}
+	}
+	else
+	{
+		//Free space is between the head and the tail, this is 0 when the ring is full
+		if (tail - head < size)
+		{
+			return false;
+		}
+		offset = head;
+		allocated = size;
+	}
+
+	head = offset + size;
+	used += allocated;
+	return true;
+}
+
+bool TextureUploader::Stage(ITexture* texture, const TextureSubResDataPassStruct* subresources, Uint32 numSubresources, bool wait)
+{
+	const TextureDesc& desc = texture->GetDesc();
+	std::vector<Copy> copies;
+	copies.reserve(numSubresources);
+	Uint64 size = LayoutCopies(desc, numSubresources, &copies);
+	if (size == 0 || size > ringSize)
+	{
+		return false;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (destroyed || mapped == nullptr)
+		{
+			return false;
+		}
+		++activeStagers;
+	}
+	StageScope scope{ *this };
+
+	Upload* upload;
+	Uint64 offset;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		Uint64 allocated;
+		while (!TryAllocateLocked(size, offset, allocated))
+		{
+			if (!wait || destroyed)
+			{
+				return false;
+			}
+			spaceAvailable.wait(lock);
+		}
+
+		uploads.push_back(Upload());
+		upload = &uploads.back();
+		upload->Texture = texture;
+		upload->State = UploadState::Writing;
+		upload->Allocated = allocated;
+		upload->End = head;
+		upload->FenceValue = 0;
+	}
+
+	//Writing happens without the lock, nothing else touches this part of the ring until it is marked ready
+	for (Uint32 i = 0; i < numSubresources; ++i)
+	{
+		Copy& copy = copies[i];
+		copy.Offset += offset;
+		const TextureSubResDataPassStruct& src = subresources[i];
+		const Uint8* srcRow = reinterpret_cast<const Uint8*>(src.pData);
+		Uint8* dstRow = mapped + copy.Offset;
+		for (Uint32 row = 0; row < copy.Rows; ++row)
+		{
+			memcpy(dstRow, srcRow, static_cast<size_t>(copy.RowSize));
+			srcRow += src.Stride;
+			dstRow += copy.Stride;
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		upload->Copies = std::move(copies);
+		upload->State = UploadState::Ready;
+	}
+	return true;
+}
+
+TextureUploader::StageScope::~StageScope()
+{
+	//Notify while locked, once the lock is released Destroy can return and the uploader can be deleted
+	std::lock_guard<std::mutex> lock(uploader.mutex);
+	if (--uploader.activeStagers == 0)
+	{
+		uploader.stagersDone.notify_all();
+	}
+}
+
+Uint32 TextureUploader::Process(IDeviceContext* context)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	Uint32 recorded = 0;
+	barriers.clear();
+	for (Upload& upload : uploads)
+	{
+		if (upload.State != UploadState::Ready)
+		{
+			continue;
+		}
+
+		for (const Copy& copy : upload.Copies)
+		{
+			TextureSubResData SubResData;
+			SubResData.pSrcBuffer = ring;
+			SubResData.SrcOffset = copy.Offset;
+			SubResData.Stride = copy.Stride;
+			Box DstBox(0, copy.Width, 0, copy.Height);
+			//The ring is a staging buffer so it is always in a state that can be copied from
+			context->UpdateTexture(upload.Texture, copy.MipLevel, copy.Slice, DstBox, SubResData,
+				RESOURCE_STATE_TRANSITION_MODE_NONE, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+		}
+
+		StateTransitionDesc Barrier;
+		Barrier.pResource = upload.Texture;
+		Barrier.OldState = RESOURCE_STATE_UNKNOWN;
+		Barrier.NewState = RESOURCE_STATE_SHADER_RESOURCE;
+		Barrier.Flags = STATE_TRANSITION_FLAG_UPDATE_STATE;
+		barriers.push_back(Barrier);
+
+		upload.State = UploadState::Recorded;
+		upload.FenceValue = nextFenceValue;
+		++recorded;
+	}
+
+	if (recorded > 0)
+	{
+		context->TransitionResourceStates(static_cast<Uint32>(barriers.size()), barriers.data());
+		context->EnqueueSignal(fence, nextFenceValue++);
+		//The barriers hold raw pointers, drop them before the textures can be released below
+		barriers.clear();
+	}
+
+	//Retire in allocation order, an upload still being written holds everything after it
+	Uint64 completed = fence->GetCompletedValue();
+	bool retired = false;
+	while (!uploads.empty())
+	{
+		Upload& upload = uploads.front();
+		if (upload.State != UploadState::Recorded || upload.FenceValue > completed)
+		{
+			break;
+		}
+
+		used -= upload.Allocated;
+		tail = upload.End;
+		uploads.pop_front();
+		retired = true;
+	}
+
+	if (retired)
+	{
+		spaceAvailable.notify_all();
+	}
+
+	return recorded;
+}
+
+Uint64 TextureUploader::GetUsedSize()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return used;
+}
+
+extern "C" _AnomalousExport TextureUploader* TextureUploader_Create(
+	IRenderDevice* pDevice
+	, IDeviceContext* pContext
+	, Uint64 RingSize)
+{
+	return new TextureUploader(pDevice, pContext, RingSize);
+}
+
+extern "C" _AnomalousExport void TextureUploader_Delete(
+	TextureUploader* objPtr
+	, IDeviceContext* pContext)
+{
+	objPtr->Destroy(pContext);
+	delete objPtr;
+}
+
+extern "C" _AnomalousExport Bool TextureUploader_Stage(
+	TextureUploader* objPtr
+	, ITexture* pTexture
+	, TextureSubResDataPassStruct* pSubResources
+	, Uint32 NumSubresources
+	, Bool Wait)
+{
+	return objPtr->Stage(pTexture, pSubResources, NumSubresources, Wait);
+}
+
+extern "C" _AnomalousExport Uint32 TextureUploader_Process(
+	TextureUploader* objPtr
+	, IDeviceContext* pContext)
+{
+	return objPtr->Process(pContext);
+}
+
+extern "C" _AnomalousExport Uint64 TextureUploader_GetStagingSize(
+	TextureUploader* objPtr
+	, RESOURCE_DIMENSION Type
+	, TEXTURE_FORMAT Format
+	, Uint32 Width
+	, Uint32 Height
+	, Uint32 ArraySize
+	, Uint32 MipLevels)
+{
+	TextureDesc Desc;
+	Desc.Type = Type;
+	Desc.Format = Format;
+	Desc.Width = Width;
+	Desc.Height = Height;
+	Desc.ArraySize = ArraySize;
+	Desc.MipLevels = MipLevels;
+	Uint64 size = TextureUploader::GetStagingSize(Desc, MipLevels * ArraySize);
+	return size <= objPtr->GetRingSize() ? size : 0;
+}
+
+extern "C" _AnomalousExport Uint64 TextureUploader_GetUsedSize(
+	TextureUploader* objPtr)
+{
+	return objPtr->GetUsedSize();
+}
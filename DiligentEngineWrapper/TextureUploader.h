@@ -0,0 +1,110 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+#include "Graphics/GraphicsEngine/interface/RenderDevice.h"
+#include "Graphics/GraphicsEngine/interface/DeviceContext.h"
+#include "Graphics/GraphicsEngine/interface/Fence.h"
+#include "Common/interface/RefCntAutoPtr.hpp"
+#include "TextureSubResData.PassStruct.h"
+
+//Streams texture data to the gpu through one persistently mapped staging buffer used as a ring.
+//Any thread can Stage a texture, which copies its subresources into the ring and queues the copy.
+//The render thread calls Process once a frame to record the queued copies on the immediate context
+//and signal a fence, ring space is reused once the gpu has passed that fence. Stage blocks when the
+//ring is full until Process retires enough space, so never call it with Wait set on the render thread.
+class TextureUploader
+{
+public:
+	//D3D12 needs buffer to texture copies to start on 512 bytes and rows to be 256 bytes apart,
+	//these are also fine for vulkan so the layout is the same for both.
+	static const Diligent::Uint64 PlacementAlignment = 512;
+	static const Diligent::Uint64 RowPitchAlignment = 256;
+
+	TextureUploader(Diligent::IRenderDevice* device, Diligent::IDeviceContext* context, Diligent::Uint64 ringSize);
+
+	//Wakes any thread waiting in Stage and waits for every thread to leave Stage, then unmaps the ring.
+	//The context must be the one the uploader was created with.
+	void Destroy(Diligent::IDeviceContext* context);
+
+	bool Stage(Diligent::ITexture* texture, const Diligent::TextureSubResDataPassStruct* subresources, Diligent::Uint32 numSubresources, bool wait);
+
+	//Record any staged copies and retire ring space the gpu is done with. Returns the number of textures recorded.
+	Diligent::Uint32 Process(Diligent::IDeviceContext* context);
+
+	//The number of ring bytes a texture with this desc and number of subresources needs.
+	static Diligent::Uint64 GetStagingSize(const Diligent::TextureDesc& desc, Diligent::Uint32 numSubresources);
+
+	Diligent::Uint64 GetRingSize() const
+	{
+		return ringSize;
+	}
+
+	Diligent::Uint64 GetUsedSize();
+
+private:
+	struct Copy
+	{
+		Diligent::Uint64 Offset;
+		Diligent::Uint64 Stride;
+		Diligent::Uint64 RowSize;
+		Diligent::Uint32 Rows;
+		Diligent::Uint32 MipLevel;
+		Diligent::Uint32 Slice;
+		Diligent::Uint32 Width;
+		Diligent::Uint32 Height;
+	};
+
+	enum class UploadState
+	{
+		Writing,
+		Ready,
+		Recorded,
+	};
+
+	struct Upload
+	{
+		Diligent::RefCntAutoPtr<Diligent::ITexture> Texture;
+		std::vector<Copy> Copies;
+		UploadState State;
+		//Bytes taken from the ring including anything skipped to wrap and where the ring head was after
+		Diligent::Uint64 Allocated;
+		Diligent::Uint64 End;
+		Diligent::Uint64 FenceValue;
+	};
+
+	//Layout the copies for a texture relative to the start of its allocation, returns the total size.
+	static Diligent::Uint64 LayoutCopies(const Diligent::TextureDesc& desc, Diligent::Uint32 numSubresources, std::vector<Copy>* copies);
+
+	bool TryAllocateLocked(Diligent::Uint64 size, Diligent::Uint64& offset, Diligent::Uint64& allocated);
+
+	//Counts a thread in Stage until it returns, Destroy waits for the count to reach 0
+	struct StageScope
+	{
+		TextureUploader& uploader;
+
+		~StageScope();
+	};
+
+	Diligent::RefCntAutoPtr<Diligent::IBuffer> ring;
+	Diligent::RefCntAutoPtr<Diligent::IFence> fence;
+	Diligent::Uint8* mapped = nullptr;
+	Diligent::Uint64 ringSize;
+	Diligent::Uint64 head = 0;
+	Diligent::Uint64 tail = 0;
+	Diligent::Uint64 used = 0;
+	Diligent::Uint64 nextFenceValue = 1;
+	bool destroyed = false;
+	Diligent::Uint32 activeStagers = 0;
+
+	std::mutex mutex;
+	std::condition_variable spaceAvailable;
+	std::condition_variable stagersDone;
+	//Node based so an upload can be written without the lock while others are added and retired
+	std::deque<Upload> uploads;
+	std::vector<Diligent::StateTransitionDesc> barriers;
+};
@@ -96,10 +96,12 @@ void main(in  PSInput  PSIn,
             // clang-format off
             // This tutorial will render to a single render target
             PSOCreateInfo.GraphicsPipeline.NumRenderTargets = 1;
+            var swapChainDesc = new SwapChainDescPassStruct();
+            m_pSwapChain.GetDesc(ref swapChainDesc);
             // Set render target format which is the format of the swap chain's color buffer
-            PSOCreateInfo.GraphicsPipeline.RTVFormats_0 = m_pSwapChain.GetDesc_ColorBufferFormat;
+            PSOCreateInfo.GraphicsPipeline.RTVFormats_0 = swapChainDesc.ColorBufferFormat;
             // Use the depth buffer format from the swap chain
-            PSOCreateInfo.GraphicsPipeline.DSVFormat = m_pSwapChain.GetDesc_DepthBufferFormat;
+            PSOCreateInfo.GraphicsPipeline.DSVFormat = swapChainDesc.DepthBufferFormat;
 
             // Primitive topology defines what kind of primitives will be rendered by this pipeline state
             PSOCreateInfo.GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY.PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
@@ -75,10 +75,12 @@ namespace DiligentEngineCube
             // clang-format off
             // This tutorial will render to a single render target
             PSOCreateInfo.GraphicsPipeline.NumRenderTargets = 1;
+            var swapChainDesc = new SwapChainDescPassStruct();
+            m_pSwapChain.GetDesc(ref swapChainDesc);
             // Set render target format which is the format of the swap chain's color buffer
-            PSOCreateInfo.GraphicsPipeline.RTVFormats_0 = m_pSwapChain.GetDesc_ColorBufferFormat;
+            PSOCreateInfo.GraphicsPipeline.RTVFormats_0 = swapChainDesc.ColorBufferFormat;
             // Use the depth buffer format from the swap chain
-            PSOCreateInfo.GraphicsPipeline.DSVFormat = m_pSwapChain.GetDesc_DepthBufferFormat;
+            PSOCreateInfo.GraphicsPipeline.DSVFormat = swapChainDesc.DepthBufferFormat;
             // Primitive topology defines what kind of primitives will be rendered by this pipeline state
             PSOCreateInfo.GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY.PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
             // Cull back faces
@@ -246,7 +248,9 @@ namespace DiligentEngineCube
         {
             var pRTV = swapChain.GetCurrentBackBufferRTV();
             var pDSV = swapChain.GetDepthBufferDSV();
-            var preTransform = swapChain.GetDesc_PreTransform;
+            var swapChainDesc = new SwapChainDescPassStruct();
+            swapChain.GetDesc(ref swapChainDesc);
+            var preTransform = swapChainDesc.PreTransform;
             m_pImmediateContext.SetRenderTarget(pRTV, pDSV, RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
             // Clear the back buffer
             var ClearColor = new Color(0.350f, 0.350f, 0.350f, 1.0f);
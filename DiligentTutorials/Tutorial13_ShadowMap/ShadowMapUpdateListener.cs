@@ -263,9 +263,11 @@ namespace Tutorial13_ShadowMap
                 new LayoutElement{InputIndex = 2, BufferSlot = 0, NumComponents = 3, ValueType = VALUE_TYPE.VT_FLOAT32, IsNormalized = false},
             };
 
+            var swapChainDesc = new SwapChainDescPassStruct();
+            m_pSwapChain.GetDesc(ref swapChainDesc);
             m_pCubePSO = CreateTexCubePipelineState(m_pDevice,
-                                                    m_pSwapChain.GetDesc_ColorBufferFormat,
-                                                    m_pSwapChain.GetDesc_DepthBufferFormat,
+                                                    swapChainDesc.ColorBufferFormat,
+                                                    swapChainDesc.DepthBufferFormat,
                                                     shaderLoader.LoadShader("cube.vsh"),
                                                     shaderLoader.LoadShader("cube.psh"),
                                                     LayoutElems);
@@ -348,10 +350,12 @@ namespace Tutorial13_ShadowMap
 
             // This tutorial renders to a single render target
             PSOCreateInfo.GraphicsPipeline.NumRenderTargets             = 1;
+            var swapChainDesc = new SwapChainDescPassStruct();
+            m_pSwapChain.GetDesc(ref swapChainDesc);
             // Set render target format which is the format of the swap chain's color buffer
-            PSOCreateInfo.GraphicsPipeline.RTVFormats_0                = m_pSwapChain.GetDesc_ColorBufferFormat;
+            PSOCreateInfo.GraphicsPipeline.RTVFormats_0                = swapChainDesc.ColorBufferFormat;
             // Set depth buffer format which is the format of the swap chain's back buffer
-            PSOCreateInfo.GraphicsPipeline.DSVFormat                    = m_pSwapChain.GetDesc_DepthBufferFormat;
+            PSOCreateInfo.GraphicsPipeline.DSVFormat                    = swapChainDesc.DepthBufferFormat;
             // Primitive topology defines what kind of primitives will be rendered by this pipeline state
             PSOCreateInfo.GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY.PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
             // No cull
@@ -426,10 +430,12 @@ namespace Tutorial13_ShadowMap
 
             // This tutorial renders to a single render target
             PSOCreateInfo.GraphicsPipeline.NumRenderTargets             = 1;
+            var swapChainDesc = new SwapChainDescPassStruct();
+            m_pSwapChain.GetDesc(ref swapChainDesc);
             // Set render target format which is the format of the swap chain's color buffer
-            PSOCreateInfo.GraphicsPipeline.RTVFormats_0                 = m_pSwapChain.GetDesc_ColorBufferFormat;
+            PSOCreateInfo.GraphicsPipeline.RTVFormats_0                 = swapChainDesc.ColorBufferFormat;
             // Set depth buffer format which is the format of the swap chain's back buffer
-            PSOCreateInfo.GraphicsPipeline.DSVFormat                    = m_pSwapChain.GetDesc_DepthBufferFormat;
+            PSOCreateInfo.GraphicsPipeline.DSVFormat                    = swapChainDesc.DepthBufferFormat;
             // Primitive topology defines what kind of primitives will be rendered by this pipeline state
             PSOCreateInfo.GraphicsPipeline.PrimitiveTopology            = PRIMITIVE_TOPOLOGY.PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
             // No cull
@@ -630,7 +636,9 @@ namespace Tutorial13_ShadowMap
             // Bind main back buffer
             var pRTV = m_pSwapChain.GetCurrentBackBufferRTV();
             var pDSV = m_pSwapChain.GetDepthBufferDSV();
-            var preTransform = m_pSwapChain.GetDesc_PreTransform;
+            var swapChainDesc = new SwapChainDescPassStruct();
+            m_pSwapChain.GetDesc(ref swapChainDesc);
+            var preTransform = swapChainDesc.PreTransform;
             m_pImmediateContext.SetRenderTarget(pRTV, pDSV, RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
             var ClearColor = new Engine.Color(0.350f, 0.350f, 0.350f, 1.0f);
             m_pImmediateContext.ClearRenderTarget(pRTV, ClearColor, RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
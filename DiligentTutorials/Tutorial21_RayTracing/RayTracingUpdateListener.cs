@@ -58,6 +58,7 @@ namespace DiligentEngineRayTracing
 
         TEXTURE_FORMAT m_ColorBufferFormat = TEXTURE_FORMAT.TEX_FORMAT_RGBA8_UNORM;
         AutoPtr<ITexture> m_pColorRT;
+        TextureDescPassStruct m_ColorRTDesc;
 
         public unsafe RayTracingUpdateListener
         (
@@ -173,7 +174,9 @@ namespace DiligentEngineRayTracing
             PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE.PIPELINE_TYPE_GRAPHICS;
 
             PSOCreateInfo.GraphicsPipeline.NumRenderTargets = 1;
-            PSOCreateInfo.GraphicsPipeline.RTVFormats_0 = m_pSwapChain.GetDesc_ColorBufferFormat;
+            var swapChainDesc = new SwapChainDescPassStruct();
+            m_pSwapChain.GetDesc(ref swapChainDesc);
+            PSOCreateInfo.GraphicsPipeline.RTVFormats_0 = swapChainDesc.ColorBufferFormat;
             PSOCreateInfo.GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY.PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
             PSOCreateInfo.GraphicsPipeline.RasterizerDesc.CullMode = CULL_MODE.CULL_MODE_NONE;
             PSOCreateInfo.GraphicsPipeline.DepthStencilDesc.DepthEnable = false;
@@ -638,12 +641,14 @@ namespace DiligentEngineRayTracing
                 }
 
                 // Create scratch buffer
+                var ScratchSizes = new ScratchBufferSizesPassStruct();
+                m_pCubeBLAS.Obj.GetScratchBufferSizes(ref ScratchSizes);
                 using var pScratchBuffer = m_pDevice.CreateBuffer(new BufferDesc()
                 {
                     Name = "BLAS Scratch Buffer",
                     Usage = USAGE.USAGE_DEFAULT,
                     BindFlags = BIND_FLAGS.BIND_RAY_TRACING,
-                    Size = m_pCubeBLAS.Obj.ScratchBufferSizes_Build,
+                    Size = ScratchSizes.Build,
                 }, new BufferData());
 
                 // Build BLAS
@@ -720,12 +725,14 @@ namespace DiligentEngineRayTracing
                 }
 
                 // Create scratch buffer
+                var ScratchSizes = new ScratchBufferSizesPassStruct();
+                m_pProceduralBLAS.Obj.GetScratchBufferSizes(ref ScratchSizes);
                 using var pScratchBuffer = m_pDevice.CreateBuffer(new BufferDesc()
                 {
                     Name = "BLAS Scratch Buffer",
                     Usage = USAGE.USAGE_DEFAULT,
                     BindFlags = BIND_FLAGS.BIND_RAY_TRACING,
-                    Size = m_pProceduralBLAS.Obj.ScratchBufferSizes_Build,
+                    Size = ScratchSizes.Build,
                 }, new BufferData());
 
                 // Build BLAS
@@ -782,12 +789,14 @@ namespace DiligentEngineRayTracing
             // Create scratch buffer
             if (m_ScratchBuffer == null)
             {
+                var ScratchSizes = new ScratchBufferSizesPassStruct();
+                m_pTLAS.Obj.GetScratchBufferSizes(ref ScratchSizes);
                 m_ScratchBuffer = m_pDevice.CreateBuffer(new BufferDesc()
                 {
                     Name = "TLAS Scratch Buffer",
                     Usage = USAGE.USAGE_DEFAULT,
                     BindFlags = BIND_FLAGS.BIND_RAY_TRACING,
-                    Size = Math.Max(m_pTLAS.Obj.ScratchBufferSizes_Build, m_pTLAS.Obj.ScratchBufferSizes_Update)
+                    Size = Math.Max(ScratchSizes.Build, ScratchSizes.Update)
                 }, new BufferData());
             }
 
@@ -1069,7 +1078,9 @@ namespace DiligentEngineRayTracing
             {
 
                 var pDSV = swapChain.GetDepthBufferDSV();
-                var preTransform = swapChain.GetDesc_PreTransform;
+                var swapChainDesc = new SwapChainDescPassStruct();
+                swapChain.GetDesc(ref swapChainDesc);
+                var preTransform = swapChainDesc.PreTransform;
 
                  //= new Vector3(0f, 0f, -15f);
                 var preTransformMatrix = CameraHelpers.GetSurfacePretransformMatrix(new Vector3(0, 0, 1), preTransform);
@@ -1125,8 +1136,8 @@ namespace DiligentEngineRayTracing
                 m_pImmediateContext.CommitShaderResources(m_pRayTracingSRB.Obj, RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
 
                 var Attribs = new TraceRaysAttribs();
-                Attribs.DimensionX = m_pColorRT.Obj.GetDesc_Width;
-                Attribs.DimensionY = m_pColorRT.Obj.GetDesc_Height;
+                Attribs.DimensionX = m_ColorRTDesc.Width;
+                Attribs.DimensionY = m_ColorRTDesc.Height;
                 Attribs.pSBT = m_pSBT.Obj;
 
                 m_pImmediateContext.TraceRays(Attribs);
@@ -1213,8 +1224,8 @@ namespace DiligentEngineRayTracing
 
             // Check if the image needs to be recreated.
             if (m_pColorRT != null &&
-                m_pColorRT.Obj.GetDesc_Width == Width &&
-                m_pColorRT.Obj.GetDesc_Height == Height)
+                m_ColorRTDesc.Width == Width &&
+                m_ColorRTDesc.Height == Height)
             {
                 return;
             }
@@ -1236,6 +1247,7 @@ namespace DiligentEngineRayTracing
             RTDesc.Format = m_ColorBufferFormat;
 
             m_pColorRT = m_pDevice.CreateTexture(RTDesc, null);
+            m_pColorRT.Obj.GetDesc(ref m_ColorRTDesc);
         }
     }
 }
@@ -0,0 +1,126 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+using System.Threading.Tasks;
+using Xunit;
+
+namespace Engine.Tests
+{
+    public class DynamicResolutionControllerTests
+    {
+        const float Target = 1.0f / 60.0f;
+
+        /// <summary>
+        /// Run a synthetic trace through the controller. The cost of a frame is fixedCost plus scaledCost
+        /// times the square of the scale, and timings reach the controller latency frames late like gpu
+        /// queries do. Returns the frame time of the last frame.
+        /// </summary>
+        private static float Simulate(DynamicResolutionController controller, int frames, Func<int, float> scaledCost, float fixedCost = 0.0f, int latency = 4)
+        {
+            var pending = new Queue<float>();
+            float frameTime = 0.0f;
+            for (int i = 0; i < frames; ++i)
+            {
+                frameTime = fixedCost + scaledCost(i) * controller.Scale * controller.Scale;
+                pending.Enqueue(frameTime);
+                controller.Update(pending.Count > latency ? pending.Dequeue() : 0.0f);
+            }
+            return frameTime;
+        }
+
+        [Fact]
+        public void StartsAtMaxScale()
+        {
+            var controller = new DynamicResolutionController(Target, 0.5f, 0.75f);
+            Assert.Equal(0.75f, controller.Scale);
+        }
+
+        [Fact]
+        public void StaysAtMaxWhenUnderBudget()
+        {
+            var controller = new DynamicResolutionController(Target, 0.5f, 1.0f);
+            Simulate(controller, 300, i => 0.010f);
+            Assert.Equal(1.0f, controller.Scale);
+        }
+
+        [Fact]
+        public void ScalesDownToHoldTarget()
+        {
+            var controller = new DynamicResolutionController(Target, 0.5f, 1.0f);
+            var frameTime = Simulate(controller, 300, i => 0.025f);
+            Assert.True(controller.Scale < 1.0f);
+            Assert.InRange(frameTime, Target * 0.85f, Target * (1.0f + controller.Tolerance));
+        }
+
+        [Fact]
+        public void ScalesDownWithFixedCost()
+        {
+            var controller = new DynamicResolutionController(Target, 0.3f, 1.0f);
+            var frameTime = Simulate(controller, 400, i => 0.020f, fixedCost: 0.005f);
+            Assert.InRange(frameTime, Target * 0.85f, Target * (1.0f + controller.Tolerance));
+        }
+
+        [Fact]
+        public void ClampsToMinScale()
+        {
+            var controller = new DynamicResolutionController(Target, 0.5f, 1.0f);
+            Simulate(controller, 300, i => 0.2f);
+            Assert.Equal(0.5f, controller.Scale);
+        }
+
+        [Fact]
+        public void RecoversAfterSpike()
+        {
+            var controller = new DynamicResolutionController(Target, 0.5f, 1.0f);
+            Simulate(controller, 200, i => 0.030f);
+            var lowScale = controller.Scale;
+            Simulate(controller, 400, i => 0.012f);
+            Assert.True(lowScale < 1.0f);
+            Assert.Equal(1.0f, controller.Scale, 3);
+        }
+
+        [Fact]
+        public void IgnoresNoiseInsideTolerance()
+        {
+            var controller = new DynamicResolutionController(Target, 0.5f, 1.0f);
+            var random = new Random(42);
+            for (int i = 0; i < 300; ++i)
+            {
+                controller.Update(Target * (1.0f + ((float)random.NextDouble() - 0.5f) * 0.04f));
+            }
+            Assert.Equal(1.0f, controller.Scale);
+        }
+
+        [Fact]
+        public void IgnoresUnmeasuredFrames()
+        {
+            var controller = new DynamicResolutionController(Target, 0.5f, 1.0f);
+            for (int i = 0; i < 100; ++i)
+            {
+                controller.Update(0.0f);
+                controller.Update(-1.0f);
+                controller.Update(float.NaN);
+            }
+            Assert.Equal(1.0f, controller.Scale);
+            Assert.Equal(0.0f, controller.AverageFrameTime);
+        }
+
+        [Fact]
+        public void ResetGoesBackToMax()
+        {
+            var controller = new DynamicResolutionController(Target, 0.5f, 1.0f);
+            Simulate(controller, 100, i => 0.05f);
+            Assert.True(controller.Scale < 1.0f);
+            controller.Reset();
+            Assert.Equal(1.0f, controller.Scale);
+        }
+
+        [Fact]
+        public void RejectsBadRange()
+        {
+            Assert.Throws<ArgumentOutOfRangeException>(() => new DynamicResolutionController(Target, 0.0f, 1.0f));
+            Assert.Throws<ArgumentOutOfRangeException>(() => new DynamicResolutionController(Target, 0.8f, 0.5f));
+        }
+    }
+}
@@ -0,0 +1,40 @@
+﻿using Engine.Resources;
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Text;
+using System.Threading.Tasks;
+using Xunit;
+
+namespace Engine.Tests
+{
+    public class IOTraceTests
+    {
+        [Fact]
+        public void RoundTrip()
+        {
+            var events = new IOTraceEvent[]
+            {
+                new IOTraceEvent() { Type = IOTraceEventType.Open, Path = "Textures/Rock_Color.jpg", ThreadId = 4, Timestamp = 10, Duration = 250, Bytes = 123456 },
+                new IOTraceEvent() { Type = IOTraceEventType.Read, Path = "Textures/Rock_Color.jpg", ThreadId = 4, Timestamp = 300, Duration = 4000, Offset = 0, Bytes = 65536 },
+                new IOTraceEvent() { Type = IOTraceEventType.NativeRead, Path = "Textures/Rock_Normal.jpg", ThreadId = -12, Timestamp = 310, Duration = 9000, Wait = 55, Bytes = 80000 },
+                new IOTraceEvent() { Type = IOTraceEventType.Read, Path = "Textures/Rock_Color.jpg", ThreadId = 4, Timestamp = 5000, Duration = 3000, Offset = 65536, Bytes = 57920 },
+                new IOTraceEvent() { Type = IOTraceEventType.Close, Path = "Textures/Rock_Color.jpg", ThreadId = 4, Timestamp = 9000, Duration = 20 },
+            };
+
+            var stream = new MemoryStream();
+            using (var writer = new IOTraceWriter(stream, 10000000))
+            {
+                foreach (var traceEvent in events)
+                {
+                    writer.write(traceEvent);
+                }
+            }
+
+            using var reader = new IOTraceReader(new MemoryStream(stream.ToArray()));
+            Assert.Equal(10000000, reader.Frequency);
+            Assert.Equal(events, reader.readEvents().ToArray());
+        }
+    }
+}
@@ -0,0 +1,142 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+using System.Threading.Tasks;
+using Xunit;
+
+namespace Engine.Tests
+{
+    public class MipFilterTests
+    {
+        const int Precision = 4;
+
+        private static Vector4 Encode(float x, float y, float z)
+        {
+            var normal = new Vector3(x, y, z).normalized();
+            return new Vector4(normal.x * 0.5f + 0.5f, normal.y * 0.5f + 0.5f, normal.z * 0.5f + 0.5f, 1.0f);
+        }
+
+        private static Vector3 Decode(in Vector4 texel)
+        {
+            return new Vector3(texel.x * 2.0f - 1.0f, texel.y * 2.0f - 1.0f, texel.z * 2.0f - 1.0f);
+        }
+
+        private static void AssertNormal(Vector3 expected, in Vector4 texel)
+        {
+            expected = expected.normalized();
+            var normal = Decode(texel);
+            Assert.Equal(expected.x, normal.x, Precision);
+            Assert.Equal(expected.y, normal.y, Precision);
+            Assert.Equal(expected.z, normal.z, Precision);
+            Assert.Equal(1.0f, normal.length(), Precision);
+        }
+
+        [Fact]
+        public void FlatNormalsStayFlat()
+        {
+            var flat = Encode(0.0f, 0.0f, 1.0f);
+            var result = MipFilters.Normal(flat, flat, flat, flat);
+            AssertNormal(new Vector3(0.0f, 0.0f, 1.0f), result);
+            Assert.Equal(1.0f, result.w, Precision);
+        }
+
+        [Fact]
+        public void MatchingTiltedNormalsStayTilted()
+        {
+            var tilted = Encode(0.6f, 0.0f, 0.8f);
+            var result = MipFilters.Normal(tilted, tilted, tilted, tilted);
+            AssertNormal(new Vector3(0.6f, 0.0f, 0.8f), result);
+        }
+
+        [Fact]
+        public void TiltedNormalsAverageAsVectors()
+        {
+            var flat = Encode(0.0f, 0.0f, 1.0f);
+            var tilted = Encode(1.0f, 0.0f, 0.0f);
+            var result = MipFilters.Normal(flat, tilted, flat, tilted);
+            AssertNormal(new Vector3(1.0f, 0.0f, 1.0f), result);
+        }
+
+        [Fact]
+        public void OppositeTiltsCancelToFlat()
+        {
+            var left = Encode(-0.6f, 0.0f, 0.8f);
+            var right = Encode(0.6f, 0.0f, 0.8f);
+            var result = MipFilters.Normal(left, right, right, left);
+            AssertNormal(new Vector3(0.0f, 0.0f, 1.0f), result);
+        }
+
+        [Fact]
+        public void CancelledNormalsFaceOut()
+        {
+            var left = Encode(-1.0f, 0.0f, 0.0f);
+            var right = Encode(1.0f, 0.0f, 0.0f);
+            var result = MipFilters.Normal(left, right, left, right);
+            AssertNormal(new Vector3(0.0f, 0.0f, 1.0f), result);
+        }
+
+        [Fact]
+        public void DownsampleFiltersBgraRows()
+        {
+            //2x2 bgra with 4 bytes of padding on each row, flat normals on the left and tilted ones on the right
+            var source = new byte[]
+            {
+                255, 128, 128, 255,  128, 128, 255, 255,  0, 0, 0, 0,
+                255, 128, 128, 255,  128, 128, 255, 255,  0, 0, 0, 0,
+            };
+            var dest = new byte[4];
+            MipFilters.Downsample(source, 2, 2, 12, dest, 1, 1, 4, MipFilters.Normal);
+
+            var texel = new Vector4(dest[2] / 255.0f, dest[1] / 255.0f, dest[0] / 255.0f, dest[3] / 255.0f);
+            var normal = Decode(texel).normalized();
+            var expected = new Vector3(1.0f, 0.0f, 1.0f).normalized();
+            Assert.Equal(expected.x, normal.x, 1);
+            Assert.Equal(expected.y, normal.y, 1);
+            Assert.Equal(expected.z, normal.z, 1);
+            Assert.Equal(255, dest[3]);
+        }
+
+        [Fact]
+        public void DownsampleRepeatsTheEdgeOfOddSizes()
+        {
+            //3x1 down to 1x1 only reads the first 2 texels
+            var source = new byte[]
+            {
+                10, 20, 30, 40,  30, 40, 50, 60,  255, 255, 255, 255,
+            };
+            var dest = new byte[4];
+            MipFilters.Downsample(source, 3, 1, 12, dest, 1, 1, 4, MipFilters.Box);
+            Assert.Equal(new byte[] { 20, 30, 40, 50 }, dest);
+        }
+
+        [Fact]
+        public void BoxAverages()
+        {
+            var result = MipFilters.Box(new Vector4(0.0f, 0.2f, 0.4f, 1.0f), new Vector4(1.0f, 0.2f, 0.4f, 1.0f), new Vector4(0.0f, 0.6f, 0.4f, 0.0f), new Vector4(1.0f, 0.6f, 0.4f, 0.0f));
+            Assert.Equal(0.5f, result.x, Precision);
+            Assert.Equal(0.4f, result.y, Precision);
+            Assert.Equal(0.4f, result.z, Precision);
+            Assert.Equal(0.5f, result.w, Precision);
+        }
+
+        [Fact]
+        public void RoughnessKeepsGreenExtremes()
+        {
+            var c00 = new Vector4(0.0f, 0.1f, 0.0f, 1.0f);
+            var c10 = new Vector4(1.0f, 0.9f, 0.0f, 1.0f);
+            var c01 = new Vector4(0.0f, 0.3f, 1.0f, 1.0f);
+            var c11 = new Vector4(1.0f, 0.5f, 1.0f, 1.0f);
+
+            var max = MipFilters.RoughnessMax(c00, c10, c01, c11);
+            Assert.Equal(0.9f, max.y, Precision);
+            Assert.Equal(0.5f, max.x, Precision);
+            Assert.Equal(0.5f, max.z, Precision);
+
+            var min = MipFilters.RoughnessMin(c00, c10, c01, c11);
+            Assert.Equal(0.1f, min.y, Precision);
+            Assert.Equal(0.5f, min.x, Precision);
+            Assert.Equal(0.5f, min.z, Precision);
+        }
+    }
+}
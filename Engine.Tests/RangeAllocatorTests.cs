@@ -0,0 +1,106 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+using System.Threading.Tasks;
+using Xunit;
+
+namespace Engine.Tests
+{
+    public class RangeAllocatorTests
+    {
+        [Fact]
+        public void AllocateInOrder()
+        {
+            var allocator = new RangeAllocator(100);
+            Assert.True(allocator.TryAllocate(10, out var first));
+            Assert.True(allocator.TryAllocate(20, out var second));
+            Assert.Equal(0u, first);
+            Assert.Equal(10u, second);
+            Assert.Equal(30u, allocator.UsedSize);
+            Assert.Equal(70u, allocator.FreeSize);
+            Assert.False(allocator.TryAllocate(71, out _));
+        }
+
+        [Fact]
+        public void FreeMergesNeighbors()
+        {
+            var allocator = new RangeAllocator(100);
+            allocator.TryAllocate(10, out var a);
+            allocator.TryAllocate(10, out var b);
+            allocator.TryAllocate(10, out var c);
+
+            allocator.Free(a);
+            allocator.Free(c);
+            Assert.Equal(2, allocator.FreeRangeCount);
+
+            allocator.Free(b);
+            Assert.Equal(1, allocator.FreeRangeCount);
+            Assert.Equal(100u, allocator.LargestFreeRange);
+            Assert.Equal(0, allocator.AllocationCount);
+        }
+
+        [Fact]
+        public void AllocateUsesBestFit()
+        {
+            var allocator = new RangeAllocator(100);
+            allocator.TryAllocate(30, out var a);
+            allocator.TryAllocate(10, out _);
+            allocator.TryAllocate(8, out var c);
+            allocator.TryAllocate(10, out _);
+            allocator.Free(a);
+            allocator.Free(c);
+
+            Assert.True(allocator.TryAllocate(8, out var fit));
+            Assert.Equal(c, fit);
+        }
+
+        [Fact]
+        public void FreeUnknownOffsetThrows()
+        {
+            var allocator = new RangeAllocator(100);
+            allocator.TryAllocate(10, out _);
+            Assert.Throws<InvalidOperationException>(() => allocator.Free(5));
+        }
+
+        [Fact]
+        public void GrowExtendsLastFreeRange()
+        {
+            var allocator = new RangeAllocator(20);
+            allocator.TryAllocate(15, out var a);
+            Assert.False(allocator.TryAllocate(10, out _));
+
+            allocator.Grow(40);
+            Assert.Equal(1, allocator.FreeRangeCount);
+            Assert.True(allocator.TryAllocate(10, out var b));
+            Assert.Equal(15u, b);
+            Assert.Equal(15u, allocator.GetSize(a));
+        }
+
+        [Fact]
+        public void DefragmentPacksAllocations()
+        {
+            var allocator = new RangeAllocator(100);
+            allocator.TryAllocate(10, out var a);
+            allocator.TryAllocate(20, out var b);
+            allocator.TryAllocate(30, out var c);
+            allocator.TryAllocate(10, out var d);
+            allocator.Free(a);
+            allocator.Free(c);
+            Assert.False(allocator.TryAllocate(50, out _));
+
+            var moves = new List<RangeAllocatorMove>();
+            allocator.Defragment(moves);
+
+            Assert.Equal(2, moves.Count);
+            Assert.Equal(new RangeAllocatorMove { From = b, To = 0, Size = 20 }, moves[0]);
+            Assert.Equal(new RangeAllocatorMove { From = d, To = 20, Size = 10 }, moves[1]);
+            Assert.Equal(1, allocator.FreeRangeCount);
+            Assert.Equal(70u, allocator.LargestFreeRange);
+            Assert.Equal(20u, allocator.GetSize(0));
+            Assert.Equal(10u, allocator.GetSize(20));
+            Assert.True(allocator.TryAllocate(50, out var e));
+            Assert.Equal(30u, e);
+        }
+    }
+}
@@ -0,0 +1,212 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Text;
+using System.Threading.Tasks;
+using Xunit;
+
+namespace Engine.Tests
+{
+    public class TextureCompressionTests
+    {
+        /// <summary>
+        /// Make an image that blends between two colors across it with a little noise on every channel,
+        /// close to what a photo texture looks like inside one block.
+        /// </summary>
+        private static byte[] CreateImage(int width, int height, int seed = 42)
+        {
+            var random = new Random(seed);
+            var rgba = new byte[width * height * 4];
+            for (var y = 0; y < height; ++y)
+            {
+                for (var x = 0; x < width; ++x)
+                {
+                    var t = (x * 2 + y) / (float)Math.Max(width * 2 + height - 3, 1);
+                    var i = (y * width + x) * 4;
+                    rgba[i] = (byte)Math.Clamp((int)(40 + 180 * t) + random.Next(-4, 5), 0, 255);
+                    rgba[i + 1] = (byte)Math.Clamp((int)(200 - 150 * t) + random.Next(-4, 5), 0, 255);
+                    rgba[i + 2] = (byte)Math.Clamp((int)(90 + 60 * t) + random.Next(-4, 5), 0, 255);
+                    rgba[i + 3] = (byte)Math.Clamp((int)(255 - 100 * t) + random.Next(-4, 5), 0, 255);
+                }
+            }
+            return rgba;
+        }
+
+        private static double GetRmse(byte[] expected, byte[] actual, int channels)
+        {
+            double sum = 0;
+            var count = 0;
+            for (var i = 0; i < expected.Length; i += 4)
+            {
+                for (var c = 0; c < channels; ++c)
+                {
+                    var diff = expected[i + c] - actual[i + c];
+                    sum += diff * diff;
+                    ++count;
+                }
+            }
+            return Math.Sqrt(sum / count);
+        }
+
+        [Fact]
+        public void CompressedSizes()
+        {
+            Assert.Equal(8 * 4 * 4, BlockCompression.GetCompressedSize(16, 16, BlockFormat.BC4));
+            Assert.Equal(16 * 4 * 4, BlockCompression.GetCompressedSize(16, 16, BlockFormat.BC5));
+            Assert.Equal(16 * 4 * 4, BlockCompression.GetCompressedSize(16, 16, BlockFormat.BC7));
+            //Partial blocks round up and tiny mips still take a whole block
+            Assert.Equal(16 * 2 * 1, BlockCompression.GetCompressedSize(5, 3, BlockFormat.BC7));
+            Assert.Equal(8, BlockCompression.GetCompressedSize(1, 1, BlockFormat.BC4));
+        }
+
+        [Fact]
+        public void BC4RoundTrip()
+        {
+            var image = CreateImage(32, 32);
+            var blocks = BlockCompression.Compress(image, 32, 32, BlockFormat.BC4);
+            var decoded = BlockCompression.Decompress(blocks, 32, 32, BlockFormat.BC4);
+            Assert.True(GetRmse(image, decoded, 1) < 4.0);
+        }
+
+        [Fact]
+        public void BC4SolidBlockIsExact()
+        {
+            var image = Enumerable.Repeat((byte)77, 4 * 4 * 4).ToArray();
+            var blocks = BlockCompression.Compress(image, 4, 4, BlockFormat.BC4);
+            var decoded = BlockCompression.Decompress(blocks, 4, 4, BlockFormat.BC4);
+            for (var i = 0; i < decoded.Length; i += 4)
+            {
+                Assert.Equal(77, decoded[i]);
+            }
+        }
+
+        [Fact]
+        public void BC5RoundTrip()
+        {
+            var image = CreateImage(32, 32);
+            var blocks = BlockCompression.Compress(image, 32, 32, BlockFormat.BC5);
+            var decoded = BlockCompression.Decompress(blocks, 32, 32, BlockFormat.BC5);
+            Assert.True(GetRmse(image, decoded, 2) < 4.0);
+            for (var i = 0; i < decoded.Length; i += 4)
+            {
+                Assert.Equal(0, decoded[i + 2]);
+            }
+        }
+
+        [Fact]
+        public void BC7RoundTrip()
+        {
+            var image = CreateImage(32, 32);
+            var blocks = BlockCompression.Compress(image, 32, 32, BlockFormat.BC7);
+            var decoded = BlockCompression.Decompress(blocks, 32, 32, BlockFormat.BC7);
+            Assert.True(GetRmse(image, decoded, 4) < 6.0);
+        }
+
+        [Fact]
+        public void BC7KeepsAntiCorrelatedChannels()
+        {
+            //Half red and half green cancels out on the diagonal, the block must not collapse to the average
+            var image = new byte[4 * 4 * 4];
+            for (var i = 0; i < 16; ++i)
+            {
+                var red = i < 8;
+                image[i * 4] = red ? (byte)255 : (byte)0;
+                image[i * 4 + 1] = red ? (byte)0 : (byte)255;
+                image[i * 4 + 2] = 0;
+                image[i * 4 + 3] = 255;
+            }
+            var blocks = BlockCompression.Compress(image, 4, 4, BlockFormat.BC7);
+            var decoded = BlockCompression.Decompress(blocks, 4, 4, BlockFormat.BC7);
+            for (var i = 0; i < image.Length; ++i)
+            {
+                Assert.True(Math.Abs(image[i] - decoded[i]) <= 1, $"Channel {i} expected {image[i]} got {decoded[i]}");
+            }
+        }
+
+        [Fact]
+        public void BC7KeepsOpaqueAlphaExact()
+        {
+            var image = CreateImage(16, 16, 11);
+            for (var i = 3; i < image.Length; i += 4)
+            {
+                image[i] = 255;
+            }
+            var blocks = BlockCompression.Compress(image, 16, 16, BlockFormat.BC7);
+            var decoded = BlockCompression.Decompress(blocks, 16, 16, BlockFormat.BC7);
+            for (var i = 3; i < decoded.Length; i += 4)
+            {
+                Assert.Equal(255, decoded[i]);
+            }
+            Assert.True(GetRmse(image, decoded, 3) < 6.0);
+        }
+
+        [Fact]
+        public void BC7WritesModeSixWithAnchorBitClear()
+        {
+            var image = CreateImage(16, 16, 7);
+            var blocks = BlockCompression.Compress(image, 16, 16, BlockFormat.BC7);
+            for (var i = 0; i < blocks.Length; i += 16)
+            {
+                //Mode 6 is 6 zero bits then a one
+                Assert.Equal(0x40, blocks[i] & 0x7F);
+            }
+        }
+
+        [Fact]
+        public void PartialBlocksRoundTrip()
+        {
+            var image = CreateImage(6, 5);
+            var blocks = BlockCompression.Compress(image, 6, 5, BlockFormat.BC7);
+            Assert.Equal(BlockCompression.GetCompressedSize(6, 5, BlockFormat.BC7), blocks.Length);
+            var decoded = BlockCompression.Decompress(blocks, 6, 5, BlockFormat.BC7);
+            Assert.Equal(image.Length, decoded.Length);
+            Assert.True(GetRmse(image, decoded, 4) < 6.0);
+        }
+
+        [Fact]
+        public void DdsRoundTrip()
+        {
+            var mipLevels = 4;
+            var size = DdsFile.GetChainSize(16, 8, mipLevels, DxgiFormat.BC7_UNORM_SRGB);
+            var data = new byte[size];
+            new Random(3).NextBytes(data);
+            var dds = new DdsFile(16, 8, mipLevels, DxgiFormat.BC7_UNORM_SRGB, DdsAlphaMode.Opaque, data);
+
+            using var stream = new MemoryStream();
+            dds.Write(stream);
+            //Magic, header and the DX10 header
+            Assert.Equal(4 + 124 + 20 + size, stream.Length);
+
+            var read = DdsFile.Read(stream.ToArray());
+            Assert.Equal(16, read.Width);
+            Assert.Equal(8, read.Height);
+            Assert.Equal(mipLevels, read.MipLevels);
+            Assert.Equal(DxgiFormat.BC7_UNORM_SRGB, read.Format);
+            Assert.Equal(DdsAlphaMode.Opaque, read.AlphaMode);
+            Assert.Equal(data, read.Data);
+        }
+
+        [Fact]
+        public void DdsMipLayout()
+        {
+            var dds = new DdsFile(16, 8, 5, DxgiFormat.BC4_UNORM, DdsAlphaMode.Unknown, new byte[DdsFile.GetChainSize(16, 8, 5, DxgiFormat.BC4_UNORM)]);
+            Assert.Equal(4 * 8, dds.GetRowPitch(0));
+            Assert.Equal(4 * 2 * 8, dds.GetMipSize(0));
+            Assert.Equal(64, dds.GetMipOffset(1));
+            //Mips 2 to 4 are smaller than a block but each still takes one
+            Assert.Equal(8, dds.GetMipSize(3));
+            Assert.Equal(64 + 16 + 8 + 8 + 8, dds.GetMipOffset(5));
+        }
+
+        [Fact]
+        public void DdsRejectsTruncatedData()
+        {
+            var dds = new DdsFile(8, 8, 1, DxgiFormat.BC5_UNORM, DdsAlphaMode.Unknown, new byte[64]);
+            using var stream = new MemoryStream();
+            dds.Write(stream);
+            var bytes = stream.ToArray();
+            Assert.Throws<InvalidDataException>(() => DdsFile.Read(bytes.Take(bytes.Length - 1).ToArray()));
+        }
+    }
+}
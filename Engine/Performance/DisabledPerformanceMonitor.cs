@@ -17,6 +17,11 @@ namespace Engine.Performance
             
         }
 
+        public void record(string name, double startTime, double endTime)
+        {
+
+        }
+
         public Timelapse this[String name]
         {
             get
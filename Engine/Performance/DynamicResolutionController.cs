@@ -0,0 +1,154 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+
+namespace Engine
+{
+    /// <summary>
+    /// Picks a render scale each frame to hold a target frame time. The scale is the fraction of the full
+    /// width and height to render, the cost of a frame is treated as growing with the square of it. Frame
+    /// times are smoothed and the scale is only moved a small step at a time, after a change it waits
+    /// SettleFrames before changing again so timings that lag behind the gpu catch up. This only does the
+    /// math, call Update with the measured frame time and apply the returned scale.
+    /// </summary>
+    public class DynamicResolutionController
+    {
+        private float averageFrameTime;
+        private bool hasAverage;
+        private int framesUntilChange;
+
+        /// <param name="targetFrameTime">The frame time to hold in seconds.</param>
+        /// <param name="minScale">The smallest scale that can be picked.</param>
+        /// <param name="maxScale">The largest scale that can be picked, this is also the starting scale.</param>
+        public DynamicResolutionController(float targetFrameTime, float minScale, float maxScale)
+        {
+            if (minScale <= 0.0f || maxScale < minScale)
+            {
+                throw new ArgumentOutOfRangeException(nameof(minScale), $"The scale range {minScale} to {maxScale} is not valid.");
+            }
+
+            TargetFrameTime = targetFrameTime;
+            MinScale = minScale;
+            MaxScale = maxScale;
+            Scale = maxScale;
+        }
+
+        /// <summary>
+        /// The frame time to hold in seconds.
+        /// </summary>
+        public float TargetFrameTime { get; set; }
+
+        public float MinScale { get; private set; }
+
+        public float MaxScale { get; private set; }
+
+        /// <summary>
+        /// The current render scale.
+        /// </summary>
+        public float Scale { get; private set; }
+
+        /// <summary>
+        /// The smoothed frame time in seconds.
+        /// </summary>
+        public float AverageFrameTime => averageFrameTime;
+
+        /// <summary>
+        /// How much of each new frame time goes into the average, 1 uses only the newest frame.
+        /// </summary>
+        public float Smoothing { get; set; } = 0.2f;
+
+        /// <summary>
+        /// The scale is left alone while the average is within this fraction of the target.
+        /// </summary>
+        public float Tolerance { get; set; } = 0.05f;
+
+        /// <summary>
+        /// The most the scale can drop in one change.
+        /// </summary>
+        public float MaxStepDown { get; set; } = 0.1f;
+
+        /// <summary>
+        /// The most the scale can rise in one change. This is smaller than MaxStepDown so a slow frame is
+        /// fixed quickly and the scale creeps back up.
+        /// </summary>
+        public float MaxStepUp { get; set; } = 0.02f;
+
+        /// <summary>
+        /// The scale is rounded to a multiple of this so the render size does not change by a pixel every frame.
+        /// </summary>
+        public float Granularity { get; set; } = 0.01f;
+
+        /// <summary>
+        /// The number of frames to wait after a change before the scale can change again.
+        /// </summary>
+        public int SettleFrames { get; set; } = 4;
+
+        /// <summary>
+        /// Add a frame time in seconds and return the scale to render the next frame at. Times that are not
+        /// positive are ignored, use these when the frame could not be measured.
+        /// </summary>
+        public float Update(float frameTime)
+        {
+            if (!(frameTime > 0.0f))
+            {
+                return Scale;
+            }
+
+            if (hasAverage)
+            {
+                averageFrameTime += (frameTime - averageFrameTime) * Smoothing;
+            }
+            else
+            {
+                averageFrameTime = frameTime;
+                hasAverage = true;
+            }
+
+            if (framesUntilChange > 0)
+            {
+                --framesUntilChange;
+                return Scale;
+            }
+
+            var headroom = TargetFrameTime / averageFrameTime;
+            if (MathF.Abs(headroom - 1.0f) <= Tolerance)
+            {
+                return Scale;
+            }
+
+            var desired = Scale * MathF.Sqrt(headroom);
+            desired = Math.Clamp(desired, Scale - MaxStepDown, Scale + MaxStepUp);
+            if (Granularity > 0.0f)
+            {
+                //Round away from the current scale so any step outside the tolerance changes it
+                desired = desired < Scale
+                    ? MathF.Floor(desired / Granularity + 0.001f) * Granularity
+                    : MathF.Ceiling(desired / Granularity - 0.001f) * Granularity;
+            }
+            desired = Math.Clamp(desired, MinScale, MaxScale);
+
+            if (desired != Scale)
+            {
+                //Guess what the new scale will cost so the average does not drag the old frames along
+                var ratio = desired / Scale;
+                averageFrameTime *= ratio * ratio;
+                Scale = desired;
+                framesUntilChange = SettleFrames;
+            }
+
+            return Scale;
+        }
+
+        /// <summary>
+        /// Go back to the max scale and forget the frame times, use after a big change like loading a level.
+        /// </summary>
+        public void Reset()
+        {
+            Scale = MaxScale;
+            hasAverage = false;
+            averageFrameTime = 0.0f;
+            framesUntilChange = 0;
+        }
+    }
+}
@@ -41,6 +41,16 @@ namespace Engine.Performance
             }
         }
 
+        public void record(string name, double startTime, double endTime)
+        {
+            timelapses.AddOrUpdate(name, passName => new Timelapse(passName) { StartTime = startTime, EndTime = endTime }, (key, value) =>
+            {
+                value.StartTime = startTime;
+                value.EndTime = endTime;
+                return value;
+            });
+        }
+
         public Timelapse this[String name]
         {
             get
@@ -44,6 +44,18 @@ namespace Engine
             currentState.stop(name);
         }
 
+        /// <summary>
+        /// Record a timelapse that was measured somewhere else, like on the gpu. The times are in milliseconds like
+        /// start and stop, but they only need to be relative to each other.
+        /// </summary>
+        /// <param name="name">The name of the counter to set.</param>
+        /// <param name="startTime">The start time in milliseconds, this can be fractional.</param>
+        /// <param name="endTime">The end time in milliseconds, this can be fractional.</param>
+        public static void record(String name, double startTime, double endTime)
+        {
+            currentState.record(name, startTime, endTime);
+        }
+
         public static void addValueProvider(String name, Func<String> getValueFunc)
         {
             valueProviders.Add(new PerformanceValueProvider(name, getValueFunc));
@@ -11,6 +11,8 @@ namespace Engine.Performance
 
         void stop(string name);
 
+        void record(string name, double startTime, double endTime);
+
         Timelapse this[String name]
         {
             get;
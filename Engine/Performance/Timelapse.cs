@@ -7,14 +7,14 @@ namespace Engine.Performance
 {
     public class Timelapse
     {
-        private Int64 min = Int64.MaxValue;
-        private Int64 max = 0;
+        private double min = double.MaxValue;
+        private double max = 0;
 
-        private Int64 endTime = 0;
+        private double endTime = 0;
 
         //Averages
-        private Int64 totalTimeSpent = 0;
-        private Int64 averageTime = 0;
+        private double totalTimeSpent = 0;
+        private double averageTime = 0;
         private Int64 numCalculations = 0;
         private bool recalcAverage = false;
 
@@ -25,7 +25,7 @@ namespace Engine.Performance
 
         public void resetStats()
         {
-            min = Int64.MaxValue;
+            min = double.MaxValue;
             max = 0;
             totalTimeSpent = 0;
             averageTime = 0;
@@ -35,9 +35,9 @@ namespace Engine.Performance
 
         public String Name { get; private set; }
 
-        public Int64 StartTime { get; internal set; }
+        public double StartTime { get; internal set; }
 
-        public Int64 EndTime
+        public double EndTime
         {
             get
             {
@@ -50,7 +50,7 @@ namespace Engine.Performance
             }
         }
 
-        public Int64 TotalTimeSpent
+        public double TotalTimeSpent
         {
             get
             {
@@ -58,7 +58,7 @@ namespace Engine.Performance
             }
         }
 
-        public Int64 Duration
+        public double Duration
         {
             get
             {
@@ -66,11 +66,11 @@ namespace Engine.Performance
             }
         }
 
-        public Int64 Min
+        public double Min
         {
             get
             {
-                Int64 duration = Duration;
+                double duration = Duration;
                 if (duration < min)
                 {
                     min = duration;
@@ -79,11 +79,11 @@ namespace Engine.Performance
             }
         }
 
-        public Int64 Max
+        public double Max
         {
             get
             {
-                Int64 duration = Duration;
+                double duration = Duration;
                 if (duration > max)
                 {
                     max = duration;
@@ -95,7 +95,7 @@ namespace Engine.Performance
         /// <summary>
         /// Get the average of this timelapse since it was reset.
         /// </summary>
-        public Int64 Average
+        public double Average
         {
             get
             {
@@ -3,6 +3,8 @@ using System.Collections.Generic;
 using System.Linq;
 using System.Text;
 using System.IO;
+using System.Threading.Tasks;
+using ZipAccess;
 
 namespace Engine.Resources
 { 
@@ -36,6 +38,11 @@ namespace Engine.Resources
 
         public abstract Stream openStream(String url, FileMode mode, FileAccess access, FileShare share);
 
+        /// <summary>
+        /// Queue a read of the whole file on the given queue. The queue must be flushed to start the read.
+        /// </summary>
+        public abstract Task<byte[]> readAllBytesAsync(String url, AsyncIOQueue queue);
+
         public abstract bool isDirectory(String url);
 
         public abstract VirtualFileInfo getFileInfo(String filename);
@@ -3,6 +3,8 @@ using System.Collections.Generic;
 using System.Linq;
 using System.Text;
 using System.IO;
+using System.Threading.Tasks;
+using ZipAccess;
 
 #if !FIXLATER_DISABLED
 namespace Engine.Resources
@@ -129,6 +131,12 @@ namespace Engine.Resources
             return File.Open(fixIncomingFileURL(url), (System.IO.FileMode)mode, (System.IO.FileAccess)access, (System.IO.FileShare)share);
         }
 
+        public override Task<byte[]> readAllBytesAsync(String url, AsyncIOQueue queue)
+        {
+            String file = fixIncomingFileURL(url);
+            return queue.submitFileRead(file, 0, new FileInfo(file).Length);
+        }
+
         public override bool isDirectory(String url)
         {
             bool isDirectory;
@@ -5,6 +5,8 @@ using System.Text;
 using System.IO;
 using Engine.Resources;
 using Microsoft.Extensions.Logging;
+using System.Threading.Tasks;
+using ZipAccess;
 
 namespace Engine
 {
@@ -51,6 +53,7 @@ namespace Engine
 
         List<Archive> archives = new List<Archive>();
         private readonly ILogger<VirtualFileSystem> logger;
+        private readonly Lazy<AsyncIOQueue> asyncIOQueue = new Lazy<AsyncIOQueue>(() => new AsyncIOQueue());
 
         public VirtualFileSystem(ILogger<VirtualFileSystem> logger)
         {
@@ -60,6 +63,10 @@ namespace Engine
 
         public void Dispose()
         {
+            if (asyncIOQueue.IsValueCreated)
+            {
+                asyncIOQueue.Value.Dispose();
+            }
             foreach (Archive archive in archives)
             {
                 archive.Dispose();
@@ -212,7 +219,8 @@ namespace Engine
             Archive targetArchive;
             if (fileMap.TryGetValue(url, out targetArchive))
             {
-                return targetArchive.openStream(url, mode);
+                var start = IOTrace.GetTimestamp();
+                return IOTrace.traceOpen(url, targetArchive.openStream(url, mode), start);
             }
             throw new FileNotFoundException(String.Format("Could not find file \"{0}\" in virtual file system.", url), url);
         }
@@ -223,7 +231,8 @@ namespace Engine
             Archive targetArchive;
             if (fileMap.TryGetValue(url, out targetArchive))
             {
-                return targetArchive.openStream(url, mode, access);
+                var start = IOTrace.GetTimestamp();
+                return IOTrace.traceOpen(url, targetArchive.openStream(url, mode, access), start);
             }
             throw new FileNotFoundException(String.Format("Could not find file \"{0}\" in virtual file system.", url), url);
         }
@@ -234,7 +243,57 @@ namespace Engine
             Archive targetArchive;
             if (fileMap.TryGetValue(url, out targetArchive))
             {
-                return targetArchive.openStream(url, mode, access, share);
+                var start = IOTrace.GetTimestamp();
+                return IOTrace.traceOpen(url, targetArchive.openStream(url, mode, access, share), start);
+            }
+            throw new FileNotFoundException(String.Format("Could not find file \"{0}\" in virtual file system.", url), url);
+        }
+
+        /// <summary>
+        /// Read the entire contents of a file without blocking the calling thread.
+        /// </summary>
+        public Task<byte[]> readAllBytesAsync(String url)
+        {
+            var task = submitRead(url);
+            asyncIOQueue.Value.flush();
+            return task;
+        }
+
+        /// <summary>
+        /// Read the entire contents of several files. All the reads are submitted to the
+        /// io queue as a single batch, which is much cheaper than reading them one at a time.
+        /// The results are in the same order as urls.
+        /// </summary>
+        public Task<byte[][]> readAllBytesAsync(IEnumerable<String> urls)
+        {
+            var tasks = new List<Task<byte[]>>();
+            try
+            {
+                foreach (var url in urls)
+                {
+                    tasks.Add(submitRead(url));
+                }
+            }
+            finally
+            {
+                asyncIOQueue.Value.flush();
+            }
+            return Task.WhenAll(tasks);
+        }
+
+        private Task<byte[]> submitRead(String url)
+        {
+            url = FileSystem.fixPathFile(url);
+            Archive targetArchive;
+            if (fileMap.TryGetValue(url, out targetArchive))
+            {
+                var start = IOTrace.GetTimestamp();
+                var task = targetArchive.readAllBytesAsync(url, asyncIOQueue.Value);
+                if (IOTrace.Enabled)
+                {
+                    task.ContinueWith(t => IOTrace.record(IOTraceEventType.AsyncRead, url, start, 0, t.IsCompletedSuccessfully ? t.Result.Length : -1), TaskContinuationOptions.ExecuteSynchronously);
+                }
+                return task;
             }
             throw new FileNotFoundException(String.Format("Could not find file \"{0}\" in virtual file system.", url), url);
         }
@@ -4,6 +4,7 @@ using System.Linq;
 using System.Text;
 using ZipAccess;
 using System.IO;
+using System.Threading.Tasks;
 
 namespace Engine.Resources
 {
@@ -107,6 +108,11 @@ namespace Engine.Resources
             return zipFile.openFile(parseURLInZip(url));
         }
 
+        public override Task<byte[]> readAllBytesAsync(String url, AsyncIOQueue queue)
+        {
+            return zipFile.readFileAsync(queue, parseURLInZip(url));
+        }
+
         public override bool isDirectory(string url)
         {
             ZipFileInfo info = zipFile.getFileInfo(parseURLInZip(url));
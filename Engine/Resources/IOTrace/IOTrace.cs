@@ -0,0 +1,125 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Linq;
+using System.Text;
+using System.Threading;
+
+namespace Engine.Resources
+{
+    /// <summary>
+    /// Records file io done through the VirtualFileSystem and the zip layer to a binary trace
+    /// that can be replayed later with IOTraceReplay. Tracing is off by default and costs
+    /// a single null check per operation when it is off. Apps record a whole run when they
+    /// are started with --iotrace file.
+    /// </summary>
+    public static class IOTrace
+    {
+        private static volatile IOTraceWriter writer;
+        private static long startTimestamp;
+
+        /// <summary>
+        /// Start writing a trace to the given file, any trace already running is stopped.
+        /// </summary>
+        public static void start(String file)
+        {
+            start(File.Open(file, FileMode.Create, FileAccess.Write, FileShare.Read));
+        }
+
+        /// <summary>
+        /// Start writing a trace to the given stream, the stream will be closed when the trace is stopped.
+        /// </summary>
+        public static void start(Stream stream)
+        {
+            stop();
+            startTimestamp = Stopwatch.GetTimestamp();
+            writer = new IOTraceWriter(stream, Stopwatch.Frequency);
+        }
+
+        /// <summary>
+        /// Stop the current trace if there is one.
+        /// </summary>
+        public static void stop()
+        {
+            var current = writer;
+            writer = null;
+            current?.Dispose();
+        }
+
+        public static bool Enabled
+        {
+            get
+            {
+                return writer != null;
+            }
+        }
+
+        /// <summary>
+        /// Get a timestamp to pass as the start of an operation to record.
+        /// </summary>
+        public static long GetTimestamp()
+        {
+            return Stopwatch.GetTimestamp();
+        }
+
+        /// <summary>
+        /// Record an operation that started at start and finished now on the current thread.
+        /// </summary>
+        public static void record(IOTraceEventType type, String path, long start, long offset, long bytes)
+        {
+            var current = writer;
+            if (current != null)
+            {
+                var now = Stopwatch.GetTimestamp();
+                current.write(new IOTraceEvent()
+                {
+                    Type = type,
+                    Path = path,
+                    ThreadId = Environment.CurrentManagedThreadId,
+                    Timestamp = start - startTimestamp,
+                    Duration = now - start,
+                    Offset = offset,
+                    Bytes = bytes,
+                });
+            }
+        }
+
+        /// <summary>
+        /// Record a read done by the native async queue. The times come from the native side in nanoseconds.
+        /// </summary>
+        internal static void recordNative(String path, uint nativeThreadId, long queuedNs, long startNs, long endNs, long bytes)
+        {
+            var current = writer;
+            if (current != null)
+            {
+                var toTicks = Stopwatch.Frequency / 1e9;
+                var duration = (long)((endNs - startNs) * toTicks);
+                var wait = (long)((startNs - queuedNs) * toTicks);
+                current.write(new IOTraceEvent()
+                {
+                    Type = IOTraceEventType.NativeRead,
+                    Path = path,
+                    ThreadId = (int)nativeThreadId,
+                    Timestamp = Stopwatch.GetTimestamp() - startTimestamp - duration - wait,
+                    Duration = duration,
+                    Wait = wait,
+                    Bytes = bytes,
+                });
+            }
+        }
+
+        /// <summary>
+        /// Wrap a stream that was opened at start so its reads are traced. If tracing is off the stream is returned as is.
+        /// </summary>
+        internal static Stream traceOpen(String path, Stream stream, long start)
+        {
+            if (writer == null || stream == null)
+            {
+                return stream;
+            }
+            record(IOTraceEventType.Open, path, start, 0, stream.CanSeek ? stream.Length : -1);
+            return new IOTraceStream(path, stream);
+        }
+    }
+}
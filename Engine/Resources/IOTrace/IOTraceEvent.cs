@@ -0,0 +1,47 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+
+namespace Engine.Resources
+{
+    public enum IOTraceEventType : byte
+    {
+        /// <summary>
+        /// A stream was opened through the VirtualFileSystem. Bytes is the stream length.
+        /// </summary>
+        Open = 1,
+        /// <summary>
+        /// A read from a stream opened through the VirtualFileSystem.
+        /// </summary>
+        Read = 2,
+        /// <summary>
+        /// A stream opened through the VirtualFileSystem was closed.
+        /// </summary>
+        Close = 3,
+        /// <summary>
+        /// A whole file read through VirtualFileSystem.readAllBytesAsync, duration is submit to completion.
+        /// </summary>
+        AsyncRead = 4,
+        /// <summary>
+        /// The native side of an async read. Path is the name inside the archive, Wait is the time
+        /// spent queued and Duration is the time spent reading.
+        /// </summary>
+        NativeRead = 5,
+    }
+
+    /// <summary>
+    /// A single event in an io trace. Times are in Stopwatch ticks relative to the start of the trace.
+    /// </summary>
+    public struct IOTraceEvent
+    {
+        public IOTraceEventType Type;
+        public String Path;
+        public int ThreadId;
+        public long Timestamp;
+        public long Duration;
+        public long Wait;
+        public long Offset;
+        public long Bytes;
+    }
+}
@@ -0,0 +1,80 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Text;
+
+namespace Engine.Resources
+{
+    /// <summary>
+    /// Reads a trace written by IOTraceWriter.
+    /// </summary>
+    public class IOTraceReader : IDisposable
+    {
+        private BinaryReader reader;
+        private List<String> paths = new List<string>();
+
+        public IOTraceReader(Stream stream)
+        {
+            reader = new BinaryReader(stream, Encoding.UTF8, false);
+            if (reader.ReadUInt32() != IOTraceWriter.Magic)
+            {
+                throw new InvalidDataException("Stream is not an io trace.");
+            }
+            var version = reader.ReadUInt16();
+            if (version != IOTraceWriter.Version)
+            {
+                throw new InvalidDataException($"Unsupported io trace version {version}.");
+            }
+            StartTime = new DateTime(reader.ReadInt64(), DateTimeKind.Utc);
+            Frequency = reader.ReadInt64();
+        }
+
+        public void Dispose()
+        {
+            reader.Dispose();
+        }
+
+        /// <summary>
+        /// The wall clock time the trace was started.
+        /// </summary>
+        public DateTime StartTime { get; private set; }
+
+        /// <summary>
+        /// The number of ticks per second for the times in the trace.
+        /// </summary>
+        public long Frequency { get; private set; }
+
+        public IEnumerable<IOTraceEvent> readEvents()
+        {
+            var stream = reader.BaseStream;
+            while (stream.Position < stream.Length)
+            {
+                var type = reader.ReadByte();
+                if (type == IOTraceWriter.PathRecord)
+                {
+                    var id = reader.Read7BitEncodedInt();
+                    var path = reader.ReadString();
+                    if (id != paths.Count)
+                    {
+                        throw new InvalidDataException($"Path id {id} out of order in io trace.");
+                    }
+                    paths.Add(path);
+                    continue;
+                }
+
+                yield return new IOTraceEvent()
+                {
+                    Type = (IOTraceEventType)type,
+                    Path = paths[reader.Read7BitEncodedInt()],
+                    ThreadId = reader.Read7BitEncodedInt(),
+                    Timestamp = reader.Read7BitEncodedInt64(),
+                    Duration = reader.Read7BitEncodedInt64(),
+                    Wait = reader.Read7BitEncodedInt64(),
+                    Offset = reader.Read7BitEncodedInt64(),
+                    Bytes = reader.Read7BitEncodedInt64(),
+                };
+            }
+        }
+    }
+}
@@ -0,0 +1,87 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Text;
+
+namespace Engine.Resources
+{
+    /// <summary>
+    /// Passes through to another stream recording reads and the close to the IOTrace.
+    /// </summary>
+    class IOTraceStream : Stream
+    {
+        private String path;
+        private Stream stream;
+
+        public IOTraceStream(String path, Stream stream)
+        {
+            this.path = path;
+            this.stream = stream;
+        }
+
+        protected override void Dispose(bool disposing)
+        {
+            if (disposing && stream != null)
+            {
+                var start = IOTrace.GetTimestamp();
+                stream.Dispose();
+                IOTrace.record(IOTraceEventType.Close, path, start, 0, 0);
+                stream = null;
+            }
+            base.Dispose(disposing);
+        }
+
+        public override int Read(byte[] buffer, int offset, int count)
+        {
+            var position = stream.CanSeek ? stream.Position : -1;
+            var start = IOTrace.GetTimestamp();
+            var read = stream.Read(buffer, offset, count);
+            IOTrace.record(IOTraceEventType.Read, path, start, position, read);
+            return read;
+        }
+
+        public override int Read(Span<byte> buffer)
+        {
+            var position = stream.CanSeek ? stream.Position : -1;
+            var start = IOTrace.GetTimestamp();
+            var read = stream.Read(buffer);
+            IOTrace.record(IOTraceEventType.Read, path, start, position, read);
+            return read;
+        }
+
+        public override bool CanRead => stream.CanRead;
+
+        public override bool CanSeek => stream.CanSeek;
+
+        public override bool CanWrite => stream.CanWrite;
+
+        public override long Length => stream.Length;
+
+        public override long Position
+        {
+            get => stream.Position;
+            set => stream.Position = value;
+        }
+
+        public override void Flush()
+        {
+            stream.Flush();
+        }
+
+        public override long Seek(long offset, SeekOrigin origin)
+        {
+            return stream.Seek(offset, origin);
+        }
+
+        public override void SetLength(long value)
+        {
+            stream.SetLength(value);
+        }
+
+        public override void Write(byte[] buffer, int offset, int count)
+        {
+            stream.Write(buffer, offset, count);
+        }
+    }
+}
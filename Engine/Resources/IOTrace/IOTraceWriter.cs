@@ -0,0 +1,72 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Text;
+
+namespace Engine.Resources
+{
+    /// <summary>
+    /// Writes io trace events in a compact binary format. Paths are written once and referred to by id
+    /// after that and all numbers are 7 bit encoded so small values stay small. This class is thread safe.
+    /// </summary>
+    public class IOTraceWriter : IDisposable
+    {
+        internal const uint Magic = 0x52544F49; //IOTR
+        internal const ushort Version = 1;
+        internal const byte PathRecord = 0;
+
+        private BinaryWriter writer;
+        private Dictionary<String, int> pathIds = new Dictionary<string, int>();
+        private Object writeLock = new Object();
+
+        public IOTraceWriter(Stream stream, long frequency)
+        {
+            writer = new BinaryWriter(stream, Encoding.UTF8, false);
+            writer.Write(Magic);
+            writer.Write(Version);
+            writer.Write(DateTime.UtcNow.Ticks);
+            writer.Write(frequency);
+        }
+
+        public void Dispose()
+        {
+            lock (writeLock)
+            {
+                writer.Dispose();
+            }
+        }
+
+        public void write(in IOTraceEvent traceEvent)
+        {
+            lock (writeLock)
+            {
+                if (!pathIds.TryGetValue(traceEvent.Path, out var pathId))
+                {
+                    pathId = pathIds.Count;
+                    pathIds.Add(traceEvent.Path, pathId);
+                    writer.Write(PathRecord);
+                    writer.Write7BitEncodedInt(pathId);
+                    writer.Write(traceEvent.Path);
+                }
+
+                writer.Write((byte)traceEvent.Type);
+                writer.Write7BitEncodedInt(pathId);
+                writer.Write7BitEncodedInt(traceEvent.ThreadId);
+                writer.Write7BitEncodedInt64(traceEvent.Timestamp);
+                writer.Write7BitEncodedInt64(traceEvent.Duration);
+                writer.Write7BitEncodedInt64(traceEvent.Wait);
+                writer.Write7BitEncodedInt64(traceEvent.Offset);
+                writer.Write7BitEncodedInt64(traceEvent.Bytes);
+            }
+        }
+
+        public void flush()
+        {
+            lock (writeLock)
+            {
+                writer.Flush();
+            }
+        }
+    }
+}
@@ -5,6 +5,7 @@ using System.Text;
 using System.IO;
 using System.Reflection;
 using System.Text.RegularExpressions;
+using System.Threading.Tasks;
 using Engine;
 
 namespace Engine.Resources
@@ -45,6 +46,14 @@ namespace Engine.Resources
             return assembly.GetManifestResourceStream(file) ?? throw new FileNotFoundException($"Cannot find embedded resource '{file}' original name '{filename}'");
         }
 
+        public async Task<byte[]> readAllBytesAsync(String filename)
+        {
+            using var stream = openFile(filename);
+            using var memory = new MemoryStream((int)stream.Length);
+            await stream.CopyToAsync(memory);
+            return memory.ToArray();
+        }
+
         public Stream openWriteStream(String filename)
         {
             throw new NotImplementedException("stream writing not supported by this resource provider.");
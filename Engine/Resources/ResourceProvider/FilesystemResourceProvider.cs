@@ -3,6 +3,7 @@ using System.Collections.Generic;
 using System.Linq;
 using System.Text;
 using System.IO;
+using System.Threading.Tasks;
 
 namespace Engine.Resources
 {
@@ -26,6 +27,11 @@ namespace Engine.Resources
             return File.Open(Path.Combine(parentPath, filename), System.IO.FileMode.Open, System.IO.FileAccess.Read, System.IO.FileShare.Read);
         }
 
+        public Task<byte[]> readAllBytesAsync(String filename)
+        {
+            return File.ReadAllBytesAsync(Path.Combine(parentPath, filename));
+        }
+
         public Stream openWriteStream(String filename)
         {
             return File.Open(Path.Combine(parentPath, filename), System.IO.FileMode.Create, System.IO.FileAccess.Write, System.IO.FileShare.None);
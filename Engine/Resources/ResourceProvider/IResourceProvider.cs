@@ -3,6 +3,7 @@ using System.Collections.Generic;
 using System.Linq;
 using System.Text;
 using System.IO;
+using System.Threading.Tasks;
 
 namespace Engine.Resources
 {
@@ -20,6 +21,13 @@ namespace Engine.Resources
         /// <returns></returns>
         Stream openFile(String filename);
 
+        /// <summary>
+        /// Read the entire contents of a file without blocking the calling thread.
+        /// </summary>
+        /// <param name="filename"></param>
+        /// <returns></returns>
+        Task<byte[]> readAllBytesAsync(String filename);
+
         /// <summary>
         /// Open a stream to write to a file.
         /// </summary>
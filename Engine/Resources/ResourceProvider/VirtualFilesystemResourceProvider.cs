@@ -3,6 +3,7 @@ using System.Collections.Generic;
 using System.Linq;
 using System.Text;
 using System.IO;
+using System.Threading.Tasks;
 using Engine;
 
 namespace Engine.Resources
@@ -35,6 +36,11 @@ namespace Engine.Resources
             return virtualFileSystem.openStream(Path.Combine(parentPath, filename), FileMode.Open, FileAccess.Read, FileShare.Read);
         }
 
+        public Task<byte[]> readAllBytesAsync(String filename)
+        {
+            return virtualFileSystem.readAllBytesAsync(Path.Combine(parentPath, filename));
+        }
+
         public Stream openWriteStream(String filename)
         {
             throw new NotImplementedException("stream writing not supported by this resource provider.");
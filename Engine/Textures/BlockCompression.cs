@@ -0,0 +1,638 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+using System.Threading.Tasks;
+
+namespace Engine
+{
+    public enum BlockFormat
+    {
+        /// <summary>
+        /// One channel, the red channel of the source.
+        /// </summary>
+        BC4,
+        /// <summary>
+        /// Two channels, the red and green channels of the source.
+        /// </summary>
+        BC5,
+        /// <summary>
+        /// All four channels. Blocks are always written in mode 6.
+        /// </summary>
+        BC7,
+    }
+
+    /// <summary>
+    /// Encodes rgba8 images into BC4, BC5 and BC7 blocks for offline texture compression. BC7 only uses
+    /// mode 6, one subset with 4 bit indices, which is fast to encode and handles alpha. The decode
+    /// functions are here to measure the error, they only read what the encoder writes.
+    /// </summary>
+    public static class BlockCompression
+    {
+        public const int BlockDimension = 4;
+        public const int BlockPixels = BlockDimension * BlockDimension;
+
+        private static readonly int[] BC7Weights4 = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+        private const int BC7Mode6 = 1 << 6;
+        private const int BC7RefineIterations = 2;
+
+        public static int GetBlockSize(BlockFormat format)
+        {
+            return format == BlockFormat.BC4 ? 8 : 16;
+        }
+
+        public static int GetBlocksWide(int width)
+        {
+            return Math.Max((width + BlockDimension - 1) / BlockDimension, 1);
+        }
+
+        public static int GetBlocksHigh(int height)
+        {
+            return Math.Max((height + BlockDimension - 1) / BlockDimension, 1);
+        }
+
+        /// <summary>
+        /// Get the size of the blocks for an image.
+        /// </summary>
+        public static int GetCompressedSize(int width, int height, BlockFormat format)
+        {
+            return GetBlocksWide(width) * GetBlocksHigh(height) * GetBlockSize(format);
+        }
+
+        /// <summary>
+        /// Compress an image. The pixels are tightly packed rgba8 rows from the top. Blocks that go past
+        /// the edge repeat the last row and column. Rows of blocks are encoded in parallel.
+        /// </summary>
+        public static byte[] Compress(byte[] rgba, int width, int height, BlockFormat format)
+        {
+            if (rgba.Length < width * height * 4)
+            {
+                throw new ArgumentException($"An image of {width}x{height} needs {width * height * 4} bytes, but only {rgba.Length} were given.", nameof(rgba));
+            }
+
+            var blocksWide = GetBlocksWide(width);
+            var blocksHigh = GetBlocksHigh(height);
+            var blockSize = GetBlockSize(format);
+            var result = new byte[blocksWide * blocksHigh * blockSize];
+
+            Parallel.For(0, blocksHigh, blockY =>
+            {
+                Span<byte> block = stackalloc byte[BlockPixels * 4];
+                for (var blockX = 0; blockX < blocksWide; ++blockX)
+                {
+                    for (var y = 0; y < BlockDimension; ++y)
+                    {
+                        var srcY = Math.Min(blockY * BlockDimension + y, height - 1);
+                        for (var x = 0; x < BlockDimension; ++x)
+                        {
+                            var srcX = Math.Min(blockX * BlockDimension + x, width - 1);
+                            var src = (srcY * width + srcX) * 4;
+                            var dest = (y * BlockDimension + x) * 4;
+                            block[dest] = rgba[src];
+                            block[dest + 1] = rgba[src + 1];
+                            block[dest + 2] = rgba[src + 2];
+                            block[dest + 3] = rgba[src + 3];
+                        }
+                    }
+
+                    var output = new Span<byte>(result, (blockY * blocksWide + blockX) * blockSize, blockSize);
+                    switch (format)
+                    {
+                        case BlockFormat.BC4:
+                            EncodeBC4Block(block, 0, output);
+                            break;
+                        case BlockFormat.BC5:
+                            EncodeBC4Block(block, 0, output.Slice(0, 8));
+                            EncodeBC4Block(block, 1, output.Slice(8, 8));
+                            break;
+                        case BlockFormat.BC7:
+                            EncodeBC7Block(block, output);
+                            break;
+                    }
+                }
+            });
+
+            return result;
+        }
+
+        /// <summary>
+        /// Decompress blocks made by Compress back to tightly packed rgba8. BC4 fills green and blue with 0
+        /// and BC5 fills blue with 0, alpha is 255 for both, the same as the gpu.
+        /// </summary>
+        public static byte[] Decompress(byte[] blocks, int width, int height, BlockFormat format)
+        {
+            var blocksWide = GetBlocksWide(width);
+            var blocksHigh = GetBlocksHigh(height);
+            var blockSize = GetBlockSize(format);
+            if (blocks.Length < blocksWide * blocksHigh * blockSize)
+            {
+                throw new ArgumentException($"An image of {width}x{height} needs {blocksWide * blocksHigh * blockSize} bytes of blocks, but only {blocks.Length} were given.", nameof(blocks));
+            }
+
+            var rgba = new byte[width * height * 4];
+            Span<byte> block = stackalloc byte[BlockPixels * 4];
+            for (var blockY = 0; blockY < blocksHigh; ++blockY)
+            {
+                for (var blockX = 0; blockX < blocksWide; ++blockX)
+                {
+                    var input = new ReadOnlySpan<byte>(blocks, (blockY * blocksWide + blockX) * blockSize, blockSize);
+                    switch (format)
+                    {
+                        case BlockFormat.BC4:
+                            block.Fill(0);
+                            DecodeBC4Block(input, block, 0);
+                            break;
+                        case BlockFormat.BC5:
+                            block.Fill(0);
+                            DecodeBC4Block(input.Slice(0, 8), block, 0);
+                            DecodeBC4Block(input.Slice(8, 8), block, 1);
+                            break;
+                        case BlockFormat.BC7:
+                            DecodeBC7Block(input, block);
+                            break;
+                    }
+
+                    for (var y = 0; y < BlockDimension; ++y)
+                    {
+                        var destY = blockY * BlockDimension + y;
+                        if (destY >= height)
+                        {
+                            break;
+                        }
+                        for (var x = 0; x < BlockDimension; ++x)
+                        {
+                            var destX = blockX * BlockDimension + x;
+                            if (destX >= width)
+                            {
+                                break;
+                            }
+                            var src = (y * BlockDimension + x) * 4;
+                            var dest = (destY * width + destX) * 4;
+                            rgba[dest] = block[src];
+                            rgba[dest + 1] = block[src + 1];
+                            rgba[dest + 2] = block[src + 2];
+                            rgba[dest + 3] = format == BlockFormat.BC7 ? block[src + 3] : (byte)255;
+                        }
+                    }
+                }
+            }
+
+            return rgba;
+        }
+
+        /// <summary>
+        /// Encode one channel of a 4x4 block of rgba8 pixels into an 8 byte BC4 block. This always uses
+        /// the 8 value mode between the smallest and largest value.
+        /// </summary>
+        public static void EncodeBC4Block(ReadOnlySpan<byte> rgbaBlock, int channel, Span<byte> output)
+        {
+            byte min = 255;
+            byte max = 0;
+            for (var i = 0; i < BlockPixels; ++i)
+            {
+                var value = rgbaBlock[i * 4 + channel];
+                min = Math.Min(min, value);
+                max = Math.Max(max, value);
+            }
+
+            output[0] = max;
+            output[1] = min;
+
+            ulong indices = 0;
+            if (max > min)
+            {
+                Span<int> palette = stackalloc int[8];
+                GetBC4Palette(max, min, palette);
+                for (var i = 0; i < BlockPixels; ++i)
+                {
+                    var value = rgbaBlock[i * 4 + channel];
+                    var best = 0;
+                    var bestError = int.MaxValue;
+                    for (var p = 0; p < 8; ++p)
+                    {
+                        var error = Math.Abs(palette[p] - value);
+                        if (error < bestError)
+                        {
+                            bestError = error;
+                            best = p;
+                        }
+                    }
+                    indices |= (ulong)best << (i * 3);
+                }
+            }
+            //Otherwise every pixel is the same and index 0 is the value
+
+            for (var i = 0; i < 6; ++i)
+            {
+                output[2 + i] = (byte)(indices >> (i * 8));
+            }
+        }
+
+        /// <summary>
+        /// Decode an 8 byte BC4 block into one channel of a 4x4 block of rgba8 pixels.
+        /// </summary>
+        public static void DecodeBC4Block(ReadOnlySpan<byte> input, Span<byte> rgbaBlock, int channel)
+        {
+            Span<int> palette = stackalloc int[8];
+            GetBC4Palette(input[0], input[1], palette);
+
+            ulong indices = 0;
+            for (var i = 0; i < 6; ++i)
+            {
+                indices |= (ulong)input[2 + i] << (i * 8);
+            }
+
+            for (var i = 0; i < BlockPixels; ++i)
+            {
+                rgbaBlock[i * 4 + channel] = (byte)palette[(int)((indices >> (i * 3)) & 0x7)];
+            }
+        }
+
+        private static void GetBC4Palette(int red0, int red1, Span<int> palette)
+        {
+            palette[0] = red0;
+            palette[1] = red1;
+            if (red0 > red1)
+            {
+                for (var i = 1; i < 7; ++i)
+                {
+                    palette[i + 1] = ((7 - i) * red0 + i * red1 + 3) / 7;
+                }
+            }
+            else
+            {
+                for (var i = 1; i < 5; ++i)
+                {
+                    palette[i + 1] = ((5 - i) * red0 + i * red1 + 2) / 5;
+                }
+                palette[6] = 0;
+                palette[7] = 255;
+            }
+        }
+
+        /// <summary>
+        /// Encode a 4x4 block of rgba8 pixels into a 16 byte BC7 mode 6 block. The endpoints start on the
+        /// principal axis of the pixels and are refit with least squares to the chosen indices.
+        /// </summary>
+        public static void EncodeBC7Block(ReadOnlySpan<byte> rgbaBlock, Span<byte> output)
+        {
+            Span<float> pixels = stackalloc float[BlockPixels * 4];
+            Span<float> mean = stackalloc float[4];
+            for (var i = 0; i < BlockPixels * 4; ++i)
+            {
+                pixels[i] = rgbaBlock[i];
+                mean[i % 4] += rgbaBlock[i];
+            }
+            for (var c = 0; c < 4; ++c)
+            {
+                mean[c] /= BlockPixels;
+            }
+
+            Span<float> axis = stackalloc float[4];
+            GetPrincipalAxis(pixels, mean, axis);
+
+            var minT = float.MaxValue;
+            var maxT = float.MinValue;
+            for (var i = 0; i < BlockPixels; ++i)
+            {
+                var t = 0.0f;
+                for (var c = 0; c < 4; ++c)
+                {
+                    t += (pixels[i * 4 + c] - mean[c]) * axis[c];
+                }
+                minT = Math.Min(minT, t);
+                maxT = Math.Max(maxT, t);
+            }
+
+            Span<float> end0 = stackalloc float[4];
+            Span<float> end1 = stackalloc float[4];
+            for (var c = 0; c < 4; ++c)
+            {
+                end0[c] = mean[c] + axis[c] * minT;
+                end1[c] = mean[c] + axis[c] * maxT;
+            }
+
+            Span<int> bestQuantized = stackalloc int[10]; //7 bit endpoints 0 and 1 for each channel, then the 2 p bits
+            Span<int> bestIndices = stackalloc int[BlockPixels];
+            Span<int> quantized = stackalloc int[10];
+            Span<int> indices = stackalloc int[BlockPixels];
+            var bestError = int.MaxValue;
+
+            for (var iteration = 0; iteration <= BC7RefineIterations; ++iteration)
+            {
+                QuantizeBC7Endpoint(end0, quantized, 0);
+                QuantizeBC7Endpoint(end1, quantized, 1);
+                var error = FindBC7Indices(rgbaBlock, quantized, indices);
+                if (error < bestError)
+                {
+                    bestError = error;
+                    quantized.CopyTo(bestQuantized);
+                    indices.CopyTo(bestIndices);
+                }
+
+                if (error == 0 || iteration == BC7RefineIterations || !RefitBC7Endpoints(pixels, indices, end0, end1))
+                {
+                    break;
+                }
+            }
+
+            WriteBC7Mode6(bestQuantized, bestIndices, output);
+        }
+
+        /// <summary>
+        /// Decode a 16 byte BC7 block into a 4x4 block of rgba8 pixels. Only mode 6 is supported.
+        /// </summary>
+        public static void DecodeBC7Block(ReadOnlySpan<byte> input, Span<byte> rgbaBlock)
+        {
+            ulong low = BitConverter.ToUInt64(input.Slice(0, 8));
+            ulong high = BitConverter.ToUInt64(input.Slice(8, 8));
+            var bit = 0;
+
+            var mode = (int)ReadBits(low, high, ref bit, 7);
+            if (mode != BC7Mode6)
+            {
+                throw new NotSupportedException($"Only BC7 mode 6 blocks can be decoded, this block is mode bits {mode}.");
+            }
+
+            Span<int> endpoints = stackalloc int[8];
+            for (var c = 0; c < 4; ++c)
+            {
+                endpoints[c] = (int)ReadBits(low, high, ref bit, 7);
+                endpoints[4 + c] = (int)ReadBits(low, high, ref bit, 7);
+            }
+            var p0 = (int)ReadBits(low, high, ref bit, 1);
+            var p1 = (int)ReadBits(low, high, ref bit, 1);
+
+            //Reorder so endpoints is channel major for each endpoint
+            Span<int> end0 = stackalloc int[4];
+            Span<int> end1 = stackalloc int[4];
+            for (var c = 0; c < 4; ++c)
+            {
+                end0[c] = (endpoints[c] << 1) | p0;
+                end1[c] = (endpoints[4 + c] << 1) | p1;
+            }
+
+            for (var i = 0; i < BlockPixels; ++i)
+            {
+                var index = (int)ReadBits(low, high, ref bit, i == 0 ? 3 : 4);
+                var weight = BC7Weights4[index];
+                for (var c = 0; c < 4; ++c)
+                {
+                    rgbaBlock[i * 4 + c] = (byte)(((64 - weight) * end0[c] + weight * end1[c] + 32) >> 6);
+                }
+            }
+        }
+
+        private static void GetPrincipalAxis(ReadOnlySpan<float> pixels, ReadOnlySpan<float> mean, Span<float> axis)
+        {
+            Span<float> covariance = stackalloc float[16];
+            for (var i = 0; i < BlockPixels; ++i)
+            {
+                for (var r = 0; r < 4; ++r)
+                {
+                    var dr = pixels[i * 4 + r] - mean[r];
+                    for (var c = 0; c < 4; ++c)
+                    {
+                        covariance[r * 4 + c] += dr * (pixels[i * 4 + c] - mean[c]);
+                    }
+                }
+            }
+
+            //Power iteration, starting on the diagonal finds the main axis for everything but odd cases
+            axis.Fill(1.0f);
+            Span<float> next = stackalloc float[4];
+            for (var iteration = 0; iteration < 8; ++iteration)
+            {
+                var length = 0.0f;
+                for (var r = 0; r < 4; ++r)
+                {
+                    next[r] = 0.0f;
+                    for (var c = 0; c < 4; ++c)
+                    {
+                        next[r] += covariance[r * 4 + c] * axis[c];
+                    }
+                    length += next[r] * next[r];
+                }
+
+                if (length < 1e-12f)
+                {
+                    //The start vector is in the null space, which happens when channels cancel like a half red half green block.
+                    //Restart on the channel with the most variance, its column is never zero unless the pixels are all the same.
+                    var widest = 0;
+                    for (var c = 1; c < 4; ++c)
+                    {
+                        if (covariance[c * 4 + c] > covariance[widest * 4 + widest])
+                        {
+                            widest = c;
+                        }
+                    }
+
+                    axis.Fill(0.0f);
+                    if (iteration > 0 || covariance[widest * 4 + widest] < 1e-6f)
+                    {
+                        //The pixels are all the same
+                        return;
+                    }
+                    axis[widest] = 1.0f;
+                    continue;
+                }
+
+                length = MathF.Sqrt(length);
+                for (var c = 0; c < 4; ++c)
+                {
+                    axis[c] = next[c] / length;
+                }
+            }
+        }
+
+        private static void QuantizeBC7Endpoint(ReadOnlySpan<float> endpoint, Span<int> quantized, int endpointIndex)
+        {
+            //Both p bits are tried, the one that lands closest for all 4 channels is kept. 0 only decodes exactly with p 0
+            //and 255 only with p 1, so ties go to the p bit that keeps more of the channels at those extremes exact.
+            //Alpha at 0 or 255 always picks its p bit so opaque and cut out pixels stay that way.
+            var pStart = 0;
+            var pEnd = 1;
+            var alpha = MathF.Round(endpoint[3]);
+            if (alpha <= 0.0f)
+            {
+                pEnd = 0;
+            }
+            else if (alpha >= 255.0f)
+            {
+                pStart = 1;
+            }
+
+            var bestError = float.MaxValue;
+            var bestExact = -1;
+            for (var p = pStart; p <= pEnd; ++p)
+            {
+                var error = 0.0f;
+                var exact = 0;
+                for (var c = 0; c < 4; ++c)
+                {
+                    var value = Math.Clamp((int)MathF.Round((endpoint[c] - p) * 0.5f), 0, 127);
+                    var decoded = (value << 1) | p;
+                    var diff = decoded - endpoint[c];
+                    error += diff * diff;
+                    if ((decoded == 0 || decoded == 255) && MathF.Abs(diff) < 0.5f)
+                    {
+                        ++exact;
+                    }
+                }
+
+                if (error < bestError || (error == bestError && exact > bestExact))
+                {
+                    bestError = error;
+                    bestExact = exact;
+                    for (var c = 0; c < 4; ++c)
+                    {
+                        quantized[c * 2 + endpointIndex] = Math.Clamp((int)MathF.Round((endpoint[c] - p) * 0.5f), 0, 127);
+                    }
+                    quantized[8 + endpointIndex] = p;
+                }
+            }
+        }
+
+        private static int FindBC7Indices(ReadOnlySpan<byte> rgbaBlock, ReadOnlySpan<int> quantized, Span<int> indices)
+        {
+            Span<int> palette = stackalloc int[16 * 4];
+            for (var c = 0; c < 4; ++c)
+            {
+                var e0 = (quantized[c * 2] << 1) | quantized[8];
+                var e1 = (quantized[c * 2 + 1] << 1) | quantized[9];
+                for (var i = 0; i < 16; ++i)
+                {
+                    var weight = BC7Weights4[i];
+                    palette[i * 4 + c] = ((64 - weight) * e0 + weight * e1 + 32) >> 6;
+                }
+            }
+
+            var totalError = 0;
+            for (var i = 0; i < BlockPixels; ++i)
+            {
+                var best = 0;
+                var bestError = int.MaxValue;
+                for (var p = 0; p < 16; ++p)
+                {
+                    var error = 0;
+                    for (var c = 0; c < 4; ++c)
+                    {
+                        var diff = palette[p * 4 + c] - rgbaBlock[i * 4 + c];
+                        error += diff * diff;
+                    }
+                    if (error < bestError)
+                    {
+                        bestError = error;
+                        best = p;
+                    }
+                }
+                indices[i] = best;
+                totalError += bestError;
+            }
+            return totalError;
+        }
+
+        private static bool RefitBC7Endpoints(ReadOnlySpan<float> pixels, ReadOnlySpan<int> indices, Span<float> end0, Span<float> end1)
+        {
+            //Least squares for the endpoints that best make the pixels with these weights
+            float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+            Span<float> ax = stackalloc float[4];
+            Span<float> bx = stackalloc float[4];
+            for (var i = 0; i < BlockPixels; ++i)
+            {
+                var b = BC7Weights4[indices[i]] / 64.0f;
+                var a = 1.0f - b;
+                aa += a * a;
+                ab += a * b;
+                bb += b * b;
+                for (var c = 0; c < 4; ++c)
+                {
+                    ax[c] += a * pixels[i * 4 + c];
+                    bx[c] += b * pixels[i * 4 + c];
+                }
+            }
+
+            var det = aa * bb - ab * ab;
+            if (MathF.Abs(det) < 1e-6f)
+            {
+                return false;
+            }
+
+            var invDet = 1.0f / det;
+            for (var c = 0; c < 4; ++c)
+            {
+                end0[c] = Math.Clamp((bb * ax[c] - ab * bx[c]) * invDet, 0.0f, 255.0f);
+                end1[c] = Math.Clamp((aa * bx[c] - ab * ax[c]) * invDet, 0.0f, 255.0f);
+            }
+            return true;
+        }
+
+        private static void WriteBC7Mode6(ReadOnlySpan<int> quantized, ReadOnlySpan<int> indices, Span<byte> output)
+        {
+            Span<int> endpoints = stackalloc int[10];
+            Span<int> blockIndices = stackalloc int[BlockPixels];
+            quantized.CopyTo(endpoints);
+            indices.CopyTo(blockIndices);
+
+            //The first index only has 3 bits, so its top bit must be 0. Swap the endpoints if it is not.
+            if (blockIndices[0] >= 8)
+            {
+                for (var c = 0; c < 4; ++c)
+                {
+                    (endpoints[c * 2], endpoints[c * 2 + 1]) = (endpoints[c * 2 + 1], endpoints[c * 2]);
+                }
+                (endpoints[8], endpoints[9]) = (endpoints[9], endpoints[8]);
+                for (var i = 0; i < BlockPixels; ++i)
+                {
+                    blockIndices[i] = 15 - blockIndices[i];
+                }
+            }
+
+            ulong low = 0;
+            ulong high = 0;
+            var bit = 0;
+            WriteBits(ref low, ref high, ref bit, BC7Mode6, 7);
+            for (var c = 0; c < 4; ++c)
+            {
+                WriteBits(ref low, ref high, ref bit, endpoints[c * 2], 7);
+                WriteBits(ref low, ref high, ref bit, endpoints[c * 2 + 1], 7);
+            }
+            WriteBits(ref low, ref high, ref bit, endpoints[8], 1);
+            WriteBits(ref low, ref high, ref bit, endpoints[9], 1);
+            for (var i = 0; i < BlockPixels; ++i)
+            {
+                WriteBits(ref low, ref high, ref bit, blockIndices[i], i == 0 ? 3 : 4);
+            }
+
+            BitConverter.TryWriteBytes(output.Slice(0, 8), low);
+            BitConverter.TryWriteBytes(output.Slice(8, 8), high);
+        }
+
+        private static void WriteBits(ref ulong low, ref ulong high, ref int bit, int value, int count)
+        {
+            for (var i = 0; i < count; ++i, ++bit)
+            {
+                var set = (ulong)((value >> i) & 1);
+                if (bit < 64)
+                {
+                    low |= set << bit;
+                }
+                else
+                {
+                    high |= set << (bit - 64);
+                }
+            }
+        }
+
+        private static ulong ReadBits(ulong low, ulong high, ref int bit, int count)
+        {
+            ulong value = 0;
+            for (var i = 0; i < count; ++i, ++bit)
+            {
+                var set = bit < 64 ? (low >> bit) & 1 : (high >> (bit - 64)) & 1;
+                value |= set << i;
+            }
+            return value;
+        }
+    }
+}
@@ -0,0 +1,288 @@
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Text;
+using System.Threading.Tasks;
+
+namespace Engine
+{
+    /// <summary>
+    /// The dxgi formats a DdsFile can hold, the values match DXGI_FORMAT.
+    /// </summary>
+    public enum DxgiFormat : uint
+    {
+        Unknown = 0,
+        BC4_UNORM = 80,
+        BC5_UNORM = 83,
+        BC7_UNORM = 98,
+        BC7_UNORM_SRGB = 99,
+    }
+
+    /// <summary>
+    /// The alpha mode in the DX10 header, the values match DDS_ALPHA_MODE.
+    /// </summary>
+    public enum DdsAlphaMode : uint
+    {
+        Unknown = 0,
+        Straight = 1,
+        Premultiplied = 2,
+        Opaque = 3,
+        Custom = 4,
+    }
+
+    /// <summary>
+    /// A 2d block compressed texture in a dds file with a DX10 header. The mip chain is kept in one array
+    /// in file order, mip 0 first. The legacy ATI1 and ATI2 headers can also be read as BC4 and BC5.
+    /// </summary>
+    public class DdsFile
+    {
+        private const uint Magic = 0x20534444; //"DDS "
+        private const int HeaderSize = 124;
+        private const int PixelFormatSize = 32;
+
+        private const uint DDSD_CAPS = 0x1;
+        private const uint DDSD_HEIGHT = 0x2;
+        private const uint DDSD_WIDTH = 0x4;
+        private const uint DDSD_PIXELFORMAT = 0x1000;
+        private const uint DDSD_MIPMAPCOUNT = 0x20000;
+        private const uint DDSD_LINEARSIZE = 0x80000;
+        private const uint DDPF_FOURCC = 0x4;
+        private const uint DDSCAPS_COMPLEX = 0x8;
+        private const uint DDSCAPS_TEXTURE = 0x1000;
+        private const uint DDSCAPS_MIPMAP = 0x400000;
+        private const uint D3D10_RESOURCE_DIMENSION_TEXTURE2D = 3;
+
+        private static readonly uint FourCCDX10 = MakeFourCC("DX10");
+        private static readonly uint FourCCATI1 = MakeFourCC("ATI1");
+        private static readonly uint FourCCBC4U = MakeFourCC("BC4U");
+        private static readonly uint FourCCATI2 = MakeFourCC("ATI2");
+        private static readonly uint FourCCBC5U = MakeFourCC("BC5U");
+
+        public DdsFile(int width, int height, int mipLevels, DxgiFormat format, DdsAlphaMode alphaMode, byte[] data)
+        {
+            Width = width;
+            Height = height;
+            MipLevels = mipLevels;
+            Format = format;
+            AlphaMode = alphaMode;
+            Data = data;
+
+            var expected = GetMipOffset(mipLevels);
+            if (data.Length < expected)
+            {
+                throw new ArgumentException($"A {width}x{height} {format} dds with {mipLevels} mips needs {expected} bytes, but only {data.Length} were given.", nameof(data));
+            }
+        }
+
+        public int Width { get; }
+
+        public int Height { get; }
+
+        public int MipLevels { get; }
+
+        public DxgiFormat Format { get; }
+
+        public DdsAlphaMode AlphaMode { get; }
+
+        /// <summary>
+        /// The blocks for every mip level in order.
+        /// </summary>
+        public byte[] Data { get; }
+
+        public int BlockSize => GetBlockSize(Format);
+
+        public int GetMipWidth(int mip) => Math.Max(Width >> mip, 1);
+
+        public int GetMipHeight(int mip) => Math.Max(Height >> mip, 1);
+
+        /// <summary>
+        /// The size of one row of blocks in a mip level.
+        /// </summary>
+        public int GetRowPitch(int mip)
+        {
+            return BlockCompression.GetBlocksWide(GetMipWidth(mip)) * BlockSize;
+        }
+
+        public int GetMipSize(int mip)
+        {
+            return GetRowPitch(mip) * BlockCompression.GetBlocksHigh(GetMipHeight(mip));
+        }
+
+        /// <summary>
+        /// Get the offset of a mip level in Data. Passing MipLevels gets the size of the whole chain.
+        /// </summary>
+        public int GetMipOffset(int mip)
+        {
+            return GetChainSize(Width, Height, mip, Format);
+        }
+
+        /// <summary>
+        /// Get the size of the first mipLevels mips of a texture.
+        /// </summary>
+        public static int GetChainSize(int width, int height, int mipLevels, DxgiFormat format)
+        {
+            var blockSize = GetBlockSize(format);
+            var size = 0;
+            for (var i = 0; i < mipLevels; ++i)
+            {
+                size += BlockCompression.GetBlocksWide(Math.Max(width >> i, 1)) * BlockCompression.GetBlocksHigh(Math.Max(height >> i, 1)) * blockSize;
+            }
+            return size;
+        }
+
+        public static int GetBlockSize(DxgiFormat format)
+        {
+            switch (format)
+            {
+                case DxgiFormat.BC4_UNORM:
+                    return 8;
+                case DxgiFormat.BC5_UNORM:
+                case DxgiFormat.BC7_UNORM:
+                case DxgiFormat.BC7_UNORM_SRGB:
+                    return 16;
+                default:
+                    throw new NotSupportedException($"Dxgi format {format} is not supported in dds files.");
+            }
+        }
+
+        public static DdsFile Read(byte[] bytes)
+        {
+            using (var stream = new MemoryStream(bytes, false))
+            {
+                return Read(stream);
+            }
+        }
+
+        public static DdsFile Read(Stream stream)
+        {
+            using (var reader = new BinaryReader(stream, Encoding.ASCII, true))
+            {
+                if (reader.ReadUInt32() != Magic)
+                {
+                    throw new InvalidDataException("Not a dds file.");
+                }
+
+                if (reader.ReadUInt32() != HeaderSize)
+                {
+                    throw new InvalidDataException("Dds header size is wrong.");
+                }
+                reader.ReadUInt32(); //Flags
+                var height = (int)reader.ReadUInt32();
+                var width = (int)reader.ReadUInt32();
+                reader.ReadUInt32(); //Pitch or linear size
+                var depth = reader.ReadUInt32();
+                var mipLevels = Math.Max((int)reader.ReadUInt32(), 1);
+                for (var i = 0; i < 11; ++i)
+                {
+                    reader.ReadUInt32(); //Reserved
+                }
+
+                reader.ReadUInt32(); //Pixel format size
+                var pixelFlags = reader.ReadUInt32();
+                var fourCC = reader.ReadUInt32();
+                for (var i = 0; i < 5; ++i)
+                {
+                    reader.ReadUInt32(); //Bit counts and masks
+                }
+                reader.ReadUInt32(); //Caps
+                var caps2 = reader.ReadUInt32();
+                reader.ReadUInt32(); //Caps3
+                reader.ReadUInt32(); //Caps4
+                reader.ReadUInt32(); //Reserved2
+
+                if ((pixelFlags & DDPF_FOURCC) == 0)
+                {
+                    throw new NotSupportedException("Only block compressed dds files are supported.");
+                }
+
+                if (caps2 != 0 || depth > 1)
+                {
+                    throw new NotSupportedException("Only 2d dds textures are supported, not cube maps or volumes.");
+                }
+
+                DxgiFormat format;
+                var alphaMode = DdsAlphaMode.Unknown;
+                if (fourCC == FourCCDX10)
+                {
+                    format = (DxgiFormat)reader.ReadUInt32();
+                    var dimension = reader.ReadUInt32();
+                    reader.ReadUInt32(); //Misc flags
+                    var arraySize = reader.ReadUInt32();
+                    alphaMode = (DdsAlphaMode)(reader.ReadUInt32() & 0x7);
+
+                    if (dimension != D3D10_RESOURCE_DIMENSION_TEXTURE2D || arraySize > 1)
+                    {
+                        throw new NotSupportedException("Only 2d dds textures are supported, not arrays.");
+                    }
+                }
+                else if (fourCC == FourCCATI1 || fourCC == FourCCBC4U)
+                {
+                    format = DxgiFormat.BC4_UNORM;
+                }
+                else if (fourCC == FourCCATI2 || fourCC == FourCCBC5U)
+                {
+                    format = DxgiFormat.BC5_UNORM;
+                }
+                else
+                {
+                    throw new NotSupportedException($"Dds four cc 0x{fourCC:X8} is not supported.");
+                }
+
+                var size = GetChainSize(width, height, mipLevels, format);
+                var data = reader.ReadBytes(size);
+                if (data.Length < size)
+                {
+                    throw new InvalidDataException($"Dds file is truncated, expected {size} bytes of data but found {data.Length}.");
+                }
+                return new DdsFile(width, height, mipLevels, format, alphaMode, data);
+            }
+        }
+
+        public void Write(Stream stream)
+        {
+            using (var writer = new BinaryWriter(stream, Encoding.ASCII, true))
+            {
+                writer.Write(Magic);
+
+                writer.Write((uint)HeaderSize);
+                writer.Write(DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT | DDSD_LINEARSIZE);
+                writer.Write((uint)Height);
+                writer.Write((uint)Width);
+                writer.Write((uint)GetMipSize(0));
+                writer.Write(0u); //Depth
+                writer.Write((uint)MipLevels);
+                for (var i = 0; i < 11; ++i)
+                {
+                    writer.Write(0u);
+                }
+
+                writer.Write((uint)PixelFormatSize);
+                writer.Write(DDPF_FOURCC);
+                writer.Write(FourCCDX10);
+                for (var i = 0; i < 5; ++i)
+                {
+                    writer.Write(0u);
+                }
+                writer.Write(DDSCAPS_TEXTURE | (MipLevels > 1 ? DDSCAPS_MIPMAP | DDSCAPS_COMPLEX : 0));
+                writer.Write(0u); //Caps2
+                writer.Write(0u); //Caps3
+                writer.Write(0u); //Caps4
+                writer.Write(0u); //Reserved2
+
+                writer.Write((uint)Format);
+                writer.Write(D3D10_RESOURCE_DIMENSION_TEXTURE2D);
+                writer.Write(0u); //Misc flags
+                writer.Write(1u); //Array size
+                writer.Write((uint)AlphaMode);
+
+                writer.Write(Data, 0, GetMipOffset(MipLevels));
+            }
+        }
+
+        private static uint MakeFourCC(String code)
+        {
+            return (uint)code[0] | ((uint)code[1] << 8) | ((uint)code[2] << 16) | ((uint)code[3] << 24);
+        }
+    }
+}
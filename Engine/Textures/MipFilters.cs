@@ -0,0 +1,118 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+using System.Threading.Tasks;
+
+namespace Engine
+{
+    /// <summary>
+    /// The 2x2 mip filters from MipGeneration.csh run on the cpu, the texture loader uses these when the gpu
+    /// mip generator is off. Texels are unorm values from 0 to 1 and normals are stored as n * 0.5 + 0.5.
+    /// The shader has to match these, the tests check the math here.
+    /// </summary>
+    public static class MipFilters
+    {
+        /// <summary>
+        /// Make one texel of a mip from the 2x2 texels above it.
+        /// </summary>
+        public delegate Vector4 Filter(in Vector4 c00, in Vector4 c10, in Vector4 c01, in Vector4 c11);
+
+        /// <summary>
+        /// Make a mip from the one above it with filter. Both are bgra8 rows of stride bytes, the same layout
+        /// as a 32 bit FreeImageBitmap. The last row or column of odd sized sources is repeated.
+        /// </summary>
+        public static void Downsample(ReadOnlySpan<byte> source, int sourceWidth, int sourceHeight, int sourceStride, Span<byte> dest, int destWidth, int destHeight, int destStride, Filter filter)
+        {
+            for (var y = 0; y < destHeight; ++y)
+            {
+                var row0 = Math.Min(y * 2, sourceHeight - 1) * sourceStride;
+                var row1 = Math.Min(y * 2 + 1, sourceHeight - 1) * sourceStride;
+                var destRow = y * destStride;
+                for (var x = 0; x < destWidth; ++x)
+                {
+                    var col0 = Math.Min(x * 2, sourceWidth - 1) * 4;
+                    var col1 = Math.Min(x * 2 + 1, sourceWidth - 1) * 4;
+                    var texel = filter(
+                        ReadTexel(source, row0 + col0),
+                        ReadTexel(source, row0 + col1),
+                        ReadTexel(source, row1 + col0),
+                        ReadTexel(source, row1 + col1));
+                    WriteTexel(dest, destRow + x * 4, texel);
+                }
+            }
+        }
+
+        private static Vector4 ReadTexel(ReadOnlySpan<byte> pixels, int offset)
+        {
+            return new Vector4(pixels[offset + 2] / 255.0f, pixels[offset + 1] / 255.0f, pixels[offset] / 255.0f, pixels[offset + 3] / 255.0f);
+        }
+
+        private static void WriteTexel(Span<byte> pixels, int offset, in Vector4 texel)
+        {
+            pixels[offset] = ToByte(texel.z);
+            pixels[offset + 1] = ToByte(texel.y);
+            pixels[offset + 2] = ToByte(texel.x);
+            pixels[offset + 3] = ToByte(texel.w);
+        }
+
+        private static byte ToByte(float value)
+        {
+            return (byte)Math.Clamp((int)(value * 255.0f + 0.5f), 0, 255);
+        }
+
+        /// <summary>
+        /// Average the 4 texels.
+        /// </summary>
+        public static Vector4 Box(in Vector4 c00, in Vector4 c10, in Vector4 c01, in Vector4 c11)
+        {
+            return new Vector4(
+                (c00.x + c10.x + c01.x + c11.x) * 0.25f,
+                (c00.y + c10.y + c01.y + c11.y) * 0.25f,
+                (c00.z + c10.z + c01.z + c11.z) * 0.25f,
+                (c00.w + c10.w + c01.w + c11.w) * 0.25f);
+        }
+
+        /// <summary>
+        /// Average the 4 normals as vectors and renormalize them, alpha is averaged.
+        /// </summary>
+        public static Vector4 Normal(in Vector4 c00, in Vector4 c10, in Vector4 c01, in Vector4 c11)
+        {
+            var result = Box(c00, c10, c01, c11);
+
+            //Each texel decodes as c * 2 - 1, so the sum of the 4 normals is the sum of the texels * 2 - 4
+            var normal = new Vector3(
+                (c00.x + c10.x + c01.x + c11.x) * 2.0f - 4.0f,
+                (c00.y + c10.y + c01.y + c11.y) * 2.0f - 4.0f,
+                (c00.z + c10.z + c01.z + c11.z) * 2.0f - 4.0f);
+            var len = normal.length();
+            //Normals that cancel out go back to facing straight out
+            normal = len > 1e-5f ? normal / len : new Vector3(0.0f, 0.0f, 1.0f);
+
+            result.x = normal.x * 0.5f + 0.5f;
+            result.y = normal.y * 0.5f + 0.5f;
+            result.z = normal.z * 0.5f + 0.5f;
+            return result;
+        }
+
+        /// <summary>
+        /// Box, but green keeps the roughest of the 4 texels.
+        /// </summary>
+        public static Vector4 RoughnessMax(in Vector4 c00, in Vector4 c10, in Vector4 c01, in Vector4 c11)
+        {
+            var result = Box(c00, c10, c01, c11);
+            result.y = Math.Max(Math.Max(c00.y, c10.y), Math.Max(c01.y, c11.y));
+            return result;
+        }
+
+        /// <summary>
+        /// Box, but green keeps the smoothest of the 4 texels.
+        /// </summary>
+        public static Vector4 RoughnessMin(in Vector4 c00, in Vector4 c10, in Vector4 c01, in Vector4 c11)
+        {
+            var result = Box(c00, c10, c01, c11);
+            result.y = Math.Min(Math.Min(c00.y, c10.y), Math.Min(c01.y, c11.y));
+            return result;
+        }
+    }
+}
@@ -0,0 +1,251 @@
+﻿using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+
+namespace Engine
+{
+    /// <summary>
+    /// A move made by RangeAllocator.Defragment. Copy Size units from From to To.
+    /// </summary>
+    public struct RangeAllocatorMove
+    {
+        public uint From;
+        public uint To;
+        public uint Size;
+    }
+
+    /// <summary>
+    /// Hands out ranges of a linear space, like a gpu buffer, from a free list kept sorted by offset. Freed
+    /// ranges are merged with their neighbors. Allocations use the smallest free range that fits. This only
+    /// does the bookkeeping, the owner of the space is responsible for moving any data when the allocator
+    /// grows or is defragmented. The units are up to the owner, usually elements.
+    /// </summary>
+    public class RangeAllocator
+    {
+        struct FreeRange
+        {
+            public uint Offset;
+            public uint Size;
+
+            public uint End => Offset + Size;
+        }
+
+        private List<FreeRange> freeRanges = new List<FreeRange>();
+        private Dictionary<uint, uint> allocations = new Dictionary<uint, uint>();
+        private uint capacity;
+        private uint usedSize;
+
+        public RangeAllocator(uint capacity)
+        {
+            this.capacity = capacity;
+            if (capacity > 0)
+            {
+                freeRanges.Add(new FreeRange { Offset = 0, Size = capacity });
+            }
+        }
+
+        /// <summary>
+        /// The total size of the space.
+        /// </summary>
+        public uint Capacity => capacity;
+
+        /// <summary>
+        /// The total size of all allocations.
+        /// </summary>
+        public uint UsedSize => usedSize;
+
+        public uint FreeSize => capacity - usedSize;
+
+        public int AllocationCount => allocations.Count;
+
+        public int FreeRangeCount => freeRanges.Count;
+
+        public uint LargestFreeRange
+        {
+            get
+            {
+                uint largest = 0;
+                foreach (var range in freeRanges)
+                {
+                    if (range.Size > largest)
+                    {
+                        largest = range.Size;
+                    }
+                }
+                return largest;
+            }
+        }
+
+        /// <summary>
+        /// Try to allocate a range of size. Returns false if there is no free range big enough, the space
+        /// might still have enough free size in total, in that case Defragment will make room.
+        /// </summary>
+        public bool TryAllocate(uint size, out uint offset)
+        {
+            if (size == 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(size), "Cannot allocate a range of size 0.");
+            }
+
+            var best = -1;
+            for (var i = 0; i < freeRanges.Count; ++i)
+            {
+                var range = freeRanges[i];
+                if (range.Size >= size && (best == -1 || range.Size < freeRanges[best].Size))
+                {
+                    best = i;
+                    if (range.Size == size)
+                    {
+                        break;
+                    }
+                }
+            }
+
+            if (best == -1)
+            {
+                offset = 0;
+                return false;
+            }
+
+            var found = freeRanges[best];
+            offset = found.Offset;
+            if (found.Size == size)
+            {
+                freeRanges.RemoveAt(best);
+            }
+            else
+            {
+                freeRanges[best] = new FreeRange { Offset = found.Offset + size, Size = found.Size - size };
+            }
+
+            allocations.Add(offset, size);
+            usedSize += size;
+            return true;
+        }
+
+        /// <summary>
+        /// Get the size of the allocation at offset.
+        /// </summary>
+        public uint GetSize(uint offset)
+        {
+            if (!allocations.TryGetValue(offset, out var size))
+            {
+                throw new InvalidOperationException($"There is no allocation at offset {offset}.");
+            }
+            return size;
+        }
+
+        /// <summary>
+        /// Free the allocation at offset.
+        /// </summary>
+        public void Free(uint offset)
+        {
+            if (!allocations.Remove(offset, out var size))
+            {
+                throw new InvalidOperationException($"There is no allocation at offset {offset}.");
+            }
+            usedSize -= size;
+
+            var freed = new FreeRange { Offset = offset, Size = size };
+            var index = FindInsertIndex(offset);
+
+            //Merge with the range after
+            if (index < freeRanges.Count && freeRanges[index].Offset == freed.End)
+            {
+                freed.Size += freeRanges[index].Size;
+                freeRanges.RemoveAt(index);
+            }
+
+            //Merge with the range before
+            if (index > 0 && freeRanges[index - 1].End == freed.Offset)
+            {
+                var before = freeRanges[index - 1];
+                before.Size += freed.Size;
+                freeRanges[index - 1] = before;
+            }
+            else
+            {
+                freeRanges.Insert(index, freed);
+            }
+        }
+
+        /// <summary>
+        /// Grow the space to newCapacity. Existing allocations keep their offsets.
+        /// </summary>
+        public void Grow(uint newCapacity)
+        {
+            if (newCapacity < capacity)
+            {
+                throw new ArgumentOutOfRangeException(nameof(newCapacity), "Cannot shrink a RangeAllocator.");
+            }
+
+            var added = newCapacity - capacity;
+            if (added == 0)
+            {
+                return;
+            }
+
+            var last = freeRanges.Count - 1;
+            if (last >= 0 && freeRanges[last].End == capacity)
+            {
+                var range = freeRanges[last];
+                range.Size += added;
+                freeRanges[last] = range;
+            }
+            else
+            {
+                freeRanges.Add(new FreeRange { Offset = capacity, Size = added });
+            }
+            capacity = newCapacity;
+        }
+
+        /// <summary>
+        /// Pack all allocations to the start of the space in offset order, leaving one free range at the end.
+        /// The moves needed are added to moves in ascending order, every move goes to a lower offset.
+        /// Allocation offsets change, so callers must update anything that stored them.
+        /// </summary>
+        public void Defragment(List<RangeAllocatorMove> moves)
+        {
+            var sorted = allocations.OrderBy(i => i.Key).ToList();
+            allocations.Clear();
+
+            uint next = 0;
+            foreach (var allocation in sorted)
+            {
+                if (allocation.Key != next)
+                {
+                    moves.Add(new RangeAllocatorMove { From = allocation.Key, To = next, Size = allocation.Value });
+                }
+                allocations.Add(next, allocation.Value);
+                next += allocation.Value;
+            }
+
+            freeRanges.Clear();
+            if (next < capacity)
+            {
+                freeRanges.Add(new FreeRange { Offset = next, Size = capacity - next });
+            }
+        }
+
+        private int FindInsertIndex(uint offset)
+        {
+            //Binary search for the first free range after offset
+            int low = 0;
+            int high = freeRanges.Count;
+            while (low < high)
+            {
+                var mid = (low + high) / 2;
+                if (freeRanges[mid].Offset < offset)
+                {
+                    low = mid + 1;
+                }
+                else
+                {
+                    high = mid;
+                }
+            }
+            return low;
+        }
+    }
+}
@@ -0,0 +1,185 @@
+﻿using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Linq;
+using System.Runtime.InteropServices;
+using System.Text;
+using System.Threading;
+using System.Threading.Tasks;
+using Engine.Resources;
+
+namespace ZipAccess
+{
+    /// <summary>
+    /// A batched asynchronous read queue backed by the native zip library. Reads are
+    /// collected with the submit functions and sent to the native side together when
+    /// flush is called, where a small native thread pool does the work.
+    /// </summary>
+    public class AsyncIOQueue : IDisposable
+    {
+        [StructLayout(LayoutKind.Sequential)]
+        struct AsyncIOCompletion
+        {
+            public long userData;
+            public long bytesRead;
+            public long queuedNs;
+            public long startNs;
+            public long endNs;
+            public uint threadId;
+            public int error;
+        }
+
+        class PendingRead
+        {
+            public TaskCompletionSource<byte[]> Source;
+            public String Path;
+            public GCHandle Handle;
+            public byte[] Buffer;
+            public Action Finished;
+        }
+
+        private const int CompletionBatchSize = 32;
+        private const int WaitTimeoutMs = 100;
+
+        IntPtr ptr;
+        Thread completionThread;
+        ConcurrentDictionary<long, PendingRead> pendingReads = new ConcurrentDictionary<long, PendingRead>();
+        long currentId = 0;
+        volatile bool running = true;
+
+        /// <summary>
+        /// Constructor.
+        /// </summary>
+        /// <param name="numThreads">The number of native worker threads.</param>
+        /// <param name="ringDepth">Unused, the native queue only has the thread pool backend.</param>
+        public AsyncIOQueue(int numThreads = 2, int ringDepth = 64)
+        {
+            ptr = AsyncIOQueue_Create(numThreads, ringDepth);
+            completionThread = new Thread(completionLoop);
+            completionThread.Name = "AsyncIOQueue Completion";
+            completionThread.IsBackground = true;
+            completionThread.Start();
+        }
+
+        public void Dispose()
+        {
+            if (ptr != IntPtr.Zero)
+            {
+                running = false;
+                AsyncIOQueue_CancelWait(ptr);
+                completionThread.Join();
+                //Destroying the native queue finishes any in flight reads, drain them so nothing stays pinned.
+                AsyncIOQueue_Destroy(ptr);
+                ptr = IntPtr.Zero;
+                foreach (var read in pendingReads.Values)
+                {
+                    release(read);
+                    read.Source.TrySetException(new ObjectDisposedException(nameof(AsyncIOQueue)));
+                }
+                pendingReads.Clear();
+            }
+        }
+
+        /// <summary>
+        /// Queue a read of size bytes at offset from a file on disk. The read does not start until flush is called.
+        /// </summary>
+        public Task<byte[]> submitFileRead(String path, long offset, long size)
+        {
+            var read = createRead(path, size, null, out var id);
+            AsyncIOQueue_SubmitFileRead(ptr, path, read.Handle.AddrOfPinnedObject(), offset, size, id);
+            return read.Source.Task;
+        }
+
+        /// <summary>
+        /// Queue a read of a whole zip entry. The zzipDir is owned by the read until it completes and
+        /// finished will be called at that point so the handle can go back to its pool.
+        /// </summary>
+        internal Task<byte[]> submitZipRead(IntPtr zzipDir, String filename, long size, Action finished)
+        {
+            var read = createRead(filename, size, finished, out var id);
+            AsyncIOQueue_SubmitZipRead(ptr, zzipDir, filename, read.Handle.AddrOfPinnedObject(), size, id);
+            return read.Source.Task;
+        }
+
+        /// <summary>
+        /// Send all reads submitted since the last flush to the native queue as one batch.
+        /// </summary>
+        public void flush()
+        {
+            AsyncIOQueue_Flush(ptr);
+        }
+
+        private PendingRead createRead(String path, long size, Action finished, out long id)
+        {
+            var buffer = new byte[size];
+            var read = new PendingRead()
+            {
+                Source = new TaskCompletionSource<byte[]>(TaskCreationOptions.RunContinuationsAsynchronously),
+                Path = path,
+                Buffer = buffer,
+                Handle = GCHandle.Alloc(buffer, GCHandleType.Pinned),
+                Finished = finished,
+            };
+            id = Interlocked.Increment(ref currentId);
+            pendingReads[id] = read;
+            return read;
+        }
+
+        private static void release(PendingRead read)
+        {
+            if (read.Handle.IsAllocated)
+            {
+                read.Handle.Free();
+            }
+            read.Finished?.Invoke();
+            read.Finished = null;
+        }
+
+        private unsafe void completionLoop()
+        {
+            var completions = stackalloc AsyncIOCompletion[CompletionBatchSize];
+            while (running)
+            {
+                int count = AsyncIOQueue_WaitCompletions(ptr, completions, CompletionBatchSize, WaitTimeoutMs);
+                for (int i = 0; i < count; ++i)
+                {
+                    var completion = completions[i];
+                    if (pendingReads.TryRemove(completion.userData, out var read))
+                    {
+                        release(read);
+                        IOTrace.recordNative(read.Path, completion.threadId, completion.queuedNs, completion.startNs, completion.endNs, completion.bytesRead);
+                        if (completion.error == 0)
+                        {
+                            read.Source.TrySetResult(read.Buffer);
+                        }
+                        else
+                        {
+                            read.Source.TrySetException(new ZipIOException("Async read failed with error {0} after {1} of {2} bytes.", completion.error, completion.bytesRead, read.Buffer.Length));
+                        }
+                    }
+                }
+            }
+        }
+
+        [DllImport(ZipLibraryInfo.Name, CallingConvention = CallingConvention.Cdecl)]
+        private static extern IntPtr AsyncIOQueue_Create(int numThreads, int ringDepth);
+
+        [DllImport(ZipLibraryInfo.Name, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void AsyncIOQueue_Destroy(IntPtr queue);
+
+        [DllImport(ZipLibraryInfo.Name, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void AsyncIOQueue_SubmitFileRead(IntPtr queue, String path, IntPtr buffer, long offset, long size, long userData);
+
+        [DllImport(ZipLibraryInfo.Name, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void AsyncIOQueue_SubmitZipRead(IntPtr queue, IntPtr zzipDir, String filename, IntPtr buffer, long size, long userData);
+
+        [DllImport(ZipLibraryInfo.Name, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void AsyncIOQueue_Flush(IntPtr queue);
+
+        [DllImport(ZipLibraryInfo.Name, CallingConvention = CallingConvention.Cdecl)]
+        private static unsafe extern int AsyncIOQueue_WaitCompletions(IntPtr queue, AsyncIOCompletion* completions, int max, int timeoutMs);
+
+        [DllImport(ZipLibraryInfo.Name, CallingConvention = CallingConvention.Cdecl)]
+        private static extern void AsyncIOQueue_CancelWait(IntPtr queue);
+    }
+}
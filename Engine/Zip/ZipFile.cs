@@ -4,6 +4,7 @@ using System.Linq;
 using System.Text;
 using System.Runtime.InteropServices;
 using System.Text.RegularExpressions;
+using System.Threading.Tasks;
 using Engine;
 
 namespace ZipAccess
@@ -80,6 +81,24 @@ namespace ZipAccess
             }
         }
 
+        /// <summary>
+        /// Read the entire contents of a file using an AsyncIOQueue. The read is only submitted,
+        /// call flush on the queue to start it. A dir handle is checked out of the pool for the
+        /// duration of the read so other streams can keep working.
+        /// </summary>
+        public unsafe Task<byte[]> readFileAsync(AsyncIOQueue queue, String filename)
+        {
+            String fixedFileName = fixPathFile(filename);
+            PooledZzipDir zzipDir = pooledZzipDirHandles.getPooledObject();
+            ZZipStat zstat = new ZZipStat();
+            if (ZipFile_DirStat(zzipDir.Ptr, fixedFileName, &zstat, (int)ZZipFlags.ZZIP_CASELESS) != ZZipError.ZZIP_NO_ERROR)
+            {
+                zzipDir.finished();
+                return Task.FromException<byte[]>(new ZipIOException("Cannot find file {0}", filename));
+            }
+            return queue.submitZipRead(zzipDir.Ptr, fixedFileName, zstat.UncompressedSize, zzipDir.finished);
+        }
+
 	    public IEnumerable<ZipFileInfo> listFiles(String path, bool recursive)
         {
             return findMatches(files, path, "*", recursive);
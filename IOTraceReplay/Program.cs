@@ -0,0 +1,343 @@
+﻿using Engine;
+using Engine.Resources;
+using Microsoft.Extensions.Logging.Abstractions;
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Linq;
+using System.Threading.Tasks;
+
+namespace IOTraceReplay
+{
+    /// <summary>
+    /// Replays an io trace recorded with Engine.Resources.IOTrace against a set of archives and
+    /// reports throughput and latency. The archives do not need to be the ones the trace was
+    /// recorded with, so the same trace can compare zip, dat and loose file layouts.
+    ///
+    /// Usage: IOTraceReplay trace.iotrace archive [archive ...] [--async] [--timed] [--repeat n]
+    ///   --async  Replay whole file reads from streams as readAllBytesAsync batches instead of stream reads.
+    ///   --timed  Keep the original spacing between operations instead of replaying as fast as possible.
+    ///   --repeat Replay the trace n times, the first pass is reported separately as the cold run.
+    /// </summary>
+    class Program
+    {
+        //Whole file reads are submitted this many at a time with --async
+        const int AsyncBatchSize = 32;
+
+        class Options
+        {
+            public String TraceFile;
+            public List<String> Archives = new List<string>();
+            public bool Async;
+            public bool Timed;
+            public int Repeat = 1;
+        }
+
+        class PassResult
+        {
+            public List<double> Latencies = new List<double>();
+            public long Bytes;
+            public int Files;
+            public int Errors;
+            public double Seconds;
+        }
+
+        static int Main(string[] args)
+        {
+            var options = ParseArgs(args);
+            if (options == null)
+            {
+                Console.WriteLine("Usage: IOTraceReplay trace.iotrace archive [archive ...] [--async] [--timed] [--repeat n]");
+                return 1;
+            }
+
+            List<IOTraceEvent> events;
+            long frequency;
+            using (var reader = new IOTraceReader(File.OpenRead(options.TraceFile)))
+            {
+                events = reader.readEvents().ToList();
+                frequency = reader.Frequency;
+            }
+
+            Console.WriteLine($"Loaded {events.Count} events from {options.TraceFile}");
+            PrintTraceSummary(events, frequency);
+
+            using var vfs = new VirtualFileSystem(NullLogger<VirtualFileSystem>.Instance);
+            foreach (var archive in options.Archives)
+            {
+                vfs.addArchive(archive);
+            }
+
+            for (int i = 0; i < options.Repeat; ++i)
+            {
+                var result = options.Async ? ReplayAsync(vfs, events) : ReplayStreams(vfs, events, frequency, options.Timed);
+                PrintResult(i == 0 ? "Cold" : $"Warm {i}", result);
+            }
+
+            return 0;
+        }
+
+        static Options ParseArgs(string[] args)
+        {
+            var options = new Options();
+            for (int i = 0; i < args.Length; ++i)
+            {
+                switch (args[i])
+                {
+                    case "--async":
+                        options.Async = true;
+                        break;
+                    case "--timed":
+                        options.Timed = true;
+                        break;
+                    case "--repeat":
+                        if (++i >= args.Length || !int.TryParse(args[i], out options.Repeat) || options.Repeat < 1)
+                        {
+                            return null;
+                        }
+                        break;
+                    default:
+                        if (options.TraceFile == null)
+                        {
+                            options.TraceFile = args[i];
+                        }
+                        else
+                        {
+                            options.Archives.Add(args[i]);
+                        }
+                        break;
+                }
+            }
+            if (options.TraceFile == null || options.Archives.Count == 0)
+            {
+                return null;
+            }
+            return options;
+        }
+
+        /// <summary>
+        /// Print which files took the most time in the recorded trace.
+        /// </summary>
+        static void PrintTraceSummary(List<IOTraceEvent> events, long frequency)
+        {
+            var perFile = events
+                .Where(i => i.Type != IOTraceEventType.NativeRead)
+                .GroupBy(i => i.Path)
+                .Select(i => new
+                {
+                    Path = i.Key,
+                    Ms = i.Sum(j => j.Duration) * 1000.0 / frequency,
+                    Bytes = i.Where(j => j.Type == IOTraceEventType.Read || j.Type == IOTraceEventType.AsyncRead).Sum(j => Math.Max(j.Bytes, 0)),
+                })
+                .OrderByDescending(i => i.Ms)
+                .Take(10);
+
+            Console.WriteLine("Slowest files in trace:");
+            foreach (var file in perFile)
+            {
+                Console.WriteLine($"  {file.Ms,10:0.000} ms {Prettify.GetSizeReadable(file.Bytes),12} {file.Path}");
+            }
+
+            var native = events.Where(i => i.Type == IOTraceEventType.NativeRead).ToList();
+            if (native.Count > 0)
+            {
+                Console.WriteLine($"Native async reads: {native.Count}, avg queue wait {native.Average(i => i.Wait) * 1000.0 / frequency:0.000} ms, avg service {native.Average(i => i.Duration) * 1000.0 / frequency:0.000} ms");
+            }
+        }
+
+        /// <summary>
+        /// Replay the trace one recorded thread per task, so the concurrency of the original run is kept.
+        /// </summary>
+        static PassResult ReplayStreams(VirtualFileSystem vfs, List<IOTraceEvent> events, long frequency, bool timed)
+        {
+            var result = new PassResult();
+            var resultLock = new Object();
+            var replayStart = Stopwatch.GetTimestamp();
+
+            var threads = events
+                .Where(i => i.Type != IOTraceEventType.NativeRead)
+                .GroupBy(i => i.ThreadId)
+                .Select(thread => Task.Run(async () =>
+                {
+                    var open = new Dictionary<String, Stream>();
+                    var buffer = new byte[64 * 1024];
+                    var latencies = new List<double>();
+                    var asyncBatch = new List<String>();
+                    long bytes = 0;
+                    int files = 0;
+                    int errors = 0;
+
+                    //Async reads recorded back to back on a thread are read as one batch, like the loaders submit them
+                    async Task FlushAsyncReads()
+                    {
+                        if (asyncBatch.Count == 0)
+                        {
+                            return;
+                        }
+
+                        var start = Stopwatch.GetTimestamp();
+                        try
+                        {
+                            foreach (var data in await vfs.readAllBytesAsync(asyncBatch))
+                            {
+                                bytes += data.Length;
+                                ++files;
+                            }
+                        }
+                        catch (Exception)
+                        {
+                            errors += asyncBatch.Count;
+                        }
+                        latencies.Add((Stopwatch.GetTimestamp() - start) * 1000.0 / Stopwatch.Frequency);
+                        asyncBatch.Clear();
+                    }
+
+                    foreach (var traceEvent in thread)
+                    {
+                        if (traceEvent.Type == IOTraceEventType.AsyncRead)
+                        {
+                            if (timed && asyncBatch.Count == 0)
+                            {
+                                WaitUntil(replayStart, traceEvent.Timestamp * Stopwatch.Frequency / frequency);
+                            }
+                            asyncBatch.Add(traceEvent.Path);
+                            continue;
+                        }
+
+                        await FlushAsyncReads();
+
+                        if (timed)
+                        {
+                            WaitUntil(replayStart, traceEvent.Timestamp * Stopwatch.Frequency / frequency);
+                        }
+
+                        var start = Stopwatch.GetTimestamp();
+                        try
+                        {
+                            switch (traceEvent.Type)
+                            {
+                                case IOTraceEventType.Open:
+                                    open[traceEvent.Path] = vfs.openStream(traceEvent.Path, FileMode.Open, FileAccess.Read, FileShare.Read);
+                                    ++files;
+                                    break;
+                                case IOTraceEventType.Read:
+                                    if (open.TryGetValue(traceEvent.Path, out var stream))
+                                    {
+                                        if (traceEvent.Offset >= 0 && stream.CanSeek && stream.Position != traceEvent.Offset)
+                                        {
+                                            stream.Seek(traceEvent.Offset, SeekOrigin.Begin);
+                                        }
+                                        var toRead = (int)Math.Max(traceEvent.Bytes, 0);
+                                        if (toRead > buffer.Length)
+                                        {
+                                            buffer = new byte[toRead];
+                                        }
+                                        bytes += stream.Read(buffer, 0, toRead);
+                                    }
+                                    break;
+                                case IOTraceEventType.Close:
+                                    if (open.Remove(traceEvent.Path, out var closing))
+                                    {
+                                        closing.Dispose();
+                                    }
+                                    break;
+                            }
+                        }
+                        catch (Exception)
+                        {
+                            ++errors;
+                        }
+                        latencies.Add((Stopwatch.GetTimestamp() - start) * 1000.0 / Stopwatch.Frequency);
+                    }
+
+                    await FlushAsyncReads();
+
+                    foreach (var stream in open.Values)
+                    {
+                        stream.Dispose();
+                    }
+
+                    lock (resultLock)
+                    {
+                        result.Latencies.AddRange(latencies);
+                        result.Bytes += bytes;
+                        result.Files += files;
+                        result.Errors += errors;
+                    }
+                }))
+                .ToArray();
+
+            Task.WaitAll(threads);
+            result.Seconds = (Stopwatch.GetTimestamp() - replayStart) / (double)Stopwatch.Frequency;
+            return result;
+        }
+
+        /// <summary>
+        /// Replay every file in the trace as whole file async reads, submitted AsyncBatchSize files per
+        /// batch with all the batches in flight at once. The latency is reported per batch and a batch
+        /// that fails counts every file in it as an error.
+        /// </summary>
+        static PassResult ReplayAsync(VirtualFileSystem vfs, List<IOTraceEvent> events)
+        {
+            var result = new PassResult();
+            var files = events
+                .Where(i => i.Type == IOTraceEventType.Open || i.Type == IOTraceEventType.AsyncRead)
+                .Select(i => i.Path)
+                .Where(i => vfs.fileExists(i))
+                .ToList();
+
+            var replayStart = Stopwatch.GetTimestamp();
+            var reads = files.Chunk(AsyncBatchSize).Select(i =>
+            {
+                var start = Stopwatch.GetTimestamp();
+                return (Start: start, Count: i.Length, Task: vfs.readAllBytesAsync(i));
+            }).ToList();
+
+            foreach (var read in reads)
+            {
+                try
+                {
+                    foreach (var data in read.Task.GetAwaiter().GetResult())
+                    {
+                        result.Bytes += data.Length;
+                        ++result.Files;
+                    }
+                }
+                catch (Exception)
+                {
+                    result.Errors += read.Count;
+                }
+                result.Latencies.Add((Stopwatch.GetTimestamp() - read.Start) * 1000.0 / Stopwatch.Frequency);
+            }
+            result.Seconds = (Stopwatch.GetTimestamp() - replayStart) / (double)Stopwatch.Frequency;
+            return result;
+        }
+
+        static void WaitUntil(long replayStart, long offsetTicks)
+        {
+            var target = replayStart + offsetTicks;
+            var remaining = target - Stopwatch.GetTimestamp();
+            if (remaining > 0)
+            {
+                Task.Delay(TimeSpan.FromSeconds(remaining / (double)Stopwatch.Frequency)).Wait();
+            }
+        }
+
+        static void PrintResult(String name, PassResult result)
+        {
+            result.Latencies.Sort();
+            Console.WriteLine($"{name}: {result.Files} files, {Prettify.GetSizeReadable(result.Bytes)} in {result.Seconds:0.000} s, {result.Bytes / (1024.0 * 1024.0) / Math.Max(result.Seconds, 1e-9):0.00} MB/s, {result.Errors} errors");
+            if (result.Latencies.Count > 0)
+            {
+                Console.WriteLine($"  op latency ms p50 {Percentile(result.Latencies, 0.5):0.000} p95 {Percentile(result.Latencies, 0.95):0.000} p99 {Percentile(result.Latencies, 0.99):0.000} max {result.Latencies[result.Latencies.Count - 1]:0.000}");
+            }
+        }
+
+        static double Percentile(List<double> sorted, double percentile)
+        {
+            var index = (int)Math.Ceiling(percentile * sorted.Count) - 1;
+            return sorted[Math.Clamp(index, 0, sorted.Count - 1)];
+        }
+    }
+}
@@ -13,6 +13,11 @@ namespace Anomalous.OSPlatform
 {
     public abstract partial class App : IDisposable
     {
+        /// <summary>
+        /// Pass this with a file name on the command line to record the file io of the run with IOTrace.
+        /// </summary>
+        public const String IOTraceArg = "--iotrace";
+
         private IntPtr appPtr;
         private CallbackHandler callbackHandler;
         private bool restartOnShutdown = false;
@@ -69,9 +74,44 @@ namespace Anomalous.OSPlatform
             }
         }
 
+        /// <summary>
+        /// Run the app until it exits. If IOTraceArg is on the command line the trace runs for the whole
+        /// app and is flushed and closed when it exits.
+        /// </summary>
         public void Run()
         {
-            App_run(appPtr);
+            var ioTraceFile = GetIOTraceFile();
+            if (ioTraceFile != null)
+            {
+                Engine.Resources.IOTrace.start(ioTraceFile);
+            }
+
+            try
+            {
+                App_run(appPtr);
+            }
+            finally
+            {
+                if (ioTraceFile != null)
+                {
+                    Engine.Resources.IOTrace.stop();
+                }
+            }
+        }
+
+        private static String GetIOTraceFile()
+        {
+            var args = Environment.GetCommandLineArgs();
+            var index = Array.IndexOf(args, IOTraceArg);
+            if (index == -1)
+            {
+                return null;
+            }
+            if (index + 1 >= args.Length)
+            {
+                throw new InvalidOperationException($"{IOTraceArg} needs the file to write the trace to.");
+            }
+            return args[index + 1];
         }
 
         public void Exit()
@@ -117,7 +117,7 @@ namespace RTBepuDemo
             blasInstanceData.indexOffset = cubeBLAS.Instance.IndexOffset;
             fixed (BlasInstanceData* ptr = &blasInstanceData)
             {
-                primaryHitShader.BindSbt(instanceData.InstanceName, sbt, tlas, new IntPtr(ptr), (uint)sizeof(BlasInstanceData));
+                primaryHitShader.BindSbt(instanceData, sbt, tlas, new IntPtr(ptr), (uint)sizeof(BlasInstanceData));
             }
         }
     }
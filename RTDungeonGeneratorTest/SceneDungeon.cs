@@ -166,7 +166,7 @@ namespace RTDungeonGeneratorTest
             floorBlasInstanceData.indexOffset = mapMesh.FloorMesh.Instance.IndexOffset;
             fixed (BlasInstanceData* ptr = &floorBlasInstanceData)
             {
-                floorShader.BindSbt(floorInstanceData.InstanceName, sbt, tlas, new IntPtr(ptr), (uint)sizeof(BlasInstanceData));
+                floorShader.BindSbt(floorInstanceData, sbt, tlas, new IntPtr(ptr), (uint)sizeof(BlasInstanceData));
             }
         }
 
@@ -177,7 +177,7 @@ namespace RTIslandGeneratorTest
             floorBlasInstanceData.indexOffset = mapMesh.FloorMesh.Instance.IndexOffset;
             fixed (BlasInstanceData* ptr = &floorBlasInstanceData)
             {
-                floorShader.BindSbt(floorInstanceData.InstanceName, sbt, tlas, new IntPtr(ptr), (uint)sizeof(BlasInstanceData));
+                floorShader.BindSbt(floorInstanceData, sbt, tlas, new IntPtr(ptr), (uint)sizeof(BlasInstanceData));
             }
         }
 
@@ -58,7 +58,11 @@ namespace RTSandbox
 
             services.AddSingleton<SandboxScene>();
             services.AddSingleton<RTGui>();
-            services.AddDiligentEngineRt();
+            services.AddDiligentEngineRt(o =>
+            {
+                o.IterativeBounces = TraceBenchmark.UseIterativeBounces;
+            });
+            services.AddSingleton<TraceBenchmark>();
             services.AddSingleton<RTInstances>();
 
             services.AddScoped<SceneCube>();
@@ -25,6 +25,7 @@ namespace RTSandbox
         private readonly RTInstances rtInstances;
         private readonly ISwapChain swapChain;
         private readonly IDeviceContext immediateContext;
+        private readonly TraceBenchmark traceBenchmark;
 
         public unsafe RTSandboxUpdateListener
         (
@@ -34,7 +35,8 @@ namespace RTSandbox
             RayTracingRenderer rayTracingRenderer,
             ISharpGui sharpGui,
             RTGui gui,
-            RTInstances rtInstances
+            RTInstances rtInstances,
+            TraceBenchmark traceBenchmark
         )
         {
             this.cameraControls = cameraControls;
@@ -43,6 +45,7 @@ namespace RTSandbox
             this.sharpGui = sharpGui;
             this.gui = gui;
             this.rtInstances = rtInstances;
+            this.traceBenchmark = traceBenchmark;
             this.swapChain = graphicsEngine.SwapChain;
             this.immediateContext = graphicsEngine.ImmediateContext;
 
@@ -68,6 +71,7 @@ namespace RTSandbox
             sharpGui.End();
 
             rayTracingRenderer.Render(rtInstances, cameraControls.Position, cameraControls.Orientation);
+            traceBenchmark.Update();
 
             //This is the old clear loop, leaving in place in case we want or need the screen clear, but I think with pure rt there is no need
             //since we blit a texture to the full screen over and over.
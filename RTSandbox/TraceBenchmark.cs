@@ -0,0 +1,83 @@
+﻿using DiligentEngine;
+using DiligentEngine.RT;
+using Microsoft.Extensions.Logging;
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+using System.Threading.Tasks;
+
+namespace RTSandbox
+{
+    /// <summary>
+    /// Times the ray tracing pass over a number of frames and logs the results. Run with --benchmark
+    /// and then again with --benchmark --iterative-bounces to compare the recursive and iterative
+    /// bounce shaders on the same scene.
+    /// </summary>
+    class TraceBenchmark
+    {
+        public const String BenchmarkArg = "--benchmark";
+        public const String IterativeBouncesArg = "--iterative-bounces";
+
+        //Skip the frames where pipelines, textures and the gpu clocks are still settling
+        const int WarmupFrames = 120;
+        const int SampleFrames = 600;
+
+        private readonly GpuTimer gpuTimer;
+        private readonly RayTracingRenderer renderer;
+        private readonly RTOptions options;
+        private readonly ILogger<TraceBenchmark> logger;
+        private readonly List<double> samples = new List<double>(SampleFrames);
+        private int frame;
+
+        public TraceBenchmark(GpuTimer gpuTimer, RayTracingRenderer renderer, RTOptions options, ILogger<TraceBenchmark> logger)
+        {
+            this.gpuTimer = gpuTimer;
+            this.renderer = renderer;
+            this.options = options;
+            this.logger = logger;
+            Enabled = Environment.GetCommandLineArgs().Contains(BenchmarkArg);
+        }
+
+        public static bool UseIterativeBounces => Environment.GetCommandLineArgs().Contains(IterativeBouncesArg);
+
+        public bool Enabled { get; private set; }
+
+        /// <summary>
+        /// Call once a frame after the renderer.
+        /// </summary>
+        public void Update()
+        {
+            if (!Enabled)
+            {
+                return;
+            }
+
+            if (!gpuTimer.Enabled)
+            {
+                logger.LogWarning("Cannot benchmark, the device does not support timestamp queries.");
+                Enabled = false;
+                return;
+            }
+
+            if (++frame <= WarmupFrames)
+            {
+                return;
+            }
+
+            if (gpuTimer.TryGetDuration("Trace Rays", out var traceTime))
+            {
+                samples.Add(traceTime.TotalMilliseconds);
+            }
+
+            if (samples.Count == SampleFrames)
+            {
+                samples.Sort();
+                logger.LogInformation("Trace benchmark IterativeBounces: {0} Pipeline recursion depth: {1} Frames: {2} Average: {3:0.000}ms Median: {4:0.000}ms 95th: {5:0.000}ms Max: {6:0.000}ms",
+                    options.IterativeBounces, renderer.PipelineRecursionDepth, samples.Count,
+                    samples.Average(), samples[samples.Count / 2], samples[samples.Count * 95 / 100], samples[samples.Count - 1]);
+                Enabled = false;
+            }
+        }
+    }
+}
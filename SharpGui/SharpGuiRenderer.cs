@@ -16,13 +16,14 @@ namespace SharpGui
 
         private AutoPtr<IPipelineState> quadPipelineState;
         private AutoPtr<IShaderResourceBinding> quadShaderResourceBinding;
-        private AutoPtr<IBuffer> quadVertexBuffer;
         private AutoPtr<IBuffer> quadIndexBuffer;
 
         private AutoPtr<IPipelineState> textPipelineState;
         private AutoPtr<IShaderResourceBinding> textShaderResourceBinding;
-        private AutoPtr<IBuffer> textVertexBuffer;
         private AutoPtr<IBuffer> textIndexBuffer;
+        private FrameRingBuffer vertexRing;
+        private IBuffer[] vertexBuffers = new IBuffer[1];
+        private UInt64[] vertexOffsets = new UInt64[1];
         private List<AutoPtr<ITexture>> fontTextures = new List<AutoPtr<ITexture>>(NumFonts);
         private List<IDeviceObject> fontDeviceObjects = new List<IDeviceObject>(NumFonts);
         private readonly GraphicsEngine graphicsEngine;
@@ -30,6 +31,7 @@ namespace SharpGui
         private readonly IResourceProvider<SharpGuiRenderer> resourceProvider;
         private readonly IScaleHelper scaleHelper;
         private readonly TextureLoader textureLoader;
+        private readonly ShaderCache shaderCache;
         private DrawIndexedAttribs DrawAttrs;
         private uint maxNumberOfQuads;
         private uint maxNumberOfTextQuads;
@@ -41,7 +43,8 @@ namespace SharpGui
             SharpGuiOptions options, 
             IResourceProvider<SharpGuiRenderer> resourceProvider, 
             IScaleHelper scaleHelper,
-            TextureLoader textureLoader
+            TextureLoader textureLoader,
+            ShaderCache shaderCache
         )
         {
             this.maxNumberOfQuads = options.MaxNumberOfQuads;
@@ -60,15 +63,17 @@ namespace SharpGui
             this.resourceProvider = resourceProvider;
             this.scaleHelper = scaleHelper;
             this.textureLoader = textureLoader;
+            this.shaderCache = shaderCache;
             CreateQuadPso(graphicsEngine, m_pSwapChain, m_pDevice);
             CreateTextPso(graphicsEngine, m_pSwapChain, m_pDevice, scaleHelper);
 
             var barriers = new List<StateTransitionDesc>(4);
 
-            quadVertexBuffer = CreateVertexBuffer(graphicsEngine.RenderDevice, "SharpGui Quad Vertex Buffer", (uint)sizeof(SharpGuiVertex), maxNumberOfQuads, barriers);
+            //Quads and text share one ring, only the vertices used each frame are written
+            var vertexRingSize = ((ulong)sizeof(SharpGuiVertex) * maxNumberOfQuads + (ulong)sizeof(SharpGuiTextVertex) * maxNumberOfTextQuads) * 4 + (ulong)sizeof(SharpGuiTextVertex);
+            vertexRing = new FrameRingBuffer(graphicsEngine.RenderDevice, "SharpGui Vertex Ring", vertexRingSize, BIND_FLAGS.BIND_VERTEX_BUFFER);
+            vertexBuffers[0] = vertexRing.Buffer;
             quadIndexBuffer = CreateIndexBuffer(graphicsEngine.RenderDevice, "SharpGui Quad Index Buffer", maxNumberOfQuads, barriers);
-
-            textVertexBuffer = CreateVertexBuffer(graphicsEngine.RenderDevice, "SharpGui Text Vertex Buffer", (uint)sizeof(SharpGuiTextVertex), maxNumberOfQuads, barriers);
             textIndexBuffer = CreateIndexBuffer(graphicsEngine.RenderDevice, "SharpGui Text Index Buffer", maxNumberOfQuads, barriers);
 
             graphicsEngine.ImmediateContext.TransitionResourceStates(barriers);
@@ -87,7 +92,7 @@ namespace SharpGui
             ShaderCI.EntryPoint = "main";
             ShaderCI.Desc.Name = "SharpGui Quad VS";
             ShaderCI.Source = VSSource;
-            using var pVS = graphicsEngine.RenderDevice.CreateShader(ShaderCI);
+            using var pVS = shaderCache.CreateShader(ShaderCI);
 
             //Create pixel shader
             ShaderCI.Desc.ShaderType = SHADER_TYPE.SHADER_TYPE_PIXEL;
@@ -95,14 +100,16 @@ namespace SharpGui
             ShaderCI.EntryPoint = "main";
             ShaderCI.Desc.Name = "SharpGui Quad PS";
             ShaderCI.Source = PSSource;
-            using var pPS = graphicsEngine.RenderDevice.CreateShader(ShaderCI);
+            using var pPS = shaderCache.CreateShader(ShaderCI);
 
             var PSOCreateInfo = new GraphicsPipelineStateCreateInfo();
             PSOCreateInfo.PSODesc.Name = "SharpGui Quad PSO";
             PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE.PIPELINE_TYPE_GRAPHICS;
             PSOCreateInfo.GraphicsPipeline.NumRenderTargets = 1;
-            PSOCreateInfo.GraphicsPipeline.RTVFormats_0 = m_pSwapChain.GetDesc_ColorBufferFormat;
-            PSOCreateInfo.GraphicsPipeline.DSVFormat = m_pSwapChain.GetDesc_DepthBufferFormat;
+            var swapChainDesc = new SwapChainDescPassStruct();
+            m_pSwapChain.GetDesc(ref swapChainDesc);
+            PSOCreateInfo.GraphicsPipeline.RTVFormats_0 = swapChainDesc.ColorBufferFormat;
+            PSOCreateInfo.GraphicsPipeline.DSVFormat = swapChainDesc.DepthBufferFormat;
             PSOCreateInfo.GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY.PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
             PSOCreateInfo.GraphicsPipeline.RasterizerDesc.CullMode = CULL_MODE.CULL_MODE_BACK;
             PSOCreateInfo.GraphicsPipeline.DepthStencilDesc.DepthEnable = true;
@@ -146,6 +153,8 @@ namespace SharpGui
             // Define variable type that will be used by default
             PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE.SHADER_RESOURCE_VARIABLE_TYPE_STATIC;
 
+            PSOCreateInfo.pPSOCache = shaderCache.PipelineStateCache;
+
             this.quadPipelineState = m_pDevice.CreateGraphicsPipelineState(PSOCreateInfo);
 
             // Create a shader resource binding object and bind all static resources in it
@@ -165,7 +174,7 @@ namespace SharpGui
             ShaderCI.EntryPoint = "main";
             ShaderCI.Desc.Name = "SharpGui Text VS";
             ShaderCI.Source = TextVSSource;
-            using var pVS = graphicsEngine.RenderDevice.CreateShader(ShaderCI);
+            using var pVS = shaderCache.CreateShader(ShaderCI);
 
             //Create pixel shader
             ShaderCI.Desc.ShaderType = SHADER_TYPE.SHADER_TYPE_PIXEL;
@@ -173,14 +182,16 @@ namespace SharpGui
             ShaderCI.EntryPoint = "main";
             ShaderCI.Desc.Name = "SharpGui Text PS";
             ShaderCI.Source = TextPSSource;
-            using var pPS = graphicsEngine.RenderDevice.CreateShader(ShaderCI);
+            using var pPS = shaderCache.CreateShader(ShaderCI);
 
             var PSOCreateInfo = new GraphicsPipelineStateCreateInfo();
             PSOCreateInfo.PSODesc.Name = "SharpGui Text PSO";
             PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE.PIPELINE_TYPE_GRAPHICS;
             PSOCreateInfo.GraphicsPipeline.NumRenderTargets = 1;
-            PSOCreateInfo.GraphicsPipeline.RTVFormats_0 = m_pSwapChain.GetDesc_ColorBufferFormat;
-            PSOCreateInfo.GraphicsPipeline.DSVFormat = m_pSwapChain.GetDesc_DepthBufferFormat;
+            var swapChainDesc = new SwapChainDescPassStruct();
+            m_pSwapChain.GetDesc(ref swapChainDesc);
+            PSOCreateInfo.GraphicsPipeline.RTVFormats_0 = swapChainDesc.ColorBufferFormat;
+            PSOCreateInfo.GraphicsPipeline.DSVFormat = swapChainDesc.DepthBufferFormat;
             PSOCreateInfo.GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY.PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
             PSOCreateInfo.GraphicsPipeline.RasterizerDesc.CullMode = CULL_MODE.CULL_MODE_BACK;
             PSOCreateInfo.GraphicsPipeline.DepthStencilDesc.DepthEnable = true;
@@ -260,6 +271,8 @@ namespace SharpGui
             };
             PSOCreateInfo.PSODesc.ResourceLayout.ImmutableSamplers = ImtblSamplers;
 
+            PSOCreateInfo.pPSOCache = shaderCache.PipelineStateCache;
+
             this.textPipelineState = m_pDevice.CreateGraphicsPipelineState(PSOCreateInfo);
 
             // Create a shader resource binding object and bind all static resources in it
@@ -358,7 +371,9 @@ namespace SharpGui
             graphicsEngine.ImmediateContext.TransitionResourceStates(barriers);
 
             //Pre-scale image size, should add support for @2x @3x etc images
-            return new ImageTexture(textureIndex, scaleHelper.Scaled((int)tex.Obj.GetDesc_Width), scaleHelper.Scaled((int)tex.Obj.GetDesc_Height));
+            var texDesc = new TextureDescPassStruct();
+            tex.Obj.GetDesc(ref texDesc);
+            return new ImageTexture(textureIndex, scaleHelper.Scaled((int)texDesc.Width), scaleHelper.Scaled((int)texDesc.Height));
         }
 
         public void Dispose()
@@ -371,37 +386,41 @@ namespace SharpGui
             fontTextures.Clear();
 
             textIndexBuffer.Dispose();
-            textVertexBuffer.Dispose();
             textShaderResourceBinding.Dispose();
             textPipelineState.Dispose();
 
             quadIndexBuffer.Dispose();
-            quadVertexBuffer.Dispose();
+            vertexRing.Dispose();
             quadShaderResourceBinding.Dispose();
             quadPipelineState.Dispose();
         }
 
         public unsafe void Render(SharpGuiBuffer buffer, IDeviceContext immediateContext)
         {
+            //Write both sets of vertices before drawing, the ring is discarded on the first write each frame
+            vertexRing.Reset();
+            UInt64 quadVertexOffset = 0;
+            UInt64 textVertexOffset = 0;
             if (buffer.NumQuadIndices != 0)
             {
-                immediateContext.SetPipelineState(quadPipelineState.Obj);
-
-                //Copy quad vertices
-                {
-                    IntPtr data = immediateContext.MapBuffer(quadVertexBuffer.Obj, MAP_TYPE.MAP_WRITE, MAP_FLAGS.MAP_FLAG_DISCARD);
+                var numVerts = (int)(buffer.NumQuadIndices / 6 * 4);
+                quadVertexOffset = vertexRing.Write(immediateContext, new ReadOnlySpan<SharpGuiVertex>(buffer.QuadVerts, 0, numVerts), (ulong)sizeof(SharpGuiVertex));
+            }
 
-                    var dest = new Span<SharpGuiVertex>(data.ToPointer(), (int)maxNumberOfQuads * 4); //Yea this typecast is bad
-                    var src = new Span<SharpGuiVertex>(buffer.QuadVerts);
-                    src.CopyTo(dest);
+            if (buffer.NumTextIndices != 0)
+            {
+                var numVerts = (int)(buffer.NumTextIndices / 6 * 4);
+                textVertexOffset = vertexRing.Write(immediateContext, new ReadOnlySpan<SharpGuiTextVertex>(buffer.TextVerts, 0, numVerts), (ulong)sizeof(SharpGuiTextVertex));
+            }
 
-                    immediateContext.UnmapBuffer(quadVertexBuffer.Obj, MAP_TYPE.MAP_WRITE);
-                }
+            if (buffer.NumQuadIndices != 0)
+            {
+                immediateContext.SetPipelineState(quadPipelineState.Obj);
 
                 //Render quad vertices
                 {
-                    IBuffer[] pBuffs = new IBuffer[] { quadVertexBuffer.Obj };
-                    immediateContext.SetVertexBuffers(0, 1, pBuffs, null, RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_VERIFY, SET_VERTEX_BUFFERS_FLAGS.SET_VERTEX_BUFFERS_FLAG_RESET);
+                    vertexOffsets[0] = quadVertexOffset;
+                    immediateContext.SetVertexBuffers(0, 1, vertexBuffers, vertexOffsets, RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_VERIFY, SET_VERTEX_BUFFERS_FLAGS.SET_VERTEX_BUFFERS_FLAG_RESET);
                     immediateContext.SetIndexBuffer(quadIndexBuffer.Obj, 0, RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_VERIFY);
                     immediateContext.CommitShaderResources(quadShaderResourceBinding.Obj, RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 
@@ -414,21 +433,10 @@ namespace SharpGui
             {
                 immediateContext.SetPipelineState(textPipelineState.Obj);
 
-                //Copy text vertices
-                {
-                    IntPtr data = immediateContext.MapBuffer(textVertexBuffer.Obj, MAP_TYPE.MAP_WRITE, MAP_FLAGS.MAP_FLAG_DISCARD);
-
-                    var dest = new Span<SharpGuiTextVertex>(data.ToPointer(), (int)maxNumberOfTextQuads * 4); //Yea this typecast is bad
-                    var src = new Span<SharpGuiTextVertex>(buffer.TextVerts);
-                    src.CopyTo(dest);
-
-                    immediateContext.UnmapBuffer(textVertexBuffer.Obj, MAP_TYPE.MAP_WRITE);
-                }
-
                 //Render text vertices
                 {
-                    IBuffer[] pBuffs = new IBuffer[] { textVertexBuffer.Obj };
-                    immediateContext.SetVertexBuffers(0, 1, pBuffs, null, RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_VERIFY, SET_VERTEX_BUFFERS_FLAGS.SET_VERTEX_BUFFERS_FLAG_RESET);
+                    vertexOffsets[0] = textVertexOffset;
+                    immediateContext.SetVertexBuffers(0, 1, vertexBuffers, vertexOffsets, RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_VERIFY, SET_VERTEX_BUFFERS_FLAGS.SET_VERTEX_BUFFERS_FLAG_RESET);
                     immediateContext.SetIndexBuffer(textIndexBuffer.Obj, 0, RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_VERIFY);
                     immediateContext.CommitShaderResources(textShaderResourceBinding.Obj, RESOURCE_STATE_TRANSITION_MODE.RESOURCE_STATE_TRANSITION_MODE_VERIFY);
 
@@ -440,22 +448,6 @@ namespace SharpGui
 
         public uint NumIndices { get; private set; }
 
-        unsafe static AutoPtr<IBuffer> CreateVertexBuffer(IRenderDevice device, string name, uint vertexSize, uint maxNumberOfQuads, List<StateTransitionDesc> barriers)
-        {
-            BufferDesc VertBuffDesc = new BufferDesc();
-            VertBuffDesc.Name = name;
-            VertBuffDesc.Usage = USAGE.USAGE_DYNAMIC;
-            VertBuffDesc.BindFlags = BIND_FLAGS.BIND_VERTEX_BUFFER;
-            VertBuffDesc.CPUAccessFlags = CPU_ACCESS_FLAGS.CPU_ACCESS_WRITE;
-            VertBuffDesc.Size = vertexSize * maxNumberOfQuads * 4;
-            
-            var vertBuffer = device.CreateBuffer(VertBuffDesc);
-
-            barriers.Add(new StateTransitionDesc { pResource = vertBuffer.Obj, OldState = RESOURCE_STATE.RESOURCE_STATE_UNKNOWN, NewState = RESOURCE_STATE.RESOURCE_STATE_SHADER_RESOURCE, Flags = STATE_TRANSITION_FLAGS.STATE_TRANSITION_FLAG_UPDATE_STATE });
-
-            return vertBuffer;
-        }
-
         unsafe static AutoPtr<IBuffer> CreateIndexBuffer(IRenderDevice device, string name, uint maxNumberOfQuads, List<StateTransitionDesc> barriers)
         {
             var Indices = new UInt32[maxNumberOfQuads * 6];
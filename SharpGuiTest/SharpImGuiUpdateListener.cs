@@ -174,7 +174,7 @@ namespace SharpImGuiTest
             lastUpdateTimeBuilder.Clear();
             foreach (var value in PerformanceMonitor.Timelapses)
             {
-                lastUpdateTimeBuilder.AppendFormat("{0}: {1} {2} {3} {4}", value.Name, value.Duration, value.Min, value.Max, value.Average);
+                lastUpdateTimeBuilder.AppendFormat("{0}: {1:0.##} {2:0.##} {3:0.##} {4:0.##}", value.Name, value.Duration, value.Min, value.Max, value.Average);
                 lastUpdateTimeBuilder.AppendLine();
             }
 
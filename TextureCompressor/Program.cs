@@ -0,0 +1,372 @@
+﻿using DiligentEngine.RT.Resources;
+using Engine;
+using FreeImageAPI;
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Linq;
+using System.Runtime.InteropServices;
+
+namespace TextureCompressor
+{
+    /// <summary>
+    /// Compresses the cc0 texture sets in a directory into dds files that CC0TextureLoader will load
+    /// instead of the source images. The maps are packed the same way the loader packs them, so the
+    /// physical map is written twice, once for reflective materials and once without.
+    ///
+    /// Color and emission become BC7, normals BC5 with z rebuilt in the shader and ambient occlusion BC4.
+    /// Every mip is made from the full image the same way TextureLoader does at runtime.
+    ///
+    /// Usage: TextureCompressor directory [--recursive] [--force]
+    ///   --recursive  Also look for texture sets in subdirectories.
+    ///   --force      Compress every map, even if its dds is newer than its sources.
+    /// </summary>
+    class Program
+    {
+        class Options
+        {
+            public String Directory;
+            public bool Recursive;
+            public bool Force;
+        }
+
+        static readonly String[] SourceMaps = { "Color", "Normal", "Roughness", "Metalness", "AmbientOcclusion", "Emission" };
+        static readonly String[] SourceExtensions = { "jpg", "png" };
+
+        static int Main(string[] args)
+        {
+            var options = ParseArgs(args);
+            if (options == null)
+            {
+                Console.WriteLine("Usage: TextureCompressor directory [--recursive] [--force]");
+                return 1;
+            }
+
+            var searchOption = options.Recursive ? SearchOption.AllDirectories : SearchOption.TopDirectoryOnly;
+            var baseNames = new SortedSet<String>();
+            foreach (var file in Directory.EnumerateFiles(options.Directory, "*.*", searchOption))
+            {
+                var name = Path.GetFileNameWithoutExtension(file);
+                var ext = Path.GetExtension(file).TrimStart('.').ToLowerInvariant();
+                if (!SourceExtensions.Contains(ext))
+                {
+                    continue;
+                }
+                foreach (var map in SourceMaps)
+                {
+                    var suffix = $"_{map}";
+                    if (name.EndsWith(suffix, StringComparison.Ordinal))
+                    {
+                        baseNames.Add(Path.Combine(Path.GetDirectoryName(file), name.Substring(0, name.Length - suffix.Length)));
+                        break;
+                    }
+                }
+            }
+
+            Console.WriteLine($"Found {baseNames.Count} texture sets in {options.Directory}");
+
+            var errors = 0;
+            var stopwatch = Stopwatch.StartNew();
+            foreach (var baseName in baseNames)
+            {
+                try
+                {
+                    CompressSet(baseName, options.Force);
+                }
+                catch (Exception ex)
+                {
+                    Console.WriteLine($"  Failed {baseName}: {ex.Message}");
+                    ++errors;
+                }
+            }
+
+            Console.WriteLine($"Done in {stopwatch.Elapsed.TotalSeconds:F1}s with {errors} errors");
+            return errors > 0 ? 2 : 0;
+        }
+
+        static Options ParseArgs(string[] args)
+        {
+            var options = new Options();
+            for (int i = 0; i < args.Length; ++i)
+            {
+                switch (args[i])
+                {
+                    case "--recursive":
+                        options.Recursive = true;
+                        break;
+                    case "--force":
+                        options.Force = true;
+                        break;
+                    default:
+                        if (options.Directory != null)
+                        {
+                            return null;
+                        }
+                        options.Directory = args[i];
+                        break;
+                }
+            }
+            if (options.Directory == null || !Directory.Exists(options.Directory))
+            {
+                return null;
+            }
+            return options;
+        }
+
+        static void CompressSet(String baseName, bool force)
+        {
+            Console.WriteLine(baseName);
+
+            var color = FindSource(baseName, "Color");
+            var opacity = File.Exists($"{baseName}_Opacity.jpg") ? $"{baseName}_Opacity.jpg" : null;
+            var normal = FindSource(baseName, "Normal");
+            var roughness = FindSource(baseName, "Roughness");
+            var metalness = FindSource(baseName, "Metalness");
+            var ambientOcclusion = FindSource(baseName, "AmbientOcclusion");
+            var emissive = File.Exists($"{baseName}_Emission.jpg") ? $"{baseName}_Emission.jpg" : null;
+
+            if (color != null)
+            {
+                var output = CC0TextureLoader.GetCompressedPath(baseName, CC0TextureLoader.CompressedColorMap);
+                if (NeedsUpdate(output, force, color, opacity))
+                {
+                    using var bmp = new FreeImageBitmap(color);
+                    if (opacity != null)
+                    {
+                        //Same as the loader, the opacity map goes in the alpha channel
+                        bmp.ConvertColorDepth(FREE_IMAGE_COLOR_DEPTH.FICD_32_BPP);
+                        using var opacityBmp = new FreeImageBitmap(opacity);
+                        opacityBmp.ConvertColorDepth(FREE_IMAGE_COLOR_DEPTH.FICD_08_BPP);
+                        bmp.SetChannel(opacityBmp, FREE_IMAGE_COLOR_CHANNEL.FICC_ALPHA);
+                    }
+                    Write(bmp, output, BlockFormat.BC7, DxgiFormat.BC7_UNORM_SRGB, opacity != null ? DdsAlphaMode.Straight : DdsAlphaMode.Opaque);
+                }
+            }
+
+            if (normal != null)
+            {
+                var output = CC0TextureLoader.GetCompressedPath(baseName, CC0TextureLoader.CompressedNormalMap);
+                if (NeedsUpdate(output, force, normal))
+                {
+                    using var bmp = new FreeImageBitmap(normal);
+                    Write(bmp, output, BlockFormat.BC5, DxgiFormat.BC5_UNORM, DdsAlphaMode.Unknown);
+                }
+            }
+
+            if (roughness != null || metalness != null)
+            {
+                foreach (var reflective in new bool[] { false, true })
+                {
+                    var output = CC0TextureLoader.GetCompressedPath(baseName, CC0TextureLoader.GetCompressedPhysicalMap(reflective));
+                    if (NeedsUpdate(output, force, roughness, metalness))
+                    {
+                        using var bmp = CreatePhysicalDescriptor(roughness, metalness, reflective);
+                        //Alpha is the reflective flag, not coverage
+                        Write(bmp, output, BlockFormat.BC7, DxgiFormat.BC7_UNORM, DdsAlphaMode.Custom);
+                    }
+                }
+            }
+
+            if (ambientOcclusion != null)
+            {
+                var output = CC0TextureLoader.GetCompressedPath(baseName, CC0TextureLoader.CompressedAmbientOcclusionMap);
+                if (NeedsUpdate(output, force, ambientOcclusion))
+                {
+                    using var bmp = new FreeImageBitmap(ambientOcclusion);
+                    Write(bmp, output, BlockFormat.BC4, DxgiFormat.BC4_UNORM, DdsAlphaMode.Unknown);
+                }
+            }
+
+            if (emissive != null)
+            {
+                var output = CC0TextureLoader.GetCompressedPath(baseName, CC0TextureLoader.CompressedEmissiveMap);
+                if (NeedsUpdate(output, force, emissive))
+                {
+                    using var bmp = new FreeImageBitmap(emissive);
+                    Write(bmp, output, BlockFormat.BC7, DxgiFormat.BC7_UNORM, DdsAlphaMode.Opaque);
+                }
+            }
+        }
+
+        static String FindSource(String baseName, String map)
+        {
+            foreach (var ext in SourceExtensions)
+            {
+                var file = $"{baseName}_{map}.{ext}";
+                if (File.Exists(file))
+                {
+                    return file;
+                }
+            }
+            return null;
+        }
+
+        static bool NeedsUpdate(String output, bool force, params String[] sources)
+        {
+            if (force || !File.Exists(output))
+            {
+                return true;
+            }
+            var outputTime = File.GetLastWriteTimeUtc(output);
+            return sources.Any(i => i != null && File.GetLastWriteTimeUtc(i) > outputTime);
+        }
+
+        /// <summary>
+        /// Build the physical descriptor the same way CC0TextureLoader does. Metal goes in blue, roughness
+        /// in green and alpha is 1 for reflective materials.
+        /// </summary>
+        static unsafe FreeImageBitmap CreatePhysicalDescriptor(String roughness, String metalness, bool reflective)
+        {
+            FreeImageBitmap roughnessBmp = null;
+            FreeImageBitmap metalnessBmp = null;
+            try
+            {
+                int width = 0;
+                int height = 0;
+                if (roughness != null)
+                {
+                    roughnessBmp = new FreeImageBitmap(roughness);
+                    width = roughnessBmp.Width;
+                    height = roughnessBmp.Height;
+                }
+
+                if (metalness != null)
+                {
+                    metalnessBmp = new FreeImageBitmap(metalness);
+                    width = metalnessBmp.Width;
+                    height = metalnessBmp.Height;
+                }
+
+                var physicalDescriptorBmp = new FreeImageBitmap(width, height, PixelFormat.Format32bppArgb);
+                var firstPixel = ((uint*)physicalDescriptorBmp.Scan0.ToPointer()) - ((physicalDescriptorBmp.Height - 1) * physicalDescriptorBmp.Width);
+                var span = new Span<UInt32>(firstPixel, physicalDescriptorBmp.Width * physicalDescriptorBmp.Height);
+                span.Fill(CC0TextureLoader.GetDefaultPhysicalPixel(reflective));
+                if (metalnessBmp != null)
+                {
+                    physicalDescriptorBmp.SetChannel(metalnessBmp, FREE_IMAGE_COLOR_CHANNEL.FICC_BLUE);
+                }
+                if (roughnessBmp != null)
+                {
+                    physicalDescriptorBmp.SetChannel(roughnessBmp, FREE_IMAGE_COLOR_CHANNEL.FICC_GREEN);
+                }
+                return physicalDescriptorBmp;
+            }
+            finally
+            {
+                roughnessBmp?.Dispose();
+                metalnessBmp?.Dispose();
+            }
+        }
+
+        /// <summary>
+        /// Compress the bitmap and all of its mips and write them out. Like TextureLoader the bitmap is
+        /// flipped and made 32 bit first, then each mip is scaled down from the full image.
+        /// </summary>
+        static void Write(FreeImageBitmap bitmap, String output, BlockFormat blockFormat, DxgiFormat format, DdsAlphaMode alphaMode)
+        {
+            if (bitmap.Width % BlockCompression.BlockDimension != 0 || bitmap.Height % BlockCompression.BlockDimension != 0)
+            {
+                //D3D12 will not create a block compressed texture with a partial block on mip 0
+                Console.WriteLine($"  Skipped {Path.GetFileName(output)}, {bitmap.Width}x{bitmap.Height} is not a multiple of {BlockCompression.BlockDimension}");
+                return;
+            }
+
+            bitmap.RotateFlip(RotateFlipType.RotateNoneFlipY);
+            if (bitmap.PixelFormat != PixelFormat.Format32bppArgb)
+            {
+                bitmap.ConvertColorDepth(FREE_IMAGE_COLOR_DEPTH.FICD_32_BPP);
+            }
+
+            var width = bitmap.Width;
+            var height = bitmap.Height;
+            var mipLevels = 1;
+            while ((Math.Max(width, height) >> mipLevels) > 0)
+            {
+                ++mipLevels;
+            }
+
+            var data = new byte[DdsFile.GetChainSize(width, height, mipLevels, format)];
+            var offset = 0;
+            double rmse = 0;
+            for (var m = 0; m < mipLevels; ++m)
+            {
+                var mipWidth = Math.Max(width >> m, 1);
+                var mipHeight = Math.Max(height >> m, 1);
+                byte[] rgba;
+                if (m == 0)
+                {
+                    rgba = GetRgba(bitmap);
+                }
+                else
+                {
+                    using var mip = bitmap.Copy(0, 0, width, height);
+                    mip.Rescale(new Size(mipWidth, mipHeight), FREE_IMAGE_FILTER.FILTER_BILINEAR);
+                    rgba = GetRgba(mip);
+                }
+
+                var blocks = BlockCompression.Compress(rgba, mipWidth, mipHeight, blockFormat);
+                Buffer.BlockCopy(blocks, 0, data, offset, blocks.Length);
+                offset += blocks.Length;
+
+                if (m == 0)
+                {
+                    rmse = GetRmse(rgba, BlockCompression.Decompress(blocks, mipWidth, mipHeight, blockFormat), blockFormat);
+                }
+            }
+
+            var dds = new DdsFile(width, height, mipLevels, format, alphaMode, data);
+            using (var stream = File.Create(output))
+            {
+                dds.Write(stream);
+            }
+
+            Console.WriteLine($"  {Path.GetFileName(output)} {width}x{height} {format} {mipLevels} mips, rmse {rmse:F2}");
+        }
+
+        /// <summary>
+        /// Copy a 32 bit bitmap to tightly packed rgba. The rows are read in the same order
+        /// TextureLoader uploads them.
+        /// </summary>
+        static byte[] GetRgba(FreeImageBitmap bitmap)
+        {
+            var width = bitmap.Width;
+            var height = bitmap.Height;
+            var stride = Math.Abs(bitmap.Stride);
+            var firstRow = bitmap.Stride > 0 ? bitmap.Scan0 : bitmap.Scan0 - (stride * (height - 1));
+
+            var row = new byte[stride];
+            var rgba = new byte[width * height * 4];
+            for (var y = 0; y < height; ++y)
+            {
+                Marshal.Copy(firstRow + y * stride, row, 0, stride);
+                for (var x = 0; x < width; ++x)
+                {
+                    //The pixels are bgra in memory
+                    var src = x * 4;
+                    var dest = (y * width + x) * 4;
+                    rgba[dest] = row[src + 2];
+                    rgba[dest + 1] = row[src + 1];
+                    rgba[dest + 2] = row[src];
+                    rgba[dest + 3] = row[src + 3];
+                }
+            }
+            return rgba;
+        }
+
+        static double GetRmse(byte[] expected, byte[] actual, BlockFormat format)
+        {
+            var channels = format == BlockFormat.BC4 ? 1 : format == BlockFormat.BC5 ? 2 : 4;
+            double sum = 0;
+            for (var i = 0; i < expected.Length; i += 4)
+            {
+                for (var c = 0; c < channels; ++c)
+                {
+                    var diff = expected[i + c] - actual[i + c];
+                    sum += diff * diff;
+                }
+            }
+            return Math.Sqrt(sum / (expected.Length / 4 * channels));
+        }
+    }
+}
@@ -0,0 +1,220 @@
+#include "Stdafx.h"
+#include "AsyncIOQueue.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+
+AsyncIOQueue::AsyncIOQueue(int numThreads, int ringDepth)
+	:waitCancelled(false),
+	running(true)
+{
+	//The ring depth was for an io_uring backend that was never built, it is kept so the exported signature does not change
+	(void)ringDepth;
+	if (numThreads < 1)
+	{
+		numThreads = 1;
+	}
+	for (int i = 0; i < numThreads; ++i)
+	{
+		workers.emplace_back(&AsyncIOQueue::workerLoop, this);
+	}
+}
+
+AsyncIOQueue::~AsyncIOQueue()
+{
+	{
+		std::lock_guard<std::mutex> lock(workMutex);
+		running = false;
+	}
+	workCondition.notify_all();
+	cancelWait();
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+}
+
+void AsyncIOQueue::submitFileRead(const char* path, void* buffer, int64_t offset, int64_t size, int64_t userData)
+{
+	std::lock_guard<std::mutex> lock(pendingMutex);
+	pending.push_back(Request{ FileRead, path, nullptr, buffer, offset, size, userData, nowNs(), 0 });
+}
+
+void AsyncIOQueue::submitZipRead(ZZIP_DIR* zzipDir, const char* filename, void* buffer, int64_t size, int64_t userData)
+{
+	std::lock_guard<std::mutex> lock(pendingMutex);
+	pending.push_back(Request{ ZipRead, filename, zzipDir, buffer, 0, size, userData, nowNs(), 0 });
+}
+
+void AsyncIOQueue::flush()
+{
+	std::vector<Request> batch;
+	{
+		std::lock_guard<std::mutex> lock(pendingMutex);
+		batch.swap(pending);
+	}
+
+	if (batch.empty())
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(workMutex);
+		for (Request& request : batch)
+		{
+			work.push_back(std::move(request));
+		}
+	}
+	workCondition.notify_all();
+}
+
+int AsyncIOQueue::waitCompletions(AsyncIOCompletion* completions, int max, int timeoutMs)
+{
+	std::unique_lock<std::mutex> lock(completedMutex);
+	if (completed.empty() && !waitCancelled)
+	{
+		completedCondition.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this]() { return !completed.empty() || waitCancelled; });
+	}
+	waitCancelled = false;
+
+	int count = 0;
+	while (count < max && count < (int)completed.size())
+	{
+		completions[count] = completed[count];
+		++count;
+	}
+	completed.erase(completed.begin(), completed.begin() + count);
+	return count;
+}
+
+void AsyncIOQueue::cancelWait()
+{
+	{
+		std::lock_guard<std::mutex> lock(completedMutex);
+		waitCancelled = true;
+	}
+	completedCondition.notify_all();
+}
+
+void AsyncIOQueue::workerLoop()
+{
+	while (true)
+	{
+		Request request;
+		{
+			std::unique_lock<std::mutex> lock(workMutex);
+			workCondition.wait(lock, [this]() { return !work.empty() || !running; });
+			if (work.empty())
+			{
+				return;
+			}
+			request = std::move(work.front());
+			work.pop_front();
+		}
+		executeRequest(request);
+	}
+}
+
+void AsyncIOQueue::executeRequest(Request& request)
+{
+	request.startNs = nowNs();
+	if (request.type == ZipRead)
+	{
+		ZZIP_FILE* zzipFile = zzip_file_open(request.zzipDir, request.path.c_str(), ZZIP_ONLYZIP | ZZIP_CASELESS);
+		if (zzipFile == nullptr)
+		{
+			complete(request, 0, ENOENT);
+			return;
+		}
+
+		char* dest = static_cast<char*>(request.buffer);
+		int64_t total = 0;
+		while (total < request.size)
+		{
+			zzip_ssize_t read = zzip_file_read(zzipFile, dest + total, static_cast<zzip_size_t>(request.size - total));
+			if (read <= 0)
+			{
+				break;
+			}
+			total += read;
+		}
+		zzip_file_close(zzipFile);
+		complete(request, total, total == request.size ? 0 : EIO);
+	}
+	else
+	{
+		FILE* file = fopen(request.path.c_str(), "rb");
+		if (file == nullptr)
+		{
+			complete(request, 0, ENOENT);
+			return;
+		}
+
+#ifdef WINDOWS
+		int seekResult = _fseeki64(file, request.offset, SEEK_SET);
+#else
+		int seekResult = fseeko(file, static_cast<off_t>(request.offset), SEEK_SET);
+#endif
+		int64_t total = 0;
+		if (seekResult == 0)
+		{
+			total = static_cast<int64_t>(fread(request.buffer, 1, static_cast<size_t>(request.size), file));
+		}
+		fclose(file);
+		complete(request, total, total == request.size ? 0 : EIO);
+	}
+}
+
+void AsyncIOQueue::complete(const Request& request, int64_t bytesRead, int32_t error)
+{
+	uint32_t threadId = static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+	AsyncIOCompletion completion{ request.userData, bytesRead, request.queuedNs, request.startNs, nowNs(), threadId, error };
+	{
+		std::lock_guard<std::mutex> lock(completedMutex);
+		completed.push_back(completion);
+	}
+	completedCondition.notify_one();
+}
+
+int64_t AsyncIOQueue::nowNs()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+extern "C" _AnomalousExport AsyncIOQueue* AsyncIOQueue_Create(int numThreads, int ringDepth)
+{
+	return new AsyncIOQueue(numThreads, ringDepth);
+}
+
+extern "C" _AnomalousExport void AsyncIOQueue_Destroy(AsyncIOQueue* queue)
+{
+	delete queue;
+}
+
+extern "C" _AnomalousExport void AsyncIOQueue_SubmitFileRead(AsyncIOQueue* queue, const char* path, void* buffer, int64_t offset, int64_t size, int64_t userData)
+{
+	queue->submitFileRead(path, buffer, offset, size, userData);
+}
+
+extern "C" _AnomalousExport void AsyncIOQueue_SubmitZipRead(AsyncIOQueue* queue, ZZIP_DIR* zzipDir, const char* filename, void* buffer, int64_t size, int64_t userData)
+{
+	queue->submitZipRead(zzipDir, filename, buffer, size, userData);
+}
+
+extern "C" _AnomalousExport void AsyncIOQueue_Flush(AsyncIOQueue* queue)
+{
+	queue->flush();
+}
+
+extern "C" _AnomalousExport int AsyncIOQueue_WaitCompletions(AsyncIOQueue* queue, AsyncIOCompletion* completions, int max, int timeoutMs)
+{
+	return queue->waitCompletions(completions, max, timeoutMs);
+}
+
+extern "C" _AnomalousExport void AsyncIOQueue_CancelWait(AsyncIOQueue* queue)
+{
+	queue->cancelWait();
+}
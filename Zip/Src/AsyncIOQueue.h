@@ -0,0 +1,89 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//Result of a single read, handed back to the caller in batches.
+//The times are steady clock nanoseconds so callers can split queue wait from service time for tracing.
+struct AsyncIOCompletion
+{
+	int64_t userData;
+	int64_t bytesRead;
+	int64_t queuedNs;
+	int64_t startNs;
+	int64_t endNs;
+	uint32_t threadId;
+	int32_t error;		//0 on success, errno style code otherwise
+};
+
+//A batched read queue. Reads are collected with submitFileRead / submitZipRead
+//and handed to a small pool of worker threads together on flush.
+class AsyncIOQueue
+{
+public:
+	AsyncIOQueue(int numThreads, int ringDepth);
+
+	~AsyncIOQueue();
+
+	void submitFileRead(const char* path, void* buffer, int64_t offset, int64_t size, int64_t userData);
+
+	void submitZipRead(ZZIP_DIR* zzipDir, const char* filename, void* buffer, int64_t size, int64_t userData);
+
+	//Push everything submitted since the last flush to the backend.
+	void flush();
+
+	//Copy up to max finished reads into completions, waiting up to timeoutMs for at least one.
+	//Returns the number of completions written.
+	int waitCompletions(AsyncIOCompletion* completions, int max, int timeoutMs);
+
+	//Wake any thread blocked in waitCompletions without a result.
+	void cancelWait();
+
+private:
+	enum RequestType
+	{
+		FileRead,
+		ZipRead,
+	};
+
+	struct Request
+	{
+		RequestType type;
+		std::string path;
+		ZZIP_DIR* zzipDir;
+		void* buffer;
+		int64_t offset;
+		int64_t size;
+		int64_t userData;
+		int64_t queuedNs;
+		int64_t startNs;
+	};
+
+	void workerLoop();
+
+	void executeRequest(Request& request);
+
+	void complete(const Request& request, int64_t bytesRead, int32_t error);
+
+	static int64_t nowNs();
+
+	std::vector<Request> pending;
+	std::mutex pendingMutex;
+
+	std::deque<Request> work;
+	std::mutex workMutex;
+	std::condition_variable workCondition;
+
+	std::vector<AsyncIOCompletion> completed;
+	std::mutex completedMutex;
+	std::condition_variable completedCondition;
+	bool waitCancelled;
+
+	std::vector<std::thread> workers;
+	bool running;
+};
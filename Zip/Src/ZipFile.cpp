@@ -2,7 +2,7 @@
 
 #include <string>
 
-#if APPLE_IOS
+#if APPLE_IOS || LINUX
 #include <unistd.h>
 #endif
 
@@ -11,7 +11,7 @@ static zzip_ssize_t xor_read (int f, void* p, zzip_size_t l)
 #ifdef WINDOWS
 	zzip_ssize_t r = _read(f, p, l);
 #endif
-#if defined(MAC_OSX) || defined(APPLE_IOS) || defined(ANDROID)
+#if defined(MAC_OSX) || defined(APPLE_IOS) || defined(ANDROID) || defined(LINUX)
 	zzip_ssize_t r = read(f, p, l);
 #endif
 	zzip_ssize_t x; 
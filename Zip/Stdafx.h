@@ -13,6 +13,6 @@
 #define _AnomalousExport __declspec(dllexport)
 #endif
 
-#if defined(MAC_OSX) || defined(APPLE_IOS) || defined(ANDROID)
+#if defined(MAC_OSX) || defined(APPLE_IOS) || defined(ANDROID) || defined(LINUX)
 #define _AnomalousExport __attribute__ ((visibility("default")))
 #endif
\ No newline at end of file